@@ -0,0 +1 @@
+static const char *petscconfigureoptions = "--with-cxx=0 --with-debugging=1 --with-fc=0 --with-ssl=0 --with-x=0 --with-openmp=1 PETSC_ARCH=arch-omp";
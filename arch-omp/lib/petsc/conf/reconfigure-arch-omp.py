@@ -0,0 +1,16 @@
+#!/root/.pyenv/versions/3.8.18/bin/python3
+if __name__ == '__main__':
+  import sys
+  import os
+  sys.path.insert(0, os.path.abspath('config'))
+  import configure
+  configure_options = [
+    '--with-cxx=0',
+    '--with-debugging=1',
+    '--with-fc=0',
+    '--with-openmp=1',
+    '--with-ssl=0',
+    '--with-x=0',
+    'PETSC_ARCH=arch-omp',
+  ]
+  configure.petsc_configure(configure_options)
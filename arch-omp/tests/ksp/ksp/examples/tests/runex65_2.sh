@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/arch-omp/lib"
+
+exec='../ex65'
+testname='runex65_2'
+label='ksp_ksp_tests-ex65_2'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='arch-omp'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/arch-omp/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/arch-omp/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-pc_type bjacobi -sub_pc_type icc'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+
+
+nsize_in=${nsize:-2}
+nonsymmetric_in=${nonsymmetric:-0 1}
+basis_in=${basis:-newton chebyshev}
+s_in=${s:-2 6}
+
+
+for nsize in ${nsize_in}; do
+   for nonsymmetric in ${nonsymmetric_in}; do
+      for basis in ${basis_in}; do
+         for s in ${s_in}; do
+
+            petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -nonsymmetric ${nonsymmetric} -basis ${basis} -s ${s}" ex65_2.tmp ${testname}.err "${label}+nonsymmetric-${nonsymmetric}_basis-${basis}_s-${s}" 
+            res=$?
+
+            if test $res = 0; then
+               petsc_testrun "${diff_exe} /root/repo/src/ksp/ksp/examples/tests/output/ex65_1.out ex65_2.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+nonsymmetric-${nonsymmetric}_basis-${basis}_s-${s} ""
+            else
+               petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+            fi
+
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/arch-omp/tests" 
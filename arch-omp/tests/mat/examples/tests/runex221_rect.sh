@@ -0,0 +1,71 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/arch-omp/lib"
+
+exec='../ex221'
+testname='runex221_rect'
+label='mat_tests-ex221_rect'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='arch-omp'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/arch-omp/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/arch-omp/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-loop 3'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+
+
+nsize_in=${nsize:-1 3}
+keep_in=${keep:-0 1}
+M_in=${M:-12 19}
+N_in=${N:-19 12}
+submat_in=${submat:-0 1}
+test_axpy_different_in=${test_axpy_different:-0 1}
+
+
+for nsize in ${nsize_in}; do
+   for keep in ${keep_in}; do
+      for M in ${M_in}; do
+         for N in ${N_in}; do
+            for submat in ${submat_in}; do
+               for test_axpy_different in ${test_axpy_different_in}; do
+
+                  petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -keep ${keep} -M ${M} -N ${N} -submat ${submat} -test_axpy_different ${test_axpy_different}" ex221_rect.tmp ${testname}.err "${label}+nsize-${nsize}keep-${keep}_M-${M}_N-${N}_submat-${submat}_test_axpy_different-${test_axpy_different}" 
+                  res=$?
+
+                  if test $res = 0; then
+                     petsc_testrun "${diff_exe} /root/repo/src/mat/examples/tests/output/ex221_1.out ex221_rect.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+nsize-${nsize}keep-${keep}_M-${M}_N-${N}_submat-${submat}_test_axpy_different-${test_axpy_different} ""
+                  else
+                     petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+                  fi
+
+               done
+            done
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/arch-omp/tests" 
@@ -0,0 +1 @@
+mpiexec  -n 1 ../ex243 -lev_mat_factor_solve_levels  -ordering rcm -levels 0 > ex243_1.tmp 2> runex243_1.err
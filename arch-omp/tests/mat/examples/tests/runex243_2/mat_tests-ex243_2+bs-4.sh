@@ -0,0 +1 @@
+mpiexec  -n 1 ../ex243 -lev_mat_factor_solve_levels -levels 1  -bs 4 > ex243_2.tmp 2> runex243_2.err
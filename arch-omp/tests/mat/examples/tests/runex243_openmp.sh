@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/arch-omp/lib"
+
+exec='../ex243'
+testname='runex243_openmp'
+label='mat_tests-ex243_openmp'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='arch-omp'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/arch-omp/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/arch-omp/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-lev_mat_factor_solve_levels -ordering rcm -levels 1'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+
+
+nsize_in=${nsize:-1}
+omp_num_threads_in=${omp_num_threads:-1 3 4}
+bs_in=${bs:-1 3}
+
+
+for nsize in ${nsize_in}; do
+   for omp_num_threads in ${omp_num_threads_in}; do
+      for bs in ${bs_in}; do
+
+         petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -omp_num_threads ${omp_num_threads} -bs ${bs}" ex243_openmp.tmp ${testname}.err "${label}+omp_num_threads-${omp_num_threads}_bs-${bs}" 
+         res=$?
+
+         if test $res = 0; then
+            petsc_testrun "${diff_exe} /root/repo/src/mat/examples/tests/output/ex243_1.out ex243_openmp.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+omp_num_threads-${omp_num_threads}_bs-${bs} ""
+         else
+            petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+         fi
+
+      done
+   done
+done
+
+petsc_testend "/root/repo/arch-omp/tests" 
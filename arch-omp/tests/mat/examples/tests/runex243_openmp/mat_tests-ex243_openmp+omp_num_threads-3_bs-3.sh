@@ -0,0 +1 @@
+mpiexec  -n 1 ../ex243 -lev_mat_factor_solve_levels -ordering rcm -levels 1  -omp_num_threads 3 -bs 3 > ex243_openmp.tmp 2> runex243_openmp.err
@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/arch-omp/lib"
+
+exec='../ex244'
+testname='runex244_1'
+label='mat_tests-ex244_1'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='arch-omp'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/arch-omp/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/arch-omp/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter=''
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-mat_no_inode'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+
+
+nsize_in=${nsize:-1}
+nonsymmetric_in=${nonsymmetric:-0 1}
+omega_in=${omega:-1.0 1.3}
+
+
+for nsize in ${nsize_in}; do
+   for nonsymmetric in ${nonsymmetric_in}; do
+      for omega in ${omega_in}; do
+
+         petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -nonsymmetric ${nonsymmetric} -omega ${omega}" ex244_1.tmp ${testname}.err "${label}+nonsymmetric-${nonsymmetric}_omega-${omega}" 
+         res=$?
+
+         if test $res = 0; then
+            petsc_testrun "${diff_exe} /root/repo/src/mat/examples/tests/output/ex244_1.out ex244_1.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+nonsymmetric-${nonsymmetric}_omega-${omega} ""
+         else
+            petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+         fi
+
+      done
+   done
+done
+
+petsc_testend "/root/repo/arch-omp/tests" 
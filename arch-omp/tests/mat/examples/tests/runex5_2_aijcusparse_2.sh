@@ -0,0 +1,71 @@
+#!/usr/bin/env bash
+# This script was created by gmakegentest.py
+
+
+
+# PATH for DLLs on windows
+PATH="$PATH":"/root/repo/arch-omp/lib"
+
+exec='../ex5'
+testname='runex5_2_aijcusparse_2'
+label='mat_tests-ex5_2_aijcusparse_2'
+runfiles=''
+wPETSC_DIR='/root/repo'
+petsc_dir='/root/repo'
+petsc_arch='arch-omp'
+# Must be consistent with gmakefile.test
+testlogtapfile=/root/repo/arch-omp/tests/test_${petsc_arch}_tap.log
+testlogerrfile=/root/repo/arch-omp/tests/test_${petsc_arch}_err.log
+config_dir='/root/repo/config'
+filter='grep -v type'
+filter_output=''
+petsc_bindir='/root/repo/lib/petsc/bin'
+DATAFILESPATH=${DATAFILESPATH:-""}
+args='-mat_type mpiaijcusparse -vec_type cuda'
+timeoutfactor=1
+
+mpiexec=${PETSCMPIEXEC:-"mpiexec"}
+diffexec=${PETSCDIFF:-"${petsc_bindir}/petscdiff"}
+
+. "${config_dir}/petsc_harness.sh"
+
+# The diff flags come from script arguments
+diff_exe="${diffexec} ${diff_flags}"
+mpiexec="${mpiexec} ${mpiexec_flags}"
+
+
+
+if ! $force; then
+    petsc_report_tapoutput "" "${label}" "SKIP PETSC_HAVE_CUDA requirement not met"
+    total=1; skip=1
+    petsc_testend "/root/repo/arch-omp/tests" 
+    exit
+fi
+
+
+nsize_in=${nsize:-3}
+sf_type_in=${sf_type:-basic neighbor}
+vecscatter_packongpu_in=${vecscatter_packongpu:-0 1}
+sf_use_pinned_buffer_in=${sf_use_pinned_buffer:-0 1}
+
+
+for nsize in ${nsize_in}; do
+   for sf_type in ${sf_type_in}; do
+      for vecscatter_packongpu in ${vecscatter_packongpu_in}; do
+         for sf_use_pinned_buffer in ${sf_use_pinned_buffer_in}; do
+
+            petsc_testrun "${mpiexec} -n ${nsize} ${exec} ${args}  -sf_type ${sf_type} -vecscatter_packongpu ${vecscatter_packongpu} -sf_use_pinned_buffer ${sf_use_pinned_buffer}" ex5_2_aijcusparse_2.tmp ${testname}.err "${label}+sf_type-${sf_type}_vecscatter_packongpu-${vecscatter_packongpu}_sf_use_pinned_buffer-${sf_use_pinned_buffer}" 
+            res=$?
+
+            if test $res = 0; then
+               petsc_testrun "${diff_exe} /root/repo/src/mat/examples/tests/output/ex5_23.out ex5_2_aijcusparse_2.tmp" diff-${testname}.out diff-${testname}.out diff-${label}+sf_type-${sf_type}_vecscatter_packongpu-${vecscatter_packongpu}_sf_use_pinned_buffer-${sf_use_pinned_buffer} ""
+            else
+               petsc_report_tapoutput "" ${label} "SKIP Command failed so no diff"
+            fi
+
+         done
+      done
+   done
+done
+
+petsc_testend "/root/repo/arch-omp/tests" 
@@ -96,6 +96,12 @@
 #define MATAIJSELL         'aijsell'
 #define MATSEQAIJSELL      'seqaijsell'
 #define MATMPIAIJSELL      'mpiaijsell'
+#define MATAIJMIXED        'aijmixed'
+#define MATAIJDELTA        'aijdelta'
+#define MATSEQAIJMIXED     'seqaijmixed'
+#define MATSEQAIJDELTA     'seqaijdelta'
+#define MATMPIAIJMIXED     'mpiaijmixed'
+#define MATMPIAIJDELTA     'mpiaijdelta'
 #define MATAIJMKL          'aijmkl'
 #define MATSEQAIJMKL       'seqaijmkl'
 #define MATMPIAIJMKL       'mpiaijmkl'
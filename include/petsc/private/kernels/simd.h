@@ -0,0 +1,42 @@
+#if !defined(PETSC_KERNELS_SIMD_H)
+#define PETSC_KERNELS_SIMD_H
+
+/*
+   Decides which x86 variants of the hand written kernels are compiled.
+
+   GNU compatible compilers can build a function for an instruction set that is not enabled
+   on the command line, so all the variants are compiled with the PETSC_SIMD_TARGET_ attributes
+   and the one installed in the ops table is chosen at run time with PetscSIMDGetLevel().
+   Other compilers only build the variants enabled by their flags.
+
+   Kernels that gather with PetscInt indices as 32 bit integers must also check PETSC_USE_64BIT_INDICES.
+*/
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_SKIP_IMMINTRIN_H_CUDAWORKAROUND)
+#  if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || __GNUC__ >= 5) && !defined(__INTEL_COMPILER) && !defined(__PGI)
+#    define PETSC_SIMD_USE_DISPATCH
+#    define PETSC_SIMD_USE_AVX
+#    define PETSC_SIMD_USE_AVX2
+#    define PETSC_SIMD_USE_AVX512
+#    define PETSC_SIMD_TARGET_AVX    __attribute__((target("avx")))
+#    define PETSC_SIMD_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#    define PETSC_SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#  else
+#    if defined(__AVX__)
+#      define PETSC_SIMD_USE_AVX
+#    endif
+#    if defined(__AVX2__) && defined(__FMA__)
+#      define PETSC_SIMD_USE_AVX2
+#    endif
+#    if defined(__AVX512F__)
+#      define PETSC_SIMD_USE_AVX512
+#    endif
+#    define PETSC_SIMD_TARGET_AVX
+#    define PETSC_SIMD_TARGET_AVX2
+#    define PETSC_SIMD_TARGET_AVX512
+#  endif
+#  if defined(PETSC_SIMD_USE_AVX) || defined(PETSC_SIMD_USE_AVX2) || defined(PETSC_SIMD_USE_AVX512)
+#    include <immintrin.h>
+#  endif
+#endif
+
+#endif
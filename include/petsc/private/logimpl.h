@@ -50,6 +50,10 @@ PETSC_EXTERN const char    *petsc_traceblanks;
 PETSC_EXTERN char           petsc_tracespace[128];
 PETSC_EXTERN PetscLogDouble petsc_tracetime;
 
+PETSC_INTERN PetscBool      petsc_logTimeline;
+PETSC_INTERN PetscInt       petsc_numHWCounters;
+PETSC_INTERN PetscLogDouble petsc_MemoryBandwidth;
+
 #ifdef PETSC_USE_LOG
 
 PETSC_EXTERN PetscErrorCode PetscIntStackCreate(PetscIntStack *);
@@ -86,6 +90,12 @@ PETSC_EXTERN PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent, int, Petsc
 PETSC_EXTERN PetscErrorCode PetscLogEventEndComplete(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventBeginTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventEndTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_INTERN PetscErrorCode PetscLogTimelineStage_Internal(PetscLogStage,PetscBool);
+PETSC_INTERN PetscErrorCode PetscLogTimelineDestroy_Internal(void);
+PETSC_INTERN PetscErrorCode PetscLogReadHWCounters_Internal(PetscLogDouble[]);
+PETSC_INTERN PetscErrorCode PetscLogCommMatrixEventPush_Internal(PetscLogEvent);
+PETSC_INTERN PetscErrorCode PetscLogCommMatrixEventPop_Internal(void);
+PETSC_INTERN PetscErrorCode PetscLogCommMatrixDestroy_Internal(void);
 
 /* Creation and destruction functions */
 PETSC_EXTERN PetscErrorCode PetscClassRegLogCreate(PetscClassRegLog *);
@@ -124,6 +134,7 @@ PETSC_EXTERN PetscErrorCode PetscStageLogGetClassPerfLog(PetscStageLog, int, Pet
 PETSC_EXTERN PetscErrorCode PetscEventRegLogGetEvent(PetscEventRegLog, const char [], PetscLogEvent *);
 
 PETSC_INTERN PetscErrorCode PetscLogView_Nested(PetscViewer);
+PETSC_INTERN PetscErrorCode PetscLogView_Flamegraph(PetscViewer);
 PETSC_INTERN PetscErrorCode PetscLogNestedEnd(void);
 
 #endif /* PETSC_USE_LOG */
@@ -377,6 +377,41 @@ typedef struct { /* used by MatCreateRedundantMatrix() for reusing matredundant
   Mat          *matseq;
 } Mat_Redundant;
 
+typedef struct { /* used by MatSetPreallocationCOO() and MatSetValuesCOO() for the XAIJ formats */
+  PetscInt         n;            /* number of COO entries given on this process */
+  PetscInt         *perm;        /* location of each COO entry in the value arrays; -1 if ignored or owned by another process */
+  PetscSF          sf;           /* leaves are the off-process COO entries, roots are the entries received by this process */
+  PetscInt         nrecv;        /* number of entries received from other processes */
+  PetscInt         *recvperm;    /* location of each received entry in the value arrays */
+  PetscScalar      *recvbuf;     /* values received from other processes */
+  PetscInt         nA,nB;        /* length of the diagonal and off-diagonal value arrays; locations >= nA are in the off-diagonal one */
+  PetscObjectState nonzerostate; /* nonzero state of the matrix when the locations were computed */
+} Mat_COO;
+PETSC_INTERN PetscErrorCode MatCOOStructCreate_XAIJ(Mat,PetscInt,PetscBool,PetscInt,const PetscInt[],const PetscInt[],PetscInt**,PetscInt**,Mat_COO**);
+PETSC_INTERN PetscErrorCode MatCOOStructSetValues_XAIJ(Mat,Mat_COO*,const PetscScalar[],InsertMode,MatScalar*,MatScalar*);
+PETSC_INTERN PetscErrorCode MatCOOStructDestroy_XAIJ(Mat_COO**);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_Basic(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_Basic(Mat,const PetscScalar[],InsertMode);
+
+typedef struct { /* kept by Y for MatAXPY() of the XAIJ formats when the nonzeros of X are a subset of those of Y */
+  PetscObjectId    xid;          /* X the locations were computed for */
+  PetscObjectState xstate;       /* nonzero state of X when the locations were computed */
+  PetscObjectState ystate;       /* nonzero state of Y when the locations were computed */
+  PetscInt         bs2;          /* number of values in each nonzero block */
+  PetscInt         nA,nB;        /* number of blocks in the diagonal and off-diagonal parts of X */
+  PetscInt         nyA;          /* number of blocks in the diagonal part of Y; locations >= nyA are in the off-diagonal one */
+  PetscInt         *loc;         /* location of each block of X in the value arrays of Y */
+} Mat_AXPY;
+PETSC_INTERN PetscErrorCode MatAXPYStructCheck_XAIJ(Mat,Mat,PetscInt,PetscInt,PetscInt,PetscInt,Mat_AXPY**,PetscBool*);
+PETSC_INTERN PetscErrorCode MatAXPYStructSetLocations_XAIJ(PetscInt,const PetscInt[],const PetscInt[],const PetscInt[],const PetscInt[],const PetscInt[],const PetscInt[],PetscInt,PetscInt[],PetscBool*);
+PETSC_INTERN PetscErrorCode MatAXPYStructApply_XAIJ(Mat_AXPY*,PetscScalar,const MatScalar*,const MatScalar*,MatScalar*,MatScalar*);
+PETSC_INTERN PetscErrorCode MatAXPYStructDestroy_XAIJ(Mat_AXPY**);
+typedef struct _n_Mat_Hash *Mat_Hash; /* entries set before the first final assembly with MatSetHashAssembly() */
+PETSC_INTERN PetscErrorCode MatSetUpHash_Private(Mat);
+#if defined(PETSC_HAVE_MPIIO)
+PETSC_INTERN PetscErrorCode MatLoadBinaryReadRows_MPIIO(PetscViewer,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt[],PetscInt**,PetscScalar**);
+#endif
+
 struct _p_Mat {
   PETSCHEADER(struct _MatOps);
   PetscLayout            rmap,cmap;
@@ -395,6 +430,8 @@ struct _p_Mat {
   MatNullSpace           nearnullsp;       /* near null space to be used by multigrid methods */
   PetscInt               congruentlayouts; /* are the rows and columns layouts congruent? */
   PetscBool              preallocated;
+  PetscBool              hashassembly;     /* set by MatSetHashAssembly() */
+  Mat_Hash               hash;             /* not NULL from MatSetUp() to the first final assembly with hash assembly */
   MatStencilInfo         stencil;          /* information for structured grid */
   PetscBool              symmetric,hermitian,structurally_symmetric,spd;
   PetscBool              symmetric_set,hermitian_set,structurally_symmetric_set,spd_set; /* if true, then corresponding flag is correct*/
@@ -556,6 +593,10 @@ struct  _p_MatFDColoring{
   PetscBool      fset;             /* indicates that the initial function value F(X) is set */
   PetscErrorCode (*f)(void);       /* function that defines Jacobian */
   void           *fctx;            /* optional user-defined context for use by the function f */
+  PetscErrorCode (*fbatch)(void);  /* optional function evaluated at several perturbed vectors at once */
+  void           *fbatchctx;       /* optional user-defined context for use by the function fbatch */
+  PetscInt       nbatch;           /* number of work vectors for fbatch */
+  Vec            *xbatch,*ybatch;  /* perturbed vectors and function values (placed on dy) passed to fbatch */
   Vec            vscale;           /* holds FD scaling, i.e. 1/dx for each perturbed column */
   PetscInt       currentcolor;     /* color for which function evaluation is being done now */
   const char     *htype;           /* "wp" or "ds" */
@@ -654,6 +695,8 @@ typedef struct { /* used by MatCreateSubMatrices_MPIAIJ_SingleIS_Local() and Mat
 #else
   PetscInt   *cmap,*rmap;
 #endif
+  PetscObjectState nonzerostate; /* of the matrix when the submatrices were created */
+  PetscSF    sfA,sfB;             /* for MAT_REUSE_MATRIX, move the values of the diagonal and off-diagonal blocks of the matrix to the submatrices */
 
   PetscErrorCode (*destroy)(Mat);
 } Mat_SubSppt;
@@ -1662,6 +1705,8 @@ PETSC_EXTERN PetscLogEvent MAT_Scale;
 PETSC_EXTERN PetscLogEvent MAT_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent MAT_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent MAT_SetValues;
+PETSC_EXTERN PetscLogEvent MAT_PreallCOO;
+PETSC_EXTERN PetscLogEvent MAT_SetVCOO;
 PETSC_EXTERN PetscLogEvent MAT_GetValues;
 PETSC_EXTERN PetscLogEvent MAT_GetRow;
 PETSC_EXTERN PetscLogEvent MAT_GetRowIJ;
@@ -66,4 +66,7 @@ PETSC_EXTERN PetscLogEvent PC_ModifySubMatrices;
 PETSC_EXTERN PetscLogEvent PC_ApplyOnBlocks;
 PETSC_EXTERN PetscLogEvent PC_ApplyTransposeOnBlocks;
 
+PETSC_INTERN PetscErrorCode PCSetUpBlocks_Private(PC,PetscBool,PetscInt,KSP[]);
+PETSC_INTERN PetscErrorCode PCSolveBlocks_Private(PC,PetscBool,PetscBool,PetscInt,KSP[],Vec[],Vec[]);
+
 #endif
@@ -173,6 +173,9 @@ struct _DMSNESOps {
   PetscErrorCode (*computefunction)(SNES,Vec,Vec,void*);
   PetscErrorCode (*computejacobian)(SNES,Vec,Mat,Mat,void*);
 
+  /* residual at several vectors at once, used by finite difference Jacobians with coloring */
+  PetscErrorCode (*computefunctionbatch)(SNES,PetscInt,Vec[],Vec[],void*);
+
   /* objective */
   PetscErrorCode (*computeobjective)(SNES,Vec,PetscReal*,void*);
 
@@ -190,6 +193,7 @@ struct _DMSNESOps {
 struct _p_DMSNES {
   PETSCHEADER(struct _DMSNESOps);
   void *functionctx;
+  void *functionbatchctx;
   void *gsctx;
   void *pctx;
   void *jacobianctx;
@@ -210,6 +214,7 @@ PETSC_EXTERN PetscErrorCode DMGetDMSNES(DM,DMSNES*);
 PETSC_EXTERN PetscErrorCode DMSNESView(DMSNES,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMSNESLoad(DMSNES,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMGetDMSNESWrite(DM,DMSNES*);
+PETSC_INTERN PetscErrorCode SNESMatFDColoringSetFunctionBatch_Private(DM,MatFDColoring);
 
 
 /* Context for Eisenstat-Walker convergence criteria for KSP solvers */
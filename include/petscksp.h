@@ -37,6 +37,7 @@ typedef const char* KSPType;
 #define KSPPIPECGRR   "pipecgrr"
 #define KSPPIPELCG     "pipelcg"
 #define KSPPIPEPRCG    "pipeprcg"
+#define KSPCACG       "cacg"
 #define   KSPCGNE       "cgne"
 #define   KSPNASH       "nash"
 #define   KSPSTCG       "stcg"
@@ -52,6 +53,7 @@ typedef const char* KSPType;
 #define   KSPLGMRES     "lgmres"
 #define   KSPDGMRES     "dgmres"
 #define   KSPPGMRES     "pgmres"
+#define   KSPCAGMRES    "cagmres"
 #define KSPTCQMR      "tcqmr"
 #define KSPBCGS       "bcgs"
 #define   KSPIBCGS      "ibcgs"
@@ -639,6 +641,27 @@ PETSC_EXTERN const char *const KSPCGTypes[];
 PETSC_EXTERN PetscErrorCode KSPCGSetType(KSP,KSPCGType);
 PETSC_EXTERN PetscErrorCode KSPCGUseSingleReduction(KSP,PetscBool );
 
+/*E
+    KSPCABasisType - The polynomial basis of the s-step (communication avoiding) Krylov methods
+
+$   KSP_CA_BASIS_MONOMIAL  - v, Bv, B^2v, ...
+$   KSP_CA_BASIS_NEWTON    - Newton polynomials with Ritz values of the first s iterations as shifts, in Leja order
+$   KSP_CA_BASIS_CHEBYSHEV - Chebyshev polynomials of the interval spanned by those Ritz values
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCAGMRES, KSPCACGSetBasisType(), KSPCAGMRESSetBasisType()
+E*/
+typedef enum {KSP_CA_BASIS_MONOMIAL,KSP_CA_BASIS_NEWTON,KSP_CA_BASIS_CHEBYSHEV} KSPCABasisType;
+PETSC_EXTERN const char *const KSPCABasisTypes[];
+
+PETSC_EXTERN PetscErrorCode KSPCACGSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPCACGGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPCACGSetBasisType(KSP,KSPCABasisType);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPCAGMRESSetBasisType(KSP,KSPCABasisType);
+
 PETSC_EXTERN PetscErrorCode KSPCGSetRadius(KSP,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPCGGetNormD(KSP,PetscReal*);
 PETSC_EXTERN PetscErrorCode KSPCGGetObjFcn(KSP,PetscReal*);
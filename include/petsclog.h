@@ -57,6 +57,8 @@ PETSC_EXTERN PetscLogEvent PETSC_LARGEST_EVENT;
 /* Global flop counter */
 PETSC_EXTERN PetscLogDouble petsc_TotalFlops;
 PETSC_EXTERN PetscLogDouble petsc_tmp_flops;
+/* Global counter of the modeled memory traffic */
+PETSC_EXTERN PetscLogDouble petsc_TotalBytes;
 
 /* Global GPU counters */
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
@@ -120,6 +122,8 @@ struct _n_PetscClassPerfLog {
       of these for each stage.
 
 */
+#define PETSC_LOG_MAX_HW_COUNTERS 4
+
 typedef struct {
   char         *name;         /* The name of this event */
   PetscClassId classid;       /* The class the event is associated with */
@@ -137,6 +141,7 @@ typedef struct {
   int            depth;         /* The nesting depth of the event call */
   int            count;         /* The number of times this event was executed */
   PetscLogDouble flops, flops2, flopsTmp; /* The flops and flops^2 used in this event */
+  PetscLogDouble bytes;                   /* The modeled memory traffic of this event, see PetscLogBytes() */
   PetscLogDouble time, time2, timeTmp;    /* The time and time^2 taken for this event */
   PetscLogDouble syncTime;                /* The synchronization barrier time */
   PetscLogDouble dof[8];        /* The number of degrees of freedom associated with this event */
@@ -148,6 +153,7 @@ typedef struct {
   PetscLogDouble mallocIncrease;/* How much the maximum malloced space has increased in this event */
   PetscLogDouble mallocSpace;   /* How much the space was malloced and kept during this event */
   PetscLogDouble mallocIncreaseEvent;  /* Maximum of the high water mark with in event minus memory available at the end of the event */
+  PetscLogDouble hwCounters[PETSC_LOG_MAX_HW_COUNTERS]; /* The hardware counter values in this event, see PetscLogSetHWCounters() */
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   PetscLogDouble CpuToGpuCount; /* The total number of CPU to GPU copies */
   PetscLogDouble GpuToCpuCount; /* The total number of GPU to CPU copies */
@@ -235,6 +241,21 @@ PETSC_STATIC_INLINE PetscErrorCode PetscLogFlops(PetscLogDouble n)
   PetscFunctionReturn(0);
 }
 
+/*
+   Memory traffic counting: the kernels log the bytes they must move between memory and the processor if nothing
+   they access is already in cache, that is each array is read (and written) exactly once. Together with the flops
+   this gives the arithmetic intensity of the events shown with -log_view_roofline.
+*/
+PETSC_STATIC_INLINE PetscErrorCode PetscLogBytes(PetscLogDouble n)
+{
+  PetscFunctionBegin;
+#if defined(PETSC_USE_DEBUG)
+  if (n < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Cannot log negative bytes");
+#endif
+  petsc_TotalBytes += n;
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
 PETSC_STATIC_INLINE PetscErrorCode PetscLogCpuToGpu(PetscLogDouble size)
 {
@@ -309,6 +330,7 @@ PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineBegin(PetscInt);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogSetThreshold(PetscLogDouble,PetscLogDouble*);
@@ -319,6 +341,7 @@ PETSC_EXTERN PetscErrorCode PetscLogSet(PetscErrorCode (*)(int, int, PetscObject
 PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewFromOptions(void);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogTimelineDump(const char[]);
 
 /* Stage functions */
 PETSC_EXTERN PetscErrorCode PetscLogStageRegister(const char[],PetscLogStage*);
@@ -363,6 +386,23 @@ PETSC_EXTERN PetscLogDouble petsc_wait_all_ct;
 PETSC_EXTERN PetscLogDouble petsc_sum_of_waits_ct;
 
 PETSC_EXTERN PetscBool      PetscLogMemory;
+PETSC_EXTERN PetscBool      PetscLogRoofline;
+PETSC_EXTERN PetscErrorCode PetscLogMeasureBandwidth(MPI_Comm,PetscInt,PetscLogDouble*);
+PETSC_EXTERN PetscErrorCode PetscLogSetHWCounters(PetscInt,const char *const[]);
+PETSC_EXTERN PetscErrorCode PetscLogGetHWCounters(PetscInt*,const char *const**);
+PETSC_EXTERN PetscBool      PetscLogCommMatrix;
+PETSC_EXTERN PetscErrorCode PetscLogCommMatrixBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogCommMatrixView(PetscViewer);
+PETSC_EXTERN PetscErrorCode PetscLogCommSend_Internal(MPI_Comm,PetscMPIInt,PetscInt,MPI_Datatype);
+
+/*
+   Communication matrix logging: the point-to-point send paths of PetscSF, VecScatter and MatStash log each message
+   with its destination rank in comm, which PetscLogCommMatrixView() shows for each event.
+*/
+PETSC_STATIC_INLINE PetscErrorCode PetscLogCommSend(MPI_Comm comm,PetscMPIInt dest,PetscInt count,MPI_Datatype type)
+{
+  return PetscLogCommMatrix ? PetscLogCommSend_Internal(comm,dest,count,type) : 0;
+}
 
 PETSC_EXTERN PetscBool PetscLogSyncOn;  /* true if logging synchronization is enabled */
 PETSC_EXTERN PetscErrorCode PetscLogEventSynchronize(PetscLogEvent, MPI_Comm);
@@ -561,8 +601,17 @@ PETSC_STATIC_INLINE int PetscMPIParallelComm(MPI_Comm comm)
 #else  /* ---Logging is turned off --------------------------------------------*/
 
 #define PetscLogMemory                     PETSC_FALSE
+#define PetscLogRoofline                   PETSC_FALSE
+#define PetscLogMeasureBandwidth(c,n,b)    (*(b) = 0.0,0)
+#define PetscLogSetHWCounters(n,c)         0
+#define PetscLogGetHWCounters(n,c)         (*(n)=0,0)
+#define PetscLogCommMatrix                 PETSC_FALSE
+#define PetscLogCommMatrixBegin()          0
+#define PetscLogCommMatrixView(v)          0
+#define PetscLogCommSend(c,r,n,t)          0
 
 #define PetscLogFlops(n)                   0
+#define PetscLogBytes(n)                   0
 #define PetscGetFlops(a)                   (*(a) = 0.0,0)
 
 #define PetscLogStageRegister(a,b)         0
@@ -602,6 +651,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogAllBegin()                 0
 #define PetscLogNestedBegin()              0
 #define PetscLogTraceBegin(file)           0
+#define PetscLogTimelineBegin(n)           0
 #define PetscLogActions(a)                 0
 #define PetscLogObjects(a)                 0
 #define PetscLogSetThreshold(a,b)          0
@@ -610,6 +660,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogView(viewer)               0
 #define PetscLogViewFromOptions()          0
 #define PetscLogDump(c)                    0
+#define PetscLogTimelineDump(c)            0
 
 #define PetscLogEventSync(e,comm)          0
 #define PetscLogEventBegin(e,o1,o2,o3,o4)  0
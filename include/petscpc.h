@@ -128,6 +128,7 @@ PETSC_EXTERN PetscErrorCode PCBJacobiSetTotalBlocks(PC,PetscInt,const PetscInt[]
 PETSC_EXTERN PetscErrorCode PCBJacobiGetTotalBlocks(PC,PetscInt*,const PetscInt*[]);
 PETSC_EXTERN PetscErrorCode PCBJacobiSetLocalBlocks(PC,PetscInt,const PetscInt[]);
 PETSC_EXTERN PetscErrorCode PCBJacobiGetLocalBlocks(PC,PetscInt*,const PetscInt*[]);
+PETSC_EXTERN PetscErrorCode PCBJacobiSetConcurrentSolves(PC,PetscBool);
 
 PETSC_EXTERN PetscErrorCode PCShellSetApply(PC,PetscErrorCode (*)(PC,Vec,Vec));
 PETSC_EXTERN PetscErrorCode PCShellSetApplySymmetricLeft(PC,PetscErrorCode (*)(PC,Vec,Vec));
@@ -181,6 +182,7 @@ PETSC_EXTERN PetscErrorCode PCASMSetOverlap(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCASMSetDMSubdomains(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCASMGetDMSubdomains(PC,PetscBool*);
 PETSC_EXTERN PetscErrorCode PCASMSetSortIndices(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCASMSetConcurrentSolves(PC,PetscBool);
 
 PETSC_EXTERN PetscErrorCode PCASMSetType(PC,PCASMType);
 PETSC_EXTERN PetscErrorCode PCASMGetType(PC,PCASMType*);
@@ -71,6 +71,7 @@ typedef const char* PCType;
 #define PCHMG             "hmg"
 #define PCDEFLATION       "deflation"
 #define PCHPDDM           "hpddm"
+#define PCCHOWILU         "chowilu"
 
 /*E
     PCSide - If the preconditioner is to be applied to the left, right
@@ -1146,6 +1146,15 @@ PETSC_EXTERN PetscErrorCode PetscMallocClear(void);
 PETSC_EXTERN PetscErrorCode PetscMallocSetDRAM(void);
 PETSC_EXTERN PetscErrorCode PetscMallocResetDRAM(void);
 
+/*
+   Pooled allocator, may be passed to PetscMallocSet() or selected with -malloc_pool
+*/
+PETSC_EXTERN PetscErrorCode PetscMallocPool(size_t,PetscBool,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscFreePool(void*,int,const char[],const char[]);
+PETSC_EXTERN PetscErrorCode PetscReallocPool(size_t,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscMallocArenaPush(void);
+PETSC_EXTERN PetscErrorCode PetscMallocArenaPop(void);
+
 #define MPIU_PETSCLOGDOUBLE  MPI_DOUBLE
 #define MPIU_2PETSCLOGDOUBLE MPI_2DOUBLE_PRECISION
 
@@ -1163,6 +1172,8 @@ PETSC_EXTERN PetscErrorCode PetscMallocGetDebug(PetscBool*,PetscBool*,PetscBool*
 PETSC_EXTERN PetscErrorCode PetscMallocValidate(int,const char[],const char[]);
 PETSC_EXTERN PetscErrorCode PetscMallocViewSet(PetscLogDouble);
 PETSC_EXTERN PetscErrorCode PetscMallocViewGet(PetscBool*);
+PETSC_EXTERN PetscErrorCode PetscMallocProfileSet(const char[],PetscInt,const char *const[]);
+PETSC_EXTERN PetscErrorCode PetscMallocProfileDump(const char[]);
 
 PETSC_EXTERN const char *const PetscDataTypes[];
 PETSC_EXTERN PetscErrorCode PetscDataTypeToMPIDataType(PetscDataType,MPI_Datatype*);
@@ -2462,6 +2473,11 @@ PETSC_EXTERN PetscErrorCode PetscCommBuildTwoSidedGetType(MPI_Comm,PetscBuildTwo
 
 PETSC_EXTERN PetscErrorCode PetscSSEIsEnabled(MPI_Comm,PetscBool*,PetscBool*);
 
+PETSC_EXTERN const char *const PetscSIMDLevels[];
+PETSC_EXTERN PetscErrorCode PetscSIMDGetHardwareLevel(PetscSIMDLevel*);
+PETSC_EXTERN PetscErrorCode PetscSIMDGetLevel(PetscSIMDLevel*);
+PETSC_EXTERN PetscErrorCode PetscSIMDSetLevel(PetscSIMDLevel);
+
 PETSC_EXTERN MPI_Comm PetscObjectComm(PetscObject);
 
 PETSC_EXTERN const char *const PetscSubcommTypes[];
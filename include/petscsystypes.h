@@ -524,6 +524,26 @@ typedef enum {
   /* Updates here must be accompanied by updates in finclude/petscsys.h and the string array in mpits.c */
 } PetscBuildTwoSidedType;
 
+/*E
+    PetscSIMDLevel - the widest x86 vector instruction set the hand written kernels may use
+
+$  PETSC_SIMD_NONE - portable C kernels only
+$  PETSC_SIMD_AVX - 256 bit AVX kernels
+$  PETSC_SIMD_AVX2 - 256 bit AVX2 kernels with fused multiply-add and gathers
+$  PETSC_SIMD_AVX512 - 512 bit AVX-512F kernels
+
+   Level: developer
+
+.seealso: PetscSIMDGetLevel(), PetscSIMDSetLevel(), PetscSIMDGetHardwareLevel()
+E*/
+typedef enum {
+  PETSC_SIMD_NONE = 0,
+  PETSC_SIMD_AVX = 1,
+  PETSC_SIMD_AVX2 = 2,
+  PETSC_SIMD_AVX512 = 3
+  /* Updates here must be accompanied by updates in the string array in simdlevel.c */
+} PetscSIMDLevel;
+
 /* NOTE: If you change this, you must also change the values in src/vec/f90-mod/petscvec.h */
 /*E
   InsertMode - Whether entries are inserted or added into vectors or matrices
@@ -454,6 +454,46 @@ PETSC_EXTERN PetscErrorCode VecMTDotBegin(Vec,PetscInt,const Vec[],PetscScalar[]
 PETSC_EXTERN PetscErrorCode VecMTDotEnd(Vec,PetscInt,const Vec[],PetscScalar[]);
 PETSC_EXTERN PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm);
 
+/*E
+    VecFusedOpType - the vector operations that VecFusedBegin() applies together in one pass over the entries
+
+$   VEC_FUSED_AXPY - y <- y + alpha x, as VecAXPY()
+$   VEC_FUSED_AYPX - y <- x + alpha y, as VecAYPX()
+$   VEC_FUSED_WAXPY - w <- alpha x + y, as VecWAXPY()
+$   VEC_FUSED_DOT - the dot product of x and y, as VecDot()
+$   VEC_FUSED_TDOT - the indefinite dot product of x and y, as VecTDot()
+$   VEC_FUSED_NORM - the 2-norm of x, as VecNorm()
+
+   Level: advanced
+
+.seealso: VecFusedOp, VecFusedBegin(), VecFusedEnd(), VecFused()
+E*/
+typedef enum {VEC_FUSED_AXPY,VEC_FUSED_AYPX,VEC_FUSED_WAXPY,VEC_FUSED_DOT,VEC_FUSED_TDOT,VEC_FUSED_NORM} VecFusedOpType;
+
+/*S
+     VecFusedOp - One operation of a sequence given to VecFusedBegin(), usually built with VecFusedOpAXPY() and friends
+
+   Level: advanced
+
+.seealso: VecFusedOpType, VecFusedBegin(), VecFusedOpAXPY(), VecFusedOpAYPX(), VecFusedOpWAXPY(), VecFusedOpDot(), VecFusedOpTDot(), VecFusedOpNorm()
+S*/
+typedef struct {
+  VecFusedOpType type;
+  PetscScalar    alpha;      /* not used by the reductions */
+  Vec            x,y,w;      /* w is only used by VEC_FUSED_WAXPY and y is not used by VEC_FUSED_NORM */
+} VecFusedOp;
+
+PETSC_STATIC_INLINE VecFusedOp VecFusedOpAXPY(Vec y,PetscScalar alpha,Vec x) {VecFusedOp op; op.type = VEC_FUSED_AXPY; op.alpha = alpha; op.x = x; op.y = y; op.w = NULL; return op;}
+PETSC_STATIC_INLINE VecFusedOp VecFusedOpAYPX(Vec y,PetscScalar alpha,Vec x) {VecFusedOp op; op.type = VEC_FUSED_AYPX; op.alpha = alpha; op.x = x; op.y = y; op.w = NULL; return op;}
+PETSC_STATIC_INLINE VecFusedOp VecFusedOpWAXPY(Vec w,PetscScalar alpha,Vec x,Vec y) {VecFusedOp op; op.type = VEC_FUSED_WAXPY; op.alpha = alpha; op.x = x; op.y = y; op.w = w; return op;}
+PETSC_STATIC_INLINE VecFusedOp VecFusedOpDot(Vec x,Vec y) {VecFusedOp op; op.type = VEC_FUSED_DOT; op.alpha = 0.0; op.x = x; op.y = y; op.w = NULL; return op;}
+PETSC_STATIC_INLINE VecFusedOp VecFusedOpTDot(Vec x,Vec y) {VecFusedOp op; op.type = VEC_FUSED_TDOT; op.alpha = 0.0; op.x = x; op.y = y; op.w = NULL; return op;}
+PETSC_STATIC_INLINE VecFusedOp VecFusedOpNorm(Vec x) {VecFusedOp op; op.type = VEC_FUSED_NORM; op.alpha = 0.0; op.x = x; op.y = NULL; op.w = NULL; return op;}
+
+PETSC_EXTERN PetscErrorCode VecFusedBegin(PetscInt,const VecFusedOp[]);
+PETSC_EXTERN PetscErrorCode VecFusedEnd(PetscInt,const VecFusedOp[],PetscScalar[]);
+PETSC_EXTERN PetscErrorCode VecFused(PetscInt,const VecFusedOp[],PetscScalar[]);
+
 PETSC_EXTERN PetscErrorCode VecBindToCPU(Vec,PetscBool);
 PETSC_DEPRECATED_FUNCTION("Use VecBindToCPU (since v3.13)") PETSC_STATIC_INLINE PetscErrorCode VecPinToCPU(Vec v,PetscBool flg) {return VecBindToCPU(v,flg);}
 
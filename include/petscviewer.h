@@ -152,7 +152,8 @@ typedef enum {
   PETSC_VIEWER_HDF5_XDMF,
   PETSC_VIEWER_HDF5_MAT,
   PETSC_VIEWER_NOFORMAT,
-  PETSC_VIEWER_LOAD_BALANCE
+  PETSC_VIEWER_LOAD_BALANCE,
+  PETSC_VIEWER_ASCII_FLAMEGRAPH
   } PetscViewerFormat;
 PETSC_EXTERN const char *const PetscViewerFormats[];
 
@@ -0,0 +1,64 @@
+static char help[] = "Benchmarks the options database with many prefixed KSP objects, each with its own options.\n\n\
+  -n <n>       : number of KSP objects, each with the prefix k<i>_\n\
+  -view_timing : print the time spent setting the options and in KSPSetFromOptions()\n\n";
+
+#include <petscksp.h>
+
+int main(int argc,char **argv)
+{
+  KSP            ksp;
+  PetscInt       i,n = 100000,maxit,nwrong = 0,nleft;
+  PetscReal      rtol;
+  PetscLogDouble t0,t1,t2;
+  PetscBool      view_timing = PETSC_FALSE;
+  char           prefix[64],name[64],value[64];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-view_timing",&view_timing,NULL);CHKERRQ(ierr);
+
+  /* every KSP gets its own options so the database holds 2n entries */
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"-k%D_ksp_max_it",i);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(value,sizeof(value),"%D",i%97+1);CHKERRQ(ierr);
+    ierr = PetscOptionsSetValue(NULL,name,value);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(name,sizeof(name),"-K%D_KSP_RTOL",i);CHKERRQ(ierr);
+    ierr = PetscOptionsSetValue(NULL,name,"1.e-3");CHKERRQ(ierr);
+  }
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+
+  /* each KSP queries dozens of prefixed options, most of which are not in the database */
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(prefix,sizeof(prefix),"k%D_",i);CHKERRQ(ierr);
+    ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+    ierr = KSPSetOptionsPrefix(ksp,prefix);CHKERRQ(ierr);
+    ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+    ierr = KSPGetTolerances(ksp,&rtol,NULL,NULL,&maxit);CHKERRQ(ierr);
+    if (maxit != i%97+1 || rtol != 1.e-3) nwrong++;
+    ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  }
+  ierr = PetscTime(&t2);CHKERRQ(ierr);
+
+  ierr = PetscOptionsAllUsed(NULL,&nleft);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"KSP objects with wrong tolerances %D, unused options %D\n",nwrong,nleft);CHKERRQ(ierr);
+  if (view_timing) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Setting %D options %g s, KSPSetFromOptions() on %D objects %g s\n",2*n,t1-t0,n,t2-t1);CHKERRQ(ierr);
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     args: -n 1000
+
+   test:
+     suffix: 2
+     nsize: 2
+     args: -n 300 -k7_ksp_type cg -options_left
+     filter: grep -v -e "^-[kK]" -e "There are no unused options"
+
+TEST*/
@@ -0,0 +1,98 @@
+static char help[] = "Solves 5-point stencil problems with the s-step methods KSPCACG and KSPCAGMRES and checks the true residuals.\n\
+  -n <n>          : the matrix is a 5-point stencil on an n x n grid\n\
+  -nonsymmetric   : add a convection term to the Laplacian\n\
+  -s <s>          : number of iterations per block\n\
+  -basis <type>   : monomial, newton or chebyshev\n\n";
+
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Mat                A;
+  KSP                ksp;
+  Vec                x,b,r;
+  PetscInt           n = 24,s = 4,N,i,rstart,rend,cols[5],ncols,its;
+  PetscScalar        vals[5],c = 0.0;
+  PetscReal          rtol = 1.e-8,nb,nr;
+  PetscBool          nonsymmetric = PETSC_FALSE;
+  KSPCABasisType     basis = KSP_CA_BASIS_NEWTON;
+  KSPConvergedReason reason;
+  PetscErrorCode     ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-s",&s,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-nonsymmetric",&nonsymmetric,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetEnum(NULL,NULL,"-basis",KSPCABasisTypes,(PetscEnum*)&basis,NULL);CHKERRQ(ierr);
+  N    = n*n;
+  if (nonsymmetric) c = 0.4;
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ncols = 0;
+    if (i >= n)    {cols[ncols] = i-n; vals[ncols++] = -1.0;}
+    if (i%n)       {cols[ncols] = i-1; vals[ncols++] = -1.0 - c;}
+    cols[ncols] = i; vals[ncols++] = 4.0;
+    if ((i+1)%n)   {cols[ncols] = i+1; vals[ncols++] = -1.0 + c;}
+    if (i+n < N)   {cols[ncols] = i+n; vals[ncols++] = -1.0;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&r);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  ierr = MatMult(A,x,b);CHKERRQ(ierr);
+  ierr = VecSet(x,0.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,nonsymmetric ? KSPCAGMRES : KSPCACG);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,rtol,PETSC_DEFAULT,PETSC_DEFAULT,1000);CHKERRQ(ierr);
+  ierr = KSPCACGSetSteps(ksp,s);CHKERRQ(ierr);
+  ierr = KSPCACGSetBasisType(ksp,basis);CHKERRQ(ierr);
+  ierr = KSPCAGMRESSetSteps(ksp,s);CHKERRQ(ierr);
+  ierr = KSPCAGMRESSetBasisType(ksp,basis);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+
+  /* the true residual, not the one updated by the recurrences, must have converged */
+  ierr = KSPGetConvergedReason(ksp,&reason);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = MatMult(A,x,r);CHKERRQ(ierr);
+  ierr = VecAYPX(r,-1.0,b);CHKERRQ(ierr);
+  ierr = VecNorm(r,NORM_2,&nr);CHKERRQ(ierr);
+  ierr = VecNorm(b,NORM_2,&nb);CHKERRQ(ierr);
+  if (reason <= 0) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Diverged with reason %s after %D iterations\n",KSPConvergedReasons[reason],its);CHKERRQ(ierr);}
+  if (nr > 100.0*rtol*nb) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative true residual %g after %D iterations\n",(double)(nr/nb),its);CHKERRQ(ierr);}
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&r);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex65_1.out
+     args: -nonsymmetric {{0 1}} -basis {{monomial newton chebyshev}} -pc_type jacobi
+
+   test:
+     suffix: 2
+     nsize: 2
+     output_file: output/ex65_1.out
+     args: -nonsymmetric {{0 1}} -basis {{newton chebyshev}} -s {{2 6}} -pc_type bjacobi -sub_pc_type icc
+
+   test:
+     suffix: right
+     nsize: 2
+     output_file: output/ex65_1.out
+     args: -nonsymmetric -ksp_pc_side right -ksp_gmres_restart 10 -pc_type bjacobi -sub_pc_type ilu
+
+TEST*/
@@ -25,10 +25,12 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 {
   PetscErrorCode ierr;
   PetscInt       i;
-  PetscScalar    rho,rhoold,alpha,beta,omega,omegaold,d1;
+  PetscInt       nops;
+  PetscScalar    rho,rhoold,alpha,beta,omega,omegaold,d1,res[2];
   Vec            X,B,V,P,R,RP,T,S;
   PetscReal      dp    = 0.0,d2;
   KSP_BCGS       *bcgs = (KSP_BCGS*)ksp->data;
+  VecFusedOp     ops[5];
 
   PetscFunctionBegin;
   X  = ksp->vec_sol;
@@ -82,7 +84,9 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 
   i=0;
   do {
-    ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);       /*   rho <- (r,rp)      */
+    if (!i) {
+      ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);     /*   rho <- (r,rp)      */
+    } else rho = res[0];                          /*   computed with the update of r */
     beta = (rho/rhoold) * (alpha/omegaold);
     ierr = VecAXPBYPCZ(P,1.0,-omegaold*beta,beta,R,V);CHKERRQ(ierr);  /* p <- r - omega * beta* v + beta * p */
     ierr = KSP_PCApplyBAorAB(ksp,P,V,T);CHKERRQ(ierr);  /*   v <- K p           */
@@ -118,10 +122,15 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
       break;
     }
     omega = d1 / d2;                               /*   w <- (t's) / (t't) */
-    ierr  = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
-    ierr  = VecWAXPY(R,-omega,T,S);CHKERRQ(ierr);     /*   r <- s - w t       */
-    if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
+    ops[0] = VecFusedOpAXPY(X,alpha,P);            /*   x <- alpha * p + omega * s + x */
+    ops[1] = VecFusedOpAXPY(X,omega,S);
+    ops[2] = VecFusedOpWAXPY(R,-omega,T,S);        /*   r <- s - w t       */
+    ops[3] = VecFusedOpDot(R,RP);                  /*   next rho <- (r,rp) */
+    ops[4] = VecFusedOpNorm(R);
+    nops   = (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) ? 5 : 4;
+    ierr   = VecFused(nops,ops,res);CHKERRQ(ierr);
+    if (nops == 5) {
+      dp = PetscRealPart(res[1]);
       KSPCheckNorm(ksp,dp);
     }
 
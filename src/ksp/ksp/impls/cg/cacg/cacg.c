@@ -0,0 +1,605 @@
+
+#include <petsc/private/kspimpl.h>   /*I "petscksp.h" I*/
+
+/*
+   The s-step (communication avoiding) conjugate gradient method.
+
+   At the start of an outer iteration the vectors p, Mp, z and r = Mz (M the preconditioner, B = M^{-1}A) give the bases
+
+       Y = [P_0,...,P_s,Z_0,...,Z_{s-1}],  P_0 = p, Z_0 = z,  and  MY
+
+   of polynomials of degree s in B applied to p and of degree s-1 applied to z, built with the recurrence of the
+   basis type (see cabasis.c) as MY_{i+1} = (A Y_i - a_i MY_i - b_i MY_{i-1})/g_i and Y_{i+1} = M^{-1} MY_{i+1}.
+   With the Gram matrix G = Y^H MY, obtained with a single reduction, and T such that B Y = Y T, the s iterations
+   of CG are done on the coordinates of p, z and of the update of x in Y:
+
+       w = T d, alpha = (c,Gc)/(d,Gw), e = e + alpha d, c = c - alpha w, beta = (c,Gc)/(c_old,Gc_old), d = c + beta d
+
+   The first outer iteration uses the monomial basis, the Ritz values of its iterations give the shifts of the
+   Newton or Chebyshev bases of the next ones.
+*/
+typedef struct {
+  PetscInt       s;              /* number of iterations per outer iteration */
+  KSPCABasisType basistype;
+  PetscBool      replacement;    /* replace the updated residual by the true one when they drift apart */
+  Vec            *Y,*MY;         /* the 2s+1 basis vectors and their products by M */
+  PetscScalar    *G,*T;          /* G = Y^H MY and B Y = Y T, stored by columns */
+  PetscScalar    *c,*d,*e,*w;    /* coordinates in Y of z, p, the update of x and Bp */
+  PetscScalar    *a,*b;          /* recurrence of the basis */
+  PetscReal      *g;
+  PetscScalar    *alpha,*beta;   /* coefficients of the first outer iteration */
+  PetscReal      *ny,*nmy;       /* norms of the basis vectors, for the residual replacement */
+  PetscReal      *re,*im;        /* Ritz values */
+} KSP_CACG;
+
+static PetscErrorCode KSPSetUp_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       s = cacg->s,n = 2*s+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetWorkVecs(ksp,4);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],n,&cacg->Y);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],n,&cacg->MY);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,n,cacg->Y);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,n,cacg->MY);CHKERRQ(ierr);
+  ierr = PetscMalloc6(n*n,&cacg->G,n*n,&cacg->T,n,&cacg->c,n,&cacg->d,n,&cacg->e,n,&cacg->w);CHKERRQ(ierr);
+  ierr = PetscMalloc7(s,&cacg->a,s,&cacg->b,s,&cacg->g,s,&cacg->alpha,s,&cacg->beta,n,&cacg->ny,n,&cacg->nmy);CHKERRQ(ierr);
+  ierr = PetscMalloc2(s,&cacg->re,s,&cacg->im);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(2*n*n+4*n+4*s)*sizeof(PetscScalar)+(2*n+3*s)*sizeof(PetscReal));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       n = 2*cacg->s+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!cacg->Y) PetscFunctionReturn(0);
+  ierr = VecDestroyVecs(n,&cacg->Y);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(n,&cacg->MY);CHKERRQ(ierr);
+  ierr = PetscFree6(cacg->G,cacg->T,cacg->c,cacg->d,cacg->e,cacg->w);CHKERRQ(ierr);
+  ierr = PetscFree7(cacg->a,cacg->b,cacg->g,cacg->alpha,cacg->beta,cacg->ny,cacg->nmy);CHKERRQ(ierr);
+  ierr = PetscFree2(cacg->re,cacg->im);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* sets the recurrence of the basis and the matrix T, with the P part in the columns 0..s and the Z part in s+1..2s */
+static PetscErrorCode KSPCACGSetUpBasis(KSP ksp,KSPCABasisType type,PetscInt nritz)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       s = cacg->s,n = 2*s+1,i;
+  PetscScalar    *T = cacg->T;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPCABasisSetUp_Private(type,s,nritz,cacg->re,cacg->im,cacg->a,cacg->b,cacg->g);CHKERRQ(ierr);
+  ierr = PetscArrayzero(T,n*n);CHKERRQ(ierr);
+  for (i=0; i<s; i++) {
+    T[i+i*n]     = cacg->a[i];
+    T[i+1+i*n]   = cacg->g[i];
+    if (i) T[i-1+i*n] = cacg->b[i];
+  }
+  for (i=0; i<s-1; i++) {
+    T[s+1+i+(s+1+i)*n] = cacg->a[i];
+    T[s+2+i+(s+1+i)*n] = cacg->g[i];
+    if (i) T[s+i+(s+1+i)*n] = cacg->b[i];
+  }
+  PetscFunctionReturn(0);
+}
+
+/* MY[k+1] = (A Y[k] - a MY[k] - b MY[k-1])/g and Y[k+1] = M^{-1} MY[k+1] */
+static PetscErrorCode KSPCACGBasisStep(KSP ksp,Mat Amat,PetscInt k,PetscScalar a,PetscScalar b,PetscReal g)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  Vec            *Y = cacg->Y,*MY = cacg->MY;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSP_MatMult(ksp,Amat,Y[k],MY[k+1]);CHKERRQ(ierr);
+  if (b != 0.0) {
+    ierr = VecAXPBYPCZ(MY[k+1],-a/g,-b/g,1.0/g,MY[k],MY[k-1]);CHKERRQ(ierr);
+  } else if (a != 0.0 || g != 1.0) {
+    ierr = VecAXPBY(MY[k+1],-a/g,1.0/g,MY[k]);CHKERRQ(ierr);
+  }
+  ierr = KSP_PCApply(ksp,MY[k+1],Y[k+1]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* u^H G v */
+PETSC_STATIC_INLINE PetscScalar KSPCACGForm(PetscInt n,const PetscScalar G[],const PetscScalar u[],const PetscScalar v[])
+{
+  PetscInt    i,j;
+  PetscScalar sum = 0.0,t;
+
+  for (i=0; i<n; i++) {
+    if (u[i] == 0.0) continue;
+    t = 0.0;
+    for (j=0; j<n; j++) t += G[i+j*n]*v[j];
+    sum += PetscConj(u[i])*t;
+  }
+  return sum;
+}
+
+/* y <- Y coef, with y one of the work vectors */
+static PetscErrorCode KSPCACGCombine(KSP ksp,Vec *Y,const PetscScalar coef[],Vec y)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(y,0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(y,2*cacg->s+1,coef,Y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* exchanges Y[k] and the work vector y, once all the combinations of the old basis are formed */
+PETSC_STATIC_INLINE void KSPCACGSwap(Vec *Y,PetscInt k,Vec *y)
+{
+  Vec t;
+
+  t    = Y[k];
+  Y[k] = *y;
+  *y   = t;
+}
+
+static PetscErrorCode KSPSolve_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       s = cacg->s,n = 2*s+1,i,j,nfirst = 0;
+  Vec            X = ksp->vec_sol,B = ksp->vec_rhs,*Y = cacg->Y,*MY = cacg->MY;
+  PetscScalar    *G = cacg->G,*T = cacg->T,*c = cacg->c,*d = cacg->d,*e = cacg->e,*w = cacg->w;
+  PetscScalar    alpha,beta,gamma,gammanew,delta;
+  PetscReal      dp = 0.0,Anorm = 0.0,nx = 0.0,nr = 0.0,nrold = 0.0,dev = 0.0,devold = 0.0,xi;
+  PetscReal      eps = PETSC_MACHINE_EPSILON,tol = PETSC_SQRT_MACHINE_EPSILON;
+  PetscBool      first = PETSC_TRUE,fresh = PETSC_TRUE,replace = PETSC_FALSE,restart = PETSC_FALSE,replacement = cacg->replacement,diagonalscale;
+  Mat            Amat,Pmat;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+  comm = PetscObjectComm((PetscObject)ksp);
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,X,MY[s+1]);CHKERRQ(ierr);    /*  r <- b - Ax  */
+    ierr = VecAYPX(MY[s+1],-1.0,B);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(B,MY[s+1]);CHKERRQ(ierr);                 /*  r <- b (x is 0)  */
+  }
+  ierr = KSP_PCApply(ksp,MY[s+1],Y[s+1]);CHKERRQ(ierr);      /*  z <- M^{-1} r  */
+  ierr = VecCopy(Y[s+1],Y[0]);CHKERRQ(ierr);                 /*  p <- z  */
+  ierr = VecCopy(MY[s+1],MY[0]);CHKERRQ(ierr);
+  /* the estimate of the deviation needs a norm of the operator */
+  if (replacement) {ierr = MatHasOperation(Amat,MATOP_NORM,&replacement);CHKERRQ(ierr);}
+  if (replacement) {ierr = MatNorm(Amat,NORM_INFINITY,&Anorm);CHKERRQ(ierr);}
+  ierr = KSPCACGSetUpBasis(ksp,KSP_CA_BASIS_MONOMIAL,0);CHKERRQ(ierr);
+
+  while (1) {
+    /* the bases of the outer iteration, P_1..P_s from p and Z_1..Z_{s-1} from z */
+    for (i=0; i<s; i++) {
+      ierr = KSPCACGBasisStep(ksp,Amat,i,cacg->a[i],cacg->b[i],cacg->g[i]);CHKERRQ(ierr);
+    }
+    for (i=0; i<s-1; i++) {
+      ierr = KSPCACGBasisStep(ksp,Amat,s+1+i,cacg->a[i],cacg->b[i],cacg->g[i]);CHKERRQ(ierr);
+    }
+
+    /* the upper triangle of the Gram matrix, and the norms for the residual replacement, in a single reduction */
+    for (j=0; j<n; j++) {
+      ierr = VecMDotBegin(MY[j],j+1,Y,G+j*n);CHKERRQ(ierr);
+    }
+    if (replacement) {
+      for (j=0; j<n; j++) {
+        ierr = VecNormBegin(Y[j],NORM_2,&cacg->ny[j]);CHKERRQ(ierr);
+        ierr = VecNormBegin(MY[j],NORM_2,&cacg->nmy[j]);CHKERRQ(ierr);
+      }
+      ierr = VecNormBegin(X,NORM_2,&nx);CHKERRQ(ierr);
+    }
+    ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+    for (j=0; j<n; j++) {
+      ierr = VecMDotEnd(MY[j],j+1,Y,G+j*n);CHKERRQ(ierr);
+    }
+    if (replacement) {
+      for (j=0; j<n; j++) {
+        ierr = VecNormEnd(Y[j],NORM_2,&cacg->ny[j]);CHKERRQ(ierr);
+        ierr = VecNormEnd(MY[j],NORM_2,&cacg->nmy[j]);CHKERRQ(ierr);
+      }
+      ierr = VecNormEnd(X,NORM_2,&nx);CHKERRQ(ierr);
+    }
+    for (j=0; j<n; j++) {
+      for (i=0; i<j; i++) G[j+i*n] = PetscConj(G[i+j*n]);
+    }
+
+    gamma = G[(s+1)+(s+1)*n];                                 /*  gamma <- r'*z  */
+    KSPCheckDot(ksp,gamma);
+    if (first) {
+      dp = (ksp->normtype == KSP_NORM_NATURAL) ? PetscSqrtReal(PetscAbsScalar(gamma)) : 0.0;
+      ksp->rnorm = dp;
+      ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,0,dp);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason) PetscFunctionReturn(0);
+    }
+
+    /* van der Vorst and Ye's criterion on an estimate of the deviation of the updated residual from the true one,
+       checked at the end of the previous outer iteration; the residual is replaced at the end of this one */
+    if (replacement) {
+      nr = cacg->nmy[s+1];
+      if (fresh) {
+        dev   = eps*(Anorm*nx + nr);
+        fresh = PETSC_FALSE;
+      } else if (devold <= tol*nrold && dev > tol*nr) replace = PETSC_TRUE;
+    }
+
+    /* s iterations on the coordinates */
+    ierr = PetscArrayzero(c,n);CHKERRQ(ierr);
+    ierr = PetscArrayzero(d,n);CHKERRQ(ierr);
+    ierr = PetscArrayzero(e,n);CHKERRQ(ierr);
+    d[0]   = 1.0;
+    c[s+1] = 1.0;
+    for (j=0; j<s; j++) {
+      if (gamma == 0.0) {
+        ksp->reason = KSP_CONVERGED_ATOL;
+        ierr        = PetscInfo(ksp,"converged due to gamma = 0\n");CHKERRQ(ierr);
+        break;
+      }
+      for (i=0; i<n; i++) {
+        PetscInt k;
+
+        w[i] = 0.0;
+        for (k=PetscMax(i-1,0); k<PetscMin(i+2,n); k++) w[i] += T[i+k*n]*d[k];   /*  w <- T d, T is tridiagonal  */
+      }
+      delta = KSPCACGForm(n,G,d,w);                           /*  delta <- p'*A*p  */
+      KSPCheckDot(ksp,delta);
+      if (PetscRealPart(delta) <= 0.0) {
+        /* at the first iteration delta is p'*A*p up to rounding; later the loss of accuracy of the basis may also
+           give a negative value, the method then restarts from the true residual */
+        if (!j) {
+          if (ksp->errorifnotconverged) SETERRQ1(comm,PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite matrix, delta %g",(double)PetscRealPart(delta));
+          ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+          ierr        = PetscInfo(ksp,"diverging due to indefinite or negative definite matrix\n");CHKERRQ(ierr);
+        } else {
+          restart = PETSC_TRUE;
+          ierr    = PetscInfo1(ksp,"restarting after a breakdown of the basis at iteration %D\n",ksp->its);CHKERRQ(ierr);
+        }
+        break;
+      }
+      alpha = gamma/delta;
+      for (i=0; i<n; i++) {
+        e[i] += alpha*d[i];                                   /*  x <- x + alpha p  */
+        c[i] -= alpha*w[i];                                   /*  z <- z - alpha B p  */
+      }
+      gammanew = KSPCACGForm(n,G,c,c);                        /*  gamma <- r'*z  */
+      KSPCheckDot(ksp,gammanew);
+      ksp->its++;
+      if (PetscRealPart(gammanew) < 0.0) {
+        if (!j) {
+          if (ksp->errorifnotconverged) SETERRQ1(comm,PETSC_ERR_NOT_CONVERGED,"Diverged due to indefinite preconditioner, gamma %g",(double)PetscRealPart(gammanew));
+          ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+          ierr        = PetscInfo(ksp,"diverging due to indefinite preconditioner\n");CHKERRQ(ierr);
+        } else {
+          restart = PETSC_TRUE;
+          ierr    = PetscInfo1(ksp,"restarting after a breakdown of the basis at iteration %D\n",ksp->its);CHKERRQ(ierr);
+        }
+        break;
+      }
+      beta = gammanew/gamma;
+      for (i=0; i<n; i++) d[i] = c[i] + beta*d[i];            /*  p <- z + beta p  */
+      gamma = gammanew;
+      if (first) {
+        cacg->alpha[j] = alpha;
+        cacg->beta[j]  = beta;
+        nfirst         = j+1;
+      }
+
+      dp = (ksp->normtype == KSP_NORM_NATURAL) ? PetscSqrtReal(PetscAbsScalar(gamma)) : 0.0;
+      ksp->rnorm = dp;
+      ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason || ksp->its >= ksp->max_it) break;
+    }
+
+    ierr = VecMAXPY(X,n,e,Y);CHKERRQ(ierr);                   /*  x <- x + Y e  */
+    if (ksp->reason) break;
+    if (ksp->its >= ksp->max_it) {
+      ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+
+    if (replacement) {
+      xi = Anorm*nx;
+      for (i=0; i<n; i++) xi += Anorm*PetscAbsScalar(e[i])*cacg->ny[i] + PetscAbsScalar(c[i])*cacg->nmy[i];
+      devold = dev;
+      nrold  = nr;
+      dev   += eps*xi;
+    }
+
+    /* Ritz values of the preconditioned operator from the Lanczos tridiagonal matrix of the first iterations */
+    if (first && cacg->basistype != KSP_CA_BASIS_MONOMIAL && nfirst) {
+      ierr = PetscArrayzero(G,nfirst*nfirst);CHKERRQ(ierr);
+      for (j=0; j<nfirst; j++) {
+        G[j+j*nfirst] = 1.0/cacg->alpha[j];
+        if (j) {
+          G[j+j*nfirst]      += cacg->beta[j-1]/cacg->alpha[j-1];
+          G[j+(j-1)*nfirst]   = PetscSqrtReal(PetscAbsScalar(cacg->beta[j-1]))/PetscAbsScalar(cacg->alpha[j-1]);
+          G[j-1+j*nfirst]     = G[j+(j-1)*nfirst];
+        }
+      }
+      ierr = KSPCABasisComputeRitz_Private(nfirst,G,nfirst,cacg->re,cacg->im);CHKERRQ(ierr);
+      ierr = KSPCACGSetUpBasis(ksp,cacg->basistype,nfirst);CHKERRQ(ierr);
+    }
+    first = PETSC_FALSE;
+
+    /* p, Mp, z and r for the next outer iteration, all formed from the basis before any of them replaces P_0 or Z_0 */
+    if (!restart) {
+      ierr = KSPCACGCombine(ksp,Y,d,ksp->work[0]);CHKERRQ(ierr);       /*  p <- Y d  */
+      ierr = KSPCACGCombine(ksp,MY,d,ksp->work[1]);CHKERRQ(ierr);      /*  Mp <- MY d  */
+      if (!replace) {
+        ierr = KSPCACGCombine(ksp,Y,c,ksp->work[2]);CHKERRQ(ierr);     /*  z <- Y c  */
+        ierr = KSPCACGCombine(ksp,MY,c,ksp->work[3]);CHKERRQ(ierr);    /*  r <- MY c  */
+      }
+      KSPCACGSwap(Y,0,&ksp->work[0]);
+      KSPCACGSwap(MY,0,&ksp->work[1]);
+    }
+    if (restart || replace) {
+      ierr = KSP_MatMult(ksp,Amat,X,MY[s+1]);CHKERRQ(ierr);           /*  r <- b - Ax  */
+      ierr = VecAYPX(MY[s+1],-1.0,B);CHKERRQ(ierr);
+      ierr = KSP_PCApply(ksp,MY[s+1],Y[s+1]);CHKERRQ(ierr);           /*  z <- M^{-1} r  */
+      if (restart) {
+        ierr = VecCopy(Y[s+1],Y[0]);CHKERRQ(ierr);                    /*  p <- z  */
+        ierr = VecCopy(MY[s+1],MY[0]);CHKERRQ(ierr);
+      }
+      if (replace) {ierr = PetscInfo1(ksp,"replacing the residual at iteration %D\n",ksp->its);CHKERRQ(ierr);}
+      fresh   = PETSC_TRUE;
+      replace = PETSC_FALSE;
+      restart = PETSC_FALSE;
+    } else {
+      KSPCACGSwap(Y,s+1,&ksp->work[2]);
+      KSPCACGSwap(MY,s+1,&ksp->work[3]);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_CACG(KSP ksp,PetscViewer viewer)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  iterations per outer iteration %D, %s basis\n",cacg->s,KSPCABasisTypes[cacg->basistype]);CHKERRQ(ierr);
+    if (cacg->replacement) {ierr = PetscViewerASCIIPrintf(viewer,"  using residual replacement\n");CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_CACG(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscInt       s;
+  KSPCABasisType type;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP CACG options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_cacg_steps","Number of iterations per global reduction","KSPCACGSetSteps",cacg->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCACGSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_cacg_basis_type","Polynomial basis","KSPCACGSetBasisType",KSPCABasisTypes,(PetscEnum)cacg->basistype,(PetscEnum*)&type,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCACGSetBasisType(ksp,type);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-ksp_cacg_residual_replacement","Replace the updated residual by the true one when they drift apart","KSPCACG",cacg->replacement,&cacg->replacement,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGSetSteps_CACG(KSP ksp,PetscInt s)
+{
+  KSP_CACG       *cacg = (KSP_CACG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps must be positive");
+  if (!ksp->setupstage) {
+    cacg->s = s;
+  } else if (cacg->s != s) {
+    /* free the data structures, then create them again */
+    ierr            = KSPReset_CACG(ksp);CHKERRQ(ierr);
+    cacg->s         = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGGetSteps_CACG(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_CACG*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCACGSetBasisType_CACG(KSP ksp,KSPCABasisType type)
+{
+  PetscFunctionBegin;
+  ((KSP_CACG*)ksp->data)->basistype = type;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGSetSteps - Sets the number of iterations of KSPCACG done with a single global reduction.
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  s - the number of iterations per outer iteration
+
+   Options Database:
+.  -ksp_cacg_steps <s>
+
+   Notes:
+   Each outer iteration applies the operator and the preconditioner 2s-1 times and computes a Gram matrix of
+   2s+1 vectors. The default is 4; larger values save more reductions but the basis loses accuracy quickly,
+   beyond 8 or so even with the Newton or Chebyshev bases.
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCACGGetSteps(), KSPCACGSetBasisType()
+@*/
+PetscErrorCode KSPCACGSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPCACGSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGGetSteps - Gets the number of iterations of KSPCACG done with a single global reduction.
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  s - the number of iterations per outer iteration
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCACGSetSteps()
+@*/
+PetscErrorCode KSPCACGGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPCACGGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCACGSetBasisType - Sets the polynomial basis of KSPCACG.
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  type - KSP_CA_BASIS_MONOMIAL, KSP_CA_BASIS_NEWTON (the default) or KSP_CA_BASIS_CHEBYSHEV
+
+   Options Database:
+.  -ksp_cacg_basis_type <monomial,newton,chebyshev>
+
+   Notes:
+   The Newton and Chebyshev bases use the Ritz values of the first outer iteration of each solve, which uses the
+   monomial basis.
+
+   Level: intermediate
+
+.seealso: KSPCACG, KSPCABasisType, KSPCACGSetSteps()
+@*/
+PetscErrorCode KSPCACGSetBasisType(KSP ksp,KSPCABasisType type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,type,2);
+  ierr = PetscTryMethod(ksp,"KSPCACGSetBasisType_C",(KSP,KSPCABasisType),(ksp,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_CACG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_CACG(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPCACG - The s-step (communication avoiding) preconditioned conjugate gradient method.
+
+   s iterations are done with a single global reduction, of the Gram matrix of a basis of 2s+1 vectors of the Krylov
+   spaces of the direction and of the preconditioned residual, against 2 reductions per iteration for KSPCG.
+
+   Options Database Keys:
++   -ksp_cacg_steps <s> - number of iterations per outer iteration (default 4)
+.   -ksp_cacg_basis_type <monomial,newton,chebyshev> - polynomial basis (default newton)
+-   -ksp_cacg_residual_replacement <bool> - replace the updated residual by the true one when they drift apart (default true)
+
+   Level: intermediate
+
+   Notes:
+   The operator and the preconditioner must be Hermitian positive definite. Only the natural norm sqrt(r'*M^{-1}*r),
+   or no norm, is available: it is obtained from the Gram matrix without more communication.
+
+   The operator and the preconditioner are applied 2s-1 times per outer iteration, and the local work of the Gram matrix
+   grows as s^2, so the method pays off when the reductions dominate, on many processes with little work each.
+
+   The bases of monomials lose their linear independence quickly. The Newton and Chebyshev bases are built from
+   the Ritz values given by the first outer iteration of each solve. When the recurrences break down because the basis
+   is not accurate enough, the method restarts from the true residual. The residual replacement follows van der Vorst
+   and Ye, with an estimate of the deviation between the updated and true residuals in the spirit of Carson and
+   Demmel; it costs an application of the operator and of the preconditioner when it occurs, and the norms of the basis
+   vectors, computed in the same reduction as the Gram matrix, in each outer iteration.
+
+   References:
++  1. - A. T. Chronopoulos and C. W. Gear, "s-step iterative methods for symmetric linear systems",
+        J. Comput. Appl. Math. 25(2):153-168, 1989.
+.  2. - M. Hoemmen, "Communication-avoiding Krylov subspace methods", PhD thesis, UC Berkeley, 2010.
+.  3. - E. Carson and J. Demmel, "A residual replacement strategy for improving the maximum attainable accuracy of
+        s-step Krylov subspace methods", SIAM J. Matrix Anal. Appl. 35(1):22-43, 2014.
+-  4. - H. A. van der Vorst and Q. Ye, "Residual replacement strategies for Krylov subspace iterative methods for the
+        convergence of true residuals", SIAM J. Sci. Comput. 22(3):835-852, 2000.
+
+.seealso: KSPCreate(), KSPSetType(), KSPCG, KSPPIPECG, KSPPIPELCG, KSPCAGMRES, KSPCACGSetSteps(), KSPCACGSetBasisType()
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CACG(KSP ksp)
+{
+  KSP_CACG       *cacg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&cacg);CHKERRQ(ierr);
+  cacg->s           = 4;
+  cacg->basistype   = KSP_CA_BASIS_NEWTON;
+  cacg->replacement = PETSC_TRUE;
+  ksp->data         = (void*)cacg;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_CACG;
+  ksp->ops->solve          = KSPSolve_CACG;
+  ksp->ops->reset          = KSPReset_CACG;
+  ksp->ops->destroy        = KSPDestroy_CACG;
+  ksp->ops->view           = KSPView_CACG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CACG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetSteps_C",KSPCACGSetSteps_CACG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGGetSteps_C",KSPCACGGetSteps_CACG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCACGSetBasisType_C",KSPCACGSetBasisType_CACG);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
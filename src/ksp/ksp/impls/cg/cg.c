@@ -95,13 +95,14 @@ static PetscErrorCode KSPSetUp_CG(KSP ksp)
 static PetscErrorCode KSPSolve_CG(KSP ksp)
 {
   PetscErrorCode ierr;
-  PetscInt       i,stored_max_it,eigs;
-  PetscScalar    dpi = 0.0,a = 1.0,beta,betaold = 1.0,b = 0,*e = 0,*d = 0,dpiold;
+  PetscInt       i,stored_max_it,eigs,nops;
+  PetscScalar    dpi = 0.0,a = 1.0,beta,betaold = 1.0,b = 0,*e = 0,*d = 0,dpiold,res;
   PetscReal      dp  = 0.0;
   Vec            X,B,Z,R,P,W;
   KSP_CG         *cg;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
+  VecFusedOp     ops[3];
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -204,14 +205,17 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     }
     a = beta/dpi;                                              /*     a = beta/p'w                     */
     if (eigs) d[i] = PetscSqrtReal(PetscAbsScalar(b))*e[i] + 1.0/a;
-    ierr = VecAXPY(X,a,P);CHKERRQ(ierr);                       /*     x <- x + ap                      */
-    ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                      /*     r <- r - aw                      */
+    ops[0] = VecFusedOpAXPY(X,a,P);                            /*     x <- x + ap                      */
+    ops[1] = VecFusedOpAXPY(R,-a,W);                           /*     r <- r - aw                      */
+    ops[2] = VecFusedOpNorm(R);                                /*     dp <- r'*r                       */
+    nops   = (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) ? 3 : 2;
+    ierr   = VecFused(nops,ops,&res);CHKERRQ(ierr);            /*     one pass over x, p, r and w      */
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i+2) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
       ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- z'*z                       */
       KSPCheckNorm(ksp,dp);
-    } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- r'*r                       */
+    } else if (nops == 3) {
+      dp = PetscRealPart(res);
       KSPCheckNorm(ksp,dp);
     } else if (ksp->normtype == KSP_NORM_NATURAL) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
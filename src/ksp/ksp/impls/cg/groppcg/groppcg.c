@@ -25,12 +25,13 @@ static PetscErrorCode KSPSetUp_GROPPCG(KSP ksp)
 static PetscErrorCode  KSPSolve_GROPPCG(KSP ksp)
 {
   PetscErrorCode ierr;
-  PetscInt       i;
-  PetscScalar    alpha,beta = 0.0,gamma,gammaNew,t;
+  PetscInt       i,nops,nred;
+  PetscScalar    alpha,beta = 0.0,gamma,gammaNew,t,res[2];
   PetscReal      dp = 0.0;
   Vec            x,b,r,p,s,S,z,Z;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
+  VecFusedOp     ops[5];
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -86,39 +87,42 @@ static PetscErrorCode  KSPSolve_GROPPCG(KSP ksp)
   ierr       = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr); /* test for convergence */
   if (ksp->reason) PetscFunctionReturn(0);
 
+  ops[0] = VecFusedOpDot(p,s);
+  nops   = 1;
+  ierr   = VecFusedBegin(nops,ops);CHKERRQ(ierr);
   i = 0;
   do {
     ksp->its = i+1;
     i++;
 
-    ierr = VecDotBegin(p,s,&t);CHKERRQ(ierr);
     ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)p));CHKERRQ(ierr);
 
     ierr = KSP_PCApply(ksp,s,S);CHKERRQ(ierr);         /*   S <- Bs       */
 
-    ierr = VecDotEnd(p,s,&t);CHKERRQ(ierr);
+    ierr = VecFusedEnd(nops,ops,res);CHKERRQ(ierr);   /*   t <- p'*s, started with the updates of p and s */
+    t    = res[0];
 
     alpha = gamma / t;
-    ierr  = VecAXPY(x, alpha,p);CHKERRQ(ierr);   /*     x <- x + alpha * p   */
-    ierr  = VecAXPY(r,-alpha,s);CHKERRQ(ierr);   /*     r <- r - alpha * s   */
-    ierr  = VecAXPY(z,-alpha,S);CHKERRQ(ierr);   /*     z <- z - alpha * S   */
-
+    nops  = 0;
+    ops[nops++] = VecFusedOpAXPY(x, alpha,p);   /*     x <- x + alpha * p   */
+    ops[nops++] = VecFusedOpAXPY(r,-alpha,s);   /*     r <- r - alpha * s   */
+    ops[nops++] = VecFusedOpAXPY(z,-alpha,S);   /*     z <- z - alpha * S   */
+    nred = 0;
     if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormBegin(r,NORM_2,&dp);CHKERRQ(ierr);
+      ops[nops+nred++] = VecFusedOpNorm(r);
     } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormBegin(z,NORM_2,&dp);CHKERRQ(ierr);
+      ops[nops+nred++] = VecFusedOpNorm(z);
     }
-    ierr = VecDotBegin(r,z,&gammaNew);CHKERRQ(ierr);
-    ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)r));CHKERRQ(ierr);
+    ops[nops+nred++] = VecFusedOpDot(r,z);
+    nops += nred;
+    ierr  = VecFusedBegin(nops,ops);CHKERRQ(ierr);
+    ierr  = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)r));CHKERRQ(ierr);
 
     ierr = KSP_MatMult(ksp,Amat,z,Z);CHKERRQ(ierr);      /*   Z <- Az       */
 
-    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormEnd(r,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormEnd(z,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    ierr = VecDotEnd(r,z,&gammaNew);CHKERRQ(ierr);
+    ierr     = VecFusedEnd(nops,ops,res);CHKERRQ(ierr);
+    gammaNew = res[nred-1];
+    if (nred == 2) dp = PetscRealPart(res[0]);
 
     if (ksp->normtype == KSP_NORM_NATURAL) {
       KSPCheckDot(ksp,gammaNew);
@@ -134,8 +138,12 @@ static PetscErrorCode  KSPSolve_GROPPCG(KSP ksp)
 
     beta  = gammaNew / gamma;
     gamma = gammaNew;
-    ierr  = VecAYPX(p,beta,z);CHKERRQ(ierr);   /*     p <- z + beta * p   */
-    ierr  = VecAYPX(s,beta,Z);CHKERRQ(ierr);   /*     s <- Z + beta * s   */
+    nops  = 0;
+    ops[nops++] = VecFusedOpAYPX(p,beta,z);   /*     p <- z + beta * p   */
+    ops[nops++] = VecFusedOpAYPX(s,beta,Z);   /*     s <- Z + beta * s   */
+    /* the reduction of the next iteration is computed in the same pass over the vectors */
+    if (i < ksp->max_it) ops[nops++] = VecFusedOpDot(p,s);
+    ierr = VecFusedBegin(nops,ops);CHKERRQ(ierr);
 
   } while (i<ksp->max_it);
 
@@ -27,12 +27,13 @@ static PetscErrorCode KSPSetUp_PIPECG(KSP ksp)
 static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
 {
   PetscErrorCode ierr;
-  PetscInt       i;
-  PetscScalar    alpha = 0.0,beta = 0.0,gamma = 0.0,gammaold = 0.0,delta = 0.0;
+  PetscInt       i,nops = 0,nred = 0;
+  PetscScalar    alpha = 0.0,beta = 0.0,gamma = 0.0,gammaold = 0.0,delta = 0.0,res[3];
   PetscReal      dp    = 0.0;
   Vec            X,B,Z,P,W,Q,U,M,N,R,S;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
+  VecFusedOp     ops[11];
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -97,29 +98,28 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
 
   i = 0;
   do {
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormBegin(U,NORM_2,&dp);CHKERRQ(ierr);
+    if (!i) {
+      if (ksp->normtype != KSP_NORM_NATURAL) {
+        ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
+      }
+      ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
     }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
-    }
-    ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
     ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
 
     ierr = KSP_PCApply(ksp,W,M);CHKERRQ(ierr);           /*   m <- Bw       */
     ierr = KSP_MatMult(ksp,Amat,M,N);CHKERRQ(ierr);      /*   n <- Am       */
 
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormEnd(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
+    if (!i) {
+      if (ksp->normtype != KSP_NORM_NATURAL) {
+        ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
+      }
+      ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
+    } else {
+      ierr  = VecFusedEnd(nops,ops,res);CHKERRQ(ierr);  /* reductions started with the updates of the previous iteration */
+      gamma = res[nred-2];
+      delta = res[nred-1];
+      if (nred == 3) dp = PetscRealPart(res[0]);
     }
-    ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
 
     if (i > 0) {
       if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
@@ -132,6 +132,7 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
       if (ksp->reason) break;
     }
 
+    nops = 0;
     if (i == 0) {
       alpha = gamma / delta;
       ierr  = VecCopy(N,Z);CHKERRQ(ierr);        /*     z <- n          */
@@ -141,15 +142,28 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
     } else {
       beta  = gamma / gammaold;
       alpha = gamma / (delta - beta / alpha * gamma);
-      ierr  = VecAYPX(Z,beta,N);CHKERRQ(ierr);   /*     z <- n + beta * z   */
-      ierr  = VecAYPX(Q,beta,M);CHKERRQ(ierr);   /*     q <- m + beta * q   */
-      ierr  = VecAYPX(P,beta,U);CHKERRQ(ierr);   /*     p <- u + beta * p   */
-      ierr  = VecAYPX(S,beta,W);CHKERRQ(ierr);   /*     s <- w + beta * s   */
+      ops[nops++] = VecFusedOpAYPX(Z,beta,N);    /*     z <- n + beta * z   */
+      ops[nops++] = VecFusedOpAYPX(Q,beta,M);    /*     q <- m + beta * q   */
+      ops[nops++] = VecFusedOpAYPX(P,beta,U);    /*     p <- u + beta * p   */
+      ops[nops++] = VecFusedOpAYPX(S,beta,W);    /*     s <- w + beta * s   */
+    }
+    ops[nops++] = VecFusedOpAXPY(X, alpha,P);    /*     x <- x + alpha * p   */
+    ops[nops++] = VecFusedOpAXPY(U,-alpha,Q);    /*     u <- u - alpha * q   */
+    ops[nops++] = VecFusedOpAXPY(W,-alpha,Z);    /*     w <- w - alpha * z   */
+    ops[nops++] = VecFusedOpAXPY(R,-alpha,S);    /*     r <- r - alpha * s   */
+    /* the reductions of the next iteration are computed in the same pass over the vectors */
+    nred = 0;
+    if (i+1 < ksp->max_it) {
+      if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+        ops[nops+nred++] = VecFusedOpNorm(R);
+      } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+        ops[nops+nred++] = VecFusedOpNorm(U);
+      }
+      ops[nops+nred++] = VecFusedOpDot(R,U);
+      ops[nops+nred++] = VecFusedOpDot(W,U);
     }
-    ierr     = VecAXPY(X, alpha,P);CHKERRQ(ierr); /*     x <- x + alpha * p   */
-    ierr     = VecAXPY(U,-alpha,Q);CHKERRQ(ierr); /*     u <- u - alpha * q   */
-    ierr     = VecAXPY(W,-alpha,Z);CHKERRQ(ierr); /*     w <- w - alpha * z   */
-    ierr     = VecAXPY(R,-alpha,S);CHKERRQ(ierr); /*     r <- r - alpha * s   */
+    nops += nred;
+    ierr  = VecFusedBegin(nops,ops);CHKERRQ(ierr);
     gammaold = gamma;
     i++;
     ksp->its = i;
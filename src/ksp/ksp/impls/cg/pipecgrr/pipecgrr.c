@@ -27,13 +27,14 @@ static PetscErrorCode KSPSetUp_PIPECGRR(KSP ksp)
 static PetscErrorCode  KSPSolve_PIPECGRR(KSP ksp)
 {
   PetscErrorCode ierr;
-  PetscInt       i = 0,replace = 0,totreplaces = 0,nsize;
-  PetscScalar    alpha = 0.0,beta = 0.0,gamma = 0.0,gammaold = 0.0,delta = 0.0,alphap = 0.0,betap = 0.0;
+  PetscInt       i = 0,replace = 0,totreplaces = 0,nsize,nops,nred,k;
+  PetscScalar    alpha = 0.0,beta = 0.0,gamma = 0.0,gammaold = 0.0,delta = 0.0,alphap = 0.0,betap = 0.0,res[11];
   PetscReal      dp = 0.0,nsi = 0.0,sqn = 0.0,Anorm = 0.0,rnp = 0.0,pnp = 0.0,snp = 0.0,unp = 0.0,wnp = 0.0,xnp = 0.0,qnp = 0.0,znp = 0.0,mnz = 5.0,tol = PETSC_SQRT_MACHINE_EPSILON,eps = PETSC_MACHINE_EPSILON;
   PetscReal      ds = 0.0,dz = 0.0,dx = 0.0,dpp = 0.0,dq = 0.0,dm = 0.0,du = 0.0,dw = 0.0,db = 0.0,errr = 0.0,errrprev = 0.0,errs = 0.0,errw = 0.0,errz = 0.0,errncr = 0.0,errncs = 0.0,errncw = 0.0,errncz = 0.0;
   Vec            X,B,Z,P,W,Q,U,M,N,R,S;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
+  VecFusedOp     ops[11];
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -123,51 +124,48 @@ static PetscErrorCode  KSPSolve_PIPECGRR(KSP ksp)
       betap = beta;
     }
 
+    /* all the reductions of the iteration are computed in one pass over the vectors */
+    nred = 0;
     if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);
+      ops[nred++] = VecFusedOpNorm(R);
     } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormBegin(U,NORM_2,&dp);CHKERRQ(ierr);
+      ops[nred++] = VecFusedOpNorm(U);
     }
     if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
+      ops[nred++] = VecFusedOpDot(R,U);
     }
-    ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
-    
+    ops[nred++] = VecFusedOpDot(W,U);
     if (i > 0) {
-      ierr = VecNormBegin(S,NORM_2,&ds);CHKERRQ(ierr);
-      ierr = VecNormBegin(Z,NORM_2,&dz);CHKERRQ(ierr);
-      ierr = VecNormBegin(P,NORM_2,&dpp);CHKERRQ(ierr);
-      ierr = VecNormBegin(Q,NORM_2,&dq);CHKERRQ(ierr);
-      ierr = VecNormBegin(M,NORM_2,&dm);CHKERRQ(ierr);
+      ops[nred++] = VecFusedOpNorm(S);
+      ops[nred++] = VecFusedOpNorm(Z);
+      ops[nred++] = VecFusedOpNorm(P);
+      ops[nred++] = VecFusedOpNorm(Q);
+      ops[nred++] = VecFusedOpNorm(M);
     }
-    ierr = VecNormBegin(X,NORM_2,&dx);CHKERRQ(ierr);
-    ierr = VecNormBegin(U,NORM_2,&du);CHKERRQ(ierr);
-    ierr = VecNormBegin(W,NORM_2,&dw);CHKERRQ(ierr);
+    ops[nred++] = VecFusedOpNorm(X);
+    ops[nred++] = VecFusedOpNorm(U);
+    ops[nred++] = VecFusedOpNorm(W);
+    ierr = VecFusedBegin(nred,ops);CHKERRQ(ierr);
 
     ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
     ierr = KSP_PCApply(ksp,W,M);CHKERRQ(ierr);           /*   m <- Bw       */
     ierr = KSP_MatMult(ksp,Amat,M,N);CHKERRQ(ierr);      /*   n <- Am       */
 
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormEnd(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
-    }
-    ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
-    
+    ierr = VecFusedEnd(nred,ops,res);CHKERRQ(ierr);
+    k    = 0;
+    if (i > 0 && (ksp->normtype == KSP_NORM_UNPRECONDITIONED || ksp->normtype == KSP_NORM_PRECONDITIONED)) dp = PetscRealPart(res[k++]);
+    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) gamma = res[k++];
+    delta = res[k++];
     if (i > 0) {
-      ierr = VecNormEnd(S,NORM_2,&ds);CHKERRQ(ierr);
-      ierr = VecNormEnd(Z,NORM_2,&dz);CHKERRQ(ierr);
-      ierr = VecNormEnd(P,NORM_2,&dpp);CHKERRQ(ierr);
-      ierr = VecNormEnd(Q,NORM_2,&dq);CHKERRQ(ierr);
-      ierr = VecNormEnd(M,NORM_2,&dm);CHKERRQ(ierr);
+      ds  = PetscRealPart(res[k++]);
+      dz  = PetscRealPart(res[k++]);
+      dpp = PetscRealPart(res[k++]);
+      dq  = PetscRealPart(res[k++]);
+      dm  = PetscRealPart(res[k++]);
     }
-    ierr = VecNormEnd(X,NORM_2,&dx);CHKERRQ(ierr);
-    ierr = VecNormEnd(U,NORM_2,&du);CHKERRQ(ierr);
-    ierr = VecNormEnd(W,NORM_2,&dw);CHKERRQ(ierr);
+    dx = PetscRealPart(res[k++]);
+    du = PetscRealPart(res[k++]);
+    dw = PetscRealPart(res[k++]);
 
     if (i > 0) {
       if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
@@ -180,6 +178,7 @@ static PetscErrorCode  KSPSolve_PIPECGRR(KSP ksp)
       if (ksp->reason) break;
     }
 
+    nops = 0;
     if (i == 0) {
       alpha = gamma / delta;
       ierr = VecCopy(N,Z);CHKERRQ(ierr);          /*  z <- n  */
@@ -189,15 +188,17 @@ static PetscErrorCode  KSPSolve_PIPECGRR(KSP ksp)
     } else {
       beta = gamma / gammaold;
       alpha = gamma / (delta - beta / alpha * gamma);
-      ierr = VecAYPX(Z,beta,N);CHKERRQ(ierr);     /*  z <- n + beta * z  */
-      ierr = VecAYPX(Q,beta,M);CHKERRQ(ierr);     /*  q <- m + beta * q  */
-      ierr = VecAYPX(P,beta,U);CHKERRQ(ierr);     /*  p <- u + beta * p  */
-      ierr = VecAYPX(S,beta,W);CHKERRQ(ierr);     /*  s <- w + beta * s  */
+      ops[nops++] = VecFusedOpAYPX(Z,beta,N);     /*  z <- n + beta * z  */
+      ops[nops++] = VecFusedOpAYPX(Q,beta,M);     /*  q <- m + beta * q  */
+      ops[nops++] = VecFusedOpAYPX(P,beta,U);     /*  p <- u + beta * p  */
+      ops[nops++] = VecFusedOpAYPX(S,beta,W);     /*  s <- w + beta * s  */
     }
-    ierr = VecAXPY(X, alpha,P);CHKERRQ(ierr);     /*  x <- x + alpha * p  */
-    ierr = VecAXPY(U,-alpha,Q);CHKERRQ(ierr);     /*  u <- u - alpha * q  */
-    ierr = VecAXPY(W,-alpha,Z);CHKERRQ(ierr);     /*  w <- w - alpha * z  */
-    ierr = VecAXPY(R,-alpha,S);CHKERRQ(ierr);     /*  r <- r - alpha * s  */
+    ops[nops++] = VecFusedOpAXPY(X, alpha,P);     /*  x <- x + alpha * p  */
+    ops[nops++] = VecFusedOpAXPY(U,-alpha,Q);     /*  u <- u - alpha * q  */
+    ops[nops++] = VecFusedOpAXPY(W,-alpha,Z);     /*  w <- w - alpha * z  */
+    ops[nops++] = VecFusedOpAXPY(R,-alpha,S);     /*  r <- r - alpha * s  */
+    /* the norms of the next iteration cannot share this pass, the residual replacement below may recompute the vectors */
+    ierr = VecFused(nops,ops,NULL);CHKERRQ(ierr);
     gammaold = gamma;
 
     if (i > 0) {
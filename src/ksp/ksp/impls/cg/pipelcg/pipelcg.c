@@ -525,6 +525,10 @@ static PetscErrorCode KSPSolve_PIPELCG(KSP ksp)
     MPI configuration may be necessary for reductions to make asynchronous progress, which is important for
     performance of pipelined methods. See the FAQ on the PETSc website for details.
 
+    Unlike KSPPIPECG, this method does not apply its vector updates with VecFusedBegin(): the dot products of the
+    l iterations in flight are reduced with their own nonblocking allreduces rather than the split phase reductions
+    of the communicator, and the recurrences use VecMAXPY() and VecScale(), which have no fused form.
+
     Contributed by:
     Siegfried Cools, University of Antwerp, Dept. Mathematics and Computer Science,
     funded by Flemish Research Foundation (FWO) grant number 12H4617N.
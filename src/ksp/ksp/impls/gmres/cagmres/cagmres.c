@@ -0,0 +1,816 @@
+
+#include <petsc/private/kspimpl.h>   /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+/*
+   The s-step (communication avoiding) GMRES method.
+
+   A cycle of max_k iterations is made of blocks of s iterations. From the last basis vector V_j0 a block builds the
+   s vectors W_i = ((B - a_{i-1}) W_{i-1} - b_{i-1} W_{i-2})/g_{i-1}, W_0 = V_j0, B the preconditioned operator, with
+   the recurrence of the basis type (see cabasis.c), so that B [W_0,...,W_{s-1}] = [W_0,...,W_s] T. The W_i are then
+   orthogonalized against V_0,...,V_j0 and among themselves with the block classical Gram-Schmidt and a Cholesky
+   QR factorization whose inner products, V^H W and W^H W, are computed in a single reduction:
+
+       W = [V_0,...,V_j0] C + [V_j0+1,...,V_j0+s] R
+
+   the Gram matrix of the projected vectors being W^H W - C^H C. The factorization is repeated on the result (CholQR2)
+   when R is ill-conditioned, and is shifted when the Gram matrix is not numerically positive definite. The s new
+   columns of the Hessenberg matrix follow from B V = V H: with Rf = [e_j0, [C;R]] the coordinates of W_0..W_s,
+
+       H(:,j0:j0+s-1) = (Rf T - [H(:,0:j0-1) Rf(0:j0-1,0:s-1); 0]) U^{-1},  U = Rf(j0:j0+s,0:s-1)
+
+   upper triangular. The Givens rotations, residual estimates and convergence tests of the s iterations are then those
+   of KSPGMRES. The first block of a solve uses the monomial basis, the Ritz values of its Hessenberg matrix give the
+   shifts of the Newton or Chebyshev bases of the next ones.
+*/
+typedef struct {
+  PetscInt                  s;             /* number of iterations per block */
+  PetscInt                  restart;       /* requested restart, max_k is this rounded up to a multiple of s */
+  PetscInt                  max_k;
+  KSPCABasisType            basistype;
+  KSPGMRESCGSRefinementType cgstype;       /* when the block orthogonalization is repeated */
+  PetscReal                 haptol;
+  Vec                       *V;            /* the max_k+1 orthonormal basis vectors */
+  Vec                       sol_temp;
+  PetscInt                  it;            /* last column of the Hessenberg matrix of the current cycle, -1 if none */
+  PetscScalar               *hes,*hh;      /* the Hessenberg matrix, and the same reduced by the rotations */
+  PetscScalar               *cc,*ss,*rs,*nrs,*coef;
+  PetscScalar               *C,*Cp,*F;     /* (max_k+1) x s block workspace */
+  PetscScalar               *R,*Rp,*Gp;    /* s x s block workspace */
+  PetscScalar               *a,*b;         /* recurrence of the basis */
+  PetscReal                 *g;
+  PetscReal                 *re,*im;       /* Ritz values */
+} KSP_CAGMRES;
+
+#define VEC_TEMP        ksp->work[0]
+#define VEC_TEMP_MATOP  ksp->work[1]
+#define HES(i,j)        cagmres->hes[(i)+(j)*(cagmres->max_k+1)]
+#define HH(i,j)         cagmres->hh[(i)+(j)*(cagmres->max_k+1)]
+
+static PetscErrorCode KSPSetUp_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt       s = cagmres->s,max_k,ld;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  max_k          = ((PetscMax(cagmres->restart,1)+s-1)/s)*s;
+  ld             = max_k+1;
+  cagmres->max_k = max_k;
+  ierr = KSPSetWorkVecs(ksp,2);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ksp->work[0],ld,&cagmres->V);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(ksp,ld,cagmres->V);CHKERRQ(ierr);
+  ierr = PetscMalloc7(ld*max_k,&cagmres->hes,ld*max_k,&cagmres->hh,max_k,&cagmres->cc,max_k,&cagmres->ss,ld,&cagmres->rs,max_k,&cagmres->nrs,ld,&cagmres->coef);CHKERRQ(ierr);
+  ierr = PetscMalloc6(ld*s,&cagmres->C,ld*s,&cagmres->Cp,ld*s,&cagmres->F,s*s,&cagmres->R,s*s,&cagmres->Rp,s*s,&cagmres->Gp);CHKERRQ(ierr);
+  ierr = PetscMalloc5(s,&cagmres->a,s,&cagmres->b,s,&cagmres->g,s,&cagmres->re,s,&cagmres->im);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(2*ld*max_k+3*max_k+2*ld+3*ld*s+3*s*s+2*s)*sizeof(PetscScalar)+3*s*sizeof(PetscReal));CHKERRQ(ierr);
+  cagmres->it = -1;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDestroy(&cagmres->sol_temp);CHKERRQ(ierr);
+  if (!cagmres->V) PetscFunctionReturn(0);
+  ierr = VecDestroyVecs(cagmres->max_k+1,&cagmres->V);CHKERRQ(ierr);
+  ierr = PetscFree7(cagmres->hes,cagmres->hh,cagmres->cc,cagmres->ss,cagmres->rs,cagmres->nrs,cagmres->coef);CHKERRQ(ierr);
+  ierr = PetscFree6(cagmres->C,cagmres->Cp,cagmres->F,cagmres->R,cagmres->Rp,cagmres->Gp);CHKERRQ(ierr);
+  ierr = PetscFree5(cagmres->a,cagmres->b,cagmres->g,cagmres->re,cagmres->im);CHKERRQ(ierr);
+  cagmres->it = -1;
+  PetscFunctionReturn(0);
+}
+
+/* W_{i+1} = ((B - a_i) W_i - b_i W_{i-1})/g_i for the s vectors of the block that starts at V[j0] */
+static PetscErrorCode KSPCAGMRESBlockBasis(KSP ksp,PetscInt j0)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  Vec            *W = cagmres->V+j0;
+  PetscScalar    a,b;
+  PetscReal      g;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<cagmres->s; i++) {
+    a    = cagmres->a[i];
+    b    = cagmres->b[i];
+    g    = cagmres->g[i];
+    ierr = KSP_PCApplyBAorAB(ksp,W[i],W[i+1],VEC_TEMP_MATOP);CHKERRQ(ierr);
+    if (b != 0.0) {
+      ierr = VecAXPBYPCZ(W[i+1],-a/g,-b/g,1.0/g,W[i],W[i-1]);CHKERRQ(ierr);
+    } else if (a != 0.0 || g != 1.0) {
+      ierr = VecAXPBY(W[i+1],-a/g,1.0/g,W[i]);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Orthogonalizes the s vectors W = V[j0+1..j0+s] against V[0..j0] and among themselves, giving W = V C + W' R.
+   Sets happy if the vectors are in the span of V[0..j0], in which case R is zero.
+*/
+static PetscErrorCode KSPCAGMRESBlockOrthogonalize(KSP ksp,PetscInt j0,PetscBool *happy)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt       s = cagmres->s,ld = cagmres->max_k+1,i,l,q,r,pass,need = 0,N;
+  Vec            *V = cagmres->V,*W = cagmres->V+j0+1;
+  PetscScalar    *C = cagmres->C,*Cp = cagmres->Cp,*R = cagmres->R,*Rp = cagmres->Rp,*Gp = cagmres->Gp,*coef = cagmres->coef,v;
+  PetscReal      trace,shift,rmin,rmax;
+  PetscBool      shifted,again = PETSC_TRUE;
+  PetscBLASInt   bs,info;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *happy = PETSC_FALSE;
+  comm   = PetscObjectComm((PetscObject)ksp);
+  ierr   = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr   = PetscArrayzero(C,ld*s);CHKERRQ(ierr);
+  ierr   = PetscArrayzero(R,s*s);CHKERRQ(ierr);
+  for (i=0; i<s; i++) R[i+i*s] = 1.0;
+
+  for (pass=0; again; pass++) {
+    /* V^H W and the upper triangle of W^H W in a single reduction */
+    for (i=0; i<s; i++) {
+      ierr = VecMDotBegin(W[i],j0+1,V,Cp+i*ld);CHKERRQ(ierr);
+      ierr = VecMDotBegin(W[i],i+1,W,Gp+i*s);CHKERRQ(ierr);
+    }
+    ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+    for (i=0; i<s; i++) {
+      ierr = VecMDotEnd(W[i],j0+1,V,Cp+i*ld);CHKERRQ(ierr);
+      ierr = VecMDotEnd(W[i],i+1,W,Gp+i*s);CHKERRQ(ierr);
+    }
+
+    /* W <- W - V Cp, whose Gram matrix is W^H W - Cp^H Cp */
+    for (i=0; i<s; i++) {
+      for (l=0; l<=i; l++) {
+        v = 0.0;
+        for (r=0; r<=j0; r++) v += PetscConj(Cp[r+l*ld])*Cp[r+i*ld];
+        Gp[l+i*s] -= v;
+      }
+      for (r=0; r<=j0; r++) coef[r] = -Cp[r+i*ld];
+      ierr = VecMAXPY(W[i],j0+1,coef,V);CHKERRQ(ierr);
+    }
+
+    /* Gp = Rp^H Rp, with a shift of the diagonal if Gp is not numerically positive definite */
+    shifted = PETSC_FALSE;
+    ierr    = PetscArraycpy(Rp,Gp,s*s);CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&bs,Rp,&bs,&info));
+    if (info) {
+      trace = 0.0;
+      for (i=0; i<s; i++) trace += PetscRealPart(Gp[i+i*s]);
+      if (PetscIsInfOrNanReal(trace)) {
+        if (ksp->errorifnotconverged) SETERRQ(comm,PETSC_ERR_NOT_CONVERGED,"Infinite or not-a-number generated in the Gram matrix of the basis");
+        ksp->reason = KSP_DIVERGED_NANORINF;
+        PetscFunctionReturn(0);
+      }
+      if (trace <= 0.0) {
+        /* the block is in the span of V[0..j0], only its first column is of use */
+        for (i=0; i<s; i++) {
+          for (r=0; r<=j0; r++) {
+            v = 0.0;
+            for (l=0; l<=i; l++) v += Cp[r+l*ld]*R[l+i*s];
+            C[r+i*ld] += v;
+          }
+        }
+        ierr   = PetscArrayzero(R,s*s);CHKERRQ(ierr);
+        *happy = PETSC_TRUE;
+        PetscFunctionReturn(0);
+      }
+      ierr  = VecGetSize(W[0],&N);CHKERRQ(ierr);
+      shift = 11.0*((PetscReal)N*s + s*(s+1))*PETSC_MACHINE_EPSILON*trace;
+      ierr  = PetscArraycpy(Rp,Gp,s*s);CHKERRQ(ierr);
+      for (i=0; i<s; i++) Rp[i+i*s] += shift;
+      PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&bs,Rp,&bs,&info));
+      if (info) {
+        if (ksp->errorifnotconverged) SETERRQ1(comm,PETSC_ERR_NOT_CONVERGED,"Breakdown of the shifted Cholesky factorization of the basis, LAPACK info %d",(int)info);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        ierr        = PetscInfo1(ksp,"breakdown of the shifted Cholesky factorization of the basis at iteration %D\n",ksp->its);CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+      }
+      shifted = PETSC_TRUE;
+      ierr    = PetscInfo2(ksp,"shifted Cholesky factorization of the basis at iteration %D, shift %g\n",ksp->its,(double)shift);CHKERRQ(ierr);
+    }
+
+    /* W <- W Rp^{-1} */
+    for (i=0; i<s; i++) {
+      if (i) {
+        for (l=0; l<i; l++) coef[l] = -Rp[l+i*s];
+        ierr = VecMAXPY(W[i],i,coef,W);CHKERRQ(ierr);
+      }
+      ierr = VecScale(W[i],1.0/Rp[i+i*s]);CHKERRQ(ierr);
+    }
+
+    /* W was V C + W R before the pass, it is V (C + Cp R) + W' (Rp R) after it */
+    for (i=0; i<s; i++) {
+      for (r=0; r<=j0; r++) {
+        v = 0.0;
+        for (l=0; l<=i; l++) v += Cp[r+l*ld]*R[l+i*s];
+        C[r+i*ld] += v;
+      }
+    }
+    for (i=0; i<s; i++) {
+      for (l=0; l<=i; l++) {
+        v = 0.0;
+        for (q=l; q<=i; q++) v += Rp[l+q*s]*R[q+i*s];
+        Gp[l+i*s] = v;
+      }
+    }
+    for (i=0; i<s; i++) {
+      for (l=0; l<=i; l++) R[l+i*s] = Gp[l+i*s];
+    }
+
+    /* a second pass for an ill-conditioned block (CholQR2), two more after a shifted factorization */
+    rmin = rmax = PetscAbsScalar(Rp[0]);
+    for (i=1; i<s; i++) {
+      rmin = PetscMin(rmin,PetscAbsScalar(Rp[i+i*s]));
+      rmax = PetscMax(rmax,PetscAbsScalar(Rp[i+i*s]));
+    }
+    if (shifted) need = 2;
+    else if (need) need--;
+    else if (!pass) {
+      if (cagmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS) need = 1;
+      else if (cagmres->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED && rmax*PetscSqrtReal(PETSC_SQRT_MACHINE_EPSILON) > rmin) need = 1;
+    }
+    again = (PetscBool)(need && pass < 3);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* the coordinates of W_l in V[0..j0+s], Rf(r,l) with r = 0..j0+s and l = 0..s */
+PETSC_STATIC_INLINE PetscScalar KSPCAGMRESRf(KSP_CAGMRES *cagmres,PetscInt j0,PetscInt r,PetscInt l)
+{
+  if (!l) return (r == j0) ? 1.0 : 0.0;
+  if (r <= j0) return cagmres->C[r+(l-1)*(cagmres->max_k+1)];
+  if (r-j0-1 <= l-1) return cagmres->R[(r-j0-1)+(l-1)*cagmres->s];
+  return 0.0;
+}
+
+/* the ncols columns j0.. of the Hessenberg matrix of the block, from B W = W T */
+static PetscErrorCode KSPCAGMRESBlockHessenberg(KSP ksp,PetscInt j0,PetscInt ncols)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt       s = cagmres->s,ld = cagmres->max_k+1,i,l,q,r;
+  PetscScalar    *F = cagmres->F,t,v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* F = Rf T - [H(:,0:j0-1) Rf(0:j0-1,0:s-1); 0], T tridiagonal and H(:,0:j0-1) upper Hessenberg */
+  for (i=0; i<ncols; i++) {
+    for (r=0; r<=j0+s; r++) {
+      v = 0.0;
+      for (l=PetscMax(i-1,0); l<=i+1; l++) {
+        t = (l == i-1) ? cagmres->b[i] : ((l == i) ? cagmres->a[i] : cagmres->g[i]);
+        if (t != 0.0) v += KSPCAGMRESRf(cagmres,j0,r,l)*t;
+      }
+      if (i && r <= j0) {
+        for (q=PetscMax(r-1,0); q<j0; q++) v -= HES(r,q)*KSPCAGMRESRf(cagmres,j0,q,i);
+      }
+      F[r+i*ld] = v;
+    }
+  }
+  /* H(:,j0:j0+ncols-1) = F U^{-1} */
+  for (i=0; i<ncols; i++) {
+    for (r=0; r<=j0+s; r++) {
+      v = F[r+i*ld];
+      for (l=0; l<i; l++) v -= HES(r,j0+l)*KSPCAGMRESRf(cagmres,j0,j0+l,i);
+      HES(r,j0+i) = v/KSPCAGMRESRf(cagmres,j0,j0+i,i);
+    }
+    for (r=j0+i+2; r<ld; r++) HES(r,j0+i) = 0.0;
+    for (r=0; r<ld; r++) HH(r,j0+i) = HES(r,j0+i);
+  }
+  ierr = PetscLogFlops(2.0*ncols*(j0+s+1)*(3+j0+ncols));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* applies the previous rotations to the column it of HH, then computes and applies the new one, as in KSPGMRES */
+static PetscErrorCode KSPCAGMRESUpdateHessenberg(KSP ksp,PetscInt it,PetscBool hapend,PetscReal *res)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscScalar *hh = &HH(0,it),*cc = cagmres->cc,*ss = cagmres->ss,*rs = cagmres->rs,tt;
+  PetscInt    j;
+
+  PetscFunctionBegin;
+  for (j=0; j<it; j++) {
+    tt      = hh[j];
+    hh[j]   = PetscConj(cc[j])*tt + ss[j]*hh[j+1];
+    hh[j+1] = cc[j]*hh[j+1] - ss[j]*tt;
+  }
+  if (!hapend) {
+    tt = PetscSqrtScalar(PetscConj(hh[it])*hh[it] + PetscConj(hh[it+1])*hh[it+1]);
+    if (tt == 0.0) {
+      if (ksp->errorifnotconverged) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"tt == 0.0");
+      else {
+        ksp->reason = KSP_DIVERGED_NULL;
+        PetscFunctionReturn(0);
+      }
+    }
+    cc[it]   = hh[it]/tt;
+    ss[it]   = hh[it+1]/tt;
+    rs[it+1] = -(ss[it]*rs[it]);
+    rs[it]   = PetscConj(cc[it])*rs[it];
+    hh[it]   = PetscConj(cc[it])*hh[it] + ss[it]*hh[it+1];
+    *res     = PetscAbsScalar(rs[it+1]);
+  } else {
+    /* happy breakdown: HH(it+1,it) = 0, no rotation is needed and the residual is zero */
+    *res = 0.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* vdest <- vs + V y, y minimizing the residual over the it+1 first columns */
+static PetscErrorCode KSPCAGMRESBuildSoln(KSP ksp,PetscScalar *nrs,Vec vs,Vec vdest,PetscInt it)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscScalar    tt;
+  PetscInt       k,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (it < 0) {
+    ierr = VecCopy(vs,vdest);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (k=it; k>=0; k--) {
+    tt = cagmres->rs[k];
+    for (j=k+1; j<=it; j++) tt -= HH(k,j)*nrs[j];
+    if (HH(k,k) == 0.0) {
+      if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"Likely your matrix or preconditioner is singular. HH(k,k) is identically zero; k = %D",k);
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      ierr        = PetscInfo1(ksp,"Likely your matrix or preconditioner is singular. HH(k,k) is identically zero; k = %D\n",k);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    nrs[k] = tt/HH(k,k);
+  }
+  ierr = VecSet(VEC_TEMP,0.0);CHKERRQ(ierr);
+  ierr = VecMAXPY(VEC_TEMP,it+1,nrs,cagmres->V);CHKERRQ(ierr);
+  ierr = KSPUnwindPreconditioner(ksp,VEC_TEMP,VEC_TEMP_MATOP);CHKERRQ(ierr);
+  if (vdest != vs) {
+    ierr = VecCopy(vs,vdest);CHKERRQ(ierr);
+  }
+  ierr = VecAXPY(vdest,1.0,VEC_TEMP);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESSetUpBasis(KSP ksp,KSPCABasisType type,PetscInt nritz)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPCABasisSetUp_Private(type,cagmres->s,nritz,cagmres->re,cagmres->im,cagmres->a,cagmres->b,cagmres->g);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* one cycle of max_k iterations, from the initial residual in V[0] */
+static PetscErrorCode KSPCAGMRESCycle(KSP ksp,PetscBool *first)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt       s = cagmres->s,max_k = cagmres->max_k,j0,i,r,col,ncols;
+  PetscReal      res,hapbnd,tt;
+  PetscBool      hapend = PETSC_FALSE,happy;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecNormalize(cagmres->V[0],&res);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,res);
+  cagmres->rs[0] = res;
+  cagmres->it    = -1;
+
+  ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->rnorm = res;
+  ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+  ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    ierr        = PetscInfo(ksp,"Converged due to zero residual norm on entry\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+
+  for (j0=0; !ksp->reason && !hapend && j0<max_k && ksp->its<ksp->max_it; j0+=s) {
+    ierr = KSPCAGMRESBlockBasis(ksp,j0);CHKERRQ(ierr);
+    ierr = KSPCAGMRESBlockOrthogonalize(ksp,j0,&happy);CHKERRQ(ierr);
+    if (ksp->reason) break;
+    ncols = happy ? 1 : s;
+    ierr  = KSPCAGMRESBlockHessenberg(ksp,j0,ncols);CHKERRQ(ierr);
+
+    /* the rotations, residual estimates and convergence tests of the iterations of the block */
+    for (i=0; i<ncols; i++) {
+      col = j0+i;
+      if (col) {
+        ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+        ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+      }
+      tt     = PetscAbsScalar(HES(col+1,col));
+      hapbnd = PetscAbsScalar(tt/cagmres->rs[col]);
+      if (hapbnd > cagmres->haptol) hapbnd = cagmres->haptol;
+      if (tt < hapbnd) {
+        ierr   = PetscInfo2(ksp,"Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n",(double)hapbnd,(double)tt);CHKERRQ(ierr);
+        hapend = PETSC_TRUE;
+      }
+      ierr = KSPCAGMRESUpdateHessenberg(ksp,col,hapend,&res);CHKERRQ(ierr);
+      cagmres->it = col;
+      ksp->its++;
+      ksp->rnorm  = res;
+      if (ksp->reason) break;
+
+      ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (hapend) {
+        if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+          ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+        } else if (!ksp->reason) {
+          if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"You reached the happy break down, but convergence was not indicated. Residual norm = %g",(double)res);
+          ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        }
+        break;
+      }
+      if (ksp->reason || ksp->its >= ksp->max_it) break;
+    }
+
+    /* Ritz values of the preconditioned operator from the Hessenberg matrix of the first block of the solve */
+    if (*first && cagmres->basistype != KSP_CA_BASIS_MONOMIAL && !happy && i == s) {
+      for (i=0; i<s; i++) {
+        for (r=0; r<s; r++) cagmres->Gp[r+i*s] = HES(r,i);
+      }
+      ierr = KSPCABasisComputeRitz_Private(s,cagmres->Gp,s,cagmres->re,cagmres->im);CHKERRQ(ierr);
+      ierr = KSPCAGMRESSetUpBasis(ksp,cagmres->basistype,s);CHKERRQ(ierr);
+    }
+    *first = PETSC_FALSE;
+  }
+
+  /* monitor if there is no restart */
+  if (cagmres->it >= 0 && (ksp->reason || ksp->its >= ksp->max_it)) {
+    ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  }
+  ierr = KSPCAGMRESBuildSoln(ksp,cagmres->nrs,ksp->vec_sol,ksp->vec_sol,cagmres->it);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSolve_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscBool      guess_zero = ksp->guess_zero,first = PETSC_TRUE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr     = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  ierr        = KSPCAGMRESSetUpBasis(ksp,KSP_CA_BASIS_MONOMIAL,0);CHKERRQ(ierr);
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  while (!ksp->reason) {
+    ierr = KSPInitialResidual(ksp,ksp->vec_sol,VEC_TEMP,VEC_TEMP_MATOP,cagmres->V[0],ksp->vec_rhs);CHKERRQ(ierr);
+    ierr = KSPCAGMRESCycle(ksp,&first);CHKERRQ(ierr);
+    if (ksp->its >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero;    /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPBuildSolution_CAGMRES(KSP ksp,Vec ptr,Vec *result)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!cagmres->sol_temp) {
+      ierr = VecDuplicate(ksp->vec_sol,&cagmres->sol_temp);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)cagmres->sol_temp);CHKERRQ(ierr);
+    }
+    ptr = cagmres->sol_temp;
+  }
+  ierr = KSPCAGMRESBuildSoln(ksp,cagmres->nrs,ksp->vec_sol,ptr,cagmres->it);CHKERRQ(ierr);
+  if (result) *result = ptr;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_CAGMRES(KSP ksp,PetscViewer viewer)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  const char     *cstr;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, iterations per block %D, %s basis\n",cagmres->restart,cagmres->s,KSPCABasisTypes[cagmres->basistype]);CHKERRQ(ierr);
+    switch (cagmres->cgstype) {
+    case (KSP_GMRES_CGS_REFINE_NEVER):
+      cstr = "never repeated";
+      break;
+    case (KSP_GMRES_CGS_REFINE_ALWAYS):
+      cstr = "always repeated";
+      break;
+    case (KSP_GMRES_CGS_REFINE_IFNEEDED):
+      cstr = "repeated for ill-conditioned blocks";
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Unknown orthogonalization");
+    }
+    ierr = PetscViewerASCIIPrintf(viewer,"  block Cholesky QR orthogonalization, %s\n",cstr);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  happy breakdown tolerance %g\n",(double)cagmres->haptol);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_CAGMRES(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_CAGMRES               *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscInt                  s,restart;
+  PetscReal                 haptol;
+  KSPCABasisType            type;
+  KSPGMRESCGSRefinementType cgstype;
+  PetscBool                 flg;
+  PetscErrorCode            ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP CAGMRES options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_cagmres_steps","Number of iterations per global reduction","KSPCAGMRESSetSteps",cagmres->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCAGMRESSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_cagmres_basis_type","Polynomial basis","KSPCAGMRESSetBasisType",KSPCABasisTypes,(PetscEnum)cagmres->basistype,(PetscEnum*)&type,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPCAGMRESSetBasisType(ksp,type);CHKERRQ(ierr);}
+  ierr = PetscOptionsInt("-ksp_gmres_restart","Number of Krylov search directions","KSPGMRESSetRestart",cagmres->restart,&restart,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetRestart(ksp,restart);CHKERRQ(ierr);}
+  ierr = PetscOptionsReal("-ksp_gmres_haptol","Tolerance for exact convergence (happy ending)","KSPGMRESSetHapTol",cagmres->haptol,&haptol,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetHapTol(ksp,haptol);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Repetition of the block orthogonalization","KSPGMRESSetCGSRefinementType",KSPGMRESCGSRefinementTypes,(PetscEnum)cagmres->cgstype,(PetscEnum*)&cgstype,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetCGSRefinementType(ksp,cgstype);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESSetSteps_CAGMRES(KSP ksp,PetscInt s)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps must be positive");
+  if (!ksp->setupstage) {
+    cagmres->s = s;
+  } else if (cagmres->s != s) {
+    /* free the data structures, then create them again */
+    ierr            = KSPReset_CAGMRES(ksp);CHKERRQ(ierr);
+    cagmres->s      = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESGetSteps_CAGMRES(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_CAGMRES*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPCAGMRESSetBasisType_CAGMRES(KSP ksp,KSPCABasisType type)
+{
+  PetscFunctionBegin;
+  ((KSP_CAGMRES*)ksp->data)->basistype = type;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSetRestart_CAGMRES(KSP ksp,PetscInt restart)
+{
+  KSP_CAGMRES    *cagmres = (KSP_CAGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (restart < 1) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Restart must be positive");
+  if (!ksp->setupstage) {
+    cagmres->restart = restart;
+  } else if (cagmres->restart != restart) {
+    /* free the data structures, then create them again */
+    ierr             = KSPReset_CAGMRES(ksp);CHKERRQ(ierr);
+    cagmres->restart = restart;
+    ksp->setupstage  = KSP_SETUP_NEW;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESGetRestart_CAGMRES(KSP ksp,PetscInt *restart)
+{
+  PetscFunctionBegin;
+  *restart = ((KSP_CAGMRES*)ksp->data)->restart;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSetHapTol_CAGMRES(KSP ksp,PetscReal tol)
+{
+  PetscFunctionBegin;
+  if (tol < 0.0) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Tolerance must be non-negative");
+  ((KSP_CAGMRES*)ksp->data)->haptol = tol;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESSetCGSRefinementType_CAGMRES(KSP ksp,KSPGMRESCGSRefinementType type)
+{
+  PetscFunctionBegin;
+  ((KSP_CAGMRES*)ksp->data)->cgstype = type;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESGetCGSRefinementType_CAGMRES(KSP ksp,KSPGMRESCGSRefinementType *type)
+{
+  PetscFunctionBegin;
+  *type = ((KSP_CAGMRES*)ksp->data)->cgstype;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESSetSteps - Sets the number of iterations of KSPCAGMRES done with a single global reduction.
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  s - the number of iterations per block
+
+   Options Database:
+.  -ksp_cagmres_steps <s>
+
+   Notes:
+   The restart is rounded up to a multiple of s. The default is 4; larger values save more reductions but the basis
+   loses accuracy quickly, beyond 8 or so even with the Newton or Chebyshev bases.
+
+   Level: intermediate
+
+.seealso: KSPCAGMRES, KSPCAGMRESGetSteps(), KSPCAGMRESSetBasisType(), KSPGMRESSetRestart()
+@*/
+PetscErrorCode KSPCAGMRESSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPCAGMRESSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESGetSteps - Gets the number of iterations of KSPCAGMRES done with a single global reduction.
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  s - the number of iterations per block
+
+   Level: intermediate
+
+.seealso: KSPCAGMRES, KSPCAGMRESSetSteps()
+@*/
+PetscErrorCode KSPCAGMRESGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPCAGMRESGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPCAGMRESSetBasisType - Sets the polynomial basis of KSPCAGMRES.
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  type - KSP_CA_BASIS_MONOMIAL, KSP_CA_BASIS_NEWTON (the default) or KSP_CA_BASIS_CHEBYSHEV
+
+   Options Database:
+.  -ksp_cagmres_basis_type <monomial,newton,chebyshev>
+
+   Notes:
+   The Newton and Chebyshev bases use the Ritz values of the first block of each solve, which uses the monomial basis.
+
+   Level: intermediate
+
+.seealso: KSPCAGMRES, KSPCABasisType, KSPCAGMRESSetSteps()
+@*/
+PetscErrorCode KSPCAGMRESSetBasisType(KSP ksp,KSPCABasisType type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,type,2);
+  ierr = PetscTryMethod(ksp,"KSPCAGMRESSetBasisType_C",(KSP,KSPCABasisType),(ksp,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_CAGMRES(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_CAGMRES(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetRestart_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetRestart_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   KSPCAGMRES - The s-step (communication avoiding) GMRES method.
+
+   s iterations are done with a single global reduction, of the inner products of a block of s basis vectors with
+   the previous ones and among themselves, against one or two reductions per iteration for KSPGMRES with classical
+   Gram-Schmidt.
+
+   Options Database Keys:
++   -ksp_cagmres_steps <s> - number of iterations per block (default 4)
+.   -ksp_cagmres_basis_type <monomial,newton,chebyshev> - polynomial basis (default newton)
+.   -ksp_gmres_restart <restart> - the number of Krylov directions to orthogonalize against, rounded up to a multiple of s
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+-   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - when the block orthogonalization is
+    repeated: never, if the triangular factor of the block is ill-conditioned (the default), or always
+
+   Level: intermediate
+
+   Notes:
+   The operator and the preconditioner are applied s times per block as in KSPGMRES; the blocks are orthogonalized
+   with the Cholesky QR factorization of their Gram matrix, repeated when the block is ill-conditioned (CholQR2) and
+   shifted when the Gram matrix is not numerically positive definite, which costs one more reduction each time. The
+   Hessenberg matrix, the residual estimates and the solution are those of KSPGMRES in exact arithmetic.
+
+   The bases of monomials lose their linear independence quickly. The Newton and Chebyshev bases are built from the
+   Ritz values given by the first block of each solve.
+
+   The matrix powers are computed with the operator and the preconditioner, one vector after another; there is no
+   kernel computing the s vectors with a single exchange of ghost values.
+
+   References:
++  1. - M. Hoemmen, "Communication-avoiding Krylov subspace methods", PhD thesis, UC Berkeley, 2010.
+.  2. - Z. Bai, D. Hu and L. Reichel, "A Newton basis GMRES implementation", IMA J. Numer. Anal. 14(4):563-581, 1994.
+-  3. - T. Fukaya, Y. Nakatsukasa, Y. Yanagisawa and Y. Yamamoto, "CholeskyQR2: a simple and communication-avoiding
+        algorithm for computing a tall-skinny QR factorization on a large-scale parallel system", ScalA 2014.
+
+.seealso: KSPCreate(), KSPSetType(), KSPGMRES, KSPPGMRES, KSPPIPEFGMRES, KSPCACG, KSPCAGMRESSetSteps(), KSPCAGMRESSetBasisType(),
+          KSPGMRESSetRestart(), KSPGMRESSetCGSRefinementType()
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES    *cagmres;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&cagmres);CHKERRQ(ierr);
+  cagmres->s         = 4;
+  cagmres->restart   = 30;
+  cagmres->basistype = KSP_CA_BASIS_NEWTON;
+  cagmres->cgstype   = KSP_GMRES_CGS_REFINE_IFNEEDED;
+  cagmres->haptol    = 1.0e-30;
+  cagmres->it        = -1;
+  ksp->data          = (void*)cagmres;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_RIGHT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_RIGHT,1);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_CAGMRES;
+  ksp->ops->solve          = KSPSolve_CAGMRES;
+  ksp->ops->reset          = KSPReset_CAGMRES;
+  ksp->ops->destroy        = KSPDestroy_CAGMRES;
+  ksp->ops->view           = KSPView_CAGMRES;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CAGMRES;
+  ksp->ops->buildsolution  = KSPBuildSolution_CAGMRES;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetSteps_C",KSPCAGMRESSetSteps_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESGetSteps_C",KSPCAGMRESGetSteps_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPCAGMRESSetBasisType_C",KSPCAGMRESSetBasisType_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetRestart_C",KSPGMRESSetRestart_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetRestart_C",KSPGMRESGetRestart_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",KSPGMRESSetCGSRefinementType_CAGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",KSPGMRESGetCGSRefinementType_CAGMRES);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
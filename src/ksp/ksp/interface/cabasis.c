@@ -0,0 +1,168 @@
+
+/*
+   Polynomial bases of the s-step (communication avoiding) Krylov methods KSPCACG and KSPCAGMRES.
+
+   The s vectors that follow v_0 are built with the three term recurrence
+
+       v_{i+1} = ((B - a_i) v_i - b_i v_{i-1})/g_i,   i = 0,...,s-1,  b_0 = 0,
+
+   so that B [v_0,...,v_{s-1}] = [v_0,...,v_s] T, with T the (s+1) x s tridiagonal matrix of diagonal a, subdiagonal g
+   and superdiagonal b_1,...,b_{s-1}. The monomial basis has a_i = b_i = 0 and g_i = 1. The Newton basis takes as shifts
+   a_i Ritz values of B in Leja order; in real arithmetic a complex conjugate pair x +/- iy is used as the two real steps
+   (B - x)/g and ((B - x) + y^2/g)/g. The Chebyshev basis uses the Chebyshev polynomials of the interval spanned by the
+   real parts of the Ritz values.
+*/
+#include <petsc/private/kspimpl.h>   /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+/*
+   KSPCABasisComputeRitz_Private - Computes the eigenvalues of the n x n matrix H (the Lanczos tridiagonal matrix or
+   the Arnoldi Hessenberg matrix of the first iterations), H is overwritten
+*/
+PetscErrorCode KSPCABasisComputeRitz_Private(PetscInt n,PetscScalar H[],PetscInt ldh,PetscReal re[],PetscReal im[])
+{
+#if defined(PETSC_HAVE_ESSL)
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Ritz values are not available with ESSL, use the monomial basis");
+#else
+  PetscErrorCode ierr;
+  PetscBLASInt   bn,bld,lwork,idummy = 1,lierr = 0;
+  PetscScalar    *work,sdummy = 0;
+#if defined(PETSC_USE_COMPLEX)
+  PetscScalar    *eigs;
+  PetscReal      *rwork;
+  PetscInt       i;
+#endif
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldh,&bld);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(5*n,&lwork);CHKERRQ(ierr);
+  ierr = PetscMalloc1(5*n,&work);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,H,&bld,re,im,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,&lierr));
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+#else
+  ierr = PetscMalloc2(n,&eigs,2*n,&rwork);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,H,&bld,eigs,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,rwork,&lierr));
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    re[i] = PetscRealPart(eigs[i]);
+    im[i] = PetscImaginaryPart(eigs[i]);
+  }
+  ierr = PetscFree2(eigs,rwork);CHKERRQ(ierr);
+#endif
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  if (lierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)lierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPCABasisSetUp_Private - Computes the coefficients a, b and g of the recurrence of s steps of the basis type
+   from the n Ritz values re + i im (ignored with the monomial basis)
+
+   Every rank computes the same coefficients from the same (reduced) Ritz values.
+*/
+PetscErrorCode KSPCABasisSetUp_Private(KSPCABasisType type,PetscInt s,PetscInt n,const PetscReal re[],const PetscReal im[],PetscScalar a[],PetscScalar b[],PetscReal g[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,l,m,q,*order;
+  PetscReal      lmin,lmax,c,h,diam,dist,scale,*logprod;
+  PetscBool      *used;
+
+  PetscFunctionBegin;
+  for (i=0; i<s; i++) {
+    a[i] = 0.0;
+    b[i] = 0.0;
+    g[i] = 1.0;
+  }
+  if (type == KSP_CA_BASIS_MONOMIAL || !n) PetscFunctionReturn(0);
+
+  if (type == KSP_CA_BASIS_CHEBYSHEV) {
+    lmin = lmax = re[0];
+    for (k=1; k<n; k++) {
+      lmin = PetscMin(lmin,re[k]);
+      lmax = PetscMax(lmax,re[k]);
+    }
+    c = 0.5*(lmax + lmin);
+    h = 0.5*(lmax - lmin);
+    if (h <= PETSC_SQRT_MACHINE_EPSILON*PetscAbsReal(c)) h = PetscAbsReal(c);
+    if (h == 0.0) h = 1.0;
+    a[0] = c;
+    g[0] = h;
+    for (i=1; i<s; i++) {
+      a[i] = c;
+      b[i] = 0.5*h;
+      g[i] = 0.5*h;
+    }
+    PetscFunctionReturn(0);
+  }
+
+  /* Newton basis: the steps are scaled by the capacity of the Ritz values, estimated by a quarter of their diameter */
+  diam = 0.0;
+  for (k=0; k<n; k++) {
+    for (l=0; l<k; l++) diam = PetscMax(diam,PetscSqrtReal((re[k]-re[l])*(re[k]-re[l]) + (im[k]-im[l])*(im[k]-im[l])));
+  }
+  scale = 0.25*diam;
+  if (scale == 0.0) scale = PetscSqrtReal(re[0]*re[0] + im[0]*im[0]);
+  if (scale == 0.0) scale = 1.0;
+
+  /* Leja order: start from the largest Ritz value, then take the one maximizing the product of the distances to those
+     already taken. In real arithmetic only the member with positive imaginary part of a conjugate pair is a candidate,
+     its conjugate being taken with it */
+  ierr = PetscMalloc3(n,&order,n,&logprod,n,&used);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    logprod[k] = 0.0;
+#if defined(PETSC_USE_COMPLEX)
+    used[k] = PETSC_FALSE;
+#else
+    used[k] = (PetscBool)(im[k] < 0.0);
+#endif
+  }
+  for (m=0; m<n; m++) {
+    q = -1;
+    for (k=0; k<n; k++) {
+      if (used[k]) continue;
+      if (!m) {
+        if (q < 0 || re[k]*re[k] + im[k]*im[k] > re[q]*re[q] + im[q]*im[q]) q = k;
+      } else if (q < 0 || logprod[k] > logprod[q]) q = k;
+    }
+    if (q < 0) break;
+    used[q]  = PETSC_TRUE;
+    order[m] = q;
+    for (k=0; k<n; k++) {
+      if (used[k]) continue;
+      dist        = PetscSqrtReal((re[k]-re[q])*(re[k]-re[q]) + (im[k]-im[q])*(im[k]-im[q]));
+      logprod[k] += PetscLogReal(PetscMax(dist,PETSC_MACHINE_EPSILON*scale));
+#if !defined(PETSC_USE_COMPLEX)
+      if (im[q] > 0.0) {
+        dist        = PetscSqrtReal((re[k]-re[q])*(re[k]-re[q]) + (im[k]+im[q])*(im[k]+im[q]));
+        logprod[k] += PetscLogReal(PetscMax(dist,PETSC_MACHINE_EPSILON*scale));
+      }
+#endif
+    }
+  }
+
+  /* the shifts are used cyclically if there are fewer Ritz values than steps */
+  for (i=0,k=0; i<s; k=(k+1)%m) {
+    q = order[k];
+#if defined(PETSC_USE_COMPLEX)
+    a[i]   = PetscCMPLX(re[q],im[q]);
+    g[i++] = scale;
+#else
+    a[i]   = re[q];
+    g[i++] = scale;
+    if (im[q] > 0.0 && i < s) {
+      a[i]   = re[q];
+      b[i]   = -im[q]*im[q]/scale;
+      g[i++] = scale;
+    }
+#endif
+  }
+  ierr = PetscFree3(order,logprod,used);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
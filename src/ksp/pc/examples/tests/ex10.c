@@ -0,0 +1,111 @@
+
+static char help[] = "Compares concurrent and sequential solves of the local blocks of PCBJACOBI and PCASM.\n\
+  -n <n>       : the matrix is a nonsymmetric 5-point stencil on an n x n grid\n\
+  -blocks <b>  : number of blocks on each process\n\
+  -asm         : use PCASM instead of PCBJACOBI\n\n";
+
+#include <petscpc.h>
+
+static PetscErrorCode CreatePC(Mat A,PetscBool useasm,PetscInt blocks,PetscBool concurrent,PC *pc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCCreate(PETSC_COMM_WORLD,pc);CHKERRQ(ierr);
+  if (useasm) {
+    ierr = PCSetType(*pc,PCASM);CHKERRQ(ierr);
+    ierr = PCASMSetLocalSubdomains(*pc,blocks,NULL,NULL);CHKERRQ(ierr);
+    ierr = PCASMSetConcurrentSolves(*pc,concurrent);CHKERRQ(ierr);
+  } else {
+    ierr = PCSetType(*pc,PCBJACOBI);CHKERRQ(ierr);
+    ierr = PCBJacobiSetLocalBlocks(*pc,blocks,NULL);CHKERRQ(ierr);
+    ierr = PCBJacobiSetConcurrentSolves(*pc,concurrent);CHKERRQ(ierr);
+  }
+  ierr = PCSetOperators(*pc,A,A);CHKERRQ(ierr);
+  ierr = PCSetFromOptions(*pc);CHKERRQ(ierr);
+  ierr = PCSetUp(*pc);CHKERRQ(ierr);
+  ierr = PCSetUpOnBlocks(*pc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  PC             pc,pcc;
+  Vec            x,y,yc;
+  PetscRandom    rand;
+  PetscInt       n = 12,blocks = 4,N,i,rstart,rend,cols[5],ncols;
+  PetscScalar    vals[5];
+  PetscBool      useasm = PETSC_FALSE,equal;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-blocks",&blocks,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-asm",&useasm,NULL);CHKERRQ(ierr);
+  N    = n*n;
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ncols = 0;
+    if (i >= n)    {cols[ncols] = i-n; vals[ncols++] = -1.0;}
+    if (i%n)       {cols[ncols] = i-1; vals[ncols++] = -1.1;}
+    cols[ncols] = i; vals[ncols++] = 4.2 + 0.1*(i%3);
+    if ((i+1)%n)   {cols[ncols] = i+1; vals[ncols++] = -0.9;}
+    if (i+n < N)   {cols[ncols] = i+n; vals[ncols++] = -1.0;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = CreatePC(A,useasm,blocks,PETSC_FALSE,&pc);CHKERRQ(ierr);
+  ierr = CreatePC(A,useasm,blocks,PETSC_TRUE,&pcc);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&yc);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+
+  /* the blocks are solved independently and the solutions combined in order, so the results are identical */
+  ierr = PCApply(pc,x,y);CHKERRQ(ierr);
+  ierr = PCApply(pcc,x,yc);CHKERRQ(ierr);
+  ierr = VecEqual(y,yc,&equal);CHKERRQ(ierr);
+  if (!equal) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Concurrent PCApply() differs from the sequential one\n");CHKERRQ(ierr);}
+  ierr = PCApplyTranspose(pc,x,y);CHKERRQ(ierr);
+  ierr = PCApplyTranspose(pcc,x,yc);CHKERRQ(ierr);
+  ierr = VecEqual(y,yc,&equal);CHKERRQ(ierr);
+  if (!equal) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Concurrent PCApplyTranspose() differs from the sequential one\n");CHKERRQ(ierr);}
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&yc);CHKERRQ(ierr);
+  ierr = PCDestroy(&pc);CHKERRQ(ierr);
+  ierr = PCDestroy(&pcc);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      output_file: output/ex10_1.out
+      args: -asm {{0 1}} -sub_pc_type ilu
+
+   test:
+      suffix: 2
+      nsize: 2
+      output_file: output/ex10_1.out
+      args: -asm {{0 1}} -sub_pc_type ilu
+
+   test:
+      suffix: openmp
+      requires: openmp threadsafety
+      nsize: {{1 2}}
+      output_file: output/ex10_1.out
+      args: -asm {{0 1}} -blocks 8 -sub_pc_type ilu
+
+TEST*/
@@ -0,0 +1,84 @@
+static char help[] = "Compares PCCHOWILU with enough sweeps to PCILU with the same levels of fill.\n\
+  -n <n>      : the matrix is a nonsymmetric 5-point stencil on an n x n grid\n\
+  -levels <l> : levels of fill\n\n";
+
+#include <petscpc.h>
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  PC             pc,pcchow;
+  Vec            x,y,ychow;
+  PetscRandom    rand;
+  PetscInt       n = 6,levels = 0,N,i,cols[5],ncols;
+  PetscScalar    vals[5];
+  PetscReal      norm,err;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-levels",&levels,NULL);CHKERRQ(ierr);
+  N    = n*n;
+
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,N,N,5,NULL,&A);CHKERRQ(ierr);
+  for (i=0; i<N; i++) {
+    ncols = 0;
+    if (i >= n)    {cols[ncols] = i-n; vals[ncols++] = -1.0;}
+    if (i%n)       {cols[ncols] = i-1; vals[ncols++] = -1.1;}
+    cols[ncols] = i; vals[ncols++] = 4.2 + 0.1*(i%3);
+    if ((i+1)%n)   {cols[ncols] = i+1; vals[ncols++] = -0.9;}
+    if (i+n < N)   {cols[ncols] = i+n; vals[ncols++] = -1.0;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = PCCreate(PETSC_COMM_SELF,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCILU);CHKERRQ(ierr);
+  ierr = PCFactorSetLevels(pc,levels);CHKERRQ(ierr);
+  ierr = PCSetOperators(pc,A,A);CHKERRQ(ierr);
+  ierr = PCSetUp(pc);CHKERRQ(ierr);
+
+  ierr = PCCreate(PETSC_COMM_SELF,&pcchow);CHKERRQ(ierr);
+  ierr = PCSetType(pcchow,PCCHOWILU);CHKERRQ(ierr);
+  ierr = PCSetFromOptions(pcchow);CHKERRQ(ierr);
+  ierr = PCSetOperators(pcchow,A,A);CHKERRQ(ierr);
+  ierr = PCSetUp(pcchow);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&ychow);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = PCApply(pc,x,y);CHKERRQ(ierr);
+  ierr = PCApply(pcchow,x,ychow);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  ierr = VecAXPY(ychow,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(ychow,NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (err > 1000*PETSC_MACHINE_EPSILON*norm) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"PCCHOWILU differs from PCILU by %g\n",(double)(err/norm));CHKERRQ(ierr);
+  }
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&ychow);CHKERRQ(ierr);
+  ierr = PCDestroy(&pc);CHKERRQ(ierr);
+  ierr = PCDestroy(&pcchow);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      output_file: output/ex8_1.out
+      args: -pc_chowilu_sweeps 80 -pc_chowilu_solve_sweeps {{0 80}}
+
+   test:
+      suffix: levels
+      output_file: output/ex8_1.out
+      args: -levels 2 -pc_chowilu_levels 2 -pc_chowilu_sweeps 80 -pc_chowilu_solve_sweeps 80
+
+TEST*/
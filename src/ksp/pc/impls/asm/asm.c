@@ -30,6 +30,7 @@ typedef struct {
   PetscBool  same_local_solves;   /* flag indicating whether all local solvers are same */
   PetscBool  sort_indices;        /* flag to sort subdomain indices */
   PetscBool  dm_subdomains;       /* whether DM is allowed to define subdomains */
+  PetscBool  concurrent;          /* set up and solve the local blocks concurrently, additive composition only */
   PCCompositeType loctype;        /* the type of composition for local solves */
   MatType    sub_mat_type;        /* the type of Mat used for subdomain solves (can be MATSAME or NULL) */
   /* For multiplicative solve */
@@ -56,6 +57,7 @@ static PetscErrorCode PCView_ASM(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  restriction/interpolation type - %s\n",PCASMTypes[osm->type]);CHKERRQ(ierr);
     if (osm->dm_subdomains) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: using DM to define subdomains\n");CHKERRQ(ierr);}
     if (osm->loctype != PC_COMPOSITE_ADDITIVE) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: local solve composition type - %s\n",PCCompositeTypes[osm->loctype]);CHKERRQ(ierr);}
+    if (osm->concurrent) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: local blocks are solved concurrently\n");CHKERRQ(ierr);}
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
     if (osm->same_local_solves) {
       if (osm->ksp) {
@@ -439,17 +441,38 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
 
 static PetscErrorCode PCSetUpOnBlocks_ASM(PC pc)
 {
-  PC_ASM             *osm = (PC_ASM*)pc->data;
-  PetscErrorCode     ierr;
-  PetscInt           i;
-  KSPConvergedReason reason;
+  PC_ASM         *osm = (PC_ASM*)pc->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  for (i=0; i<osm->n_local_true; i++) {
-    ierr = KSPSetUp(osm->ksp[i]);CHKERRQ(ierr);
-    ierr = KSPGetConvergedReason(osm->ksp[i],&reason);CHKERRQ(ierr);
-    if (reason == KSP_DIVERGED_PC_FAILED) {
-      pc->failedreason = PC_SUBPC_ERROR;
+  ierr = PCSetUpBlocks_Private(pc,osm->concurrent,osm->n_local_true,osm->ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Additive composition with concurrent solves: all the block right hand sides are restricted first, the blocks are
+   solved together, and the block solutions are then added to the local solution in the order of the blocks, as in
+   the sequential loop.
+*/
+static PetscErrorCode PCApplyBlocksConcurrent_ASM(PC pc,PetscBool transpose,ScatterMode forward,ScatterMode reverse)
+{
+  PC_ASM         *osm = (PC_ASM*)pc->data;
+  PetscErrorCode ierr;
+  PetscInt       i,n_local_true = osm->n_local_true;
+
+  PetscFunctionBegin;
+  for (i=1; i<n_local_true; i++) {
+    ierr = VecScatterBegin(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+    ierr = VecScatterEnd(osm->lrestriction[i], osm->lx, osm->x[i], INSERT_VALUES, forward);CHKERRQ(ierr);
+  }
+  ierr = PCSolveBlocks_Private(pc,PETSC_TRUE,transpose,n_local_true,osm->ksp,osm->x,osm->y);CHKERRQ(ierr);
+  for (i=0; i<n_local_true; i++) {
+    if (osm->lprolongation) {
+      ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+      ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+    } else {
+      ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+      ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
     }
   }
   PetscFunctionReturn(0);
@@ -490,32 +513,36 @@ static PetscErrorCode PCApply_ASM(PC pc,Vec x,Vec y)
     ierr = VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0],  INSERT_VALUES, forward);CHKERRQ(ierr);
 
     /* do the local solves */
-    for (i = 0; i < n_local_true; ++i) {
+    if (osm->concurrent && osm->loctype == PC_COMPOSITE_ADDITIVE) {
+      ierr = PCApplyBlocksConcurrent_ASM(pc,PETSC_FALSE,forward,reverse);CHKERRQ(ierr);
+    } else {
+      for (i = 0; i < n_local_true; ++i) {
 
-      /* solve the overlapping i-block */
-      ierr = PetscLogEventBegin(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
-      ierr = KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
-      ierr = KSPCheckSolve(osm->ksp[i],pc,osm->y[i]);CHKERRQ(ierr);
-      ierr = PetscLogEventEnd(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
+        /* solve the overlapping i-block */
+        ierr = PetscLogEventBegin(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
+        ierr = KSPSolve(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
+        ierr = KSPCheckSolve(osm->ksp[i],pc,osm->y[i]);CHKERRQ(ierr);
+        ierr = PetscLogEventEnd(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
 
-      if (osm->lprolongation) { /* interpolate the non-overalapping i-block solution to the local solution (only for restrictive additive) */
-        ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
-        ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
-      }
-      else{ /* interpolate the overalapping i-block solution to the local solution */
-        ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
-        ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
-      }
+        if (osm->lprolongation) { /* interpolate the non-overalapping i-block solution to the local solution (only for restrictive additive) */
+          ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+          ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+        }
+        else{ /* interpolate the overalapping i-block solution to the local solution */
+          ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+          ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+        }
 
-      if (i < n_local_true-1) {
-        /* Restrict local RHS to the overlapping (i+1)-block RHS */
-        ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
-        ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+        if (i < n_local_true-1) {
+          /* Restrict local RHS to the overlapping (i+1)-block RHS */
+          ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+          ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
 
-        if ( osm->loctype == PC_COMPOSITE_MULTIPLICATIVE){
-          /* update the overlapping (i+1)-block RHS using the current local solution */
-          ierr = MatMult(osm->lmats[i+1], osm->ly, osm->y[i+1]);CHKERRQ(ierr);
-          ierr = VecAXPBY(osm->x[i+1],-1.,1., osm->y[i+1]); CHKERRQ(ierr);
+          if ( osm->loctype == PC_COMPOSITE_MULTIPLICATIVE){
+            /* update the overlapping (i+1)-block RHS using the current local solution */
+            ierr = MatMult(osm->lmats[i+1], osm->ly, osm->y[i+1]);CHKERRQ(ierr);
+            ierr = VecAXPBY(osm->x[i+1],-1.,1., osm->y[i+1]); CHKERRQ(ierr);
+          }
         }
       }
     }
@@ -564,27 +591,31 @@ static PetscErrorCode PCApplyTranspose_ASM(PC pc,Vec x,Vec y)
   ierr = VecScatterEnd(osm->lrestriction[0], osm->lx, osm->x[0],  INSERT_VALUES, forward);CHKERRQ(ierr);
 
   /* do the local solves */
-  for (i = 0; i < n_local_true; ++i) {
+  if (osm->concurrent) {
+    ierr = PCApplyBlocksConcurrent_ASM(pc,PETSC_TRUE,forward,reverse);CHKERRQ(ierr);
+  } else {
+    for (i = 0; i < n_local_true; ++i) {
 
-    /* solve the overlapping i-block */
-    ierr = PetscLogEventBegin(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
-    ierr = KSPSolveTranspose(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
-    ierr = KSPCheckSolve(osm->ksp[i],pc,osm->y[i]);CHKERRQ(ierr);
-    ierr = PetscLogEventEnd(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
+      /* solve the overlapping i-block */
+      ierr = PetscLogEventBegin(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
+      ierr = KSPSolveTranspose(osm->ksp[i], osm->x[i], osm->y[i]);CHKERRQ(ierr);
+      ierr = KSPCheckSolve(osm->ksp[i],pc,osm->y[i]);CHKERRQ(ierr);
+      ierr = PetscLogEventEnd(PC_ApplyOnBlocks,osm->ksp[i],osm->x[i],osm->y[i],0);CHKERRQ(ierr);
 
-    if (osm->lprolongation) { /* interpolate the non-overalapping i-block solution to the local solution */
-     ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
-     ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
-    }
-    else{ /* interpolate the overalapping i-block solution to the local solution */
-      ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
-      ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
-    }
+      if (osm->lprolongation) { /* interpolate the non-overalapping i-block solution to the local solution */
+       ierr = VecScatterBegin(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+       ierr = VecScatterEnd(osm->lprolongation[i], osm->y[i], osm->ly, ADD_VALUES, forward);CHKERRQ(ierr);
+      }
+      else{ /* interpolate the overalapping i-block solution to the local solution */
+        ierr = VecScatterBegin(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+        ierr = VecScatterEnd(osm->lrestriction[i], osm->y[i], osm->ly, ADD_VALUES, reverse);CHKERRQ(ierr);
+      }
 
-    if (i < n_local_true-1) {
-      /* Restrict local RHS to the overlapping (i+1)-block RHS */
-      ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
-      ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+      if (i < n_local_true-1) {
+        /* Restrict local RHS to the overlapping (i+1)-block RHS */
+        ierr = VecScatterBegin(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+        ierr = VecScatterEnd(osm->lrestriction[i+1], osm->lx, osm->x[i+1], INSERT_VALUES, forward);CHKERRQ(ierr);
+      }
     }
   }
   /* Add the local solution to the global solution including the ghost nodes */
@@ -693,6 +724,7 @@ static PetscErrorCode PCSetFromOptions_ASM(PetscOptionItems *PetscOptionsObject,
   flg  = PETSC_FALSE;
   ierr = PetscOptionsEnum("-pc_asm_local_type","Type of local solver composition","PCASMSetLocalType",PCCompositeTypes,(PetscEnum)osm->loctype,(PetscEnum*)&loctype,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCASMSetLocalType(pc,loctype);CHKERRQ(ierr); }
+  ierr = PetscOptionsBool("-pc_asm_concurrent_solves","Set up and solve the local blocks concurrently","PCASMSetConcurrentSolves",osm->concurrent,&osm->concurrent,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsFList("-pc_asm_sub_mat_type","Subsolve Matrix Type","PCASMSetSubMatType",MatList,NULL,sub_mat_type,256,&flg);CHKERRQ(ierr);
   if(flg){
     ierr = PCASMSetSubMatType(pc,sub_mat_type);CHKERRQ(ierr);
@@ -838,6 +870,15 @@ static PetscErrorCode  PCASMSetSortIndices_ASM(PC pc,PetscBool  doSort)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCASMSetConcurrentSolves_ASM(PC pc,PetscBool flg)
+{
+  PC_ASM *osm = (PC_ASM*)pc->data;
+
+  PetscFunctionBegin;
+  osm->concurrent = flg;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCASMGetSubKSP_ASM(PC pc,PetscInt *n_local,PetscInt *first_local,KSP **ksp)
 {
   PC_ASM         *osm = (PC_ASM*)pc->data;
@@ -1192,6 +1233,43 @@ PetscErrorCode  PCASMSetSortIndices(PC pc,PetscBool doSort)
   PetscFunctionReturn(0);
 }
 
+/*@
+    PCASMSetConcurrentSolves - Sets whether the subdomains owned by a process are set up and solved concurrently,
+    by the OpenMP threads of the process.
+
+    Logically Collective on pc
+
+    Input Parameters:
++   pc  - the preconditioner context
+-   flg - PETSC_TRUE to process the local subdomains concurrently
+
+    Options Database Key:
+.   -pc_asm_concurrent_solves - process the local subdomains concurrently
+
+    Notes:
+    This only has an effect with more than one subdomain per process, and when PETSc is configured with OpenMP and
+    --with-threadsafety; otherwise the subdomains are processed one after another. With the multiplicative local
+    composition (see PCASMSetLocalType()) only the set up of the subdomains is concurrent, since each solve depends
+    on the previous ones.
+
+    The solutions of the subdomains are added to the local solution in the order of the subdomains, so the result
+    does not depend on the number of threads.
+
+    Level: intermediate
+
+.seealso: PCASMSetLocalSubdomains(), PCASMSetLocalType(), PCBJacobiSetConcurrentSolves()
+@*/
+PetscErrorCode  PCASMSetConcurrentSolves(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCASMSetConcurrentSolves_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PCASMGetSubKSP - Gets the local KSP contexts for all blocks on
    this processor.
@@ -1239,7 +1317,8 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
 +  -pc_asm_blocks <blks> - Sets total blocks
 .  -pc_asm_overlap <ovl> - Sets overlap
 .  -pc_asm_type [basic,restrict,interpolate,none] - Sets ASM type, default is restrict
--  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+.  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+-  -pc_asm_concurrent_solves - set up and solve the subdomains of a process concurrently, see PCASMSetConcurrentSolves()
 
      IMPORTANT: If you run with, for example, 3 blocks on 1 processor or 3 blocks on 3 processors you
       will get a different convergence rate due to the default option of -pc_asm_type restrict. Use
@@ -1266,7 +1345,8 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
            PCBJACOBI, PCASMGetSubKSP(), PCASMSetLocalSubdomains(), PCASMType, PCASMGetType(), PCASMSetLocalType(), PCASMGetLocalType()
-           PCASMSetTotalSubdomains(), PCSetModifySubMatrices(), PCASMSetOverlap(), PCASMSetType(), PCCompositeType
+           PCASMSetTotalSubdomains(), PCSetModifySubMatrices(), PCASMSetOverlap(), PCASMSetType(), PCCompositeType,
+           PCASMSetConcurrentSolves()
 
 M*/
 
@@ -1297,6 +1377,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   osm->same_local_solves = PETSC_TRUE;
   osm->sort_indices      = PETSC_TRUE;
   osm->dm_subdomains     = PETSC_FALSE;
+  osm->concurrent        = PETSC_FALSE;
   osm->sub_mat_type      = NULL;
 
   pc->data                 = (void*)osm;
@@ -1318,6 +1399,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetLocalType_C",PCASMSetLocalType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetLocalType_C",PCASMGetLocalType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSortIndices_C",PCASMSetSortIndices_ASM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetConcurrentSolves_C",PCASMSetConcurrentSolves_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubKSP_C",PCASMGetSubKSP_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubMatType_C",PCASMGetSubMatType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSubMatType_C",PCASMSetSubMatType_ASM);CHKERRQ(ierr);
@@ -167,6 +167,7 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PetscOptionItems *PetscOptionsObj
   if (flg) {ierr = PCBJacobiSetTotalBlocks(pc,blocks,NULL);CHKERRQ(ierr);}
   ierr = PetscOptionsInt("-pc_bjacobi_local_blocks","Local number of blocks","PCBJacobiSetLocalBlocks",jac->n_local,&blocks,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCBJacobiSetLocalBlocks(pc,blocks,NULL);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-pc_bjacobi_concurrent_solves","Set up and solve the local blocks concurrently","PCBJacobiSetConcurrentSolves",jac->concurrent,&jac->concurrent,NULL);CHKERRQ(ierr);
   if (jac->ksp) {
     /* The sub-KSP has already been set up (e.g., PCSetUp_BJacobi_Singleblock), but KSPSetFromOptions was not called
      * unless we had already been called. */
@@ -198,6 +199,9 @@ static PetscErrorCode PCView_BJacobi(PC pc,PetscViewer viewer)
       ierr = PetscViewerASCIIPrintf(viewer,"  using Amat local matrix, number of blocks = %D\n",jac->n);CHKERRQ(ierr);
     }
     ierr = PetscViewerASCIIPrintf(viewer,"  number of blocks = %D\n",jac->n);CHKERRQ(ierr);
+    if (jac->concurrent) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  local blocks are solved concurrently\n");CHKERRQ(ierr);
+    }
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRQ(ierr);
     if (jac->same_local_solves) {
       ierr = PetscViewerASCIIPrintf(viewer,"  Local solve is same for all blocks, in the following KSP and PC objects:\n");CHKERRQ(ierr);
@@ -333,6 +337,15 @@ static PetscErrorCode  PCBJacobiGetLocalBlocks_BJacobi(PC pc, PetscInt *blocks,
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCBJacobiSetConcurrentSolves_BJacobi(PC pc,PetscBool flg)
+{
+  PC_BJacobi *jac = (PC_BJacobi*)pc->data;
+
+  PetscFunctionBegin;
+  jac->concurrent = flg;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 /*@C
@@ -497,6 +510,42 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCBJacobiSetConcurrentSolves - Sets whether the blocks owned by a process are set up and solved concurrently,
+   by the OpenMP threads of the process.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to process the local blocks concurrently
+
+   Options Database Key:
+.  -pc_bjacobi_concurrent_solves - process the local blocks concurrently
+
+   Notes:
+   This only has an effect with more than one block per process, and when PETSc is configured with OpenMP and
+   --with-threadsafety; otherwise the blocks are processed one after another. The solvers of the blocks must not
+   themselves use OpenMP or share objects with each other.
+
+   Each block is still solved by a single thread, and the failures of the blocks are collected in the order of the
+   blocks, so the result does not depend on the number of threads.
+
+   Level: intermediate
+
+.seealso: PCBJacobiSetLocalBlocks(), PCASMSetConcurrentSolves()
+@*/
+PetscErrorCode  PCBJacobiSetConcurrentSolves(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCBJacobiSetConcurrentSolves_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -----------------------------------------------------------------------------------*/
 
 /*MC
@@ -505,7 +554,8 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
    Options Database Keys:
 +  -pc_use_amat - use Amat to apply block of operator in inner Krylov method
--  -pc_bjacobi_blocks <n> - use n total blocks
+.  -pc_bjacobi_blocks <n> - use n total blocks
+-  -pc_bjacobi_concurrent_solves - set up and solve the blocks of a process concurrently, see PCBJacobiSetConcurrentSolves()
 
    Notes:
     Each processor can have one or more blocks, or a single block can be shared by several processes. Defaults to one block per processor.
@@ -529,7 +579,7 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
            PCASM, PCSetUseAmat(), PCGetUseAmat(), PCBJacobiGetSubKSP(), PCBJacobiSetTotalBlocks(),
-           PCBJacobiSetLocalBlocks(), PCSetModifySubMatrices()
+           PCBJacobiSetLocalBlocks(), PCSetModifySubMatrices(), PCBJacobiSetConcurrentSolves()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_BJacobi(PC pc)
@@ -559,12 +609,14 @@ PETSC_EXTERN PetscErrorCode PCCreate_BJacobi(PC pc)
   jac->g_lens            = 0;
   jac->l_lens            = 0;
   jac->psubcomm          = 0;
+  jac->concurrent        = PETSC_FALSE;
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetSubKSP_C",PCBJacobiGetSubKSP_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetTotalBlocks_C",PCBJacobiSetTotalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetTotalBlocks_C",PCBJacobiGetTotalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetLocalBlocks_C",PCBJacobiSetLocalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetLocalBlocks_C",PCBJacobiGetLocalBlocks_BJacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetConcurrentSolves_C",PCBJacobiSetConcurrentSolves_BJacobi);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -871,19 +923,11 @@ static PetscErrorCode PCDestroy_BJacobi_Multiblock(PC pc)
 
 static PetscErrorCode PCSetUpOnBlocks_BJacobi_Multiblock(PC pc)
 {
-  PC_BJacobi         *jac = (PC_BJacobi*)pc->data;
-  PetscErrorCode     ierr;
-  PetscInt           i,n_local = jac->n_local;
-  KSPConvergedReason reason;
+  PC_BJacobi     *jac = (PC_BJacobi*)pc->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  for (i=0; i<n_local; i++) {
-    ierr = KSPSetUp(jac->ksp[i]);CHKERRQ(ierr);
-    ierr = KSPGetConvergedReason(jac->ksp[i],&reason);CHKERRQ(ierr);
-    if (reason == KSP_DIVERGED_PC_FAILED) {
-      pc->failedreason = PC_SUBPC_ERROR;
-    }
-  }
+  ierr = PCSetUpBlocks_Private(pc,jac->concurrent,jac->n_local,jac->ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -910,12 +954,9 @@ static PetscErrorCode PCApply_BJacobi_Multiblock(PC pc,Vec x,Vec y)
     */
     ierr = VecPlaceArray(bjac->x[i],xin+bjac->starts[i]);CHKERRQ(ierr);
     ierr = VecPlaceArray(bjac->y[i],yin+bjac->starts[i]);CHKERRQ(ierr);
-
-    ierr = PetscLogEventBegin(PC_ApplyOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-    ierr = KSPSolve(jac->ksp[i],bjac->x[i],bjac->y[i]);CHKERRQ(ierr);
-    ierr = KSPCheckSolve(jac->ksp[i],pc,bjac->y[i]);CHKERRQ(ierr);
-    ierr = PetscLogEventEnd(PC_ApplyOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-
+  }
+  ierr = PCSolveBlocks_Private(pc,jac->concurrent,PETSC_FALSE,n_local,jac->ksp,bjac->x,bjac->y);CHKERRQ(ierr);
+  for (i=0; i<n_local; i++) {
     ierr = VecResetArray(bjac->x[i]);CHKERRQ(ierr);
     ierr = VecResetArray(bjac->y[i]);CHKERRQ(ierr);
   }
@@ -947,12 +988,9 @@ static PetscErrorCode PCApplyTranspose_BJacobi_Multiblock(PC pc,Vec x,Vec y)
     */
     ierr = VecPlaceArray(bjac->x[i],xin+bjac->starts[i]);CHKERRQ(ierr);
     ierr = VecPlaceArray(bjac->y[i],yin+bjac->starts[i]);CHKERRQ(ierr);
-
-    ierr = PetscLogEventBegin(PC_ApplyTransposeOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-    ierr = KSPSolveTranspose(jac->ksp[i],bjac->x[i],bjac->y[i]);CHKERRQ(ierr);
-    ierr = KSPCheckSolve(jac->ksp[i],pc,bjac->y[i]);CHKERRQ(ierr);
-    ierr = PetscLogEventEnd(PC_ApplyTransposeOnBlocks,jac->ksp[i],bjac->x[i],bjac->y[i],0);CHKERRQ(ierr);
-
+  }
+  ierr = PCSolveBlocks_Private(pc,jac->concurrent,PETSC_TRUE,n_local,jac->ksp,bjac->x,bjac->y);CHKERRQ(ierr);
+  for (i=0; i<n_local; i++) {
     ierr = VecResetArray(bjac->x[i]);CHKERRQ(ierr);
     ierr = VecResetArray(bjac->y[i]);CHKERRQ(ierr);
   }
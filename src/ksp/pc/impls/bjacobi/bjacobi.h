@@ -21,6 +21,7 @@ typedef struct {
   PetscInt     *l_lens;           /* lens of each block */
   PetscInt     *g_lens;
   PetscSubcomm psubcomm;          /* for multiple processors per block */
+  PetscBool    concurrent;        /* set up and solve the local blocks concurrently */
 } PC_BJacobi;
 
 /*
@@ -0,0 +1,362 @@
+/*
+   Chow-Patel fine-grained parallel ILU factorization of MATSEQAIJ matrices, computed by fixed-point
+   sweeps over the nonzeros of the factors and applied with Jacobi sweeps of the triangular solves,
+   so both the setup and the application are parallel over the rows with OpenMP threads.
+*/
+#include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscInt    sweeps;           /* fixed-point sweeps of the factorization */
+  PetscInt    solvesweeps;      /* Jacobi sweeps of each triangular solve, 0 for exact triangular solves */
+  PetscInt    levels;           /* levels of fill of the sparsity pattern of the factors */
+  PetscInt    n,nz;
+  PetscInt    *i,*j,*diag;      /* pattern of L+U by rows, diag[r] is the position of the diagonal of row r */
+  PetscInt    *ci,*cj,*cpos;    /* pattern of U by columns, cpos[] are the positions of its entries in a[] */
+  PetscScalar *a,*aold;         /* L strictly below the diagonal (its unit diagonal is not stored) and U */
+  PetscScalar *aA;              /* the entries of the matrix on the pattern, zero at the fill positions */
+  PetscScalar *idiag;           /* inverse of the diagonal of U */
+  PetscScalar *work;            /* iterates of the triangular solves */
+} PC_ChowILU;
+
+static PetscErrorCode PCReset_ChowILU(PC pc)
+{
+  PC_ChowILU     *ilu = (PC_ChowILU*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscFree3(ilu->i,ilu->j,ilu->diag);CHKERRQ(ierr);
+  ierr    = PetscFree3(ilu->ci,ilu->cj,ilu->cpos);CHKERRQ(ierr);
+  ierr    = PetscFree5(ilu->a,ilu->aold,ilu->aA,ilu->idiag,ilu->work);CHKERRQ(ierr);
+  ilu->n  = 0;
+  ilu->nz = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The pattern of the factors is the one of the ILU(levels) factorization with the natural ordering,
+   taken from its symbolic factorization: row r of L is in f->j[f->i[r]..f->i[r+1]) and row r of U
+   in f->j[f->diag[r+1]+1..f->diag[r]).
+*/
+static PetscErrorCode PCChowILUSetUpPattern_Private(PC pc)
+{
+  PC_ChowILU     *ilu = (PC_ChowILU*)pc->data;
+  PetscErrorCode ierr;
+  Mat            F;
+  Mat_SeqAIJ     *f;
+  IS             row,col;
+  MatFactorInfo  info;
+  PetscInt       n,nz,nu,r,k,p,c,*cnt;
+
+  PetscFunctionBegin;
+  ierr = MatGetOrdering(pc->pmat,MATORDERINGNATURAL,&row,&col);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill   = 1.0;
+  info.levels = ilu->levels;
+  ierr = MatGetFactor(pc->pmat,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic(F,pc->pmat,row,col,&info);CHKERRQ(ierr);
+  ierr = ISDestroy(&row);CHKERRQ(ierr);
+  ierr = ISDestroy(&col);CHKERRQ(ierr);
+  f    = (Mat_SeqAIJ*)F->data;
+  n    = pc->pmat->rmap->n;
+  nu   = f->diag[0] - f->diag[n];
+  nz   = f->i[n] + nu;
+
+  ilu->n  = n;
+  ilu->nz = nz;
+  ierr = PetscMalloc3(n+1,&ilu->i,nz,&ilu->j,n,&ilu->diag);CHKERRQ(ierr);
+  ilu->i[0] = 0;
+  for (r=0; r<n; r++) {
+    p = ilu->i[r];
+    for (k=f->i[r]; k<f->i[r+1]; k++) ilu->j[p++] = f->j[k];
+    ilu->diag[r] = p;
+    ilu->j[p++]  = r;
+    for (k=f->diag[r+1]+1; k<f->diag[r]; k++) ilu->j[p++] = f->j[k];
+    ilu->i[r+1] = p;
+    ierr = PetscSortInt(ilu->diag[r]-ilu->i[r],ilu->j+ilu->i[r]);CHKERRQ(ierr);
+    ierr = PetscSortInt(p-ilu->diag[r]-1,ilu->j+ilu->diag[r]+1);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+
+  /* the rows of each column of U are in increasing order */
+  ierr = PetscMalloc3(n+1,&ilu->ci,nu,&ilu->cj,nu,&ilu->cpos);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n+1,&cnt);CHKERRQ(ierr);
+  for (r=0; r<n; r++) {
+    for (p=ilu->diag[r]; p<ilu->i[r+1]; p++) cnt[ilu->j[p]+1]++;
+  }
+  for (c=0; c<n; c++) cnt[c+1] += cnt[c];
+  ierr = PetscArraycpy(ilu->ci,cnt,n+1);CHKERRQ(ierr);
+  for (r=0; r<n; r++) {
+    for (p=ilu->diag[r]; p<ilu->i[r+1]; p++) {
+      c                 = ilu->j[p];
+      ilu->cj[cnt[c]]   = r;
+      ilu->cpos[cnt[c]] = p;
+      cnt[c]++;
+    }
+  }
+  ierr = PetscFree(cnt);CHKERRQ(ierr);
+  ierr = PetscMalloc5(nz,&ilu->a,nz,&ilu->aold,nz,&ilu->aA,n,&ilu->idiag,2*n,&ilu->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)pc,(3*nz+3*n)*sizeof(PetscScalar)+(3*n+nz+2*nu)*sizeof(PetscInt));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   One sweep updates every entry of the factors from the values of the previous sweep,
+
+     l_rc = (a_rc - sum_{k<c} l_rk u_kc)/u_cc  for r > c
+     u_rc =  a_rc - sum_{k<r} l_rk u_kc        for r <= c
+
+   so the rows are independent and the result does not depend on the number of threads.
+*/
+static PetscErrorCode PCSetUp_ChowILU(PC pc)
+{
+  PC_ChowILU        *ilu = (PC_ChowILU*)pc->data;
+  PetscErrorCode    ierr;
+  PetscBool         isseqaij;
+  const PetscInt    *ai,*aj;
+  const PetscScalar *aa;
+  PetscInt          n,r,p,q,s,nzero = 0;
+  PetscBool         done;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectBaseTypeCompare((PetscObject)pc->pmat,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"PCCHOWILU does not handle matrix type %s, use it on the blocks of PCBJACOBI or PCASM in parallel",((PetscObject)pc->pmat)->type_name);
+  if (!pc->setupcalled || pc->flag != SAME_NONZERO_PATTERN) {
+    ierr = PCReset_ChowILU(pc);CHKERRQ(ierr);
+    ierr = PCChowILUSetUpPattern_Private(pc);CHKERRQ(ierr);
+  }
+  n = ilu->n;
+
+  /* the pattern of the factors contains the one of the matrix */
+  ierr = MatGetRowIJ(pc->pmat,0,PETSC_FALSE,PETSC_FALSE,&n,&ai,&aj,&done);CHKERRQ(ierr);
+  if (!done) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot get the rows of the matrix");
+  ierr = MatSeqAIJGetArrayRead(pc->pmat,&aa);CHKERRQ(ierr);
+  ierr = PetscArrayzero(ilu->aA,ilu->nz);CHKERRQ(ierr);
+  for (r=0; r<n; r++) {
+    q = ilu->i[r];
+    for (p=ai[r]; p<ai[r+1]; p++) {
+      while (ilu->j[q] < aj[p]) q++;
+      ilu->aA[q] = aa[p];
+    }
+  }
+  ierr = MatSeqAIJRestoreArrayRead(pc->pmat,&aa);CHKERRQ(ierr);
+  ierr = MatRestoreRowIJ(pc->pmat,0,PETSC_FALSE,PETSC_FALSE,&n,&ai,&aj,&done);CHKERRQ(ierr);
+
+  /* the initial guess is L = strictly lower part of A times inverse of its diagonal, U = upper part of A */
+  pc->failedreason = PC_NOERROR;
+  for (r=0; r<n; r++) {
+    if (ilu->aA[ilu->diag[r]] == 0.0) {
+      ierr = PetscInfo1(pc,"Zero diagonal entry in row %D\n",r);CHKERRQ(ierr);
+      pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+      PetscFunctionReturn(0);
+    }
+  }
+  for (r=0; r<n; r++) {
+    for (p=ilu->i[r]; p<ilu->diag[r]; p++) ilu->a[p] = ilu->aA[p]/ilu->aA[ilu->diag[ilu->j[p]]];
+    for (p=ilu->diag[r]; p<ilu->i[r+1]; p++) ilu->a[p] = ilu->aA[p];
+  }
+
+  for (s=0; s<ilu->sweeps; s++) {
+    const PetscInt    *fi = ilu->i,*fj = ilu->j,*fdiag = ilu->diag,*ci = ilu->ci,*cj = ilu->cj,*cpos = ilu->cpos;
+    const PetscScalar *aold = ilu->aold,*aA = ilu->aA;
+    PetscScalar       *a = ilu->a;
+
+    ierr = PetscArraycpy(ilu->aold,ilu->a,ilu->nz);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (r=0; r<n; r++) {
+      PetscInt    k,c,m,pl,pu;
+      PetscScalar sum;
+
+      for (k=fi[r]; k<fi[r+1]; k++) {
+        c   = fj[k];
+        m   = PetscMin(r,c);
+        sum = aA[k];
+        /* merge row r of L with column c of U, over the indices below m */
+        pl  = fi[r];
+        pu  = ci[c];
+        while (pl < fi[r+1] && fj[pl] < m && pu < ci[c+1] && cj[pu] < m) {
+          if (fj[pl] == cj[pu]) {
+            sum -= aold[pl]*aold[cpos[pu]];
+            pl++; pu++;
+          } else if (fj[pl] < cj[pu]) pl++;
+          else pu++;
+        }
+        a[k] = (r > c) ? sum/aold[fdiag[c]] : sum;
+      }
+    }
+  }
+
+  for (r=0; r<n; r++) {
+    if (ilu->a[ilu->diag[r]] == 0.0 || PetscIsInfOrNanScalar(ilu->a[ilu->diag[r]])) nzero++;
+    ilu->idiag[r] = 1.0/ilu->a[ilu->diag[r]];
+  }
+  if (nzero) {
+    ierr = PetscInfo1(pc,"%D zero or not finite diagonal entries of U after the sweeps\n",nzero);CHKERRQ(ierr);
+    pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+  }
+  /* each update merges a row of L and a column of U, of nz/n entries on average */
+  ierr = PetscLogFlops(2.0*ilu->sweeps*ilu->nz*ilu->nz/PetscMax(n,1));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Solves L U y = x. Each Jacobi sweep of L t = x is t <- x - (L - I) t starting from t = x, and each one
+   of U y = t is y <- D^{-1} (t - (U - D) y) starting from y = D^{-1} t, both exact after as many
+   sweeps as the triangular factor has levels.
+*/
+static PetscErrorCode PCApply_ChowILU(PC pc,Vec x,Vec y)
+{
+  PC_ChowILU        *ilu = (PC_ChowILU*)pc->data;
+  PetscErrorCode    ierr;
+  const PetscInt    *fi = ilu->i,*fj = ilu->j,*fdiag = ilu->diag;
+  const PetscScalar *a = ilu->a,*idiag = ilu->idiag,*b;
+  PetscScalar       *yarray,*t,*tnext,*ycur,*ynext,*swap,sum;
+  PetscInt          n = ilu->n,r,p,s;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(y,&yarray);CHKERRQ(ierr);
+  if (!ilu->solvesweeps) {
+    t = ilu->work;
+    for (r=0; r<n; r++) {
+      sum = b[r];
+      for (p=fi[r]; p<fdiag[r]; p++) sum -= a[p]*t[fj[p]];
+      t[r] = sum;
+    }
+    for (r=n-1; r>=0; r--) {
+      sum = t[r];
+      for (p=fdiag[r]+1; p<fi[r+1]; p++) sum -= a[p]*yarray[fj[p]];
+      yarray[r] = sum*idiag[r];
+    }
+  } else {
+    t     = ilu->work;
+    tnext = ilu->work + n;
+    ierr  = PetscArraycpy(t,b,n);CHKERRQ(ierr);
+    for (s=0; s<ilu->solvesweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) private(p,sum)
+#endif
+      for (r=0; r<n; r++) {
+        sum = b[r];
+        for (p=fi[r]; p<fdiag[r]; p++) sum -= a[p]*t[fj[p]];
+        tnext[r] = sum;
+      }
+      swap = t; t = tnext; tnext = swap;
+    }
+    /* tnext is free for the iterates of U */
+    ycur  = yarray;
+    ynext = tnext;
+    for (r=0; r<n; r++) ycur[r] = idiag[r]*t[r];
+    for (s=0; s<ilu->solvesweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) private(p,sum)
+#endif
+      for (r=0; r<n; r++) {
+        sum = t[r];
+        for (p=fdiag[r]+1; p<fi[r+1]; p++) sum -= a[p]*ycur[fj[p]];
+        ynext[r] = idiag[r]*sum;
+      }
+      swap = ycur; ycur = ynext; ynext = swap;
+    }
+    if (ycur != yarray) {ierr = PetscArraycpy(yarray,ycur,n);CHKERRQ(ierr);}
+  }
+  ierr = VecRestoreArrayRead(x,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(y,&yarray);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*PetscMax(ilu->solvesweeps,1)*ilu->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCDestroy_ChowILU(PC pc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCReset_ChowILU(pc);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCSetFromOptions_ChowILU(PetscOptionItems *PetscOptionsObject,PC pc)
+{
+  PC_ChowILU     *ilu = (PC_ChowILU*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Chow-Patel ILU options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-pc_chowilu_sweeps","Fixed-point sweeps of the factorization","",ilu->sweeps,&ilu->sweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-pc_chowilu_solve_sweeps","Jacobi sweeps of each triangular solve, 0 for exact triangular solves","",ilu->solvesweeps,&ilu->solvesweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-pc_chowilu_levels","Levels of fill of the pattern of the factors","",ilu->levels,&ilu->levels,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  if (ilu->sweeps < 0 || ilu->solvesweeps < 0 || ilu->levels < 0) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"The numbers of sweeps and of levels cannot be negative");
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCView_ChowILU(PC pc,PetscViewer viewer)
+{
+  PC_ChowILU     *ilu = (PC_ChowILU*)pc->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  ILU(%D) pattern, %D fixed-point sweeps\n",ilu->levels,ilu->sweeps);CHKERRQ(ierr);
+    if (ilu->solvesweeps) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  %D Jacobi sweeps per triangular solve\n",ilu->solvesweeps);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIIPrintf(viewer,"  exact triangular solves\n");CHKERRQ(ierr);
+    }
+    if (ilu->nz) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  factors with %D nonzeros\n",ilu->nz);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*MC
+     PCCHOWILU - Fine-grained parallel incomplete LU factorization of Chow and Patel
+
+   Options Database Keys:
++  -pc_chowilu_sweeps <3> - fixed-point sweeps of the factorization
+.  -pc_chowilu_solve_sweeps <2> - Jacobi sweeps of each triangular solve, 0 for exact (sequential) triangular solves
+-  -pc_chowilu_levels <0> - levels of fill of the sparsity pattern of the factors
+
+   Level: intermediate
+
+   Notes:
+   Every entry of the factors is updated independently from the values of the previous sweep, so
+   the factorization and, with Jacobi sweeps, the triangular solves run in parallel over the rows
+   with OpenMP threads. With enough sweeps the factors are those of PCILU with the natural ordering.
+
+   Only handles MATSEQAIJ matrices; in parallel use it on the blocks of PCBJACOBI or PCASM.
+   PCCHOWILUVIENNACL is the same method on GPUs.
+
+   References:
+.  1. - E. Chow and A. Patel, "Fine-grained parallel incomplete LU factorization", SIAM J. Sci. Comput., 2015.
+
+.seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCILU, PCCHOWILUVIENNACL
+
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_ChowILU(PC pc)
+{
+  PetscErrorCode ierr;
+  PC_ChowILU     *ilu;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(pc,&ilu);CHKERRQ(ierr);
+
+  pc->ops->apply           = PCApply_ChowILU;
+  pc->ops->setup           = PCSetUp_ChowILU;
+  pc->ops->reset           = PCReset_ChowILU;
+  pc->ops->destroy         = PCDestroy_ChowILU;
+  pc->ops->setfromoptions  = PCSetFromOptions_ChowILU;
+  pc->ops->view            = PCView_ChowILU;
+  pc->data                 = (void*)ilu;
+  ilu->sweeps              = 3;
+  ilu->solvesweeps         = 2;
+  ilu->levels              = 0;
+  PetscFunctionReturn(0);
+}
@@ -42,7 +42,7 @@ static PetscErrorCode PCApplyTranspose_SOR(PC pc,Vec x,Vec y)
 
   PetscFunctionBegin;
   ierr = MatIsSymmetricKnown(pc->pmat,&set,&sym);CHKERRQ(ierr);
-  if (!set || !sym || (jac->sym != SOR_SYMMETRIC_SWEEP && jac->sym != SOR_LOCAL_SYMMETRIC_SWEEP)) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Can only apply transpose of SOR if matrix is symmetric and sweep is symmetric");
+  if (!set || !sym || ((jac->sym & ~SOR_MULTICOLOR) != SOR_SYMMETRIC_SWEEP && (jac->sym & ~SOR_MULTICOLOR) != SOR_LOCAL_SYMMETRIC_SWEEP)) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Can only apply transpose of SOR if matrix is symmetric and sweep is symmetric");
   ierr = MatSOR(pc->pmat,x,jac->omega,(MatSORType)flag,jac->fshift,jac->its,jac->lits,y);CHKERRQ(ierr);
   ierr = MatFactorGetError(pc->pmat,(MatFactorError*)&pc->failedreason);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -68,7 +68,7 @@ PetscErrorCode PCSetFromOptions_SOR(PetscOptionItems *PetscOptionsObject,PC pc)
 {
   PC_SOR         *jac = (PC_SOR*)pc->data;
   PetscErrorCode ierr;
-  PetscBool      flg;
+  PetscBool      flg,multicolor = (jac->sym & SOR_MULTICOLOR) ? PETSC_TRUE : PETSC_FALSE;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"(S)SOR options");CHKERRQ(ierr);
@@ -88,6 +88,9 @@ PetscErrorCode PCSetFromOptions_SOR(PetscOptionItems *PetscOptionsObject,PC pc)
   if (flg) {ierr = PCSORSetSymmetric(pc,SOR_LOCAL_BACKWARD_SWEEP);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupEnd("-pc_sor_local_forward","use forward sweep locally","PCSORSetSymmetric",&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCSORSetSymmetric(pc,SOR_LOCAL_FORWARD_SWEEP);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-pc_sor_multicolor","relax the rows one color at a time, with threads","PCSORSetSymmetric",multicolor,&multicolor,NULL);CHKERRQ(ierr);
+  if (multicolor) jac->sym = (MatSORType)(jac->sym | SOR_MULTICOLOR);
+  else            jac->sym = (MatSORType)(jac->sym & ~SOR_MULTICOLOR);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -104,6 +107,8 @@ PetscErrorCode PCView_SOR(PC pc,PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
     if (sym & SOR_ZERO_INITIAL_GUESS) {ierr = PetscViewerASCIIPrintf(viewer,"  zero initial guess\n");CHKERRQ(ierr);}
+    if (sym & SOR_MULTICOLOR) {ierr = PetscViewerASCIIPrintf(viewer,"  multicolor\n");CHKERRQ(ierr);}
+    sym = (MatSORType)(sym & ~SOR_MULTICOLOR);
     if (sym == SOR_APPLY_UPPER)                                              sortype = "apply_upper";
     else if (sym == SOR_APPLY_LOWER)                                         sortype = "apply_lower";
     else if (sym & SOR_EISENSTAT)                                            sortype = "Eisenstat";
@@ -306,13 +311,15 @@ PetscErrorCode  PCSORGetIterations(PC pc,PetscInt *its,PetscInt *lits)
     SOR_LOCAL_BACKWARD_SWEEP
     SOR_LOCAL_SYMMETRIC_SWEEP
 .ve
+   possibly or'ed with SOR_MULTICOLOR
 
    Options Database Keys:
 +  -pc_sor_symmetric - Activates symmetric version
 .  -pc_sor_backward - Activates backward version
 .  -pc_sor_local_forward - Activates local forward version
 .  -pc_sor_local_symmetric - Activates local symmetric version
--  -pc_sor_local_backward - Activates local backward version
+.  -pc_sor_local_backward - Activates local backward version
+-  -pc_sor_multicolor - Relaxes the rows one color at a time, see MatSOR()
 
    Notes:
    To use the Eisenstat trick with SSOR, employ the PCEISENSTAT preconditioner,
@@ -405,6 +412,7 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
 .  -pc_sor_local_forward - Activates local forward version
 .  -pc_sor_local_symmetric - Activates local symmetric version  (default version)
 .  -pc_sor_local_backward - Activates local backward version
+.  -pc_sor_multicolor - Relaxes the rows one color of a distance one coloring at a time, the rows of a color with OpenMP threads
 .  -pc_sor_omega <omega> - Sets omega
 .  -pc_sor_diagonal_shift <shift> - shift the diagonal entries; useful if the matrix has zeros on the diagonal
 .  -pc_sor_its <its> - Sets number of iterations   (default 1)
@@ -424,6 +432,10 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
 
           For SeqBAIJ matrices this implements point-block SOR, but the omega, its, lits options are not supported.
 
+          -pc_sor_multicolor is only supported for AIJ matrices; it ignores the inodes and so does pointwise
+          SOR. The multicolor sweeps have no loop-carried dependency between the rows of a color which makes
+          them a threaded smoother for PCMG.
+
           For SeqBAIJ the diagonal blocks are inverted using dense LU with partial pivoting. If a zero pivot is detected 
           the computation is stopped with an error
 
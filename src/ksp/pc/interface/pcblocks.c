@@ -0,0 +1,102 @@
+
+/*
+   Set up and solves of the independent local blocks of PCBJACOBI and PCASM.
+
+   With concurrent set, and PETSc configured with OpenMP and --with-threadsafety, each block is an OpenMP task;
+   the threads of the team take the tasks and steal them from each other when idle. A block is still processed by a
+   single thread exactly as in the sequential loop, and what the blocks share, the failed reason of the PC, is updated
+   afterwards in the order of the blocks, so the results do not depend on the number of threads or on the schedule.
+   Without such a configuration the blocks are processed one after another.
+*/
+#include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+#define PC_BLOCKS_CONCURRENT 1
+#endif
+
+#if defined(PC_BLOCKS_CONCURRENT)
+/* returns the first error of the blocks, after freeing the error codes */
+static PetscErrorCode PCBlocksCheckErrors_Private(PetscInt n,PetscErrorCode **errs)
+{
+  PetscErrorCode ierr,err = 0;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  for (i=0; i<n && !err; i++) err = (*errs)[i];
+  ierr = PetscFree(*errs);CHKERRQ(ierr);
+  PetscFunctionReturn(err);
+}
+#endif
+
+PetscErrorCode PCSetUpBlocks_Private(PC pc,PetscBool concurrent,PetscInt n,KSP ksp[])
+{
+  PetscErrorCode     ierr;
+  PetscInt           i;
+  KSPConvergedReason reason;
+
+  PetscFunctionBegin;
+#if defined(PC_BLOCKS_CONCURRENT)
+  if (concurrent && n > 1) {
+    PetscErrorCode *errs;
+
+    ierr = PetscMalloc1(n,&errs);CHKERRQ(ierr);
+#pragma omp parallel
+#pragma omp single
+    for (i=0; i<n; i++) {
+#pragma omp task firstprivate(i)
+      errs[i] = KSPSetUp(ksp[i]);
+    }
+    ierr = PCBlocksCheckErrors_Private(n,&errs);CHKERRQ(ierr);
+  } else
+#endif
+  {
+    for (i=0; i<n; i++) {
+      ierr = KSPSetUp(ksp[i]);CHKERRQ(ierr);
+    }
+  }
+  for (i=0; i<n; i++) {
+    ierr = KSPGetConvergedReason(ksp[i],&reason);CHKERRQ(ierr);
+    if (reason == KSP_DIVERGED_PC_FAILED) {
+      pc->failedreason = PC_SUBPC_ERROR;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PCSolveBlocks_Private(PC pc,PetscBool concurrent,PetscBool transpose,PetscInt n,KSP ksp[],Vec x[],Vec y[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscLogEvent  event = transpose ? PC_ApplyTransposeOnBlocks : PC_ApplyOnBlocks;
+
+  PetscFunctionBegin;
+#if defined(PC_BLOCKS_CONCURRENT)
+  if (concurrent && n > 1) {
+    PetscErrorCode *errs;
+
+    ierr = PetscMalloc1(n,&errs);CHKERRQ(ierr);
+#pragma omp parallel
+#pragma omp single
+    for (i=0; i<n; i++) {
+#pragma omp task firstprivate(i)
+      errs[i] = transpose ? KSPSolveTranspose(ksp[i],x[i],y[i]) : KSPSolve(ksp[i],x[i],y[i]);
+    }
+    ierr = PCBlocksCheckErrors_Private(n,&errs);CHKERRQ(ierr);
+    for (i=0; i<n; i++) {
+      ierr = KSPCheckSolve(ksp[i],pc,y[i]);CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
+#endif
+  for (i=0; i<n; i++) {
+    ierr = PetscLogEventBegin(event,ksp[i],x[i],y[i],0);CHKERRQ(ierr);
+    if (transpose) {
+      ierr = KSPSolveTranspose(ksp[i],x[i],y[i]);CHKERRQ(ierr);
+    } else {
+      ierr = KSPSolve(ksp[i],x[i],y[i]);CHKERRQ(ierr);
+    }
+    ierr = KSPCheckSolve(ksp[i],pc,y[i]);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(event,ksp[i],x[i],y[i],0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -58,6 +58,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_PARMS(PC);
 #endif
 PETSC_EXTERN PetscErrorCode PCCreate_BDDC(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_Deflation(PC);
+PETSC_EXTERN PetscErrorCode PCCreate_ChowILU(PC);
 #if defined(PETSC_HAVE_HPDDM)
 PETSC_EXTERN PetscErrorCode PCCreate_HPDDM(PC);
 #endif
@@ -142,5 +143,6 @@ PetscErrorCode  PCRegisterAll(void)
 #if defined(PETSC_HAVE_HPDDM)
   ierr = PCRegister(PCHPDDM        ,PCCreate_HPDDM);CHKERRQ(ierr);
 #endif
+  ierr = PCRegister(PCCHOWILU      ,PCCreate_ChowILU);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -0,0 +1,124 @@
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO().\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckEqual(Mat A,Mat B,const char *msg)
+{
+  PetscErrorCode ierr;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  ierr = MatEqual(A,B,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"Matrices differ after %s\n",msg);CHKERRQ(ierr);}
+  ierr = MatMultEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"MatMult() differs after %s\n",msg);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       n = 4,bs = 1,m,M,rstart,rend,i,k,ncoo,*coo_i,*coo_j;
+  PetscScalar    *coo_v;
+  PetscMPIInt    rank,size;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  m    = n*bs;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,m,m,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MPI_Scan(&m,&rend,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  rstart = rend - m;
+  M      = m*size;
+
+  /* a 3-point stencil on the local rows with a repeated diagonal, an ignored entry and entries for rows of the next process */
+  ncoo = 4*m + 3;
+  ierr = PetscMalloc3(ncoo,&coo_i,ncoo,&coo_j,ncoo,&coo_v);CHKERRQ(ierr);
+  for (i=rstart,k=0; i<rend; i++) {
+    coo_i[k] = i; coo_j[k] = (i+M-1)%M; k++;
+    coo_i[k] = i; coo_j[k] = i;         k++;
+    coo_i[k] = i; coo_j[k] = (i+1)%M;   k++;
+    coo_i[k] = i; coo_j[k] = i;         k++;
+  }
+  coo_i[k] = -1;     coo_j[k] = rstart;      k++;
+  coo_i[k] = rend%M; coo_j[k] = rend%M;      k++;
+  coo_i[k] = rend%M; coo_j[k] = (rend+2)%M;  k++;
+  for (k=0; k<ncoo; k++) coo_v[k] = (PetscScalar)(k + 100*rank + 1);
+
+  ierr = MatSetPreallocationCOO(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+
+  /* the same matrix assembled with MatSetValues() */
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_LOCATION_ERR,PETSC_TRUE);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    ierr = MatSetValues(B,1,coo_i+k,1,coo_j+k,coo_v+k,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = CheckEqual(A,B,"INSERT_VALUES");CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = CheckEqual(A,B,"ADD_VALUES");CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatScale(B,0.5);CHKERRQ(ierr);
+  ierr = CheckEqual(A,B,"second INSERT_VALUES");CHKERRQ(ierr);
+
+  /* a second preallocation replaces the first */
+  ierr = MatSetPreallocationCOO(A,4*m,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&B);CHKERRQ(ierr);
+  for (k=0; k<4*m; k++) {
+    ierr = MatSetValues(B,1,coo_i+k,1,coo_j+k,coo_v+k,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = CheckEqual(A,B,"second preallocation");CHKERRQ(ierr);
+
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     suffix: aij
+     output_file: output/ex236_1.out
+     args: -mat_type aij
+
+   test:
+     suffix: aij_par
+     nsize: 3
+     output_file: output/ex236_1.out
+     args: -mat_type aij
+
+   test:
+     suffix: baij
+     output_file: output/ex236_1.out
+     args: -mat_type baij -bs 2
+
+   test:
+     suffix: baij_par
+     nsize: 3
+     output_file: output/ex236_1.out
+     args: -mat_type baij -bs 3
+
+   test:
+     suffix: dense
+     nsize: 2
+     output_file: output/ex236_1.out
+     args: -mat_type dense
+
+TEST*/
@@ -0,0 +1,130 @@
+static char help[] = "Benchmarks MatLoad() and VecLoad() with and without MPI-IO and checks that both give the same objects.\n\n\
+Run with -log_view to compare the stages, or -view_timing to print the load times.\n\
+  -n <n>     : the matrix is a 5-point stencil on an n x n grid with bs unknowns per grid point\n\
+  -bs <bs>   : block size\n\
+  -f <file>  : name of the binary file written and read back\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode LoadFromFile(const char file[],PetscBool usempiio,MatType mtype,PetscInt bs,Mat *B,Vec *y)
+{
+  PetscErrorCode ierr;
+  PetscViewer    viewer;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerCreate(PETSC_COMM_WORLD,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerSetType(viewer,PETSCVIEWERBINARY);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetUseMPIIO(viewer,usempiio);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetSkipInfo(viewer,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = PetscViewerFileSetMode(viewer,FILE_MODE_READ);CHKERRQ(ierr);
+  ierr = PetscViewerFileSetName(viewer,file);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,B);CHKERRQ(ierr);
+  ierr = MatSetType(*B,mtype);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(*B,bs);CHKERRQ(ierr);
+  ierr = MatLoad(*B,viewer);CHKERRQ(ierr);
+  ierr = MatCreateVecs(*B,y,NULL);CHKERRQ(ierr);
+  ierr = VecLoad(*y,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B[2];
+  Vec            x,y[2];
+  PetscViewer    viewer;
+  PetscRandom    rand;
+  MatType        mtype;
+  PetscInt       n = 10,bs = 1,N,i,rstart,rend,cols[5],ncols,k;
+  PetscScalar    vals[5];
+  PetscLogStage  stage[2];
+  PetscLogDouble t0,t1,tl,tg[2];
+  PetscBool      flg,view_timing = PETSC_FALSE;
+  char           file[PETSC_MAX_PATH_LEN] = "ex237.dat";
+  const char     *name[2] = {"POSIX","MPI-IO"};
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,NULL,"-f",file,sizeof(file),NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-view_timing",&view_timing,NULL);CHKERRQ(ierr);
+  N    = n*n*bs;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATMPIAIJ);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ncols = 0;
+    if (i >= n*bs)   {cols[ncols] = i-n*bs; vals[ncols++] = -1.0;}
+    if (i >= bs)     {cols[ncols] = i-bs;   vals[ncols++] = -1.0;}
+    cols[ncols] = i; vals[ncols++] = 4.0 + i%bs;
+    if (i+bs < N)    {cols[ncols] = i+bs;   vals[ncols++] = -1.0;}
+    if (i+n*bs < N)  {cols[ncols] = i+n*bs; vals[ncols++] = -1.0;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,file,FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+  ierr = MatView(A,viewer);CHKERRQ(ierr);
+  ierr = VecView(x,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  /* the first process reads and distributes everything, then every process reads its own part */
+  ierr = MatGetType(A,&mtype);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = PetscLogStageRegister(k ? "Load MPI-IO" : "Load POSIX",&stage[k]);CHKERRQ(ierr);
+    ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRQ(ierr);
+    ierr = PetscLogStagePush(stage[k]);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    ierr = LoadFromFile(file,(PetscBool)k,mtype,bs,&B[k],&y[k]);CHKERRQ(ierr);
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    ierr = PetscLogStagePop();CHKERRQ(ierr);
+    tl   = t1 - t0;
+    ierr = MPIU_Allreduce(&tl,&tg[k],1,MPIU_PETSCLOGDOUBLE,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+
+    ierr = MatEqual(A,B[k],&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Matrix loaded with %s differs\n",name[k]);CHKERRQ(ierr);}
+    ierr = VecEqual(x,y[k],&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Vector loaded with %s differs\n",name[k]);CHKERRQ(ierr);}
+  }
+  if (view_timing) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"MatLoad()+VecLoad() of %D rows: %s %g s, %s %g s\n",N,name[0],tg[0],name[1],tg[1]);CHKERRQ(ierr);
+  }
+
+  for (k=0; k<2; k++) {
+    ierr = MatDestroy(&B[k]);CHKERRQ(ierr);
+    ierr = VecDestroy(&y[k]);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     suffix: aij
+     nsize: {{1 3}}
+     output_file: output/ex237_1.out
+     args: -f ex237_aij.dat
+
+   test:
+     suffix: baij
+     nsize: {{1 2}}
+     output_file: output/ex237_1.out
+     args: -mat_type mpibaij -bs 3 -n 7 -f ex237_baij.dat
+
+TEST*/
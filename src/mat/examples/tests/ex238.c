@@ -0,0 +1,124 @@
+static char help[] = "Checks that MatMult(), MatMultAdd(), MatSOR() and ILU(0) solves with MATAIJMIXED agree with MATAIJ to single precision.\n\
+  -n <n> : the matrix is a 5-point stencil on an n x n grid\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckAgree(const char op[],Vec y,Vec ymixed)
+{
+  PetscErrorCode ierr;
+  PetscReal      norm,err;
+  Vec            r;
+
+  PetscFunctionBegin;
+  ierr = VecDuplicate(y,&r);CHKERRQ(ierr);
+  ierr = VecWAXPY(r,-1.0,y,ymixed);CHKERRQ(ierr);
+  ierr = VecNorm(r,NORM_2,&err);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&norm);CHKERRQ(ierr);
+  if (err > 1.e-5*norm) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: relative difference %g\n",op,(double)(err/norm));CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&r);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,F,Fmixed;
+  Vec            x,b,y,ymixed;
+  PetscRandom    rand;
+  IS             isrow,iscol;
+  MatFactorInfo  info;
+  PetscInt       n = 10,N,i,rstart,rend,cols[5],ncols;
+  PetscScalar    vals[5];
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  N    = n*n;
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,5,NULL,2,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ncols = 0;
+    if (i >= n)        {cols[ncols] = i-n; vals[ncols++] = -1.0;}
+    if (i%n)           {cols[ncols] = i-1; vals[ncols++] = -1.0;}
+    cols[ncols] = i; vals[ncols++] = 4.0 + 0.1*(i%7);
+    if ((i+1)%n)       {cols[ncols] = i+1; vals[ncols++] = -1.0;}
+    if (i+n < N)       {cols[ncols] = i+n; vals[ncols++] = -1.0;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATAIJMIXED,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&ymixed);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,ymixed);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMult",y,ymixed);CHKERRQ(ierr);
+
+  ierr = MatMultAdd(A,x,b,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,b,ymixed);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMultAdd",y,ymixed);CHKERRQ(ierr);
+
+  /* the values change after the first product, so the single precision copy must be refreshed */
+  ierr = MatScale(A,2.0);CHKERRQ(ierr);
+  ierr = MatScale(B,2.0);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,ymixed);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMult after MatScale",y,ymixed);CHKERRQ(ierr);
+
+  ierr = MatSOR(A,b,1.0,(MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_LOCAL_SYMMETRIC_SWEEP),0.0,2,1,y);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,1.0,(MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_LOCAL_SYMMETRIC_SWEEP),0.0,2,1,ymixed);CHKERRQ(ierr);
+  ierr = CheckAgree("MatSOR",y,ymixed);CHKERRQ(ierr);
+
+  if (size == 1) {
+    ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+    info.fill = 1.0;
+    ierr = MatGetOrdering(A,MATORDERINGRCM,&isrow,&iscol);CHKERRQ(ierr);
+    ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(F,A,isrow,iscol,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+    ierr = MatGetFactor(B,MATSOLVERPETSC,MAT_FACTOR_ILU,&Fmixed);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(Fmixed,B,isrow,iscol,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(Fmixed,B,&info);CHKERRQ(ierr);
+    ierr = MatSolve(F,b,y);CHKERRQ(ierr);
+    ierr = MatSolve(Fmixed,b,ymixed);CHKERRQ(ierr);
+    ierr = CheckAgree("MatSolve",y,ymixed);CHKERRQ(ierr);
+    ierr = MatDestroy(&F);CHKERRQ(ierr);
+    ierr = MatDestroy(&Fmixed);CHKERRQ(ierr);
+    ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+    ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  }
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&ymixed);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     nsize: {{1 2}}
+     output_file: output/ex238_1.out
+
+   test:
+     suffix: long_indices
+     output_file: output/ex238_1.out
+     args: -mat_aijmixed_short_indices 0
+
+TEST*/
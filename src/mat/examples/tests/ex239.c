@@ -0,0 +1,127 @@
+static char help[] = "Checks the products of MATAIJDELTA against MATAIJ, with rows whose columns span more than 65536 columns.\n\
+  -n <n> : the matrix is a 5-point stencil on an n x n grid, with every tenth row coupled to an unknown 70000 rows away\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckAgree(const char op[],Vec y,Vec ydelta)
+{
+  PetscErrorCode ierr;
+  PetscReal      norm,err;
+  Vec            r;
+
+  PetscFunctionBegin;
+  ierr = VecDuplicate(y,&r);CHKERRQ(ierr);
+  ierr = VecWAXPY(r,-1.0,y,ydelta);CHKERRQ(ierr);
+  ierr = VecNorm(r,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: relative difference %g\n",op,(double)(err/norm));CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&r);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckProducts(Mat A,Mat B,PetscRandom rand)
+{
+  PetscErrorCode ierr;
+  Vec            x,b,y,ydelta,xt,yt,ytdelta;
+
+  PetscFunctionBegin;
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&ydelta);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&yt,&xt);CHKERRQ(ierr);
+  ierr = VecDuplicate(yt,&ytdelta);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(xt,rand);CHKERRQ(ierr);
+
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,ydelta);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMult",y,ydelta);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,b,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,b,ydelta);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMultAdd",y,ydelta);CHKERRQ(ierr);
+  ierr = MatMultTranspose(A,xt,yt);CHKERRQ(ierr);
+  ierr = MatMultTranspose(B,xt,ytdelta);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMultTranspose",yt,ytdelta);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(A,xt,yt,yt);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(B,xt,ytdelta,ytdelta);CHKERRQ(ierr);
+  ierr = CheckAgree("MatMultTransposeAdd",yt,ytdelta);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&ydelta);CHKERRQ(ierr);
+  ierr = VecDestroy(&xt);CHKERRQ(ierr);
+  ierr = VecDestroy(&yt);CHKERRQ(ierr);
+  ierr = VecDestroy(&ytdelta);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscRandom    rand;
+  PetscInt       n = 300,N,i,rstart,rend,cols[7],ncols;
+  PetscScalar    vals[7];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  N    = n*n;
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,7,NULL,7,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ncols = 0;
+    if (i >= n)        {cols[ncols] = i-n; vals[ncols++] = -1.0;}
+    if (i%n)           {cols[ncols] = i-1; vals[ncols++] = -1.0;}
+    cols[ncols] = i; vals[ncols++] = 4.0 + 0.1*(i%7);
+    if ((i+1)%n)       {cols[ncols] = i+1; vals[ncols++] = -1.0;}
+    if (i+n < N)       {cols[ncols] = i+n; vals[ncols++] = -1.0;}
+    /* every tenth row is coupled to an unknown far away, so it needs wider offsets */
+    if (!(i%10) && (i+70000)%N > i+n) {cols[ncols] = (i+70000)%N; vals[ncols++] = 0.5;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATAIJDELTA,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = CheckProducts(A,B,rand);CHKERRQ(ierr);
+
+  /* a new nonzero location must recompute the offsets */
+  if (!rstart) {
+    cols[0] = N-1; vals[0] = 1.0;
+    ierr = MatSetValues(A,1,&rstart,1,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+    ierr = MatSetValues(B,1,&rstart,1,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = CheckProducts(A,B,rand);CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     nsize: {{1 3}}
+     output_file: output/ex239_1.out
+
+   test:
+     suffix: portable
+     output_file: output/ex239_1.out
+     args: -simd_level none
+
+TEST*/
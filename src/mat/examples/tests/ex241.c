@@ -0,0 +1,147 @@
+static char help[] = "Tests the selection of the MatMult() storage at assembly with -mat_aij_select_format.\n\
+  -n <n>   : the matrix is a 5-point stencil on an n x n grid with bs unknowns per grid point\n\
+  -bs <bs> : block size, the rows of a block form an I-node\n\
+  -expect <type> : check the type selected for the matrix, on one process; seqaijsell is only expected\n\
+                   when the kernels may use AVX, the heuristic keeps seqaij otherwise\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode AssembleStencil(Mat A,PetscInt n,PetscInt bs)
+{
+  PetscErrorCode ierr;
+  PetscInt       rstart,rend,row,col,g,k,l,nb[5],nnb;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    g   = row/bs;
+    nnb = 0;
+    if (g >= n)      nb[nnb++] = g-n;
+    if (g%n)         nb[nnb++] = g-1;
+    nb[nnb++] = g;
+    if ((g+1)%n)     nb[nnb++] = g+1;
+    if (g+n < n*n)   nb[nnb++] = g+n;
+    for (k=0; k<nnb; k++) {
+      for (l=0; l<bs; l++) {
+        PetscScalar v = (nb[k] == g) ? 4.0 + 0.1*l + (row == nb[k]*bs+l) : -1.0/(1+l);
+        col  = nb[k]*bs + l;
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  Vec            x,y,yref;
+  PetscRandom    rand;
+  PetscInt       n = 20,bs = 1,N;
+  PetscReal      norm,err;
+  PetscBool      view = PETSC_FALSE,flg,match;
+  char           expect[256];
+  PetscSIMDLevel level;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-view_info",&view,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,NULL,"-expect",expect,sizeof(expect),&flg);CHKERRQ(ierr);
+  N    = n*n*bs;
+
+  /* A selects its storage, B uses another prefix and stays a plain MATAIJ for the reference products */
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,5*bs,NULL,2*bs,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = AssembleStencil(A,n,bs);CHKERRQ(ierr);
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,5*bs,NULL,2*bs,NULL,&B);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(B,"ref_");CHKERRQ(ierr);
+  ierr = AssembleStencil(B,n,bs);CHKERRQ(ierr);
+  if (view) {
+    Mat C;
+
+    ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_WORLD,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+    ierr = MatView(A,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+    /* the product is assembled by the library, it does not select its storage */
+    ierr = MatMatMult(A,A,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+    ierr = MatView(C,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+    ierr = MatDestroy(&C);CHKERRQ(ierr);
+    ierr = PetscViewerPopFormat(PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  }
+
+  if (flg) {
+    ierr = PetscStrcmp(expect,MATSEQAIJSELL,&match);CHKERRQ(ierr);
+    ierr = PetscSIMDGetLevel(&level);CHKERRQ(ierr);
+    if (match && level < PETSC_SIMD_AVX) {ierr = PetscStrcpy(expect,MATSEQAIJ);CHKERRQ(ierr);}
+    ierr = PetscObjectTypeCompare((PetscObject)A,expect,&match);CHKERRQ(ierr);
+    if (!match) {
+      MatType type;
+      ierr = MatGetType(A,&type);CHKERRQ(ierr);
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Storage %s selected instead of %s\n",type,expect);CHKERRQ(ierr);
+    }
+  }
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&yref);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,yref);CHKERRQ(ierr);
+  ierr = VecNorm(yref,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,yref);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&err);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult() with the selected storage differs by %g\n",(double)(err/norm));CHKERRQ(ierr);
+  }
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&yref);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     suffix: heuristic
+     requires: !define(PETSC_USE_64BIT_INDICES)
+     args: -mat_aij_select_format heuristic -simd_level none -view_info
+
+   test:
+     suffix: heuristic_inode
+     requires: !define(PETSC_USE_64BIT_INDICES)
+     args: -mat_aij_select_format heuristic -bs 3 -view_info
+
+   test:
+     suffix: heuristic_mpi
+     nsize: 2
+     requires: !define(PETSC_USE_64BIT_INDICES)
+     args: -mat_aij_select_format heuristic -simd_level none -view_info
+
+   test:
+     suffix: sell
+     requires: !define(PETSC_USE_64BIT_INDICES)
+     output_file: output/ex241_timed.out
+     args: -mat_aij_select_format heuristic -expect seqaijsell
+
+   test:
+     suffix: delta
+     requires: define(PETSC_USE_64BIT_INDICES)
+     output_file: output/ex241_timed.out
+     args: -mat_aij_select_format heuristic -expect seqaijdelta
+
+   test:
+     suffix: timed
+     nsize: {{1 2}}
+     output_file: output/ex241_timed.out
+     args: -mat_aij_select_format timed -mat_aij_select_format_its 2
+
+TEST*/
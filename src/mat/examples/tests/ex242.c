@@ -0,0 +1,126 @@
+static char help[] = "Checks MatMatMult() of AIJ and BAIJ matrices with a dense matrix against MatMult() on each column.\n\
+  -n <n>   : the matrix is a 5-point stencil on an n x n grid with bs unknowns per grid point\n\
+  -bs <bs> : block size\n\
+  -k <k>   : number of columns of the dense matrix\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckMatMatMult(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,col;
+  PetscReal      norm,err;
+  Vec            x,y,yref;
+  MatType        type;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(B,NULL,&k);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&yref);CHKERRQ(ierr);
+  for (col=0; col<k; col++) {
+    ierr = MatGetColumnVector(B,x,col);CHKERRQ(ierr);
+    ierr = MatGetColumnVector(C,yref,col);CHKERRQ(ierr);
+    ierr = VecDuplicate(yref,&y);CHKERRQ(ierr);
+    ierr = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    ierr = VecAXPY(y,-1.0,yref);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_INFINITY,&err);CHKERRQ(ierr);
+    if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+      ierr = MatGetType(A,&type);CHKERRQ(ierr);
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: column %D of MatMatMult() has relative difference %g\n",type,col,(double)(err/norm));CHKERRQ(ierr);
+    }
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&yref);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,Ab,B,C;
+  PetscRandom    rand;
+  PetscInt       n = 12,bs = 2,k = 21,N,nloc,row,col,g,l,nb[5],nnb,i,rstart,rend;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+  N    = n*n*bs;
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,5*bs,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,5*bs,NULL,4*bs,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    g   = row/bs;
+    nnb = 0;
+    if (g >= n)    nb[nnb++] = g-n;
+    if (g%n)       nb[nnb++] = g-1;
+    nb[nnb++] = g;
+    if ((g+1)%n)   nb[nnb++] = g+1;
+    if (g+n < n*n) nb[nnb++] = g+n;
+    for (i=0; i<nnb; i++) {
+      for (l=0; l<bs; l++) {
+        col  = nb[i]*bs + l;
+        v    = (col == row) ? 4.0 + 0.1*l : -1.0/(1 + l + row%bs);
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATBAIJ,MAT_INITIAL_MATRIX,&Ab);CHKERRQ(ierr);
+
+  ierr = MatGetLocalSize(A,NULL,&nloc);CHKERRQ(ierr);
+  ierr = MatCreateDense(PETSC_COMM_WORLD,nloc,PETSC_DECIDE,N,k,NULL,&B);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+
+  ierr = MatMatMult(A,B,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = CheckMatMatMult(A,B,C);CHKERRQ(ierr);
+  /* new values of B must be sent again */
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+  ierr = MatMatMult(A,B,MAT_REUSE_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = CheckMatMatMult(A,B,C);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+
+  ierr = MatMatMult(Ab,B,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = CheckMatMatMult(Ab,B,C);CHKERRQ(ierr);
+  ierr = MatSetRandom(B,rand);CHKERRQ(ierr);
+  ierr = MatMatMult(Ab,B,MAT_REUSE_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = CheckMatMatMult(Ab,B,C);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&Ab);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     nsize: {{1 3}}
+     output_file: output/ex242_1.out
+
+   test:
+     suffix: 2
+     nsize: {{1 2}}
+     output_file: output/ex242_1.out
+     args: -bs 3 -k 3
+
+   test:
+     suffix: 3
+     nsize: 3
+     output_file: output/ex242_1.out
+     args: -bs 1 -k 5 -matmatmult_Bbn 2
+
+TEST*/
@@ -0,0 +1,149 @@
+static char help[] = "Tests the level scheduled triangular solves of ILU factors of AIJ and BAIJ matrices, -mat_factor_solve_levels.\n\
+  -n <n>        : the matrix is a 5-point stencil on an n x n grid with bs unknowns per grid point\n\
+  -bs <bs>      : block size\n\
+  -ordering <o> : ordering of the AIJ factors, BAIJ factors always use the natural ordering\n\
+  -levels <l>   : levels of fill of the ILU factorization\n\n";
+
+#include <petscmat.h>
+
+/* the factors with the prefix lev_ use the level scheduled solves when the tests run with -lev_mat_factor_solve_levels */
+static PetscErrorCode CheckSolve(Mat A,MatOrderingType ordering,PetscInt levels,PetscRandom rand)
+{
+  PetscErrorCode ierr;
+  Mat            F,Flev;
+  IS             row,col;
+  MatFactorInfo  info;
+  Vec            b,x,xlev,xlev2;
+  PetscReal      norm,err;
+  PetscBool      equal,isaij;
+  MatType        type;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  ierr = MatGetType(A,&type);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isaij);CHKERRQ(ierr);
+  ierr = MatGetOrdering(A,ordering,&row,&col);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.fill   = 1.0;
+  info.levels = levels;
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,&Flev);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(Flev,"lev_");CHKERRQ(ierr);
+  /* the reference AIJ factor solves with MatSolve_SeqAIJ(), whose operations the level scheduled solve repeats, rather than by I-nodes */
+  if (isaij) {ierr = MatSetOption(F,MAT_USE_INODES,PETSC_FALSE);CHKERRQ(ierr);}
+  ierr = MatILUFactorSymbolic(F,A,row,col,&info);CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic(Flev,A,row,col,&info);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xlev);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xlev2);CHKERRQ(ierr);
+
+  /* the second numeric factorization recomputes the levels */
+  for (k=0; k<2; k++) {
+    ierr = MatLUFactorNumeric(F,A,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(Flev,A,&info);CHKERRQ(ierr);
+    ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+    ierr = MatSolve(F,b,x);CHKERRQ(ierr);
+    ierr = MatSolve(Flev,b,xlev);CHKERRQ(ierr);
+    ierr = MatSolve(Flev,b,xlev2);CHKERRQ(ierr);
+    ierr = VecEqual(xlev,xlev2,&equal);CHKERRQ(ierr);
+    if (!equal) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %s: two solves with the same factor differ\n",type,ordering);CHKERRQ(ierr);
+    }
+    if (isaij) {
+      ierr = VecEqual(x,xlev,&equal);CHKERRQ(ierr);
+      if (!equal) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %s: the level scheduled solve differs from MatSolve()\n",type,ordering);CHKERRQ(ierr);
+      }
+    } else {
+      /* the level scheduled BAIJ solve writes out the block kernels that MatSolve() leaves to BLAS or to kernels unrolled
+         for the block size, so the sums are formed in another order and may differ in the last bits */
+      ierr = VecNorm(x,NORM_INFINITY,&norm);CHKERRQ(ierr);
+      ierr = VecAXPY(xlev,-1.0,x);CHKERRQ(ierr);
+      ierr = VecNorm(xlev,NORM_INFINITY,&err);CHKERRQ(ierr);
+      if (err > PETSC_SMALL*norm) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"%s %s: the level scheduled solve has relative difference %g\n",type,ordering,(double)(err/norm));CHKERRQ(ierr);
+      }
+    }
+  }
+
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&xlev);CHKERRQ(ierr);
+  ierr = VecDestroy(&xlev2);CHKERRQ(ierr);
+  ierr = ISDestroy(&row);CHKERRQ(ierr);
+  ierr = ISDestroy(&col);CHKERRQ(ierr);
+  ierr = MatDestroy(&F);CHKERRQ(ierr);
+  ierr = MatDestroy(&Flev);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,Ab;
+  PetscRandom    rand;
+  PetscInt       n = 30,bs = 3,levels = 0,N,row,col,g,l,nb[5],nnb,i;
+  PetscScalar    v;
+  char           ordering[256] = MATORDERINGNATURAL;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-levels",&levels,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,NULL,"-ordering",ordering,sizeof(ordering),NULL);CHKERRQ(ierr);
+  N    = n*n*bs;
+
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,N,N,5*bs,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  /* without I-nodes in A, which the ILU(0) factors inherit, both AIJ factors are computed by MatLUFactorNumeric_SeqAIJ() */
+  ierr = MatSetOption(A,MAT_USE_INODES,PETSC_FALSE);CHKERRQ(ierr);
+  for (row=0; row<N; row++) {
+    g   = row/bs;
+    nnb = 0;
+    if (g >= n)    nb[nnb++] = g-n;
+    if (g%n)       nb[nnb++] = g-1;
+    nb[nnb++] = g;
+    if ((g+1)%n)   nb[nnb++] = g+1;
+    if (g+n < n*n) nb[nnb++] = g+n;
+    for (i=0; i<nnb; i++) {
+      for (l=0; l<bs; l++) {
+        col  = nb[i]*bs + l;
+        v    = (col == row) ? 4.0 + 0.1*l : -1.0/(1 + l + row%bs + (nb[i] > g));
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATSEQBAIJ,MAT_INITIAL_MATRIX,&Ab);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = CheckSolve(A,ordering,levels,rand);CHKERRQ(ierr);
+  ierr = CheckSolve(Ab,MATORDERINGNATURAL,levels,rand);CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&Ab);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex243_1.out
+     args: -lev_mat_factor_solve_levels -ordering {{natural rcm}} -levels {{0 2}}
+
+   test:
+     suffix: 2
+     output_file: output/ex243_1.out
+     args: -lev_mat_factor_solve_levels -bs {{1 2 4 5 8}} -levels 1
+
+   test:
+     suffix: openmp
+     requires: openmp
+     output_file: output/ex243_1.out
+     args: -lev_mat_factor_solve_levels -omp_num_threads {{1 3 4}} -bs {{1 3}} -ordering rcm -levels 1
+
+TEST*/
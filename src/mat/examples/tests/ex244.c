@@ -0,0 +1,137 @@
+static char help[] = "Tests MatSOR() with SOR_MULTICOLOR against lexicographic SOR of the matrix permuted by color.\n\
+  -n <n>        : the matrix is a 5-point stencil on an n x n grid\n\
+  -nonsymmetric : adds couplings in one direction only, so the structure is not symmetric\n\
+  -omega <w>    : relaxation factor\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat                   A,G,Ap,B;
+  MatColoring           mc;
+  ISColoring            iscoloring;
+  IS                    perm;
+  const ISColoringValue *colors;
+  Vec                   b,x,bp,xp,xref;
+  PetscRandom           rand;
+  PetscInt              n = 12,N,i,j,k,nc,*idx,cols[6],ncols,its;
+  PetscScalar           vals[6],*xa,*xpa;
+  const PetscScalar     *ba,*xpra;
+  PetscReal             omega = 1.3,norm,err;
+  PetscBool             nonsymmetric = PETSC_FALSE,equal;
+  MatSORType            sweeps[] = {SOR_FORWARD_SWEEP,SOR_BACKWARD_SWEEP,SOR_SYMMETRIC_SWEEP},flag;
+  PetscErrorCode        ierr,serr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-nonsymmetric",&nonsymmetric,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-omega",&omega,NULL);CHKERRQ(ierr);
+  N    = n*n;
+
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,N,N,6,NULL,&A);CHKERRQ(ierr);
+  for (i=0; i<N; i++) {
+    ncols = 0;
+    if (i >= n)    {cols[ncols] = i-n; vals[ncols++] = -1.0;}
+    if (i%n)       {cols[ncols] = i-1; vals[ncols++] = -1.1;}
+    cols[ncols] = i; vals[ncols++] = 4.5 + 0.1*(i%3);
+    if ((i+1)%n)   {cols[ncols] = i+1; vals[ncols++] = -0.9;}
+    if (i+n < N)   {cols[ncols] = i+n; vals[ncols++] = -1.0;}
+    if (nonsymmetric && !(i%3) && i+2*n+1 < N) {cols[ncols] = i+2*n+1; vals[ncols++] = -0.3;}
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  /* the same coloring as MatSOR() computes, the rows sorted by color give the reference ordering */
+  ierr = MatTranspose(A,MAT_INITIAL_MATRIX,&G);CHKERRQ(ierr);
+  ierr = MatAXPY(G,1.0,A,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatColoringCreate(G,&mc);CHKERRQ(ierr);
+  ierr = MatColoringSetType(mc,MATCOLORINGGREEDY);CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(mc,1);CHKERRQ(ierr);
+  ierr = MatColoringSetWeightType(mc,MAT_COLORING_WEIGHT_LEXICAL);CHKERRQ(ierr);
+  ierr = MatColoringApply(mc,&iscoloring);CHKERRQ(ierr);
+  ierr = ISColoringGetColors(iscoloring,NULL,&nc,&colors);CHKERRQ(ierr);
+  ierr = PetscMalloc1(N,&idx);CHKERRQ(ierr);
+  for (k=0,j=0; j<nc; j++) {
+    for (i=0; i<N; i++) if (colors[i] == j) idx[k++] = i;
+  }
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,N,idx,PETSC_OWN_POINTER,&perm);CHKERRQ(ierr);
+  ierr = ISSetPermutation(perm);CHKERRQ(ierr);
+  ierr = MatPermute(A,perm,perm,&Ap);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xref);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xp);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&bp);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(b,&ba);CHKERRQ(ierr);
+  ierr = VecGetArray(bp,&xpa);CHKERRQ(ierr);
+  for (k=0; k<N; k++) xpa[k] = ba[idx[k]];
+  ierr = VecRestoreArray(bp,&xpa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(b,&ba);CHKERRQ(ierr);
+
+  for (i=0; i<3; i++) {
+    for (its=1; its<3; its++) {
+      flag = (its == 1) ? (MatSORType)(sweeps[i] | SOR_ZERO_INITIAL_GUESS) : sweeps[i];
+      ierr = MatSOR(Ap,bp,omega,flag,0.0,1,1,xp);CHKERRQ(ierr);
+      ierr = MatSOR(A,b,omega,(MatSORType)(flag | SOR_MULTICOLOR),0.0,1,1,x);CHKERRQ(ierr);
+      ierr = VecGetArrayRead(xp,&xpra);CHKERRQ(ierr);
+      ierr = VecGetArray(xref,&xa);CHKERRQ(ierr);
+      for (k=0; k<N; k++) xa[idx[k]] = xpra[k];
+      ierr = VecRestoreArray(xref,&xa);CHKERRQ(ierr);
+      ierr = VecRestoreArrayRead(xp,&xpra);CHKERRQ(ierr);
+      ierr = VecNorm(xref,NORM_INFINITY,&norm);CHKERRQ(ierr);
+      ierr = VecAXPY(xref,-1.0,x);CHKERRQ(ierr);
+      ierr = VecNorm(xref,NORM_INFINITY,&err);CHKERRQ(ierr);
+      if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+        ierr = PetscPrintf(PETSC_COMM_SELF,"Sweep %D iteration %D: multicolor SOR differs from SOR of the permuted matrix by %g\n",(PetscInt)sweeps[i],its,(double)(err/norm));CHKERRQ(ierr);
+      }
+    }
+  }
+
+  /* the subclasses forward the sweeps by color to the AIJ storage */
+  ierr = MatConvert(A,MATSEQAIJSELL,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = VecCopy(x,xref);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,omega,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_MULTICOLOR),0.0,1,1,x);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,omega,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_MULTICOLOR),0.0,1,1,xref);CHKERRQ(ierr);
+  ierr = VecEqual(x,xref,&equal);CHKERRQ(ierr);
+  if (!equal) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Multicolor SOR of MATSEQAIJSELL differs from MATSEQAIJ\n");CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+
+  /* the other types do not support the flag */
+  ierr = MatConvert(A,MATSEQBAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = PetscPushErrorHandler(PetscReturnErrorHandler,NULL);CHKERRQ(ierr);
+  serr = MatSOR(B,b,omega,(MatSORType)(SOR_FORWARD_SWEEP | SOR_MULTICOLOR),0.0,1,1,x);
+  ierr = PetscPopErrorHandler();CHKERRQ(ierr);
+  if (serr != PETSC_ERR_SUP) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Multicolor SOR of MATSEQBAIJ did not generate an error\n");CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&bp);CHKERRQ(ierr);
+  ierr = VecDestroy(&xp);CHKERRQ(ierr);
+  ierr = VecDestroy(&xref);CHKERRQ(ierr);
+  ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  ierr = MatDestroy(&Ap);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex244_1.out
+     args: -mat_no_inode -nonsymmetric {{0 1}} -omega {{1.0 1.3}}
+
+TEST*/
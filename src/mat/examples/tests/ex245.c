@@ -0,0 +1,142 @@
+static char help[] = "Tests MatSetHashAssembly() against a matrix assembled with MatSetUp() and the default preallocation.\n\
+  -n <n>  : number of block rows, the elements couple consecutive block rows\n\
+  -bs <b> : block size\n\
+  -zero_entries : sets entries outside the elements and zeros them with MatZeroEntries() before the first assembly\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode AssembleElements(Mat A,PetscInt n,PetscInt bs,PetscScalar scale)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,size;
+  PetscInt       e,k,l,a,b,idx[2];
+  PetscScalar    *v;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  ierr = PetscMalloc1(4*bs*bs,&v);CHKERRQ(ierr);
+  /* the elements are dealt out cyclically so most processes set entries of rows they do not own */
+  for (e=rank; e<n-1; e+=size) {
+    idx[0] = e;
+    idx[1] = e+1;
+    for (k=0; k<2; k++) for (a=0; a<bs; a++) for (l=0; l<2; l++) for (b=0; b<bs; b++) {
+      v[(k*bs+a)*2*bs+l*bs+b] = scale*(e+1)*(k == l ? 2.0 : -1.0)*(1.0 + 0.1*(a+b));
+    }
+    ierr = MatSetValuesBlocked(A,2,idx,2,idx,v,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* each process sets a block of the last block column, they keep their locations with zero values */
+static PetscErrorCode ZeroEntries(Mat A,PetscInt n,PetscInt bs)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscInt       idx[2],k;
+  PetscScalar    *v;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)A),&rank);CHKERRQ(ierr);
+  ierr = PetscMalloc1(bs*bs,&v);CHKERRQ(ierr);
+  for (k=0; k<bs*bs; k++) v[k] = 1.0 + k;
+  idx[0] = rank%(n-2);
+  idx[1] = n-1;
+  ierr = MatSetValuesBlocked(A,1,&idx[0],1,&idx[1],v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateMatrix(PetscInt n,PetscInt bs,PetscBool hash,Mat *A)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,size;
+  PetscInt       m;
+  PetscBool      sbaij;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  m    = bs*(n/size + (rank < n%size));
+  ierr = MatCreate(PETSC_COMM_WORLD,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,m,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(*A,bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(*A);CHKERRQ(ierr);
+  ierr = MatSetHashAssembly(*A,hash);CHKERRQ(ierr);
+  ierr = MatSetUp(*A);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompareAny((PetscObject)*A,&sbaij,MATSEQSBAIJ,MATMPISBAIJ,"");CHKERRQ(ierr);
+  if (sbaij) {ierr = MatSetOption(*A,MAT_IGNORE_LOWER_TRIANGULAR,PETSC_TRUE);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  MatInfo        info,infoA;
+  PetscInt       n = 10,bs = 1,i;
+  PetscBool      equal,zero = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-zero_entries",&zero,NULL);CHKERRQ(ierr);
+
+  ierr = CreateMatrix(n,bs,PETSC_FALSE,&A);CHKERRQ(ierr);
+  ierr = CreateMatrix(n,bs,PETSC_TRUE,&B);CHKERRQ(ierr);
+  if (zero) {
+    ierr = ZeroEntries(A,n,bs);CHKERRQ(ierr);
+    ierr = ZeroEntries(B,n,bs);CHKERRQ(ierr);
+  }
+  /* the first assembly allocates the storage of B, the second one reuses it */
+  for (i=0; i<2; i++) {
+    ierr = AssembleElements(A,n,bs,1.0+i);CHKERRQ(ierr);
+    ierr = AssembleElements(B,n,bs,1.0+i);CHKERRQ(ierr);
+    ierr = MatEqual(A,B,&equal);CHKERRQ(ierr);
+    if (!equal) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Assembly %D: the matrix assembled with a hash table differs\n",i);CHKERRQ(ierr);
+    }
+    ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&infoA);CHKERRQ(ierr);
+    ierr = MatGetInfo(B,MAT_GLOBAL_SUM,&info);CHKERRQ(ierr);
+    if (info.nz_used != infoA.nz_used) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Assembly %D: %g nonzeros with hash assembly instead of %g\n",i,(double)info.nz_used,(double)infoA.nz_used);CHKERRQ(ierr);
+    }
+    if (info.mallocs) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Assembly %D: %g mallocs with hash assembly\n",i,(double)info.mallocs);CHKERRQ(ierr);
+    }
+    if (info.nz_allocated != info.nz_used) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Assembly %D: %g nonzeros allocated for %g used with hash assembly\n",i,(double)info.nz_allocated,(double)info.nz_used);CHKERRQ(ierr);
+    }
+  }
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex245_1.out
+     args: -mat_type {{aij baij sbaij}} -bs {{1 2}}
+
+   test:
+     suffix: 2
+     nsize: 2
+     output_file: output/ex245_1.out
+     args: -mat_type {{aij baij sbaij}} -bs {{1 2}}
+
+   test:
+     suffix: zero_entries
+     nsize: {{1 3}}
+     output_file: output/ex245_1.out
+     args: -mat_type {{aij baij sbaij}} -bs 2 -zero_entries
+
+TEST*/
@@ -0,0 +1,151 @@
+static char help[] = "Tests MatFDColoringSetFunctionBatch() against MatFDColoringSetFunction().\n\
+  -n <n>  : number of block rows, the function couples consecutive blocks\n\
+  -bs <b> : block size\n\n";
+
+#include <petscmat.h>
+
+typedef struct {
+  PetscInt n,bs;
+  PetscInt nbatch;   /* number of calls of the batched function */
+} AppCtx;
+
+static PetscErrorCode FormFunction(void *dummy,Vec X,Vec F,void *ctx)
+{
+  AppCtx            *user = (AppCtx*)ctx;
+  PetscErrorCode    ierr;
+  PetscInt          n = user->n,bs = user->bs,i,j,a,b;
+  const PetscScalar *x;
+  PetscScalar       *f;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(F,&f);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (a=0; a<bs; a++) {
+      f[i*bs+a] = x[i*bs+a]*x[i*bs+a]*x[i*bs+a];
+      for (j=PetscMax(i-1,0); j<=PetscMin(i+1,n-1); j++) {
+        for (b=0; b<bs; b++) f[i*bs+a] += (0.1*(a+1) + 0.05*b + 0.2*(j-i+1))*x[j*bs+b]*x[j*bs+b];
+      }
+    }
+  }
+  ierr = VecRestoreArray(F,&f);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(X,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormFunctionBatch(void *dummy,PetscInt nv,Vec X[],Vec F[],void *ctx)
+{
+  AppCtx         *user = (AppCtx*)ctx;
+  PetscErrorCode ierr;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  user->nbatch++;
+  for (k=0; k<nv; k++) {
+    ierr = FormFunction(dummy,X[k],F[k],ctx);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            J,Jref;
+  MatColoring    mc;
+  ISColoring     iscoloring;
+  MatFDColoring  fd,fdbatch;
+  Vec            x;
+  PetscRandom    rand;
+  AppCtx         user;
+  PetscInt       i,idx[3],ncolors,bcols;
+  PetscScalar    *v;
+  PetscReal      norm,err;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  user.n      = 20;
+  user.bs     = 1;
+  user.nbatch = 0;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&user.n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&user.bs,NULL);CHKERRQ(ierr);
+  bcols = 0;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mat_fd_coloring_bcols",&bcols,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_SELF,&J);CHKERRQ(ierr);
+  ierr = MatSetSizes(J,user.n*user.bs,user.n*user.bs,user.n*user.bs,user.n*user.bs);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(J,user.bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(J);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(J,3*user.bs,NULL);CHKERRQ(ierr);
+  ierr = MatSeqBAIJSetPreallocation(J,user.bs,3,NULL);CHKERRQ(ierr);
+  ierr = PetscCalloc1(9*user.bs*user.bs,&v);CHKERRQ(ierr);
+  for (i=0; i<user.n; i++) {
+    idx[0] = PetscMax(i-1,0);
+    idx[1] = i;
+    idx[2] = PetscMin(i+1,user.n-1);
+    ierr   = MatSetValuesBlocked(J,1,&i,3,idx,v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(J,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(J,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatColoringCreate(J,&mc);CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(mc,2);CHKERRQ(ierr);
+  ierr = MatColoringSetType(mc,MATCOLORINGSL);CHKERRQ(ierr);
+  ierr = MatColoringApply(mc,&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(J,&x,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+
+  ierr = MatFDColoringCreate(J,iscoloring,&fd);CHKERRQ(ierr);
+  ierr = MatFDColoringSetFunction(fd,(PetscErrorCode (*)(void))FormFunction,&user);CHKERRQ(ierr);
+  ierr = MatFDColoringSetFromOptions(fd);CHKERRQ(ierr);
+  ierr = MatFDColoringSetUp(J,iscoloring,fd);CHKERRQ(ierr);
+  ierr = MatFDColoringApply(J,fd,x,NULL);CHKERRQ(ierr);
+  ierr = MatDuplicate(J,MAT_COPY_VALUES,&Jref);CHKERRQ(ierr);
+
+  ierr = MatFDColoringCreate(J,iscoloring,&fdbatch);CHKERRQ(ierr);
+  ierr = MatFDColoringSetFunctionBatch(fdbatch,(PetscErrorCode (*)(void))FormFunctionBatch,&user);CHKERRQ(ierr);
+  ierr = MatFDColoringSetFromOptions(fdbatch);CHKERRQ(ierr);
+  ierr = MatFDColoringSetUp(J,iscoloring,fdbatch);CHKERRQ(ierr);
+  ierr = MatZeroEntries(J);CHKERRQ(ierr);
+  ierr = MatFDColoringApply(J,fdbatch,x,NULL);CHKERRQ(ierr);
+
+  ierr = MatNorm(Jref,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  ierr = MatAXPY(Jref,-1.0,J,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(Jref,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"The Jacobian computed with the batched function differs by %g\n",(double)(err/norm));CHKERRQ(ierr);
+  }
+  /* one call for F(x) and one per block of colors */
+  ierr = ISColoringGetColors(iscoloring,NULL,&ncolors,NULL);CHKERRQ(ierr);
+  if (user.bs > 1) bcols = 1;
+  else if (bcols > ncolors) bcols = ncolors;
+  if (bcols && user.nbatch != 1 + (ncolors + bcols - 1)/bcols) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"%D calls of the batched function for %D colors in blocks of %D\n",user.nbatch,ncolors,bcols);CHKERRQ(ierr);
+  }
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = MatFDColoringDestroy(&fd);CHKERRQ(ierr);
+  ierr = MatFDColoringDestroy(&fdbatch);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+  ierr = MatDestroy(&Jref);CHKERRQ(ierr);
+  ierr = MatDestroy(&J);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex246_1.out
+     args: -mat_type aij -mat_fd_coloring_bcols {{1 3}}
+
+   test:
+     suffix: baij
+     output_file: output/ex246_1.out
+     args: -mat_type baij -bs 3
+
+TEST*/
@@ -0,0 +1,117 @@
+static char help[] = "Tests repeated MatAXPY() with DIFFERENT_NONZERO_PATTERN, as done to form shift*M + J at each time step.\n\
+  -n <n>  : number of block rows\n\
+  -bs <b> : block size\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CreateMatrix(PetscInt n,PetscInt bs,Mat *A)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank,size;
+  PetscInt       m;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  m    = bs*(n/size + (rank < n%size));
+  ierr = MatCreate(PETSC_COMM_WORLD,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,m,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(*A,bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(*A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(*A,5*bs,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(*A,5*bs,NULL,5*bs,NULL);CHKERRQ(ierr);
+  ierr = MatSeqBAIJSetPreallocation(*A,bs,5,NULL);CHKERRQ(ierr);
+  ierr = MatMPIBAIJSetPreallocation(*A,bs,5,NULL,5,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* sets the blocks (i,i+offset) of the locally owned block rows */
+static PetscErrorCode FillMatrix(Mat A,PetscInt n,PetscInt bs,PetscInt noff,const PetscInt offsets[],PetscScalar scale)
+{
+  PetscErrorCode ierr;
+  PetscInt       rstart,rend,i,j,k,l;
+  PetscScalar    *v;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = PetscMalloc1(bs*bs,&v);CHKERRQ(ierr);
+  for (i=rstart/bs; i<rend/bs; i++) {
+    for (k=0; k<noff; k++) {
+      j = i + offsets[k];
+      if (j < 0 || j >= n) continue;
+      for (l=0; l<bs*bs; l++) v[l] = scale*(1.0 + i + 0.1*j + 0.01*l);
+      ierr = MatSetValuesBlocked(A,1,&i,1,&j,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat             M,J,Y,R;
+  PetscInt        n = 12,bs = 1,step;
+  const PetscInt  moff[] = {-1,0,1},joff[] = {-2,0,2};
+  PetscScalar     shift;
+  PetscReal       norm,err;
+  PetscObjectId   id,id0 = 0;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+
+  ierr = CreateMatrix(n,bs,&M);CHKERRQ(ierr);
+  ierr = FillMatrix(M,n,bs,3,moff,1.0);CHKERRQ(ierr);
+  ierr = CreateMatrix(n,bs,&J);CHKERRQ(ierr);
+  for (step=0; step<3; step++) {
+    shift = 1.0/(step+1);
+    ierr  = FillMatrix(J,n,bs,3,joff,1.0+step);CHKERRQ(ierr);
+    /* after the first step Y has the union of the patterns and keeps it */
+    if (!step) {
+      ierr = MatDuplicate(J,MAT_COPY_VALUES,&Y);CHKERRQ(ierr);
+    } else {
+      ierr = MatZeroEntries(Y);CHKERRQ(ierr);
+      ierr = FillMatrix(Y,n,bs,3,joff,1.0+step);CHKERRQ(ierr);
+    }
+    ierr = MatAXPY(Y,shift,M,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    /* the matrix is only replaced when the union of the patterns is formed */
+    ierr = PetscObjectGetId((PetscObject)Y,&id);CHKERRQ(ierr);
+    if (!step) id0 = id;
+    else if (id != id0) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Step %D: the nonzero pattern of Y has been rebuilt\n",step);CHKERRQ(ierr);
+    }
+
+    ierr = MatDuplicate(J,MAT_COPY_VALUES,&R);CHKERRQ(ierr);
+    ierr = MatAXPY(R,shift,M,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(R,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+    ierr = MatAXPY(R,-1.0,Y,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(R,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+    if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"Step %D: shift*M + J differs by %g\n",step,(double)(err/norm));CHKERRQ(ierr);
+    }
+    ierr = MatDestroy(&R);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&M);CHKERRQ(ierr);
+  ierr = MatDestroy(&J);CHKERRQ(ierr);
+  ierr = MatDestroy(&Y);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex247_1.out
+     args: -mat_type {{aij baij}} -bs {{1 2}}
+
+   test:
+     suffix: 2
+     nsize: 2
+     output_file: output/ex247_1.out
+     args: -mat_type {{aij baij}} -bs {{1 2}}
+
+TEST*/
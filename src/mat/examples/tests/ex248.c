@@ -0,0 +1,123 @@
+static char help[] = "Tests MatCreateSubMatrices() with MAT_REUSE_MATRIX on overlapping subdomains, as done by PCASM at each PCSetUp().\n\
+  -n <n>       : the matrix is a 5-point stencil on an n x n grid\n\
+  -nis <nis>   : number of subdomains on each process, 1 or 2\n\
+  -singleis    : use MAT_SUBMAT_SINGLEIS (with -nis 1)\n\
+  -unsorted    : use unsorted column index sets\n\
+  -newnz       : add a nonzero to the matrix, outside the submatrices, before the second reuse\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode FillMatrix(Mat C,PetscInt n,PetscInt step)
+{
+  PetscErrorCode ierr;
+  PetscInt       rstart,rend,i,ncols,cols[5];
+  PetscScalar    vals[5];
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(C,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ncols = 0;
+    if (i >= n)      {cols[ncols] = i-n; vals[ncols++] = -1.0 - 0.01*i - step;}
+    if (i%n)         {cols[ncols] = i-1; vals[ncols++] = -1.1 + 0.02*step;}
+    cols[ncols] = i; vals[ncols++] = 4.2 + 0.1*(i%3) + step;
+    if ((i+1)%n)     {cols[ncols] = i+1; vals[ncols++] = -0.9 - 0.03*step;}
+    if (i+n < n*n)   {cols[ncols] = i+n; vals[ncols++] = -1.0 + 0.01*i*step;}
+    ierr = MatSetValues(C,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            C,*sub,*ref;
+  IS             isrow[2],iscol[2];
+  PetscInt       n = 8,nis = 1,rstart,rend,i,j,step,nidx,*idx;
+  const PetscInt *ridx;
+  PetscBool      singleis = PETSC_FALSE,unsorted = PETSC_FALSE,newnz = PETSC_FALSE,equal;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nis",&nis,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-singleis",&singleis,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-unsorted",&unsorted,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-newnz",&newnz,NULL);CHKERRQ(ierr);
+  if (nis < 1 || nis > 2) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"-nis must be 1 or 2");
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n,5,NULL,2,NULL,&C);CHKERRQ(ierr);
+  if (newnz) {ierr = MatSetOption(C,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);}
+  ierr = FillMatrix(C,n,0);CHKERRQ(ierr);
+
+  /* the owned rows, split into nis subdomains, with one layer of overlap */
+  ierr = MatGetOwnershipRange(C,&rstart,&rend);CHKERRQ(ierr);
+  if (nis == 1) {
+    ierr = ISCreateStride(PETSC_COMM_SELF,rend-rstart,rstart,1,&isrow[0]);CHKERRQ(ierr);
+  } else {
+    ierr = ISCreateStride(PETSC_COMM_SELF,(rend-rstart)/2,rstart,1,&isrow[0]);CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF,rend-rstart-(rend-rstart)/2,rstart+(rend-rstart)/2,1,&isrow[1]);CHKERRQ(ierr);
+  }
+  ierr = MatIncreaseOverlap(C,nis,isrow,1);CHKERRQ(ierr);
+  for (i=0; i<nis; i++) {
+    ierr = ISGetLocalSize(isrow[i],&nidx);CHKERRQ(ierr);
+    ierr = ISGetIndices(isrow[i],&ridx);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nidx,&idx);CHKERRQ(ierr);
+    for (j=0; j<nidx; j++) idx[j] = unsorted ? ridx[nidx-1-j] : ridx[j];
+    ierr = ISRestoreIndices(isrow[i],&ridx);CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF,nidx,idx,PETSC_OWN_POINTER,&iscol[i]);CHKERRQ(ierr);
+  }
+
+  if (singleis) {ierr = MatSetOption(C,MAT_SUBMAT_SINGLEIS,PETSC_TRUE);CHKERRQ(ierr);}
+  ierr = MatCreateSubMatrices(C,nis,isrow,iscol,MAT_INITIAL_MATRIX,&sub);CHKERRQ(ierr);
+  for (step=1; step<4; step++) {
+    /* same nonzero pattern, new values; with -newnz the pattern of C changes, which the reuse must detect */
+    if (newnz && step == 2 && !rstart) {ierr = MatSetValue(C,0,n*n-1,1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    ierr = FillMatrix(C,n,step);CHKERRQ(ierr);
+    if (singleis) {ierr = MatSetOption(C,MAT_SUBMAT_SINGLEIS,PETSC_TRUE);CHKERRQ(ierr);}
+    ierr = MatCreateSubMatrices(C,nis,isrow,iscol,MAT_REUSE_MATRIX,&sub);CHKERRQ(ierr);
+
+    if (singleis) {ierr = MatSetOption(C,MAT_SUBMAT_SINGLEIS,PETSC_TRUE);CHKERRQ(ierr);}
+    ierr = MatCreateSubMatrices(C,nis,isrow,iscol,MAT_INITIAL_MATRIX,&ref);CHKERRQ(ierr);
+    for (i=0; i<nis; i++) {
+      ierr = MatEqual(sub[i],ref[i],&equal);CHKERRQ(ierr);
+      if (!equal) {ierr = PetscPrintf(PETSC_COMM_SELF,"Step %D: reused submatrix %D differs\n",step,i);CHKERRQ(ierr);}
+    }
+    ierr = MatDestroySubMatrices(nis,&ref);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroySubMatrices(nis,&sub);CHKERRQ(ierr);
+  for (i=0; i<nis; i++) {
+    ierr = ISDestroy(&isrow[i]);CHKERRQ(ierr);
+    ierr = ISDestroy(&iscol[i]);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     output_file: output/ex248_1.out
+     args: -nis {{1 2}} -unsorted {{0 1}}
+
+   test:
+     suffix: 2
+     nsize: 3
+     output_file: output/ex248_1.out
+     args: -nis {{1 2}} -unsorted {{0 1}}
+
+   test:
+     suffix: newnz
+     nsize: 3
+     output_file: output/ex248_1.out
+     args: -nis {{1 2}} -newnz
+
+   test:
+     suffix: singleis
+     nsize: 3
+     output_file: output/ex248_1.out
+     args: -singleis -unsorted {{0 1}}
+
+TEST*/
@@ -286,4 +286,9 @@ int main(int argc,char **args)
       args: -mat_type sell -test_diagonalscale
       output_file: output/ex5_53.out
 
+   test:
+      suffix: sell_5
+      args: -mat_type sell -simd_level none
+      output_file: output/ex5_41.out
+
 TEST*/
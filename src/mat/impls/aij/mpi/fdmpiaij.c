@@ -3,17 +3,77 @@
 #include <../src/mat/impls/baij/mpi/mpibaij.h>
 #include <petsc/private/isimpl.h>
 
+/*
+   Computes y[i] = F(x[i]) for n vectors, with a single call of the batched function if one is set;
+   a single vector is given to the scalar function when there is one
+*/
+static PetscErrorCode MatFDColoringComputeFunction_Private(MatFDColoring coloring,void *sctx,PetscInt n,Vec x[],Vec y[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (coloring->fbatch && (n > 1 || !coloring->f)) {
+    PetscErrorCode (*f)(void*,PetscInt,Vec[],Vec[],void*) = (PetscErrorCode (*)(void*,PetscInt,Vec[],Vec[],void*))coloring->fbatch;
+
+    ierr = (*f)(sctx,n,x,y,coloring->fbatchctx);CHKERRQ(ierr);
+  } else {
+    PetscErrorCode (*f)(void*,Vec,Vec,void*) = (PetscErrorCode (*)(void*,Vec,Vec,void*))coloring->f;
+
+    for (i=0; i<n; i++) {
+      ierr = (*f)(sctx,x[i],y[i],coloring->fctx);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Creates the n perturbed vectors passed to the batched function and the n vectors, without arrays, that are
+   placed on the columns of dy for the function values
+*/
+static PetscErrorCode MatFDColoringSetUpBatch_Private(MatFDColoring coloring,Vec x1,PetscInt n)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+  PetscInt       i,m,M,bs;
+  Vec            w1 = coloring->w1;
+
+  PetscFunctionBegin;
+  if (coloring->nbatch >= n) PetscFunctionReturn(0);
+  if (coloring->nbatch) {
+    ierr = VecDestroyVecs(coloring->nbatch,&coloring->xbatch);CHKERRQ(ierr);
+    ierr = VecDestroyVecs(coloring->nbatch,&coloring->ybatch);CHKERRQ(ierr);
+  }
+  ierr = VecDuplicateVecs(x1,n,&coloring->xbatch);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&coloring->ybatch);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)w1),&size);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(w1,&m);CHKERRQ(ierr);
+  ierr = VecGetSize(w1,&M);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(w1,&bs);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = VecBindToCPU(coloring->xbatch[i],PETSC_TRUE);CHKERRQ(ierr);
+    if (size == 1) {
+      ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,bs,m,NULL,&coloring->ybatch[i]);CHKERRQ(ierr);
+    } else {
+      ierr = VecCreateMPIWithArray(PetscObjectComm((PetscObject)w1),bs,m,M,NULL,&coloring->ybatch[i]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscLogObjectParents(coloring,n,coloring->xbatch);CHKERRQ(ierr);
+  ierr = PetscLogObjectParents(coloring,n,coloring->ybatch);CHKERRQ(ierr);
+  coloring->nbatch = n;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatFDColoringApply_BAIJ(Mat J,MatFDColoring coloring,Vec x1,void *sctx)
 {
-  PetscErrorCode    (*f)(void*,Vec,Vec,void*)=(PetscErrorCode (*)(void*,Vec,Vec,void*))coloring->f;
   PetscErrorCode    ierr;
   PetscInt          k,cstart,cend,l,row,col,nz,spidx,i,j;
   PetscScalar       dx=0.0,*w3_array,*dy_i,*dy=coloring->dy;
   PetscScalar       *vscale_array;
   const PetscScalar *xx;
   PetscReal         epsilon=coloring->error_rel,umin=coloring->umin,unorm;
-  Vec               w1=coloring->w1,w2=coloring->w2,w3,vscale=coloring->vscale;
-  void              *fctx=coloring->fctx;
+  Vec               w1=coloring->w1,w2=coloring->w2,w3,xi,vscale=coloring->vscale;
+  PetscBool         batch=coloring->fbatch ? PETSC_TRUE : PETSC_FALSE;
   PetscInt          ctype=coloring->ctype,nxloc,nrows_k;
   PetscScalar       *valaddr;
   MatEntry          *Jentry=coloring->matentry;
@@ -26,7 +86,7 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J,MatFDColoring coloring,Vec x1,void
   /* (1) Set w1 = F(x1) */
   if (!coloring->fset) {
     ierr = PetscLogEventBegin(MAT_FDColoringFunction,coloring,0,0,0);CHKERRQ(ierr);
-    ierr = (*f)(sctx,x1,w1,fctx);CHKERRQ(ierr);
+    ierr = MatFDColoringComputeFunction_Private(coloring,sctx,1,&x1,&w1);CHKERRQ(ierr);
     ierr = PetscLogEventEnd(MAT_FDColoringFunction,coloring,0,0,0);CHKERRQ(ierr);
   } else {
     coloring->fset = PETSC_FALSE;
@@ -66,6 +126,8 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J,MatFDColoring coloring,Vec x1,void
     ierr = PetscLogObjectParent((PetscObject)coloring,(PetscObject)coloring->w3);CHKERRQ(ierr);
   }
   w3 = coloring->w3;
+  /* with a batched function the bs columns of a block are perturbed in separate vectors and evaluated together */
+  if (batch) {ierr = MatFDColoringSetUpBatch_Private(coloring,x1,bs);CHKERRQ(ierr);}
 
   ierr = VecGetOwnershipRange(x1,&cstart,&cend);CHKERRQ(ierr); /* used by ghosted vscale */
   if (vscale) {
@@ -79,40 +141,58 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J,MatFDColoring coloring,Vec x1,void
       (3-1) Loop over each column associated with color
       adding the perturbation to the vector w3 = x1 + dx.
     */
-    ierr = VecCopy(x1,w3);CHKERRQ(ierr);
+    if (!batch) {ierr = VecCopy(x1,w3);CHKERRQ(ierr);}
     dy_i = dy;
     for (i=0; i<bs; i++) {     /* Loop over a block of columns */
-      ierr = VecGetArray(w3,&w3_array);CHKERRQ(ierr);
+      xi = w3;
+      if (batch) {
+        xi   = coloring->xbatch[i];
+        ierr = VecCopy(x1,xi);CHKERRQ(ierr);
+      }
+      ierr = VecGetArray(xi,&w3_array);CHKERRQ(ierr);
       if (ctype == IS_COLORING_GLOBAL) w3_array -= cstart; /* shift pointer so global index can be used */
       if (coloring->htype[0] == 'w') {
         for (l=0; l<ncolumns[k]; l++) {
           col            = i + bs*coloring->columns[k][l];  /* local column (in global index!) of the matrix we are probing for */
           w3_array[col] += 1.0/dx;
-          if (i) w3_array[col-1] -= 1.0/dx; /* resume original w3[col-1] */
+          if (i && !batch) w3_array[col-1] -= 1.0/dx; /* resume original w3[col-1] */
         }
       } else { /* htype == 'ds' */
         vscale_array -= cstart; /* shift pointer so global index can be used */
         for (l=0; l<ncolumns[k]; l++) {
           col = i + bs*coloring->columns[k][l]; /* local column (in global index!) of the matrix we are probing for */
           w3_array[col] += 1.0/vscale_array[col];
-          if (i) w3_array[col-1] -=  1.0/vscale_array[col-1]; /* resume original w3[col-1] */
+          if (i && !batch) w3_array[col-1] -=  1.0/vscale_array[col-1]; /* resume original w3[col-1] */
         }
         vscale_array += cstart;
       }
       if (ctype == IS_COLORING_GLOBAL) w3_array += cstart;
-      ierr = VecRestoreArray(w3,&w3_array);CHKERRQ(ierr);
+      ierr = VecRestoreArray(xi,&w3_array);CHKERRQ(ierr);
 
       /*
        (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
                            w2 = F(x1 + dx) - F(x1)
        */
+      if (batch) {
+        ierr = VecPlaceArray(coloring->ybatch[i],dy_i);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
+        ierr = VecPlaceArray(w2,dy_i);CHKERRQ(ierr); /* place w2 to the array dy_i */
+        ierr = MatFDColoringComputeFunction_Private(coloring,sctx,1,&w3,&w2);CHKERRQ(ierr);
+        ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
+        ierr = VecAXPY(w2,-1.0,w1);CHKERRQ(ierr);
+        ierr = VecResetArray(w2);CHKERRQ(ierr);
+      }
+      dy_i += nxloc; /* points to dy+i*nxloc */
+    }
+    if (batch) {
       ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
-      ierr = VecPlaceArray(w2,dy_i);CHKERRQ(ierr); /* place w2 to the array dy_i */
-      ierr = (*f)(sctx,w3,w2,fctx);CHKERRQ(ierr);
+      ierr = MatFDColoringComputeFunction_Private(coloring,sctx,bs,coloring->xbatch,coloring->ybatch);CHKERRQ(ierr);
       ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
-      ierr = VecAXPY(w2,-1.0,w1);CHKERRQ(ierr);
-      ierr = VecResetArray(w2);CHKERRQ(ierr);
-      dy_i += nxloc; /* points to dy+i*nxloc */
+      for (i=0; i<bs; i++) {
+        ierr = VecAXPY(coloring->ybatch[i],-1.0,w1);CHKERRQ(ierr);
+        ierr = VecResetArray(coloring->ybatch[i]);CHKERRQ(ierr);
+      }
     }
 
     /*
@@ -162,7 +242,6 @@ PetscErrorCode MatFDColoringApply_BAIJ(Mat J,MatFDColoring coloring,Vec x1,void
 /* this is declared PETSC_EXTERN because it is used by MatFDColoringUseDM() which is in the DM library */
 PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void *sctx)
 {
-  PetscErrorCode    (*f)(void*,Vec,Vec,void*) = (PetscErrorCode (*)(void*,Vec,Vec,void*))coloring->f;
   PetscErrorCode    ierr;
   PetscInt          k,cstart,cend,l,row,col,nz;
   PetscScalar       dx=0.0,*y,*w3_array;
@@ -170,7 +249,7 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
   PetscScalar       *vscale_array;
   PetscReal         epsilon=coloring->error_rel,umin=coloring->umin,unorm;
   Vec               w1=coloring->w1,w2=coloring->w2,w3,vscale=coloring->vscale;
-  void              *fctx=coloring->fctx;
+  PetscBool         batch=coloring->fbatch ? PETSC_TRUE : PETSC_FALSE;
   ISColoringType    ctype=coloring->ctype;
   PetscInt          nxloc,nrows_k;
   MatEntry          *Jentry=coloring->matentry;
@@ -183,7 +262,7 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
   /* (1) Set w1 = F(x1) */
   if (!coloring->fset) {
     ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
-    ierr = (*f)(sctx,x1,w1,fctx);CHKERRQ(ierr);
+    ierr = MatFDColoringComputeFunction_Private(coloring,sctx,1,&x1,&w1);CHKERRQ(ierr);
     ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
   } else {
     coloring->fset = PETSC_FALSE;
@@ -231,7 +310,10 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
   if (coloring->bcols > 1) { /* use blocked insertion of Jentry */
     PetscInt    i,m=J->rmap->n,nbcols,bcols=coloring->bcols;
     PetscScalar *dy=coloring->dy,*dy_k;
+    Vec         xk;
 
+    /* with a batched function the bcols colors of a block are perturbed in separate vectors and evaluated together */
+    if (batch) {ierr = MatFDColoringSetUpBatch_Private(coloring,x1,bcols);CHKERRQ(ierr);}
     nbcols = 0;
     for (k=0; k<ncolors; k+=bcols) {
 
@@ -243,10 +325,11 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
       dy_k = dy;
       if (k + bcols > ncolors) bcols = ncolors - k;
       for (i=0; i<bcols; i++) {
-        coloring->currentcolor = k+i;
+        xk = batch ? coloring->xbatch[i] : w3;
+        if (!batch) coloring->currentcolor = k+i;
 
-        ierr = VecCopy(x1,w3);CHKERRQ(ierr);
-        ierr = VecGetArray(w3,&w3_array);CHKERRQ(ierr);
+        ierr = VecCopy(x1,xk);CHKERRQ(ierr);
+        ierr = VecGetArray(xk,&w3_array);CHKERRQ(ierr);
         if (ctype == IS_COLORING_GLOBAL) w3_array -= cstart; /* shift pointer so global index can be used */
         if (coloring->htype[0] == 'w') {
           for (l=0; l<ncolumns[k+i]; l++) {
@@ -262,19 +345,33 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
           vscale_array += cstart;
         }
         if (ctype == IS_COLORING_GLOBAL) w3_array += cstart;
-        ierr = VecRestoreArray(w3,&w3_array);CHKERRQ(ierr);
+        ierr = VecRestoreArray(xk,&w3_array);CHKERRQ(ierr);
 
         /*
          (3-2) Evaluate function at w3 = x1 + dx (here dx is a vector of perturbations)
                            w2 = F(x1 + dx) - F(x1)
          */
+        if (batch) {
+          ierr = VecPlaceArray(coloring->ybatch[i],dy_k);CHKERRQ(ierr);
+        } else {
+          ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
+          ierr = VecPlaceArray(w2,dy_k);CHKERRQ(ierr); /* place w2 to the array dy_i */
+          ierr = MatFDColoringComputeFunction_Private(coloring,sctx,1,&w3,&w2);CHKERRQ(ierr);
+          ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
+          ierr = VecAXPY(w2,-1.0,w1);CHKERRQ(ierr);
+          ierr = VecResetArray(w2);CHKERRQ(ierr);
+        }
+        dy_k += m; /* points to dy+i*nxloc */
+      }
+      if (batch) { /* w2 = F(x1 + dx) - F(x1) for all the colors of the block */
+        coloring->currentcolor = (bcols == 1) ? k : -1;
         ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
-        ierr = VecPlaceArray(w2,dy_k);CHKERRQ(ierr); /* place w2 to the array dy_i */
-        ierr = (*f)(sctx,w3,w2,fctx);CHKERRQ(ierr);
+        ierr = MatFDColoringComputeFunction_Private(coloring,sctx,bcols,coloring->xbatch,coloring->ybatch);CHKERRQ(ierr);
         ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
-        ierr = VecAXPY(w2,-1.0,w1);CHKERRQ(ierr);
-        ierr = VecResetArray(w2);CHKERRQ(ierr);
-        dy_k += m; /* points to dy+i*nxloc */
+        for (i=0; i<bcols; i++) {
+          ierr = VecAXPY(coloring->ybatch[i],-1.0,w1);CHKERRQ(ierr);
+          ierr = VecResetArray(coloring->ybatch[i]);CHKERRQ(ierr);
+        }
       }
 
       /*
@@ -327,7 +424,7 @@ PetscErrorCode  MatFDColoringApply_AIJ(Mat J,MatFDColoring coloring,Vec x1,void
                            w2 = F(x1 + dx) - F(x1)
        */
       ierr = PetscLogEventBegin(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
-      ierr = (*f)(sctx,w3,w2,fctx);CHKERRQ(ierr);
+      ierr = MatFDColoringComputeFunction_Private(coloring,sctx,1,&w3,&w2);CHKERRQ(ierr);
       ierr = PetscLogEventEnd(MAT_FDColoringFunction,0,0,0,0);CHKERRQ(ierr);
       ierr = VecAXPY(w2,-1.0,w1);CHKERRQ(ierr);
 
@@ -850,6 +850,8 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   if (mat->offloadmask == PETSC_OFFLOAD_CPU) aij->A->offloadmask = PETSC_OFFLOAD_CPU;
 #endif
+  a->formatselect = aij->formatselect;
+  a->formatits    = aij->formatits;
   ierr = MatAssemblyBegin(aij->A,mode);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(aij->A,mode);CHKERRQ(ierr);
 
@@ -875,6 +877,8 @@ PetscErrorCode MatAssemblyEnd_MPIAIJ(Mat mat,MatAssemblyType mode)
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   if (mat->offloadmask == PETSC_OFFLOAD_CPU && aij->B->offloadmask != PETSC_OFFLOAD_UNALLOCATED) aij->B->offloadmask = PETSC_OFFLOAD_CPU;
 #endif
+  ((Mat_SeqAIJ*)aij->B->data)->formatselect = aij->formatselect;
+  ((Mat_SeqAIJ*)aij->B->data)->formatits    = aij->formatits;
   ierr = MatAssemblyBegin(aij->B,mode);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(aij->B,mode);CHKERRQ(ierr);
 
@@ -1264,6 +1268,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
 #endif
   ierr = MatStashDestroy_Private(&mat->stash);CHKERRQ(ierr);
   ierr = VecDestroy(&aij->diag);CHKERRQ(ierr);
+  ierr = MatCOOStructDestroy_XAIJ(&aij->coo);CHKERRQ(ierr);
+  ierr = MatAXPYStructDestroy_XAIJ(&aij->axpy);CHKERRQ(ierr);
   ierr = MatDestroy(&aij->A);CHKERRQ(ierr);
   ierr = MatDestroy(&aij->B);CHKERRQ(ierr);
 #if defined(PETSC_USE_CTABLE)
@@ -1286,6 +1292,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpibaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisbaij_C",NULL);CHKERRQ(ierr);
@@ -1496,6 +1504,8 @@ PetscErrorCode MatView_MPIAIJ_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"not using I-node (on process 0) routines\n");CHKERRQ(ierr);
       }
+      ierr = MatView_SeqAIJ_SelectFormat(aij->A,"storage of the diagonal block (on process 0)",viewer);CHKERRQ(ierr);
+      ierr = MatView_SeqAIJ_SelectFormat(aij->B,"storage of the off-diagonal block (on process 0)",viewer);CHKERRQ(ierr);
       PetscFunctionReturn(0);
     } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO) {
       PetscFunctionReturn(0);
@@ -1611,7 +1621,7 @@ PetscErrorCode MatSOR_MPIAIJ(Mat matin,Vec bb,PetscReal omega,MatSORType flag,Pe
       ierr = (*mat->B->ops->multadd)(mat->B,mat->lvec,bb,bb1);CHKERRQ(ierr);
 
       /* local sweep */
-      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,SOR_SYMMETRIC_SWEEP,fshift,lits,1,xx);CHKERRQ(ierr);
+      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,(MatSORType)(SOR_SYMMETRIC_SWEEP | (flag & SOR_MULTICOLOR)),fshift,lits,1,xx);CHKERRQ(ierr);
     }
   } else if (flag & SOR_LOCAL_FORWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1627,7 +1637,7 @@ PetscErrorCode MatSOR_MPIAIJ(Mat matin,Vec bb,PetscReal omega,MatSORType flag,Pe
       ierr = (*mat->B->ops->multadd)(mat->B,mat->lvec,bb,bb1);CHKERRQ(ierr);
 
       /* local sweep */
-      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,SOR_FORWARD_SWEEP,fshift,lits,1,xx);CHKERRQ(ierr);
+      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,(MatSORType)(SOR_FORWARD_SWEEP | (flag & SOR_MULTICOLOR)),fshift,lits,1,xx);CHKERRQ(ierr);
     }
   } else if (flag & SOR_LOCAL_BACKWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1643,7 +1653,7 @@ PetscErrorCode MatSOR_MPIAIJ(Mat matin,Vec bb,PetscReal omega,MatSORType flag,Pe
       ierr = (*mat->B->ops->multadd)(mat->B,mat->lvec,bb,bb1);CHKERRQ(ierr);
 
       /* local sweep */
-      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,SOR_BACKWARD_SWEEP,fshift,lits,1,xx);CHKERRQ(ierr);
+      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,(MatSORType)(SOR_BACKWARD_SWEEP | (flag & SOR_MULTICOLOR)),fshift,lits,1,xx);CHKERRQ(ierr);
     }
   } else if (flag & SOR_EISENSTAT) {
     Vec xx1;
@@ -2269,12 +2279,34 @@ static PetscErrorCode MatAXPYGetPreallocation_MPIAIJ(Mat Y,const PetscInt *yltog
   PetscFunctionReturn(0);
 }
 
+/* Keeps in Y the locations of the nonzeros of X, or none if they are not a subset of those of Y on some process */
+static PetscErrorCode MatAXPYSetUp_MPIAIJ(Mat Y,Mat X)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *xx = (Mat_MPIAIJ*)X->data,*yy = (Mat_MPIAIJ*)Y->data;
+  Mat_SeqAIJ     *xa = (Mat_SeqAIJ*)xx->A->data,*xb = (Mat_SeqAIJ*)xx->B->data;
+  Mat_SeqAIJ     *ya = (Mat_SeqAIJ*)yy->A->data,*yb = (Mat_SeqAIJ*)yy->B->data;
+  PetscBool      valid,lsubset,subset;
+
+  PetscFunctionBegin;
+  ierr = MatAXPYStructCheck_XAIJ(Y,X,1,xa->nz,xb->nz,ya->nz,&yy->axpy,&valid);CHKERRQ(ierr);
+  if (valid) PetscFunctionReturn(0);
+  ierr = MatAXPYStructSetLocations_XAIJ(Y->rmap->n,xa->i,xa->j,NULL,ya->i,ya->j,NULL,0,yy->axpy->loc,&lsubset);CHKERRQ(ierr);
+  if (lsubset) {
+    ierr = MatAXPYStructSetLocations_XAIJ(Y->rmap->n,xb->i,xb->j,xx->garray,yb->i,yb->j,yy->garray,ya->nz,yy->axpy->loc+xa->nz,&lsubset);CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(&lsubset,&subset,1,MPIU_BOOL,MPI_LAND,PetscObjectComm((PetscObject)Y));CHKERRQ(ierr);
+  if (!subset) {ierr = MatAXPYStructDestroy_XAIJ(&yy->axpy);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAXPY_MPIAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
 {
   PetscErrorCode ierr;
   Mat_MPIAIJ     *xx = (Mat_MPIAIJ*)X->data,*yy = (Mat_MPIAIJ*)Y->data;
   PetscBLASInt   bnz,one=1;
   Mat_SeqAIJ     *x,*y;
+  PetscBool      ismpiaij;
 
   PetscFunctionBegin;
   if (str == SAME_NONZERO_PATTERN) {
@@ -2295,25 +2327,48 @@ PetscErrorCode MatAXPY_MPIAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
       Y->offloadmask = PETSC_OFFLOAD_CPU;
     }
 #endif
-  } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
-    ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
   } else {
-    Mat      B;
-    PetscInt *nnz_d,*nnz_o;
-    ierr = PetscMalloc1(yy->A->rmap->N,&nnz_d);CHKERRQ(ierr);
-    ierr = PetscMalloc1(yy->B->rmap->N,&nnz_o);CHKERRQ(ierr);
-    ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
-    ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
-    ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
-    ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
-    ierr = MatSetType(B,MATMPIAIJ);CHKERRQ(ierr);
-    ierr = MatAXPYGetPreallocation_SeqAIJ(yy->A,xx->A,nnz_d);CHKERRQ(ierr);
-    ierr = MatAXPYGetPreallocation_MPIAIJ(yy->B,yy->garray,xx->B,xx->garray,nnz_o);CHKERRQ(ierr);
-    ierr = MatMPIAIJSetPreallocation(B,0,nnz_d,0,nnz_o);CHKERRQ(ierr);
-    ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
-    ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
-    ierr = PetscFree(nnz_d);CHKERRQ(ierr);
-    ierr = PetscFree(nnz_o);CHKERRQ(ierr);
+    /* as in MatAXPY_SeqAIJ() the locations of the nonzeros of X in Y are kept for the next calls */
+    ierr = MatAXPYSetUp_MPIAIJ(Y,X);CHKERRQ(ierr);
+    if (yy->axpy) {
+      ierr = MatAXPYStructApply_XAIJ(yy->axpy,a,((Mat_SeqAIJ*)xx->A->data)->a,((Mat_SeqAIJ*)xx->B->data)->a,((Mat_SeqAIJ*)yy->A->data)->a,((Mat_SeqAIJ*)yy->B->data)->a);CHKERRQ(ierr);
+      ierr = MatSeqAIJInvalidateDiagonal(yy->A);CHKERRQ(ierr);
+      ierr = VecDestroy(&yy->diag);CHKERRQ(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)yy->A);CHKERRQ(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)yy->B);CHKERRQ(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
+      if (Y->offloadmask != PETSC_OFFLOAD_UNALLOCATED) {
+        Y->offloadmask = PETSC_OFFLOAD_CPU;
+      }
+#endif
+      /* derived formats keep their own copy of the values, which is refreshed at assembly */
+      ierr = PetscObjectTypeCompare((PetscObject)Y,MATMPIAIJ,&ismpiaij);CHKERRQ(ierr);
+      if (!ismpiaij) {
+        ierr = MatAssemblyBegin(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      }
+    } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
+      ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
+    } else {
+      Mat      B;
+      PetscInt *nnz_d,*nnz_o;
+      ierr = PetscMalloc1(yy->A->rmap->N,&nnz_d);CHKERRQ(ierr);
+      ierr = PetscMalloc1(yy->B->rmap->N,&nnz_o);CHKERRQ(ierr);
+      ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
+      ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
+      ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
+      ierr = MatSetType(B,MATMPIAIJ);CHKERRQ(ierr);
+      ierr = MatAXPYGetPreallocation_SeqAIJ(yy->A,xx->A,nnz_d);CHKERRQ(ierr);
+      ierr = MatAXPYGetPreallocation_MPIAIJ(yy->B,yy->garray,xx->B,xx->garray,nnz_o);CHKERRQ(ierr);
+      ierr = MatMPIAIJSetPreallocation(B,0,nnz_d,0,nnz_o);CHKERRQ(ierr);
+      ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
+      ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
+      ierr = PetscFree(nnz_d);CHKERRQ(ierr);
+      ierr = PetscFree(nnz_o);CHKERRQ(ierr);
+      ierr = MatAXPYSetUp_MPIAIJ(Y,X);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -2583,6 +2638,7 @@ PetscErrorCode MatMPIAIJSetUseScalableIncreaseOverlap(Mat A,PetscBool sc)
 
 PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
 {
+  Mat_MPIAIJ           *aij = (Mat_MPIAIJ*)A->data;
   PetscErrorCode       ierr;
   PetscBool            sc = PETSC_FALSE,flg;
 
@@ -2593,6 +2649,7 @@ PetscErrorCode MatSetFromOptions_MPIAIJ(PetscOptionItems *PetscOptionsObject,Mat
   if (flg) {
     ierr = MatMPIAIJSetUseScalableIncreaseOverlap(A,sc);CHKERRQ(ierr);
   }
+  ierr = MatSetFromOptions_SeqAIJ_SelectFormat(PetscOptionsObject,&aij->formatselect,&aij->formatits);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2985,6 +3042,80 @@ PetscErrorCode MatLoad_MPIAIJ(Mat newMat, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_MPIIO)
+/* every process reads its own rows with collective MPI-IO, nothing goes through the first process */
+static PetscErrorCode MatLoad_MPIAIJ_Binary_MPIIO(Mat newMat, PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    rank,size;
+  PetscInt       header[4],M,N,m,n,rstart,cstart,cend,i,j,row,*rowlens,*dlens,*olens,*cols,*scols;
+  PetscInt       bs = newMat->rmap->bs;
+  PetscScalar    *vals,*svals;
+  PetscBool      nooffprocentries;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,header,4,NULL,PETSC_INT);CHKERRQ(ierr);
+  if (header[0] != MAT_FILE_CLASSID) SETERRQ(comm,PETSC_ERR_FILE_UNEXPECTED,"not matrix object");
+  if (header[3] < 0) SETERRQ(comm,PETSC_ERR_FILE_UNEXPECTED,"Matrix stored in special format on disk,cannot load as MATMPIAIJ");
+
+  ierr = PetscOptionsBegin(comm,NULL,"Options for loading MATMPIAIJ matrix","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-matload_block_size","Set the blocksize used to store the matrix","MatLoad",bs,&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (bs < 0) bs = 1;
+
+  M = header[1]; N = header[2];
+  if (newMat->rmap->N >= 0 && newMat->rmap->N != M) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Inconsistent # of rows:Matrix in file has (%D) and input matrix has (%D)",newMat->rmap->N,M);
+  if (newMat->cmap->N >= 0 && newMat->cmap->N != N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Inconsistent # of cols:Matrix in file has (%D) and input matrix has (%D)",newMat->cmap->N,N);
+  if (M%bs) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Inconsistent # of rows (%d) and block size (%d)",M,bs);
+
+  /* same distribution as MatLoad_MPIAIJ_Binary() */
+  if (newMat->rmap->n < 0) m = bs*((M/bs)/size + (((M/bs) % size) > rank));
+  else m = newMat->rmap->n;
+  if (newMat->cmap->n >= 0) n = newMat->cmap->n;
+  else if (N == M) n = m;
+  else n = N/size + ((N % size) > rank);
+  ierr = MatSetSizes(newMat,m,n,M,N);CHKERRQ(ierr);
+  if (bs > 1) {ierr = MatSetBlockSize(newMat,bs);CHKERRQ(ierr);}
+  ierr   = PetscLayoutSetUp(newMat->rmap);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(newMat->cmap);CHKERRQ(ierr);
+  rstart = newMat->rmap->rstart;
+  cstart = newMat->cmap->rstart;
+  cend   = newMat->cmap->rend;
+
+  ierr = PetscMalloc3(m,&rowlens,m,&dlens,m,&olens);CHKERRQ(ierr);
+  ierr = MatLoadBinaryReadRows_MPIIO(viewer,M,header[3],rstart,m,rowlens,&cols,&vals);CHKERRQ(ierr);
+  for (i=0,scols=cols; i<m; i++) {
+    dlens[i] = olens[i] = 0;
+    for (j=0; j<rowlens[i]; j++) {
+      if (scols[j] < cstart || scols[j] >= cend) olens[i]++;
+      else dlens[i]++;
+    }
+    scols += rowlens[i];
+  }
+  ierr = MatMPIAIJSetPreallocation(newMat,0,dlens,0,olens);CHKERRQ(ierr);
+
+  for (i=0,row=rstart,scols=cols,svals=vals; i<m; i++,row++) {
+    ierr   = MatSetValues_MPIAIJ(newMat,1,&row,rowlens[i],scols,svals,INSERT_VALUES);CHKERRQ(ierr);
+    scols += rowlens[i];
+    svals += rowlens[i];
+  }
+  ierr = PetscFree3(rowlens,dlens,olens);CHKERRQ(ierr);
+  ierr = PetscFree(cols);CHKERRQ(ierr);
+  ierr = PetscFree(vals);CHKERRQ(ierr);
+
+  nooffprocentries         = newMat->nooffprocentries;
+  newMat->nooffprocentries = PETSC_TRUE;
+  ierr = MatAssemblyBegin(newMat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(newMat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  newMat->nooffprocentries = nooffprocentries;
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode MatLoad_MPIAIJ_Binary(Mat newMat, PetscViewer viewer)
 {
   PetscScalar    *vals,*svals;
@@ -2997,8 +3128,18 @@ PetscErrorCode MatLoad_MPIAIJ_Binary(Mat newMat, PetscViewer viewer)
   PetscInt       cend,cstart,n,*rowners;
   int            fd;
   PetscInt       bs = newMat->rmap->bs;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscBool      usempiio;
+#endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&usempiio);CHKERRQ(ierr);
+  if (usempiio) {
+    ierr = MatLoad_MPIAIJ_Binary_MPIIO(newMat,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
@@ -4023,6 +4164,50 @@ PetscErrorCode MatMPIAIJSetPreallocationCSR_MPIAIJ(Mat B,const PetscInt Ii[],con
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *aij;
+  Mat_COO        *coo;
+  PetscInt       *ii,*jj,nzA,nzB;
+
+  PetscFunctionBegin;
+  ierr = MatCOOStructCreate_XAIJ(mat,1,PETSC_TRUE,n,coo_i,coo_j,&ii,&jj,&coo);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocationCSR(mat,ii,jj,NULL);CHKERRQ(ierr);
+  ierr = PetscFree(ii);CHKERRQ(ierr);
+  ierr = PetscFree(jj);CHKERRQ(ierr);
+  aij  = (Mat_MPIAIJ*)mat->data;
+  nzA  = ((Mat_SeqAIJ*)aij->A->data)->nz;
+  nzB  = ((Mat_SeqAIJ*)aij->B->data)->nz;
+  if (nzA != coo->nA || nzB != coo->nB) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Matrix has %D+%D nonzeros, COO pattern has %D+%D",nzA,nzB,coo->nA,coo->nB);
+  coo->nonzerostate = mat->nonzerostate;
+  ierr = MatCOOStructDestroy_XAIJ(&aij->coo);CHKERRQ(ierr);
+  aij->coo = coo;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  PetscErrorCode ierr;
+  Mat_MPIAIJ     *aij = (Mat_MPIAIJ*)mat->data;
+  PetscBool      ismpiaij;
+
+  PetscFunctionBegin;
+  if (!aij->coo) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  ierr = MatCOOStructSetValues_XAIJ(mat,aij->coo,v,imode,((Mat_SeqAIJ*)aij->A->data)->a,((Mat_SeqAIJ*)aij->B->data)->a);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(aij->A);CHKERRQ(ierr);
+  ierr = VecDestroy(&aij->diag);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)aij->A);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)aij->B);CHKERRQ(ierr);
+  /* derived formats keep their own copy of the values, which is refreshed at assembly */
+  ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPIAIJ,&ismpiaij);CHKERRQ(ierr);
+  if (!ismpiaij) {
+    ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatMPIAIJSetPreallocationCSR - Allocates memory for a sparse parallel matrix in AIJ format
    (the default parallel PETSc format).
@@ -5951,6 +6136,8 @@ PetscErrorCode MatGetCommunicationStructs(Mat A, Vec *lvec, PetscInt *colmap[],
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMixed(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJDelta(Mat,MatType,MatReuse,Mat*);
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat,MatType,MatReuse,Mat*);
 #endif
@@ -6095,9 +6282,13 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijsell_C",MatConvert_MPIAIJ_MPIAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijmixed_C",MatConvert_MPIAIJ_MPIAIJMixed);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijdelta_C",MatConvert_MPIAIJ_MPIAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijmkl_C",MatConvert_MPIAIJ_MPIAIJMKL);CHKERRQ(ierr);
 #endif
@@ -79,6 +79,15 @@ typedef struct {
   /* used by MatMatMatMult() */
   Mat_MatMatMatMult *matmatmatmult;
 
+  /* Used by MatSetValuesCOO() */
+  Mat_COO *coo;
+
+  /* Locations of the nonzeros of the last X of MatAXPY() */
+  Mat_AXPY *axpy;
+
+  /* Storage selection at assembly passed to the diagonal and off-diagonal blocks, see MatAssemblyEnd_SeqAIJ_SelectFormat() */
+  PetscInt formatselect,formatits;
+
   /* Used by MPICUSP and MPICUSPARSE classes */
   void * spptr;
 
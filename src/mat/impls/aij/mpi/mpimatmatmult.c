@@ -365,6 +365,7 @@ typedef struct {
   PetscInt     numBb;  /* num of Bb matrices */
   PetscInt     nsends,nrecvs;
   MPI_Datatype *stype,*rtype;
+  Mat_MPIDenseInterleaved *il; /* used instead of the above when numBb is zero */
 } MPIAIJ_MPIDense;
 
 PetscErrorCode MatMPIAIJ_MPIDenseDestroy(void *ctx)
@@ -391,6 +392,7 @@ PetscErrorCode MatMPIAIJ_MPIDenseDestroy(void *ctx)
     ierr = MPI_Type_free(&contents->rtype[i]);CHKERRQ(ierr);
   }
   ierr = PetscFree4(contents->stype,contents->rtype,contents->rwaits,contents->swaits);CHKERRQ(ierr);
+  ierr = MatMPIDenseInterleavedDestroy_Private(&contents->il);CHKERRQ(ierr);
   ierr = PetscFree(contents);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -515,41 +517,46 @@ PetscErrorCode MatMatMultSymbolic_MPIAIJ_MPIDense(Mat A,Mat B,PetscReal fill,Mat
     }
   }
 
-  /* Create work matrix used to store off processor rows of B needed for local product */
-  ierr = MatCreateSeqDense(PETSC_COMM_SELF,nz,Bbn,NULL,&contents->workB);CHKERRQ(ierr);
-
-  /* Use MPI derived data type to reduce memory required by the send/recv buffers */
-  ierr = PetscMalloc4(nsends,&stype,nrecvs,&rtype,nrecvs,&contents->rwaits,nsends,&contents->swaits);CHKERRQ(ierr);
-  contents->stype  = stype;
-  contents->nsends = nsends;
+  if (!contents->numBb) {
+    /* all the columns of B are sent at once, interleaved, so the local product reads A only once */
+    ierr = MatMPIDenseInterleavedCreate_Private(B,1,nz,aij->garray,&contents->il);CHKERRQ(ierr);
+  } else {
+    /* Create work matrix used to store off processor rows of B needed for local product */
+    ierr = MatCreateSeqDense(PETSC_COMM_SELF,nz,Bbn,NULL,&contents->workB);CHKERRQ(ierr);
+
+    /* Use MPI derived data type to reduce memory required by the send/recv buffers */
+    ierr = PetscMalloc4(nsends,&stype,nrecvs,&rtype,nrecvs,&contents->rwaits,nsends,&contents->swaits);CHKERRQ(ierr);
+    contents->stype  = stype;
+    contents->nsends = nsends;
+
+    contents->rtype  = rtype;
+    contents->nrecvs = nrecvs;
+
+    ierr = PetscMalloc1(Bm+1,&disp);CHKERRQ(ierr);
+    for (i=0; i<nsends; i++) {
+      nrows_to = sstarts[i+1]-sstarts[i];
+      for (j=0; j<nrows_to; j++){
+        disp[j] = sindices[sstarts[i]+j]; /* rowB to be sent */
+      }
+      ierr = MPI_Type_create_indexed_block(nrows_to,1,(const PetscMPIInt *)disp,MPIU_SCALAR,&type1);CHKERRQ(ierr);
 
-  contents->rtype  = rtype;
-  contents->nrecvs = nrecvs;
+      ierr = MPI_Type_create_resized(type1,0,lda*sizeof(PetscScalar),&stype[i]);CHKERRQ(ierr);
+      ierr = MPI_Type_commit(&stype[i]);CHKERRQ(ierr);
+      ierr = MPI_Type_free(&type1);CHKERRQ(ierr);
+    }
 
-  ierr = PetscMalloc1(Bm+1,&disp);CHKERRQ(ierr);
-  for (i=0; i<nsends; i++) {
-    nrows_to = sstarts[i+1]-sstarts[i];
-    for (j=0; j<nrows_to; j++){
-      disp[j] = sindices[sstarts[i]+j]; /* rowB to be sent */
+    for (i=0; i<nrecvs; i++) {
+      /* received values from a process form a (nrows_from x Bbn) row block in workB (column-wise) */
+      nrows_from = rstarts[i+1]-rstarts[i];
+      disp[0] = 0;
+      ierr = MPI_Type_create_indexed_block(1, nrows_from, (const PetscMPIInt *)disp, MPIU_SCALAR, &type1);CHKERRQ(ierr);
+      ierr = MPI_Type_create_resized(type1, 0, nz*sizeof(PetscScalar), &rtype[i]);CHKERRQ(ierr);
+      ierr = MPI_Type_commit(&rtype[i]);CHKERRQ(ierr);
+      ierr = MPI_Type_free(&type1);CHKERRQ(ierr);
     }
-    ierr = MPI_Type_create_indexed_block(nrows_to,1,(const PetscMPIInt *)disp,MPIU_SCALAR,&type1);CHKERRQ(ierr);
 
-    ierr = MPI_Type_create_resized(type1,0,lda*sizeof(PetscScalar),&stype[i]);CHKERRQ(ierr);
-    ierr = MPI_Type_commit(&stype[i]);CHKERRQ(ierr);
-    ierr = MPI_Type_free(&type1);CHKERRQ(ierr);
+    ierr = PetscFree(disp);CHKERRQ(ierr);
   }
-
-  for (i=0; i<nrecvs; i++) {
-    /* received values from a process form a (nrows_from x Bbn) row block in workB (column-wise) */
-    nrows_from = rstarts[i+1]-rstarts[i];
-    disp[0] = 0;
-    ierr = MPI_Type_create_indexed_block(1, nrows_from, (const PetscMPIInt *)disp, MPIU_SCALAR, &type1);CHKERRQ(ierr);
-    ierr = MPI_Type_create_resized(type1, 0, nz*sizeof(PetscScalar), &rtype[i]);CHKERRQ(ierr);
-    ierr = MPI_Type_commit(&rtype[i]);CHKERRQ(ierr);
-    ierr = MPI_Type_free(&type1);CHKERRQ(ierr);
-  }
-
-  ierr = PetscFree(disp);CHKERRQ(ierr);
   ierr = VecScatterRestoreRemote_Private(ctx,PETSC_TRUE/*send*/,&nsends,&sstarts,&sindices,NULL,NULL);CHKERRQ(ierr);
   ierr = VecScatterRestoreRemoteOrdered_Private(ctx,PETSC_FALSE/*recv*/,&nrecvs,&rstarts,NULL,NULL,NULL);CHKERRQ(ierr);
 
@@ -674,16 +681,13 @@ PetscErrorCode MatMatMultNumeric_MPIAIJ_MPIDense(Mat A,Mat B,Mat C)
   Mat_MPIAIJ      *aij    = (Mat_MPIAIJ*)A->data;
   Mat_MPIDense    *bdense = (Mat_MPIDense*)B->data;
   Mat_MPIDense    *cdense = (Mat_MPIDense*)C->data;
-  Mat             workB;
   MPIAIJ_MPIDense *contents;
   PetscContainer  container;
   MPI_Comm        comm;
-  PetscInt        numBb;
+  PetscInt        numBb,ldc;
+  PetscScalar     *c;
 
   PetscFunctionBegin;
-  /* diagonal block of A times all local rows of B*/
-  ierr = MatMatMultNumeric_SeqAIJ_SeqDense(aij->A,bdense->A,cdense->A);CHKERRQ(ierr);
-
   ierr = PetscObjectGetComm((PetscObject)A,&comm);CHKERRQ(ierr);
   ierr = PetscObjectQuery((PetscObject)C,"workB",(PetscObject*)&container);CHKERRQ(ierr);
   if (!container) SETERRQ(comm,PETSC_ERR_PLIB,"Container does not exist");
@@ -691,18 +695,27 @@ PetscErrorCode MatMatMultNumeric_MPIAIJ_MPIDense(Mat A,Mat B,Mat C)
   numBb = contents->numBb;
 
   if (!numBb) {
-    /* get off processor parts of B needed to complete C=A*B */
-    ierr = MatMPIDenseScatter(A,B,0,C,&workB);CHKERRQ(ierr);
+    Mat_MPIDenseInterleaved *il = contents->il;
 
-    /* off-diagonal block of A times nonlocal rows of B */
-    ierr = MatMatMultNumericAdd_SeqAIJ_SeqDense(aij->B,workB,cdense->A);CHKERRQ(ierr);
+    /* send the rows of B needed by the other processes, then overlap with the diagonal block of A times the local rows */
+    ierr = MatMPIDenseInterleavedBegin_Private(B,il);CHKERRQ(ierr);
+    ierr = MatZeroEntries(cdense->A);CHKERRQ(ierr);
+    ierr = MatDenseGetLDA(cdense->A,&ldc);CHKERRQ(ierr);
+    ierr = MatDenseGetArray(cdense->A,&c);CHKERRQ(ierr);
+    ierr = MatMatMultNumericAdd_SeqAIJ_Interleaved(aij->A,il->k,il->xloc,c,ldc);CHKERRQ(ierr);
 
+    /* off-diagonal block of A times nonlocal rows of B */
+    ierr = MatMPIDenseInterleavedEnd_Private(il);CHKERRQ(ierr);
+    ierr = MatMatMultNumericAdd_SeqAIJ_Interleaved(aij->B,il->k,il->xghost,c,ldc);CHKERRQ(ierr);
+    ierr = MatDenseRestoreArray(cdense->A,&c);CHKERRQ(ierr);
   } else {
     const PetscScalar *barray;
     PetscScalar       *carray;
     Mat               Bb=contents->Bb,Cb=contents->Cb;
     PetscInt          BbN=Bb->cmap->N,start,i;
 
+    /* diagonal block of A times all local rows of B*/
+    ierr = MatMatMultNumeric_SeqAIJ_SeqDense(aij->A,bdense->A,cdense->A);CHKERRQ(ierr);
     ierr = MatDenseGetArrayRead(B,&barray);CHKERRQ(ierr);
     ierr = MatDenseGetArray(C,&carray);CHKERRQ(ierr);
     for (i=0; i<numBb; i++) {
@@ -1231,6 +1231,198 @@ PetscErrorCode MatCreateSubMatrix_MPIAIJ_All(Mat A,MatCreateSubMatrixOption flag
   PetscFunctionReturn(0);
 }
 
+/*
+   For MAT_REUSE_MATRIX: sfA and sfB take the values of the diagonal and off-diagonal blocks of C, where they are stored,
+   to the values of the submatrices placed one after another. They are built with one more exchange of indices on the
+   first reuse, and afterwards a refresh of the submatrices only moves the values that are needed.
+*/
+static PetscErrorCode MatCreateSubMatrices_MPIAIJ_SetUpSF(Mat C,PetscInt ismax,const IS isrow[],const IS iscol[],Mat submats[],Mat_SubSppt *smat)
+{
+  Mat_MPIAIJ     *c = (Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)c->A->data,*b = (Mat_SeqAIJ*)c->B->data,*subc;
+  PetscInt       m = C->rmap->n,*ai = a->i,*bi = b->i,*bmap = c->garray;
+  const PetscInt *irow,*icol = NULL,*subj;
+  PetscInt       i,j,k,l,t,nrow,nreq,nA,nB,nlA,nlB,nz,rmax,idx,offset;
+  PetscInt       *rastart,*raend,*rbstart,*rbend,*acols,*bcols,*bgcols,*subgcols,*subpos,*ilocalA,*ilocalB;
+  PetscSFNode    *rremote,*eremote,*iremoteA,*iremoteB;
+  PetscMPIInt    owner = -1;
+  PetscSF        rowsf,entsf;
+  PetscBool      allcolumns;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)C,&comm);CHKERRQ(ierr);
+
+  /* the requested rows, and where the row of each is stored in the blocks of its owner */
+  for (i=0,nreq=0; i<ismax; i++) nreq += submats[i]->rmap->n;
+  ierr = PetscMalloc1(nreq,&rremote);CHKERRQ(ierr);
+  for (i=0,k=0; i<ismax; i++) {
+    ierr = ISGetLocalSize(isrow[i],&nrow);CHKERRQ(ierr);
+    ierr = ISGetIndices(isrow[i],&irow);CHKERRQ(ierr);
+    for (j=0; j<nrow; j++,k++) {
+      ierr = PetscLayoutFindOwnerIndex(C->rmap,irow[j],&owner,&rremote[k].index);CHKERRQ(ierr);
+      rremote[k].rank = owner;
+    }
+    ierr = ISRestoreIndices(isrow[i],&irow);CHKERRQ(ierr);
+  }
+  ierr = PetscSFCreate(comm,&rowsf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(rowsf,m,nreq,NULL,PETSC_OWN_POINTER,rremote,PETSC_USE_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(rowsf);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nreq,&rastart,nreq,&raend,nreq,&rbstart,nreq,&rbend);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(rowsf,MPIU_INT,ai,rastart);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(rowsf,MPIU_INT,ai,rastart);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(rowsf,MPIU_INT,ai+1,raend);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(rowsf,MPIU_INT,ai+1,raend);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(rowsf,MPIU_INT,bi,rbstart);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(rowsf,MPIU_INT,bi,rbstart);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(rowsf,MPIU_INT,bi+1,rbend);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(rowsf,MPIU_INT,bi+1,rbend);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&rowsf);CHKERRQ(ierr);
+
+  /* the global columns of the requested rows, from the diagonal and off-diagonal blocks */
+  for (k=0,nA=0,nB=0; k<nreq; k++) {
+    nA += raend[k] - rastart[k];
+    nB += rbend[k] - rbstart[k];
+  }
+  ierr = PetscMalloc2(nA,&acols,nB,&bcols);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nA,&eremote);CHKERRQ(ierr);
+  for (k=0,l=0; k<nreq; k++) {
+    for (t=rastart[k]; t<raend[k]; t++,l++) {
+      eremote[l].rank  = rremote[k].rank;
+      eremote[l].index = t;
+    }
+  }
+  ierr = PetscSFCreate(comm,&entsf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(entsf,ai[m],nA,NULL,PETSC_OWN_POINTER,eremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(entsf);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(entsf,MPIU_INT,a->j,acols);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(entsf,MPIU_INT,a->j,acols);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&entsf);CHKERRQ(ierr);
+  for (k=0,l=0; k<nreq; k++) {
+    for (t=rastart[k]; t<raend[k]; t++,l++) acols[l] += C->cmap->range[rremote[k].rank];
+  }
+
+  ierr = PetscMalloc1(bi[m],&bgcols);CHKERRQ(ierr);
+  for (l=0; l<bi[m]; l++) bgcols[l] = bmap[b->j[l]];
+  ierr = PetscMalloc1(nB,&eremote);CHKERRQ(ierr);
+  for (k=0,l=0; k<nreq; k++) {
+    for (t=rbstart[k]; t<rbend[k]; t++,l++) {
+      eremote[l].rank  = rremote[k].rank;
+      eremote[l].index = t;
+    }
+  }
+  ierr = PetscSFCreate(comm,&entsf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(entsf,bi[m],nB,NULL,PETSC_OWN_POINTER,eremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(entsf);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(entsf,MPIU_INT,bgcols,bcols);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(entsf,MPIU_INT,bgcols,bcols);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&entsf);CHKERRQ(ierr);
+  ierr = PetscFree(bgcols);CHKERRQ(ierr);
+
+  /* match the columns of each row of C, which are sorted, with the nonzeros of the row of the submatrix */
+  for (i=0,nz=0,rmax=0; i<ismax; i++) {
+    subc = (Mat_SeqAIJ*)submats[i]->data;
+    nz  += subc->i[submats[i]->rmap->n];
+    for (j=0; j<submats[i]->rmap->n; j++) rmax = PetscMax(rmax,subc->i[j+1]-subc->i[j]);
+  }
+  ierr = PetscMalloc4(nz,&ilocalA,nz,&iremoteA,nz,&ilocalB,nz,&iremoteB);CHKERRQ(ierr);
+  ierr = PetscMalloc2(rmax,&subgcols,rmax,&subpos);CHKERRQ(ierr);
+  nlA = nlB = 0;
+  nA  = nB  = 0;
+  for (i=0,k=0,offset=0; i<ismax; i++) {
+    subc       = (Mat_SeqAIJ*)submats[i]->data;
+    allcolumns = subc->submatis1->allcolumns;
+    nrow       = submats[i]->rmap->n;
+    if (!allcolumns) {ierr = ISGetIndices(iscol[i],&icol);CHKERRQ(ierr);}
+    for (j=0; j<nrow; j++,k++) {
+      nz   = subc->i[j+1] - subc->i[j];
+      subj = subc->j + subc->i[j];
+      for (l=0; l<nz; l++) {
+        subgcols[l] = allcolumns ? subj[l] : icol[subj[l]];
+        subpos[l]   = offset + subc->i[j] + l;
+      }
+      ierr = PetscSortIntWithArray(nz,subgcols,subpos);CHKERRQ(ierr);
+      for (t=rastart[k]; t<raend[k]; t++,nA++) {
+        ierr = PetscFindInt(acols[nA],nz,subgcols,&idx);CHKERRQ(ierr);
+        if (idx < 0) continue;
+        ilocalA[nlA]        = subpos[idx];
+        iremoteA[nlA].rank  = rremote[k].rank;
+        iremoteA[nlA].index = t;
+        nlA++;
+      }
+      for (t=rbstart[k]; t<rbend[k]; t++,nB++) {
+        ierr = PetscFindInt(bcols[nB],nz,subgcols,&idx);CHKERRQ(ierr);
+        if (idx < 0) continue;
+        ilocalB[nlB]        = subpos[idx];
+        iremoteB[nlB].rank  = rremote[k].rank;
+        iremoteB[nlB].index = t;
+        nlB++;
+      }
+    }
+    if (!allcolumns) {ierr = ISRestoreIndices(iscol[i],&icol);CHKERRQ(ierr);}
+    offset += subc->i[nrow];
+  }
+  if (nlA + nlB != offset) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Submatrices have %D nonzeros but %D are found in the matrix",offset,nlA+nlB);
+
+  ierr = PetscSFCreate(comm,&smat->sfA);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(smat->sfA,ai[m],nlA,ilocalA,PETSC_COPY_VALUES,iremoteA,PETSC_COPY_VALUES);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(smat->sfA);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&smat->sfB);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(smat->sfB,bi[m],nlB,ilocalB,PETSC_COPY_VALUES,iremoteB,PETSC_COPY_VALUES);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(smat->sfB);CHKERRQ(ierr);
+
+  ierr = PetscFree4(ilocalA,iremoteA,ilocalB,iremoteB);CHKERRQ(ierr);
+  ierr = PetscFree2(subgcols,subpos);CHKERRQ(ierr);
+  ierr = PetscFree2(acols,bcols);CHKERRQ(ierr);
+  ierr = PetscFree4(rastart,raend,rbstart,rbend);CHKERRQ(ierr);
+  ierr = PetscFree(rremote);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MAT_REUSE_MATRIX when the nonzero pattern of C has not changed since the submatrices were created: the values of C
+   are moved to the submatrices with sfA and sfB, without the exchange of row requests and column indices
+*/
+static PetscErrorCode MatCreateSubMatrices_MPIAIJ_Refresh(Mat C,PetscInt ismax,const IS isrow[],const IS iscol[],Mat submats[],Mat_SubSppt *smat)
+{
+  Mat_MPIAIJ     *c = (Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)c->A->data,*b = (Mat_SeqAIJ*)c->B->data,*subc;
+  PetscScalar    *vals = NULL;
+  PetscInt       i,nrow,nz;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0,nz=0; i<ismax; i++) {
+    ierr = ISGetLocalSize(isrow[i],&nrow);CHKERRQ(ierr);
+    if (!submats[i]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"submats[%D] is null, cannot reuse",i);
+    if (submats[i]->rmap->n != nrow) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Cannot reuse matrix. wrong size");
+    nz += ((Mat_SeqAIJ*)submats[i]->data)->i[nrow];
+  }
+  if (!smat->sfA) {ierr = MatCreateSubMatrices_MPIAIJ_SetUpSF(C,ismax,isrow,iscol,submats,smat);CHKERRQ(ierr);}
+
+  if (ismax == 1) vals = ((Mat_SeqAIJ*)submats[0]->data)->a;
+  else if (ismax) {ierr = PetscMalloc1(nz,&vals);CHKERRQ(ierr);}
+  ierr = PetscSFBcastBegin(smat->sfA,MPIU_SCALAR,a->a,vals);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(smat->sfB,MPIU_SCALAR,b->a,vals);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(smat->sfA,MPIU_SCALAR,a->a,vals);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(smat->sfB,MPIU_SCALAR,b->a,vals);CHKERRQ(ierr);
+  if (ismax > 1) {
+    for (i=0,nz=0; i<ismax; i++) {
+      subc = (Mat_SeqAIJ*)submats[i]->data;
+      ierr = PetscArraycpy(subc->a,vals+nz,subc->i[submats[i]->rmap->n]);CHKERRQ(ierr);
+      nz  += subc->i[submats[i]->rmap->n];
+    }
+    ierr = PetscFree(vals);CHKERRQ(ierr);
+  }
+
+  for (i=0; i<ismax; i++) {
+    ierr = MatAssemblyBegin(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatCreateSubMatrices_MPIAIJ_SingleIS_Local(Mat C,PetscInt ismax,const IS isrow[],const IS iscol[],MatReuse scall,PetscBool allcolumns,Mat *submats)
 {
   Mat_MPIAIJ     *c = (Mat_MPIAIJ*)C->data;
@@ -1267,6 +1459,18 @@ PetscErrorCode MatCreateSubMatrices_MPIAIJ_SingleIS_Local(Mat C,PetscInt ismax,c
 
   PetscFunctionBegin;
   if (ismax != 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This routine only works when all processes have ismax=1");
+  if (scall == MAT_REUSE_MATRIX) {
+    if (!submats[0]) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"submats[0] is null, cannot reuse");
+    smatis1 = ((Mat_SeqAIJ*)submats[0]->data)->submatis1;
+    if (smatis1->nonzerostate == C->nonzerostate) {
+      ierr = MatCreateSubMatrices_MPIAIJ_Refresh(C,ismax,isrow,iscol,submats,smatis1);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    /* the nonzero pattern of C has changed, the SFs are built again on the next reuse */
+    ierr = PetscSFDestroy(&smatis1->sfA);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&smatis1->sfB);CHKERRQ(ierr);
+    smatis1->nonzerostate = C->nonzerostate;
+  }
 
   ierr = PetscObjectGetComm((PetscObject)C,&comm);CHKERRQ(ierr);
   size = c->size;
@@ -1660,6 +1864,7 @@ PetscErrorCode MatCreateSubMatrices_MPIAIJ_SingleIS_Local(Mat C,PetscInt ismax,c
 
     smatis1->allcolumns  = allcolumns;
     smatis1->singleis    = PETSC_TRUE;
+    smatis1->nonzerostate = C->nonzerostate;
     smatis1->row2proc    = row2proc;
     smatis1->rmap        = rmap;
     smatis1->cmap        = cmap;
@@ -2097,6 +2302,20 @@ PetscErrorCode MatCreateSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS i
   PetscInt       *sbuf1_i,*rbuf2_i,*rbuf3_i,ilen;
 
   PetscFunctionBegin;
+  if (scall == MAT_REUSE_MATRIX) {
+    if (!submats[0]) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"submats are null, cannot reuse");
+    if (ismax) smat_i = ((Mat_SeqAIJ*)submats[0]->data)->submatis1;
+    else smat_i = (Mat_SubSppt*)submats[0]->data; /* dummy submats[0] */
+    if (smat_i->nonzerostate == C->nonzerostate) {
+      ierr = MatCreateSubMatrices_MPIAIJ_Refresh(C,ismax,isrow,iscol,submats,smat_i);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    /* the nonzero pattern of C has changed, the SFs are built again on the next reuse */
+    ierr = PetscSFDestroy(&smat_i->sfA);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&smat_i->sfB);CHKERRQ(ierr);
+    smat_i->nonzerostate = C->nonzerostate;
+  }
+
   ierr = PetscObjectGetComm((PetscObject)C,&comm);CHKERRQ(ierr);
   size = c->size;
   rank = c->rank;
@@ -2598,6 +2817,7 @@ PetscErrorCode MatCreateSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS i
 
       smat_i->allcolumns  = allcolumns[i];
       smat_i->singleis    = PETSC_FALSE;
+      smat_i->nonzerostate = C->nonzerostate;
       smat_i->row2proc    = row2proc[i];
       smat_i->rmap        = rmap[i];
       smat_i->cmap        = cmap[i];
@@ -2636,6 +2856,7 @@ PetscErrorCode MatCreateSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS i
 
       smat_i->allcolumns  = PETSC_FALSE;
       smat_i->singleis    = PETSC_FALSE;
+      smat_i->nonzerostate = C->nonzerostate;
       smat_i->row2proc    = NULL;
       smat_i->rmap        = NULL;
       smat_i->cmap        = NULL;
@@ -8,6 +8,7 @@
 #include <../src/mat/impls/aij/seq/aij.h>          /*I "petscmat.h" I*/
 #include <petscblaslapack.h>
 #include <petscbt.h>
+#include <petscsf.h>
 #include <petsc/private/kernels/blocktranspose.h>
 
 PetscErrorCode MatSeqAIJSetTypeFromOptions(Mat A)
@@ -1037,6 +1038,7 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
     ierr = MatView_SeqAIJ_Draw(A,viewer);CHKERRQ(ierr);
   }
   ierr = MatView_SeqAIJ_Inode(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_SelectFormat(A,"storage",viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1103,6 +1105,19 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd_SeqAIJ_SelectFormat(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetFromOptions_SeqAIJ(PetscOptionItems *PetscOptionsObject,Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"SeqAIJ options");CHKERRQ(ierr);
+  ierr = MatSetFromOptions_SeqAIJ_SelectFormat(PetscOptionsObject,&a->formatselect,&a->formatits);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1171,11 +1186,16 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscFree(a->ipre);CHKERRQ(ierr);
   ierr = PetscFree3(a->idiag,a->mdiag,a->ssor_work);CHKERRQ(ierr);
   ierr = PetscFree(a->solve_work);CHKERRQ(ierr);
+  ierr = MatSeqAIJSolveLevelsDestroy_Private(&a->solvelevels);CHKERRQ(ierr);
+  ierr = PetscFree2(a->sorcolorptr,a->sorcolorrows);CHKERRQ(ierr);
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
+  ierr = PetscFree(a->formatinfo);CHKERRQ(ierr);
   ierr = ISColoringDestroy(&a->coloring);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
+  ierr = MatCOOStructDestroy_XAIJ(&a->coo);CHKERRQ(ierr);
+  ierr = MatAXPYStructDestroy_XAIJ(&a->axpy);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1201,6 +1221,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatPtAP_is_seqaij_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1411,6 +1433,7 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
 #endif
   }
   ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,1,A->rmap->n) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1510,6 +1533,7 @@ PetscErrorCode MatMultAddMax_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
     }
   }
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,1,A->rmap->n) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1564,6 +1588,7 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
 #endif
   }
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,1,A->rmap->n) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1829,8 +1854,13 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
   PetscErrorCode    ierr;
   PetscInt          n,m = A->rmap->n,i;
   const PetscInt    *idx,*diag;
+  PetscLogDouble    mbytes = MatSeqXAIJMatrixBytes(a->nz,1,m),vbytes = m*sizeof(PetscScalar);
 
   PetscFunctionBegin;
+  if (flag & SOR_MULTICOLOR) {
+    ierr = MatSOR_SeqAIJ_MultiColor(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   its = its*lits;
 
   if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
@@ -1845,7 +1875,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
 
   ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
-  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  /* We count flops and bytes by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
   if (flag == SOR_APPLY_UPPER) {
     /* apply (U + D/omega) to the vector */
     bs = b;
@@ -1861,6 +1891,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
     ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
     ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    ierr = PetscLogBytes(0.5*mbytes + 3.0*vbytes);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
 
@@ -1904,6 +1935,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
     }
 
     ierr = PetscLogFlops(6.0*m-1 + 2.0*a->nz);CHKERRQ(ierr);
+    ierr = PetscLogBytes(mbytes + 8.0*vbytes);CHKERRQ(ierr);
     ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
     ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
     PetscFunctionReturn(0);
@@ -1921,6 +1953,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
       }
       xb   = t;
       ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+      ierr = PetscLogBytes(0.5*mbytes + 4.0*vbytes);CHKERRQ(ierr);
     } else xb = b;
     if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
       for (i=m-1; i>=0; i--) {
@@ -1936,6 +1969,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
         }
       }
       ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      ierr = PetscLogBytes(0.5*mbytes + 4.0*vbytes);CHKERRQ(ierr);
     }
     its--;
   }
@@ -1958,6 +1992,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
       }
       xb   = t;
       ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      ierr = PetscLogBytes(mbytes + 5.0*vbytes);CHKERRQ(ierr);
     } else xb = b;
     if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
       for (i=m-1; i>=0; i--) {
@@ -1979,8 +2014,10 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
       }
       if (xb == b) {
         ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+        ierr = PetscLogBytes(mbytes + 5.0*vbytes);CHKERRQ(ierr);
       } else {
         ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+        ierr = PetscLogBytes(0.5*mbytes + 4.0*vbytes);CHKERRQ(ierr);
       }
     }
   }
@@ -2693,6 +2730,8 @@ PetscErrorCode MatDestroySubMatrix_Private(Mat_SubSppt *submatj)
     }
     ierr = PetscFree3(submatj->req_source2,submatj->rbuf2,submatj->rbuf3);CHKERRQ(ierr);
     ierr = PetscFree(submatj->pa);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&submatj->sfA);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&submatj->sfB);CHKERRQ(ierr);
   }
 
 #if defined(PETSC_USE_CTABLE)
@@ -2974,11 +3013,27 @@ PetscErrorCode MatAXPYGetPreallocation_SeqAIJ(Mat Y,Mat X,PetscInt *nnz)
   PetscFunctionReturn(0);
 }
 
+/* Keeps in Y the locations of the nonzeros of X, or none if they are not a subset of those of Y */
+static PetscErrorCode MatAXPYSetUp_SeqAIJ(Mat Y,Mat X)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *x = (Mat_SeqAIJ*)X->data,*y = (Mat_SeqAIJ*)Y->data;
+  PetscBool      valid,subset;
+
+  PetscFunctionBegin;
+  ierr = MatAXPYStructCheck_XAIJ(Y,X,1,x->nz,0,y->nz,&y->axpy,&valid);CHKERRQ(ierr);
+  if (valid) PetscFunctionReturn(0);
+  ierr = MatAXPYStructSetLocations_XAIJ(Y->rmap->n,x->i,x->j,NULL,y->i,y->j,NULL,0,y->axpy->loc,&subset);CHKERRQ(ierr);
+  if (!subset) {ierr = MatAXPYStructDestroy_XAIJ(&y->axpy);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAXPY_SeqAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
 {
   PetscErrorCode ierr;
   Mat_SeqAIJ     *x = (Mat_SeqAIJ*)X->data,*y = (Mat_SeqAIJ*)Y->data;
   PetscBLASInt   one=1,bnz;
+  PetscBool      isseqaij;
 
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(x->nz,&bnz);CHKERRQ(ierr);
@@ -2994,22 +3049,44 @@ PetscErrorCode MatAXPY_SeqAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
       Y->offloadmask = PETSC_OFFLOAD_CPU;
     }
 #endif
-  } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
-    ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
   } else {
-    Mat      B;
-    PetscInt *nnz;
-    ierr = PetscMalloc1(Y->rmap->N,&nnz);CHKERRQ(ierr);
-    ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
-    ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
-    ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
-    ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
-    ierr = MatSetType(B,(MatType) ((PetscObject)Y)->type_name);CHKERRQ(ierr);
-    ierr = MatAXPYGetPreallocation_SeqAIJ(Y,X,nnz);CHKERRQ(ierr);
-    ierr = MatSeqAIJSetPreallocation(B,0,nnz);CHKERRQ(ierr);
-    ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
-    ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
-    ierr = PetscFree(nnz);CHKERRQ(ierr);
+    /* the locations of the nonzeros of X in Y are kept, so that repeated calls with the same X,
+       for instance on the union of the patterns left in Y by a first call, add the values in one pass */
+    ierr = MatAXPYSetUp_SeqAIJ(Y,X);CHKERRQ(ierr);
+    if (y->axpy) {
+      ierr = MatAXPYStructApply_XAIJ(y->axpy,a,x->a,NULL,y->a,NULL);CHKERRQ(ierr);
+      ierr = MatSeqAIJInvalidateDiagonal(Y);CHKERRQ(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
+      if (Y->offloadmask != PETSC_OFFLOAD_UNALLOCATED) {
+        Y->offloadmask = PETSC_OFFLOAD_CPU;
+      }
+#endif
+      /* derived formats such as MATSEQAIJSELL keep their own copy of the values, which is refreshed at assembly */
+      ierr = PetscObjectTypeCompare((PetscObject)Y,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+      if (!isseqaij) {
+        ierr = MatAssemblyBegin(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      }
+    } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
+      ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
+    } else {
+      Mat      B;
+      PetscInt *nnz;
+      ierr = PetscMalloc1(Y->rmap->N,&nnz);CHKERRQ(ierr);
+      ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
+      ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
+      ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
+      ierr = MatSetType(B,(MatType) ((PetscObject)Y)->type_name);CHKERRQ(ierr);
+      ierr = MatAXPYGetPreallocation_SeqAIJ(Y,X,nnz);CHKERRQ(ierr);
+      ierr = MatSeqAIJSetPreallocation(B,0,nnz);CHKERRQ(ierr);
+      ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
+      ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
+      ierr = PetscFree(nnz);CHKERRQ(ierr);
+      /* Y now holds the union of the patterns, keep the locations of X in it for the next call */
+      ierr = MatAXPYSetUp_SeqAIJ(Y,X);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -3442,7 +3519,7 @@ static struct _MatOps MatOps_Values = { MatSetValues_SeqAIJ,
                                         0,
                                 /* 74*/ 0,
                                         MatFDColoringApply_AIJ,
-                                        0,
+                                        MatSetFromOptions_SeqAIJ,
                                         0,
                                         0,
                                 /* 79*/ MatFindZeroDiagonals_SeqAIJ,
@@ -4075,6 +4152,48 @@ PetscErrorCode  MatSeqAIJSetPreallocationCSR_SeqAIJ(Mat B,const PetscInt Ii[],co
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a;
+  Mat_COO        *coo;
+  PetscInt       *ii,*jj;
+
+  PetscFunctionBegin;
+  ierr = MatCOOStructCreate_XAIJ(A,1,PETSC_FALSE,n,coo_i,coo_j,&ii,&jj,&coo);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocationCSR(A,ii,jj,NULL);CHKERRQ(ierr);
+  ierr = PetscFree(ii);CHKERRQ(ierr);
+  ierr = PetscFree(jj);CHKERRQ(ierr);
+  a    = (Mat_SeqAIJ*)A->data;
+  if (a->nz != coo->nA) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Matrix has %D nonzeros, COO pattern has %D",a->nz,coo->nA);
+  coo->nonzerostate = A->nonzerostate;
+  ierr = MatCOOStructDestroy_XAIJ(&a->coo);CHKERRQ(ierr);
+  a->coo = coo;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscBool      isseqaij;
+
+  PetscFunctionBegin;
+  if (!a->coo) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  ierr = MatCOOStructSetValues_XAIJ(A,a->coo,v,imode,a->a,NULL);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
+  if (A->offloadmask != PETSC_OFFLOAD_UNALLOCATED) A->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  /* derived formats such as MATSEQAIJSELL keep their own copy of the values, which is refreshed at assembly */
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij) {
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/dense/seq/dense.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
@@ -4428,6 +4547,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqbaij_C",MatConvert_SeqAIJ_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijperm_C",MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijsell_C",MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijmixed_C",MatConvert_SeqAIJ_SeqAIJMixed);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijdelta_C",MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijmkl_C",MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -4450,6 +4571,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaij_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaij_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
@@ -4518,9 +4641,12 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   } else c->diag = NULL;
 
   c->solve_work         = 0;
+  c->solvelevels        = NULL;
   c->saved_values       = 0;
   c->idiag              = 0;
   c->ssor_work          = 0;
+  c->sorcolorptr        = NULL;
+  c->sorcolorrows       = NULL;
   c->keepnonzeropattern = a->keepnonzeropattern;
   c->free_a             = PETSC_TRUE;
   c->free_ij            = PETSC_TRUE;
@@ -5060,6 +5186,8 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   ierr = MatSeqAIJRegister(MATSEQAIJCRL,      MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJPERM,     MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJSELL,     MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJMIXED,    MatConvert_SeqAIJ_SeqAIJMixed);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJDELTA,    MatConvert_SeqAIJ_SeqAIJDelta);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatSeqAIJRegister(MATSEQAIJMKL,      MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -5,6 +5,18 @@
 #include <petsc/private/matimpl.h>
 #include <petscctable.h>
 
+/*
+    Level schedule of the triangular solves of an LU or ILU factor, see MatFactorSetUpSolveLevels_SeqAIJ().
+    A row is in level l when the rows it depends on are in levels less than l.
+*/
+typedef struct {
+  PetscInt n;                         /* number of (block) rows */
+  PetscInt nlevels[2];                /* number of levels of L and of U */
+  PetscInt *order[2];                 /* the rows of L and of U sorted by increasing level */
+  PetscInt *done;                     /* epoch of the solve phase that last computed each row */
+  PetscInt epoch;
+} Mat_SeqAIJSolveLevels;
+
 /*
     Struct header shared by SeqAIJ, SeqBAIJ and SeqSBAIJ matrix formats
 */
@@ -34,6 +46,7 @@
   PetscBool         free_diag;         \
   datatype          *a;               /* nonzero elements */                               \
   PetscScalar       *solve_work;      /* work space used in MatSolve */                    \
+  Mat_SeqAIJSolveLevels *solvelevels; /* level schedule used by the multithreaded MatSolve */ \
   IS                row, col, icol;   /* index sets, used for reorderings */ \
   PetscBool         pivotinblocks;    /* pivot inside factorization of each diagonal block */ \
   Mat               parent;           /* set if this matrix was formed with MatDuplicate(...,MAT_SHARE_NONZERO_PATTERN,....); \
@@ -99,6 +112,9 @@ typedef struct {
 
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_SelectFormat(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_SelectFormat(Mat,const char[],PetscViewer);
+PETSC_INTERN PetscErrorCode MatSetFromOptions_SeqAIJ_SelectFormat(PetscOptionItems*,PetscInt*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Inode(Mat,MatOption,PetscBool);
@@ -120,6 +136,9 @@ typedef struct {
   PetscBool   ibdiagvalid;                    /* inverses of block diagonals are valid. */
   PetscBool   diagonaldense;                  /* all entries along the diagonal have been set; i.e. no missing diagonal terms */
   PetscScalar fshift,omega;                   /* last used omega and fshift */
+  PetscInt    sorncolors;                     /* number of colors of the multicolor SOR */
+  PetscInt    *sorcolorptr,*sorcolorrows;     /* rows of each color for the multicolor SOR */
+  PetscObjectState sorcolorstate;             /* nonzero state when the coloring was computed */
 
   ISColoring  coloring;                       /* set with MatADSetColoring() used by MatADSetValues() */
 
@@ -129,6 +148,14 @@ typedef struct {
   Mat_RARt            *rart;               /* used by MatRARt() */
   Mat_MatMatTransMult *abt;                /* used by MatMatTransposeMult() */
   Mat_MatTransMatMult *atb;                /* used by MatTransposeMatMult() */
+  Mat_COO             *coo;                /* used by MatSetValuesCOO() */
+  Mat_AXPY            *axpy;               /* locations of the nonzeros of the last X of MatAXPY() */
+
+  PetscInt            formatselect;        /* storage selection at assembly set with -mat_aij_select_format, 0 for none */
+  PetscInt            formatits;           /* number of products timed for each candidate by the timed selection */
+  PetscObjectState    formatstate;         /* nonzero state when the storage was selected with -mat_aij_select_format */
+  MatType             formattype;          /* the storage selected, the info is stale once the type differs */
+  char                *formatinfo;         /* the storage selected and why, reported by MatView() */
 } Mat_SeqAIJ;
 
 /*
@@ -147,6 +174,13 @@ PETSC_STATIC_INLINE PetscErrorCode MatSeqXAIJFreeAIJ(Mat AA,MatScalar **a,PetscI
   }
   return 0;
 }
+
+/*
+    The modeled memory traffic, see PetscLogBytes(), of streaming the nonzeros of an XAIJ (AIJ, BAIJ, and SBAIJ) matrix
+    once: the values of the nz blocks of size bs2, their column indices and the m+1 row offsets
+*/
+#define MatSeqXAIJMatrixBytes(nz,bs2,m) ((PetscLogDouble)(nz)*((bs2)*sizeof(MatScalar)+sizeof(PetscInt)) + ((m)+1.0)*sizeof(PetscInt))
+
 /*
     Allocates larger a, i, and j arrays for the XAIJ (AIJ, BAIJ, and SBAIJ) matrix types
     This is a macro because it takes the datatype as an argument which can be either a Mat or a MatScalar
@@ -237,6 +271,8 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_MultiColor(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
 
@@ -259,6 +295,11 @@ PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_InplaceWithPerm(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Levels(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatFactorSetUpSolveLevels_SeqAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSolveLevelsCreate_Private(PetscInt,const PetscInt[],const PetscInt[],const PetscInt[],Mat_SeqAIJSolveLevels**);
+PETSC_INTERN PetscErrorCode MatSeqAIJSolveLevelsDestroy_Private(Mat_SeqAIJSolveLevels**);
+PETSC_INTERN PetscErrorCode MatSeqAIJSolveLevelsNextEpoch_Private(Mat_SeqAIJSolveLevels*);
 PETSC_INTERN PetscErrorCode MatSolveAdd_SeqAIJ_inplace(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveAdd_SeqAIJ(Mat,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveTranspose_SeqAIJ_inplace(Mat,Vec,Vec);
@@ -347,6 +388,8 @@ PETSC_INTERN PetscErrorCode MatSetUp_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ(Mat,PetscViewer);
 
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal(Mat);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJCheckInode(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJCheckInode_FactorLU(Mat);
@@ -366,6 +409,8 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_Elemental(Mat,MatType,MatReuse,Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat,PetscReal,IS,IS);
@@ -440,6 +485,37 @@ PETSC_INTERN PetscErrorCode MatSeqAIJCompactOutExtraColumns_SeqAIJ(Mat,ISLocalTo
     for (__i=0; __i<nnz; __i++) sum -= xv[__i] * r[xi[__i]];}
 #endif
 
+/*
+    MatSeqAIJSolveLevelsWait_Private - Waits until row has been computed by the current phase of a
+    level scheduled solve, after which its values can be read by the calling thread
+
+    MatSeqAIJSolveLevelsSignal_Private - Marks row as computed by the current phase, after its
+    values have been written
+
+    Without OpenMP the rows are computed in level order by a single thread, so there is nothing to do
+*/
+PETSC_STATIC_INLINE void MatSeqAIJSolveLevelsWait_Private(const PetscInt *done,PetscInt row,PetscInt epoch)
+{
+#if defined(PETSC_HAVE_OPENMP)
+  PetscInt d;
+
+  do {
+#pragma omp atomic read
+    d = done[row];
+  } while (d != epoch);
+#pragma omp flush
+#endif
+}
+
+PETSC_STATIC_INLINE void MatSeqAIJSolveLevelsSignal_Private(PetscInt *done,PetscInt row,PetscInt epoch)
+{
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp flush
+#pragma omp atomic write
+  done[row] = epoch;
+#endif
+}
+
 
 
 /*
@@ -0,0 +1,619 @@
+/*
+  Defines basic operations for the MATSEQAIJDELTA matrix class.
+  This class is derived from the MATSEQAIJ class, but MatMult(), MatMultAdd(), MatMultTranspose()
+  and MatMultTransposeAdd() read a compressed copy of the column indices: each row stores its
+  first column, and its entries as unsigned offsets from that column in 16 bits, in 32 bits for
+  rows that span more columns (64 bit PetscInt only), or as the PetscInt of the base class for
+  the rows that span more than 2^31 columns. With 64 bit PetscInt this reduces the index traffic
+  of the products by a factor of 2 to 4.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petsc/private/kernels/simd.h>
+
+#define MATSEQAIJDELTA_WIDE 0 /* the row uses the column indices of Mat_SeqAIJ */
+#define MATSEQAIJDELTA_16   1
+#define MATSEQAIJDELTA_32   2
+
+typedef struct _Mat_SeqAIJDelta Mat_SeqAIJDelta;
+
+/* y = yin + A x for all the rows, yin may be NULL or y */
+typedef void (*MatSeqAIJDeltaMultKernel)(PetscInt,const PetscInt*,const PetscInt*,const MatScalar*,const Mat_SeqAIJDelta*,const PetscScalar*,const PetscScalar*,PetscScalar*);
+/* y = y + A^T x */
+typedef void (*MatSeqAIJDeltaMultTransposeKernel)(PetscInt,const PetscInt*,const PetscInt*,const MatScalar*,const Mat_SeqAIJDelta*,const PetscScalar*,PetscScalar*);
+
+struct _Mat_SeqAIJDelta {
+  PetscInt                          *base;         /* first column of each row */
+  unsigned char                     *width;        /* MATSEQAIJDELTA_16, MATSEQAIJDELTA_32 or MATSEQAIJDELTA_WIDE for each row */
+  unsigned short                    *d16;          /* offsets of the 16 bit rows, one row after the other */
+  unsigned int                      *d32;          /* offsets of the 32 bit rows, all smaller than 2^31 */
+  PetscInt                          n16,n32,nwide; /* number of entries stored in each width */
+  PetscObjectState                  nonzerostate;  /* nonzero state of the matrix when the offsets were computed */
+  MatSeqAIJDeltaMultKernel          mult;
+  MatSeqAIJDeltaMultTransposeKernel multtranspose;
+};
+
+/* Build or update the offsets if and only if the nonzero pattern changed. */
+static PetscErrorCode MatSeqAIJDeltaBuild_Private(Mat A)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJ      *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta *delta = (Mat_SeqAIJDelta*)A->spptr;
+  PetscInt        m      = A->rmap->n,i,k,n,span,n16 = 0,n32 = 0,nwide = 0;
+  const PetscInt  *ai    = a->i,*aj = a->j;
+
+  PetscFunctionBegin;
+  if (delta->width && delta->nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+
+  ierr = PetscLogEventBegin(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscFree2(delta->base,delta->width);CHKERRQ(ierr);
+  ierr = PetscFree(delta->d16);CHKERRQ(ierr);
+  ierr = PetscFree(delta->d32);CHKERRQ(ierr);
+  ierr = PetscMalloc2(m+1,&delta->base,m+1,&delta->width);CHKERRQ(ierr);
+  /* the columns of each row are sorted, so the span of a row is given by its first and last entries */
+  for (i=0; i<m; i++) {
+    n = ai[i+1] - ai[i];
+    delta->base[i] = n ? aj[ai[i]] : 0;
+    span           = n ? aj[ai[i+1]-1] - aj[ai[i]] : 0;
+    if (span < 65536) {
+      delta->width[i] = MATSEQAIJDELTA_16;
+      n16            += n;
+#if defined(PETSC_USE_64BIT_INDICES)
+    } else if (span < ((PetscInt)1 << 31)) {
+      delta->width[i] = MATSEQAIJDELTA_32;
+      n32            += n;
+#endif
+    } else {
+      delta->width[i] = MATSEQAIJDELTA_WIDE;
+      nwide          += n;
+    }
+  }
+  ierr = PetscMalloc1(n16+1,&delta->d16);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n32+1,&delta->d32);CHKERRQ(ierr);
+  n16  = n32 = 0;
+  for (i=0; i<m; i++) {
+    if (delta->width[i] == MATSEQAIJDELTA_16) {
+      for (k=ai[i]; k<ai[i+1]; k++) delta->d16[n16++] = (unsigned short)(aj[k] - delta->base[i]);
+    } else if (delta->width[i] == MATSEQAIJDELTA_32) {
+      for (k=ai[i]; k<ai[i+1]; k++) delta->d32[n32++] = (unsigned int)(aj[k] - delta->base[i]);
+    }
+  }
+  ierr = PetscLogEventEnd(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+
+  delta->n16          = n16;
+  delta->n32          = n32;
+  delta->nwide        = nwide;
+  delta->nonzerostate = A->nonzerostate;
+  ierr = PetscInfo4(A,"%D rows, %D entries with 16 bit offsets, %D with 32 bit offsets, %D with PetscInt indices\n",m,n16,n32,nwide);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* bytes of the matrix read by a product, compare to MatSeqXAIJMatrixBytes() */
+PETSC_STATIC_INLINE PetscLogDouble MatSeqAIJDeltaMatrixBytes(const Mat_SeqAIJDelta *delta,PetscInt nz,PetscInt m)
+{
+  return (PetscLogDouble)nz*sizeof(MatScalar) + (PetscLogDouble)delta->n16*sizeof(unsigned short) + (PetscLogDouble)delta->n32*sizeof(unsigned int)
+         + (PetscLogDouble)delta->nwide*sizeof(PetscInt) + (m+1.0)*sizeof(PetscInt) + m*(sizeof(PetscInt)+sizeof(unsigned char));
+}
+
+static void MatMultKernel_SeqAIJDelta(PetscInt m,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const Mat_SeqAIJDelta *delta,const PetscScalar *x,const PetscScalar *yin,PetscScalar *y)
+{
+  const unsigned short *d16 = delta->d16;
+  const unsigned int   *d32 = delta->d32;
+  const PetscScalar    *xb;
+  const MatScalar      *v;
+  const PetscInt       *idx;
+  PetscScalar          sum;
+  PetscInt             i,k,n;
+
+  for (i=0; i<m; i++) {
+    n   = ai[i+1] - ai[i];
+    v   = aa + ai[i];
+    xb  = x + delta->base[i];
+    sum = yin ? yin[i] : 0.0;
+    switch (delta->width[i]) {
+    case MATSEQAIJDELTA_16:
+      for (k=0; k<n; k++) sum += v[k]*xb[d16[k]];
+      d16 += n;
+      break;
+    case MATSEQAIJDELTA_32:
+      for (k=0; k<n; k++) sum += v[k]*xb[d32[k]];
+      d32 += n;
+      break;
+    default:
+      idx = aj + ai[i];
+      for (k=0; k<n; k++) sum += v[k]*x[idx[k]];
+    }
+    y[i] = sum;
+  }
+}
+
+static void MatMultTransposeKernel_SeqAIJDelta(PetscInt m,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const Mat_SeqAIJDelta *delta,const PetscScalar *x,PetscScalar *y)
+{
+  const unsigned short *d16 = delta->d16;
+  const unsigned int   *d32 = delta->d32;
+  PetscScalar          *yb,alpha;
+  const MatScalar      *v;
+  const PetscInt       *idx;
+  PetscInt             i,k,n;
+
+  for (i=0; i<m; i++) {
+    n     = ai[i+1] - ai[i];
+    v     = aa + ai[i];
+    yb    = y + delta->base[i];
+    alpha = x[i];
+    switch (delta->width[i]) {
+    case MATSEQAIJDELTA_16:
+      for (k=0; k<n; k++) yb[d16[k]] += alpha*v[k];
+      d16 += n;
+      break;
+    case MATSEQAIJDELTA_32:
+      for (k=0; k<n; k++) yb[d32[k]] += alpha*v[k];
+      d32 += n;
+      break;
+    default:
+      idx = aj + ai[i];
+      for (k=0; k<n; k++) y[idx[k]] += alpha*v[k];
+    }
+  }
+}
+
+/*
+   The offsets are widened to 32 bit integers in registers and used directly as the indices of the
+   gathers (and of the scatters for the transpose with AVX-512, which are safe since the columns
+   of a row are distinct).
+*/
+#if defined(PETSC_SIMD_USE_AVX2)
+static void PETSC_SIMD_TARGET_AVX2 MatMultKernel_SeqAIJDelta_AVX2(PetscInt m,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const Mat_SeqAIJDelta *delta,const PetscScalar *x,const PetscScalar *yin,PetscScalar *y)
+{
+  const unsigned short *d16 = delta->d16;
+  const unsigned int   *d32 = delta->d32;
+  const PetscScalar    *xb;
+  const MatScalar      *v;
+  const PetscInt       *idx;
+  PetscScalar          sum;
+  PetscInt             i,k,n;
+  __m256d              vsum;
+  __m128d              vlo;
+
+  for (i=0; i<m; i++) {
+    n    = ai[i+1] - ai[i];
+    v    = aa + ai[i];
+    xb   = x + delta->base[i];
+    sum  = yin ? yin[i] : 0.0;
+    vsum = _mm256_setzero_pd();
+    k    = 0;
+    switch (delta->width[i]) {
+    case MATSEQAIJDELTA_16:
+      for (; k+4<=n; k+=4) vsum = _mm256_fmadd_pd(_mm256_loadu_pd(v+k),_mm256_i32gather_pd(xb,_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(d16+k))),8),vsum);
+      for (; k<n; k++) sum += v[k]*xb[d16[k]];
+      d16 += n;
+      break;
+    case MATSEQAIJDELTA_32:
+      for (; k+4<=n; k+=4) vsum = _mm256_fmadd_pd(_mm256_loadu_pd(v+k),_mm256_i32gather_pd(xb,_mm_loadu_si128((const __m128i*)(d32+k)),8),vsum);
+      for (; k<n; k++) sum += v[k]*xb[d32[k]];
+      d32 += n;
+      break;
+    default:
+      idx = aj + ai[i];
+      for (; k<n; k++) sum += v[k]*x[idx[k]];
+    }
+    vlo  = _mm_add_pd(_mm256_castpd256_pd128(vsum),_mm256_extractf128_pd(vsum,1));
+    y[i] = sum + _mm_cvtsd_f64(_mm_add_sd(vlo,_mm_unpackhi_pd(vlo,vlo)));
+  }
+}
+
+static void PETSC_SIMD_TARGET_AVX2 MatMultTransposeKernel_SeqAIJDelta_AVX2(PetscInt m,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const Mat_SeqAIJDelta *delta,const PetscScalar *x,PetscScalar *y)
+{
+  const unsigned short *d16 = delta->d16;
+  const unsigned int   *d32 = delta->d32;
+  PetscScalar          *yb,alpha,t[4];
+  const MatScalar      *v;
+  const PetscInt       *idx;
+  PetscInt             i,k,n;
+  int                  c[4];
+  __m128i              vidx;
+  __m256d              valpha;
+
+  for (i=0; i<m; i++) {
+    n      = ai[i+1] - ai[i];
+    v      = aa + ai[i];
+    yb     = y + delta->base[i];
+    alpha  = x[i];
+    valpha = _mm256_set1_pd(alpha);
+    k      = 0;
+    switch (delta->width[i]) {
+    case MATSEQAIJDELTA_16:
+      for (; k+4<=n; k+=4) {
+        vidx = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)(d16+k)));
+        _mm256_storeu_pd(t,_mm256_fmadd_pd(valpha,_mm256_loadu_pd(v+k),_mm256_i32gather_pd(yb,vidx,8)));
+        _mm_storeu_si128((__m128i*)c,vidx);
+        yb[c[0]] = t[0]; yb[c[1]] = t[1]; yb[c[2]] = t[2]; yb[c[3]] = t[3];
+      }
+      for (; k<n; k++) yb[d16[k]] += alpha*v[k];
+      d16 += n;
+      break;
+    case MATSEQAIJDELTA_32:
+      for (; k+4<=n; k+=4) {
+        vidx = _mm_loadu_si128((const __m128i*)(d32+k));
+        _mm256_storeu_pd(t,_mm256_fmadd_pd(valpha,_mm256_loadu_pd(v+k),_mm256_i32gather_pd(yb,vidx,8)));
+        _mm_storeu_si128((__m128i*)c,vidx);
+        yb[c[0]] = t[0]; yb[c[1]] = t[1]; yb[c[2]] = t[2]; yb[c[3]] = t[3];
+      }
+      for (; k<n; k++) yb[d32[k]] += alpha*v[k];
+      d32 += n;
+      break;
+    default:
+      idx = aj + ai[i];
+      for (; k<n; k++) y[idx[k]] += alpha*v[k];
+    }
+  }
+}
+#endif
+
+#if defined(PETSC_SIMD_USE_AVX512)
+static void PETSC_SIMD_TARGET_AVX512 MatMultKernel_SeqAIJDelta_AVX512(PetscInt m,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const Mat_SeqAIJDelta *delta,const PetscScalar *x,const PetscScalar *yin,PetscScalar *y)
+{
+  const unsigned short *d16 = delta->d16;
+  const unsigned int   *d32 = delta->d32;
+  const PetscScalar    *xb;
+  const MatScalar      *v;
+  const PetscInt       *idx;
+  PetscScalar          sum;
+  PetscInt             i,k,n;
+  __m512d              vsum;
+  __m256d              vhalf;
+  __m128d              vlo;
+
+  for (i=0; i<m; i++) {
+    n    = ai[i+1] - ai[i];
+    v    = aa + ai[i];
+    xb   = x + delta->base[i];
+    sum  = yin ? yin[i] : 0.0;
+    vsum = _mm512_setzero_pd();
+    k    = 0;
+    switch (delta->width[i]) {
+    case MATSEQAIJDELTA_16:
+      for (; k+8<=n; k+=8) vsum = _mm512_fmadd_pd(_mm512_loadu_pd(v+k),_mm512_i32gather_pd(_mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(d16+k))),xb,8),vsum);
+      for (; k<n; k++) sum += v[k]*xb[d16[k]];
+      d16 += n;
+      break;
+    case MATSEQAIJDELTA_32:
+      for (; k+8<=n; k+=8) vsum = _mm512_fmadd_pd(_mm512_loadu_pd(v+k),_mm512_i32gather_pd(_mm256_loadu_si256((const __m256i*)(d32+k)),xb,8),vsum);
+      for (; k<n; k++) sum += v[k]*xb[d32[k]];
+      d32 += n;
+      break;
+    default:
+      idx = aj + ai[i];
+      for (; k<n; k++) sum += v[k]*x[idx[k]];
+    }
+    vhalf = _mm256_add_pd(_mm512_castpd512_pd256(vsum),_mm512_extractf64x4_pd(vsum,1));
+    vlo   = _mm_add_pd(_mm256_castpd256_pd128(vhalf),_mm256_extractf128_pd(vhalf,1));
+    y[i]  = sum + _mm_cvtsd_f64(_mm_add_sd(vlo,_mm_unpackhi_pd(vlo,vlo)));
+  }
+}
+
+static void PETSC_SIMD_TARGET_AVX512 MatMultTransposeKernel_SeqAIJDelta_AVX512(PetscInt m,const PetscInt *ai,const PetscInt *aj,const MatScalar *aa,const Mat_SeqAIJDelta *delta,const PetscScalar *x,PetscScalar *y)
+{
+  const unsigned short *d16 = delta->d16;
+  const unsigned int   *d32 = delta->d32;
+  PetscScalar          *yb,alpha;
+  const MatScalar      *v;
+  const PetscInt       *idx;
+  PetscInt             i,k,n;
+  __m256i              vidx;
+  __m512d              valpha;
+
+  for (i=0; i<m; i++) {
+    n      = ai[i+1] - ai[i];
+    v      = aa + ai[i];
+    yb     = y + delta->base[i];
+    alpha  = x[i];
+    valpha = _mm512_set1_pd(alpha);
+    k      = 0;
+    switch (delta->width[i]) {
+    case MATSEQAIJDELTA_16:
+      for (; k+8<=n; k+=8) {
+        vidx = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(d16+k)));
+        _mm512_i32scatter_pd(yb,vidx,_mm512_fmadd_pd(valpha,_mm512_loadu_pd(v+k),_mm512_i32gather_pd(vidx,yb,8)),8);
+      }
+      for (; k<n; k++) yb[d16[k]] += alpha*v[k];
+      d16 += n;
+      break;
+    case MATSEQAIJDELTA_32:
+      for (; k+8<=n; k+=8) {
+        vidx = _mm256_loadu_si256((const __m256i*)(d32+k));
+        _mm512_i32scatter_pd(yb,vidx,_mm512_fmadd_pd(valpha,_mm512_loadu_pd(v+k),_mm512_i32gather_pd(vidx,yb,8)),8);
+      }
+      for (; k<n; k++) yb[d32[k]] += alpha*v[k];
+      d32 += n;
+      break;
+    default:
+      idx = aj + ai[i];
+      for (; k<n; k++) y[idx[k]] += alpha*v[k];
+    }
+  }
+}
+#endif
+
+/*
+   Chooses the widest kernels allowed by PetscSIMDGetLevel()
+*/
+static PetscErrorCode MatSeqAIJDeltaSetSIMDKernels_Private(Mat A)
+{
+  Mat_SeqAIJDelta *delta = (Mat_SeqAIJDelta*)A->spptr;
+  PetscSIMDLevel  level;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSIMDGetLevel(&level);CHKERRQ(ierr);
+  delta->mult          = MatMultKernel_SeqAIJDelta;
+  delta->multtranspose = MatMultTransposeKernel_SeqAIJDelta;
+#if defined(PETSC_SIMD_USE_AVX2)
+  if (level >= PETSC_SIMD_AVX2) {
+    delta->mult          = MatMultKernel_SeqAIJDelta_AVX2;
+    delta->multtranspose = MatMultTransposeKernel_SeqAIJDelta_AVX2;
+  }
+#endif
+#if defined(PETSC_SIMD_USE_AVX512)
+  if (level >= PETSC_SIMD_AVX512) {
+    delta->mult          = MatMultKernel_SeqAIJDelta_AVX512;
+    delta->multtranspose = MatMultTransposeKernel_SeqAIJDelta_AVX512;
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJDelta(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *delta = (Mat_SeqAIJDelta*)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaBuild_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  (*delta->mult)(m,a->i,a->j,a->a,delta,x,NULL,y);
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqAIJDeltaMatrixBytes(delta,a->nz,m) + (A->cmap->n + m)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJDelta(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *delta = (Mat_SeqAIJDelta*)A->spptr;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaBuild_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  (*delta->mult)(m,a->i,a->j,a->a,delta,x,y,z);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqAIJDeltaMatrixBytes(delta,a->nz,m) + (A->cmap->n + 2.0*m)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultTransposeAdd_SeqAIJDelta(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJDelta   *delta = (Mat_SeqAIJDelta*)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJDeltaBuild_Private(A);CHKERRQ(ierr);
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  (*delta->multtranspose)(m,a->i,a->j,a->a,delta,x,y);
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqAIJDeltaMatrixBytes(delta,a->nz,m) + (m + 2.0*A->cmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultTranspose_SeqAIJDelta(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSet(yy,0.0);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd_SeqAIJDelta(A,xx,yy,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJDelta(Mat A,MatAssemblyType mode)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  /* the inode routines would replace the products below */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJDeltaDestroyData_Private(Mat A)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJDelta *delta = (Mat_SeqAIJDelta*)A->spptr;
+
+  PetscFunctionBegin;
+  if (!delta) PetscFunctionReturn(0);
+  ierr = PetscFree2(delta->base,delta->width);CHKERRQ(ierr);
+  ierr = PetscFree(delta->d16);CHKERRQ(ierr);
+  ierr = PetscFree(delta->d32);CHKERRQ(ierr);
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJDELTA to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy          = MatDestroy_SeqAIJ;
+  B->ops->mult             = MatMult_SeqAIJ;
+  B->ops->multadd          = MatMultAdd_SeqAIJ;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
+  ((Mat_SeqAIJ*)B->data)->inode.use = PETSC_TRUE;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijdelta_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijdelta_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijdelta_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijdelta_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijdelta_C",NULL);CHKERRQ(ierr);
+
+  ierr = MatSeqAIJDeltaDestroyData_Private(B);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this SeqAIJDelta matrix will not have an spptr pointer. */
+  ierr = MatSeqAIJDeltaDestroyData_Private(A);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* This function prototype is needed in MatConvert_SeqAIJ_SeqAIJDelta(), below. */
+PETSC_INTERN PetscErrorCode MatPtAP_IS_XAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
+
+/* MatConvert_SeqAIJ_SeqAIJDelta converts a SeqAIJ matrix into a
+ * SeqAIJDelta matrix.  This routine is called by the MatCreate_SeqAIJDelta()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJDelta one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode  ierr;
+  Mat             B = *newmat;
+  Mat_SeqAIJDelta *delta;
+  PetscBool       sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr     = PetscNewLog(B,&delta);CHKERRQ(ierr);
+  B->spptr = (void*)delta;
+  ierr     = MatSeqAIJDeltaSetSIMDKernels_Private(B);CHKERRQ(ierr);
+
+  /* Disable use of the inode routines so that the AIJDELTA ones will be used instead.
+   * This happens in MatAssemblyEnd_SeqAIJDelta as well, but the assembly end may not be called, so set it here, too. */
+  ((Mat_SeqAIJ*)B->data)->inode.use = PETSC_FALSE;
+
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJDelta;
+  B->ops->destroy          = MatDestroy_SeqAIJDelta;
+  B->ops->mult             = MatMult_SeqAIJDelta;
+  B->ops->multadd          = MatMultAdd_SeqAIJDelta;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJDelta;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJDelta;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijdelta_seqaij_C",MatConvert_SeqAIJDelta_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijdelta_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijdelta_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijdelta_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijdelta_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJDELTA);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatCreateSeqAIJDelta - Creates a sparse matrix of type SEQAIJDELTA.
+   This type inherits from AIJ and is largely identical, but MatMult(), MatMultAdd(),
+   MatMultTranspose() and MatMultTransposeAdd() read a compressed copy of the column indices:
+   the first column of each row, and the other columns as 16 bit offsets from it, or 32 bit
+   offsets for rows that span 65536 columns or more. Because SEQAIJDELTA is a subtype of SEQAIJ,
+   the option "-mat_seqaij_type seqaijdelta" can be used to make sequential AIJ matrices,
+   including the diagonal and off-diagonal blocks of MPIAIJ matrices, default to being instances
+   of MATSEQAIJDELTA.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to PETSC_COMM_SELF
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows)
+-  nnz - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or NULL
+
+   Output Parameter:
+.  A - the matrix
+
+   Notes:
+   If nnz is given then nz is ignored
+
+   The compressed indices are computed the first time the matrix is applied after its nonzero
+   pattern changed and are kept in addition to those of the base class; changing only the
+   values does not recompute them. The 32 bit offsets are only used with 64 bit PetscInt, rows
+   that span 2^31 columns or more use the PetscInt indices. With 64 bit PetscInt the index
+   traffic of the products is reduced by 4 for rows with a narrow band, which are the majority
+   for matrices from discretizations on a reasonably ordered mesh.
+
+   The products use AVX2 or AVX-512 gathers, chosen at run time with PetscSIMDGetLevel().
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatCreateMPIAIJDelta(), MatSetValues(), MATAIJDELTA
+@*/
+PetscErrorCode  MatCreateSeqAIJDelta(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,const PetscInt nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJDELTA);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(*A,nz,nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJDelta(A,MATSEQAIJDELTA,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
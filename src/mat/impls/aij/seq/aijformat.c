@@ -0,0 +1,192 @@
+/*
+  Selects the storage used by MatMult() for a MATSEQAIJ matrix when it is assembled, by converting
+  it in place to one of the subclasses of MATSEQAIJ.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petsctime.h>
+
+PETSC_INTERN PetscErrorCode MatSeqAIJPERM_create_perm(Mat);
+
+static const char *const MatSeqAIJFormatSelections[] = {"none","heuristic","timed"};
+
+typedef struct {
+  MatType        type;
+  PetscErrorCode (*convert)(Mat,MatType,MatReuse,Mat*);
+} MatSeqAIJFormatCandidate;
+
+/* the subclasses that only change the products, so the matrix stays a MATSEQAIJ for everything else */
+static const MatSeqAIJFormatCandidate MatSeqAIJFormatCandidates[] = {
+  {MATSEQAIJSELL,  MatConvert_SeqAIJ_SeqAIJSELL},
+  {MATSEQAIJPERM,  MatConvert_SeqAIJ_SeqAIJPERM},
+  {MATSEQAIJDELTA, MatConvert_SeqAIJ_SeqAIJDelta}
+};
+
+static PetscErrorCode MatSeqAIJFormatConvert_Private(Mat A,const MatSeqAIJFormatCandidate *candidate)
+{
+  PetscErrorCode ierr;
+  PetscBool      isperm;
+
+  PetscFunctionBegin;
+  ierr = (*candidate->convert)(A,candidate->type,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  /* the permutation is otherwise only computed when an assembled matrix is converted */
+  ierr = PetscStrcmp(candidate->type,MATSEQAIJPERM,&isperm);CHKERRQ(ierr);
+  if (isperm) {ierr = MatSeqAIJPERM_create_perm(A);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* seconds per MatMult() of A, after one product that builds the data of the lazy subclasses */
+static PetscErrorCode MatSeqAIJFormatTime_Private(Mat A,Vec x,Vec y,PetscInt its,PetscLogDouble *time)
+{
+  PetscErrorCode ierr;
+  PetscLogDouble t0,t1;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  ierr = (*A->ops->mult)(A,x,y);CHKERRQ(ierr);
+  ierr = PetscTime(&t0);CHKERRQ(ierr);
+  for (k=0; k<its; k++) {ierr = (*A->ops->mult)(A,x,y);CHKERRQ(ierr);}
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  *time = (t1 - t0)/its;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Registers the options of the selection, called by MatSetFromOptions() of MATSEQAIJ and MATMPIAIJ
+   so that only the matrices the user sets up from the options database select their storage
+*/
+PetscErrorCode MatSetFromOptions_SeqAIJ_SelectFormat(PetscOptionItems *PetscOptionsObject,PetscInt *select,PetscInt *its)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*its) *its = 5;
+  ierr = PetscOptionsEList("-mat_aij_select_format","Select the storage used by MatMult() at each final assembly","MatAssemblyEnd",MatSeqAIJFormatSelections,3,MatSeqAIJFormatSelections[*select],select,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_aij_select_format_its","Number of products timed for each storage by the timed selection","MatAssemblyEnd",*its,its,NULL);CHKERRQ(ierr);
+  if (*its < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of timed products %D must be positive",*its);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Called at the end of every final assembly of a MATSEQAIJ matrix, including the diagonal and
+   off-diagonal blocks of MATMPIAIJ matrices. The storage is selected once per nonzero pattern,
+   only for matrices that requested it in MatSetFromOptions() (so not for the matrices the library
+   creates internally, such as the products) and only for matrices that are still of the base type,
+   so a matrix that was converted keeps its format.
+
+   The heuristic keeps the I-node kernels when the rows come in groups of identical structure
+   (they use them as small dense blocks), prefers the 16 bit column offsets of MATSEQAIJDELTA
+   with 64 bit indices when almost all rows are narrow, and prefers the SELL slices of
+   MATSEQAIJSELL when the rows have similar lengths, so the slices need little padding.
+*/
+PetscErrorCode MatAssemblyEnd_SeqAIJ_SelectFormat(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ                     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode                 ierr;
+  PetscInt                       select = a->formatselect,its = a->formatits,m = A->rmap->n,nz = a->nz,i,n,c,best = -1;
+  PetscBool                      isseqaij;
+  PetscReal                      mean,dev = 0.0;
+#if defined(PETSC_USE_64BIT_INDICES)
+  PetscInt                       nnarrow = 0;
+  PetscReal                      narrow;
+#endif
+  PetscLogDouble                 time,besttime;
+  PetscSIMDLevel                 level;
+  const MatSeqAIJFormatCandidate *chosen = NULL;
+  char                           info[256];
+  Mat                            T;
+  Vec                            x,y;
+
+  PetscFunctionBegin;
+  if (!select || mode == MAT_FLUSH_ASSEMBLY || A->factortype || A->structure_only || !m || !nz) PetscFunctionReturn(0);
+  if (a->formatstate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+  if (!isseqaij) PetscFunctionReturn(0);
+  a->formatstate = A->nonzerostate;
+
+  mean = (PetscReal)nz/m;
+  for (i=0; i<m; i++) {
+    n    = a->i[i+1] - a->i[i];
+    dev += (n - mean)*(n - mean);
+#if defined(PETSC_USE_64BIT_INDICES)
+    if (n && a->j[a->i[i+1]-1] - a->j[a->i[i]] < 65536) nnarrow += n;
+#endif
+  }
+  dev    = PetscSqrtReal(dev/m)/mean;
+#if defined(PETSC_USE_64BIT_INDICES)
+  narrow = (PetscReal)nnarrow/nz;
+#endif
+
+  if (select == 1) {
+    ierr = PetscSIMDGetLevel(&level);CHKERRQ(ierr);
+    if (a->inode.size) {
+      ierr = PetscSNPrintf(info,sizeof(info),"%s with I-nodes (heuristic: %D I-nodes for %D rows)",MATSEQAIJ,a->inode.node_count,m);CHKERRQ(ierr);
+#if defined(PETSC_USE_64BIT_INDICES)
+    } else if (narrow > 0.9) {
+      chosen = &MatSeqAIJFormatCandidates[2];
+      ierr   = PetscSNPrintf(info,sizeof(info),"%s (heuristic: %g of the entries in rows narrower than 65536 columns)",chosen->type,(double)narrow);CHKERRQ(ierr);
+#endif
+    } else if (level >= PETSC_SIMD_AVX && dev < 0.25) {
+      chosen = &MatSeqAIJFormatCandidates[0];
+      ierr   = PetscSNPrintf(info,sizeof(info),"%s (heuristic: mean row length %g, relative deviation %g)",chosen->type,(double)mean,(double)dev);CHKERRQ(ierr);
+    } else {
+      ierr = PetscSNPrintf(info,sizeof(info),"%s (heuristic: mean row length %g, relative deviation %g)",MATSEQAIJ,(double)mean,(double)dev);CHKERRQ(ierr);
+    }
+  } else {
+    ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+    ierr = VecSet(x,1.0);CHKERRQ(ierr);
+    ierr = MatSeqAIJFormatTime_Private(A,x,y,its,&besttime);CHKERRQ(ierr);
+    ierr = PetscInfo2(A,"%s: %g seconds per product\n",MATSEQAIJ,(double)besttime);CHKERRQ(ierr);
+    /* the trials are made on copies, so the matrix being assembled is only converted once */
+    for (c=0; c<(PetscInt)(sizeof(MatSeqAIJFormatCandidates)/sizeof(MatSeqAIJFormatCandidates[0])); c++) {
+      ierr = MatDuplicate_SeqAIJ(A,MAT_COPY_VALUES,&T);CHKERRQ(ierr);
+      ierr = MatSeqAIJFormatConvert_Private(T,&MatSeqAIJFormatCandidates[c]);CHKERRQ(ierr);
+      ierr = MatSeqAIJFormatTime_Private(T,x,y,its,&time);CHKERRQ(ierr);
+      ierr = MatDestroy(&T);CHKERRQ(ierr);
+      ierr = PetscInfo2(A,"%s: %g seconds per product\n",MatSeqAIJFormatCandidates[c].type,(double)time);CHKERRQ(ierr);
+      /* a candidate must be clearly faster to be worth the extra storage it keeps */
+      if (time < 0.95*besttime) {
+        besttime = time;
+        best     = c;
+      }
+    }
+    ierr = VecDestroy(&x);CHKERRQ(ierr);
+    ierr = VecDestroy(&y);CHKERRQ(ierr);
+    if (best >= 0) chosen = &MatSeqAIJFormatCandidates[best];
+    ierr = PetscSNPrintf(info,sizeof(info),"%s (timed: %g seconds per product, mean row length %g, relative deviation %g)",chosen ? chosen->type : MATSEQAIJ,(double)besttime,(double)mean,(double)dev);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree(a->formatinfo);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(info,&a->formatinfo);CHKERRQ(ierr);
+  a->formattype = chosen ? chosen->type : MATSEQAIJ;
+  ierr = PetscInfo1(A,"Storage selected: %s\n",info);CHKERRQ(ierr);
+  if (chosen) {ierr = MatSeqAIJFormatConvert_Private(A,chosen);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+   Reports the selection made by MatAssemblyEnd_SeqAIJ_SelectFormat(), unless the type of the matrix
+   was changed afterwards, for example by MatSetType() or MatConvert(), so the selection no longer applies
+*/
+PetscErrorCode MatView_SeqAIJ_SelectFormat(Mat A,const char label[],PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii,same;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->formatinfo) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)A,a->formattype,&same);CHKERRQ(ierr);
+  if (!same) {
+    ierr = PetscFree(a->formatinfo);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format == PETSC_VIEWER_ASCII_INFO_DETAIL || format == PETSC_VIEWER_ASCII_INFO) {
+    ierr = PetscViewerASCIIPrintf(viewer,"%s selected at assembly: %s\n",label,a->formatinfo);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
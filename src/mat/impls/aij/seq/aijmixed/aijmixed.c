@@ -0,0 +1,549 @@
+/*
+  Defines basic operations for the MATSEQAIJMIXED matrix class.
+  This class is derived from the MATSEQAIJ class, but keeps a copy of the values in single
+  precision, and of the column indices in 16 bits when the matrix has few enough columns.
+  MatMult(), MatMultAdd(), MatSOR() and the triangular solves of ILU factors read these copies
+  instead of the full precision arrays and accumulate the sums in PetscScalar, which reduces
+  the memory traffic of these bandwidth bound kernels by 30 to 50 percent.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+typedef float MatScalarMixed;
+#else
+typedef MatScalar MatScalarMixed; /* no narrower type is available, only the column indices are compressed */
+#endif
+
+/* the compressed column indices are unsigned short */
+#define MATSEQAIJMIXED_MAXCOLUMNS 65536
+
+typedef struct {
+  MatScalarMixed   *a;            /* the values, with the same layout as the a[] of Mat_SeqAIJ */
+  unsigned short   *j;            /* the column indices, NULL if they are not compressed */
+  PetscInt         nz;            /* length of a[] and j[] */
+  PetscBool        shortindices;  /* compress the column indices when possible */
+  PetscObjectState state;         /* state of the matrix when the copies were made */
+  PetscErrorCode   (*lufactornumeric)(Mat,Mat,const MatFactorInfo*); /* numeric factorization of the base class, for ILU factors */
+} Mat_SeqAIJMixed;
+
+/* bytes of the matrix read by a product, compare to MatSeqXAIJMatrixBytes() */
+#define MatSeqAIJMixedMatrixBytes(mixed,nz,m) ((PetscLogDouble)(nz)*(sizeof(MatScalarMixed)+((mixed)->j ? sizeof(unsigned short) : sizeof(PetscInt))) + ((m)+1.0)*sizeof(PetscInt))
+
+/* sum of the n entries of the copy starting at position start times the entries of x */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJMixedDot(const Mat_SeqAIJMixed *mixed,const PetscInt *aj,PetscInt start,PetscInt n,const PetscScalar *x)
+{
+  const MatScalarMixed *v  = mixed->a + start;
+  PetscScalar          sum = 0.0;
+  PetscInt             k;
+
+  if (mixed->j) {
+    const unsigned short *j = mixed->j + start;
+    for (k=0; k<n; k++) sum += v[k]*x[j[k]];
+  } else {
+    const PetscInt *j = aj + start;
+    for (k=0; k<n; k++) sum += v[k]*x[j[k]];
+  }
+  return sum;
+}
+
+/* Build or update the reduced precision copies if and only if needed.
+ * We track the ObjectState to determine when this needs to be done. */
+static PetscErrorCode MatSeqAIJMixedBuild_Private(Mat A)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJMixed  *mixed = (Mat_SeqAIJMixed*)A->spptr;
+  PetscObjectState state;
+  PetscInt         i,nz;
+  PetscBool        shortindices;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (mixed->a && mixed->state == state) PetscFunctionReturn(0);
+
+  ierr = PetscLogEventBegin(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+  /* factors store the rows of U after those of L, see MatILUFactorSymbolic_SeqAIJ() */
+  nz           = A->factortype ? a->diag[0] + 1 : a->i[A->rmap->n];
+  shortindices = (mixed->shortindices && A->cmap->n <= MATSEQAIJMIXED_MAXCOLUMNS) ? PETSC_TRUE : PETSC_FALSE;
+  if (nz != mixed->nz || !mixed->a) {
+    ierr = PetscFree(mixed->a);CHKERRQ(ierr);
+    ierr = PetscFree(mixed->j);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nz+1,&mixed->a);CHKERRQ(ierr);
+    if (shortindices) {
+      ierr = PetscMalloc1(nz+1,&mixed->j);CHKERRQ(ierr);
+    }
+    ierr = PetscLogObjectMemory((PetscObject)A,(nz+1)*(sizeof(MatScalarMixed)+(shortindices ? sizeof(unsigned short) : 0)));CHKERRQ(ierr);
+    mixed->nz = nz;
+  }
+  for (i=0; i<nz; i++) mixed->a[i] = (MatScalarMixed)a->a[i];
+  if (mixed->j) {
+    for (i=0; i<nz; i++) mixed->j[i] = (unsigned short)a->j[i];
+  }
+  ierr = PetscLogEventEnd(MAT_Convert,A,0,0,0);CHKERRQ(ierr);
+
+  mixed->state = state;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJMixedCreateData_Private(Mat B)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJMixed *mixed;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(B,&mixed);CHKERRQ(ierr);
+  B->spptr = (void*)mixed;
+
+  mixed->shortindices = PETSC_TRUE;
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"AIJMIXED Options","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aijmixed_short_indices","Store the column indices in 16 bits when there are fewer than 65536 columns","None",mixed->shortindices,&mixed->shortindices,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJMixedDestroyData_Private(Mat A)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJMixed *mixed = (Mat_SeqAIJMixed*)A->spptr;
+
+  PetscFunctionBegin;
+  if (!mixed) PetscFunctionReturn(0);
+  ierr = PetscFree(mixed->a);CHKERRQ(ierr);
+  ierr = PetscFree(mixed->j);CHKERRQ(ierr);
+  ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJMixed_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJMIXED to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+  ((Mat_SeqAIJ*)B->data)->inode.use = PETSC_TRUE;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijmixed_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijmixed_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijmixed_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijmixed_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijmixed_C",NULL);CHKERRQ(ierr);
+
+  ierr = MatSeqAIJMixedDestroyData_Private(B);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJMixed(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this SeqAIJMixed matrix will not have an spptr pointer. */
+  ierr = MatSeqAIJMixedDestroyData_Private(A);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDuplicate_SeqAIJMixed(Mat A,MatDuplicateOption op,Mat *M)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJMixed *mixed = (Mat_SeqAIJMixed*)A->spptr,*mixed_dest;
+
+  PetscFunctionBegin;
+  ierr = MatDuplicate_SeqAIJ(A,op,M);CHKERRQ(ierr);
+  /* factors keep the type of their base class, so the copy does not get its data from MatSetType() */
+  if (!(*M)->spptr) {
+    ierr = MatSeqAIJMixedCreateData_Private(*M);CHKERRQ(ierr);
+  }
+  mixed_dest = (Mat_SeqAIJMixed*)(*M)->spptr;
+  /* the copies of the values are made when they are needed */
+  mixed_dest->shortindices    = mixed->shortindices;
+  mixed_dest->lufactornumeric = mixed->lufactornumeric;
+  (*M)->ops->destroy          = MatDestroy_SeqAIJMixed;
+  (*M)->ops->duplicate        = MatDuplicate_SeqAIJMixed;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJMixed(Mat A,MatAssemblyType mode)
+{
+  PetscErrorCode ierr;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  /* the inode routines would replace the products below */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJMixed(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJMixed   *mixed = (Mat_SeqAIJMixed*)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,i;
+  const PetscInt    *ii,*ridx;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJMixedBuild_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    ierr = PetscArrayzero(y,m);CHKERRQ(ierr);
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i=0; i<a->compressedrow.nrows; i++) y[ridx[i]] = MatSeqAIJMixedDot(mixed,a->j,ii[i],ii[i+1]-ii[i],x);
+  } else {
+    ii = a->i;
+    for (i=0; i<m; i++) y[i] = MatSeqAIJMixedDot(mixed,a->j,ii[i],ii[i+1]-ii[i],x);
+  }
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqAIJMixedMatrixBytes(mixed,a->nz,m) + (A->cmap->n + m)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJMixed(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJMixed   *mixed = (Mat_SeqAIJMixed*)A->spptr;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,i;
+  const PetscInt    *ii,*ridx;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJMixedBuild_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    if (zz != yy) {
+      ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
+    }
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i=0; i<a->compressedrow.nrows; i++) z[ridx[i]] = y[ridx[i]] + MatSeqAIJMixedDot(mixed,a->j,ii[i],ii[i+1]-ii[i],x);
+  } else {
+    ii = a->i;
+    for (i=0; i<m; i++) z[i] = y[i] + MatSeqAIJMixedDot(mixed,a->j,ii[i],ii[i+1]-ii[i],x);
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqAIJMixedMatrixBytes(mixed,a->nz,m) + (A->cmap->n + 2.0*m)*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The sweeps of MatSOR_SeqAIJ() with the reduced precision copies; the diagonal and its inverse
+   are kept in full precision. Eisenstat's trick and the application of the triangular parts are
+   left to MatSOR_SeqAIJ().
+*/
+PetscErrorCode MatSOR_SeqAIJMixed(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJMixed   *mixed = (Mat_SeqAIJMixed*)A->spptr;
+  PetscScalar       *x,sum,*t;
+  const PetscScalar *b,*xb,*idiag,*mdiag;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,i;
+  const PetscInt    *ai = a->i,*aj = a->j,*diag;
+  PetscLogDouble    mbytes,vbytes = m*sizeof(PetscScalar);
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & (SOR_EISENSTAT | SOR_MULTICOLOR))) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr   = MatSeqAIJMixedBuild_Private(A);CHKERRQ(ierr);
+  mbytes = MatSeqAIJMixedMatrixBytes(mixed,a->nz,m);
+  its    = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        sum  = b[i] - MatSeqAIJMixedDot(mixed,aj,ai[i],diag[i]-ai[i],x);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+      ierr = PetscLogBytes(0.5*mbytes + 4.0*vbytes);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum = xb[i] - MatSeqAIJMixedDot(mixed,aj,diag[i]+1,ai[i+1]-diag[i]-1,x);
+        if (xb == b) x[i] = sum*idiag[i];
+        else         x[i] = (1-omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      ierr = PetscLogBytes(0.5*mbytes + 4.0*vbytes);CHKERRQ(ierr);
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        sum  = b[i] - MatSeqAIJMixedDot(mixed,aj,ai[i],diag[i]-ai[i],x);
+        t[i] = sum;             /* save application of the lower-triangular part */
+        sum -= MatSeqAIJMixedDot(mixed,aj,diag[i]+1,ai[i+1]-diag[i]-1,x);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      ierr = PetscLogBytes(mbytes + 5.0*vbytes);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          sum  = xb[i] - MatSeqAIJMixedDot(mixed,aj,ai[i],ai[i+1]-ai[i],x);
+          x[i] = (1. - omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          sum  = xb[i] - MatSeqAIJMixedDot(mixed,aj,diag[i]+1,ai[i+1]-diag[i]-1,x);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+        ierr = PetscLogBytes(mbytes + 5.0*vbytes);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+        ierr = PetscLogBytes(0.5*mbytes + 4.0*vbytes);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSolve_SeqAIJ() with the reduced precision copy of the factor, which stores L by rows
+   followed by U from the last row to the first with the inverse of the diagonal
+*/
+PetscErrorCode MatSolve_SeqAIJMixed(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJMixed   *mixed = (Mat_SeqAIJMixed*)A->spptr;
+  PetscErrorCode    ierr;
+  PetscInt          i,n = A->rmap->n;
+  const PetscInt    *ai = a->i,*aj = a->j,*adiag = a->diag,*r,*c;
+  PetscScalar       *x,*tmp,sum;
+  const PetscScalar *b;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = MatSeqAIJMixedBuild_Private(A);CHKERRQ(ierr);
+
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  tmp  = a->solve_work;
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+
+  /* forward solve the lower triangular */
+  tmp[0] = b[r[0]];
+  for (i=1; i<n; i++) tmp[i] = b[r[i]] - MatSeqAIJMixedDot(mixed,aj,ai[i],ai[i+1]-ai[i],tmp);
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    sum     = tmp[i] - MatSeqAIJMixedDot(mixed,aj,adiag[i+1]+1,adiag[i]-adiag[i+1]-1,tmp);
+    x[c[i]] = tmp[i] = sum*mixed->a[adiag[i]];
+  }
+
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqAIJMixedMatrixBytes(mixed,mixed->nz,n) + 2.0*n*sizeof(PetscInt) + 4.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqAIJMixed(Mat B,Mat A,const MatFactorInfo *info)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJMixed *mixed = (Mat_SeqAIJMixed*)B->spptr;
+
+  PetscFunctionBegin;
+  ierr = (*mixed->lufactornumeric)(B,A,info);CHKERRQ(ierr);
+  /* the in-place factorizations store the factor differently and keep their own solve */
+  if (B->ops->solve == MatSolve_SeqAIJ || B->ops->solve == MatSolve_SeqAIJ_NaturalOrdering || B->ops->solve == MatSolve_SeqAIJ_Inode) {
+    B->ops->solve = MatSolve_SeqAIJMixed;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqAIJMixed(Mat fact,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  PetscErrorCode  ierr;
+  Mat_SeqAIJMixed *mixed;
+
+  PetscFunctionBegin;
+  ierr = MatILUFactorSymbolic_SeqAIJ(fact,A,isrow,iscol,info);CHKERRQ(ierr);
+  if (!fact->spptr) {
+    ierr = MatSeqAIJMixedCreateData_Private(fact);CHKERRQ(ierr);
+  }
+  mixed                      = (Mat_SeqAIJMixed*)fact->spptr;
+  mixed->lufactornumeric     = fact->ops->lufactornumeric;
+  fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJMixed;
+  fact->ops->destroy         = MatDestroy_SeqAIJMixed;
+  fact->ops->duplicate       = MatDuplicate_SeqAIJMixed;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The factors are computed in full precision by the MATSEQAIJ code; only the triangular solves of
+   ILU factors use a reduced precision copy of the factor. LU factors, which are usually used as
+   exact coarse solvers, keep their full precision solves.
+*/
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_petsc(Mat,MatFactorType,Mat*);
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqaijmixed_petsc(Mat A,MatFactorType ftype,Mat *B)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetFactor_seqaij_petsc(A,ftype,B);CHKERRQ(ierr);
+  if (ftype == MAT_FACTOR_ILU) (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqAIJMixed;
+  PetscFunctionReturn(0);
+}
+
+/* This function prototype is needed in MatConvert_SeqAIJ_SeqAIJMixed(), below. */
+PETSC_INTERN PetscErrorCode MatPtAP_IS_XAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
+
+/* MatConvert_SeqAIJ_SeqAIJMixed converts a SeqAIJ matrix into a
+ * SeqAIJMixed matrix.  This routine is called by the MatCreate_SeqAIJMixed()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJMixed one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+  PetscBool      sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr = MatSeqAIJMixedCreateData_Private(B);CHKERRQ(ierr);
+
+  /* Disable use of the inode routines so that the AIJMIXED ones will be used instead.
+   * This happens in MatAssemblyEnd_SeqAIJMixed as well, but the assembly end may not be called, so set it here, too. */
+  ((Mat_SeqAIJ*)B->data)->inode.use = PETSC_FALSE;
+
+  B->ops->duplicate   = MatDuplicate_SeqAIJMixed;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJMixed;
+  B->ops->destroy     = MatDestroy_SeqAIJMixed;
+  B->ops->mult        = MatMult_SeqAIJMixed;
+  B->ops->multadd     = MatMultAdd_SeqAIJMixed;
+  B->ops->sor         = MatSOR_SeqAIJMixed;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijmixed_seqaij_C",MatConvert_SeqAIJMixed_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijmixed_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijmixed_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijmixed_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijmixed_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJMIXED);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   MatCreateSeqAIJMixed - Creates a sparse matrix of type SEQAIJMIXED.
+   This type inherits from AIJ and is largely identical, but MatMult(), MatMultAdd(), MatSOR()
+   and the triangular solves of its ILU factors read a single precision copy of the values, and
+   a 16 bit copy of the column indices when there are fewer than 65536 columns, while the sums
+   are accumulated in PetscScalar. Because SEQAIJMIXED is a subtype of SEQAIJ, the option
+   "-mat_seqaij_type seqaijmixed" can be used to make sequential AIJ matrices, including the
+   diagonal and off-diagonal blocks of MPIAIJ matrices and the coarse operators built by PCMG and
+   PCGAMG, default to being instances of MATSEQAIJMIXED.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to PETSC_COMM_SELF
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows)
+-  nnz - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or NULL
+
+   Output Parameter:
+.  A - the matrix
+
+   Options Database Keys:
+.  -mat_aijmixed_short_indices <true> - Store the column indices in 16 bits when possible
+
+   Notes:
+   If nnz is given then nz is ignored
+
+   The products are only accurate to single precision; this type is meant for the operators
+   used inside preconditioners, such as multigrid smoothers and level operators, not for the
+   operator whose residual is monitored. Only with real double precision scalars are the values
+   stored in single precision; otherwise only the column indices are compressed.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatCreateMPIAIJMixed(), MatSetValues(), MATAIJMIXED
+@*/
+PetscErrorCode  MatCreateSeqAIJMixed(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,const PetscInt nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,m,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJMIXED);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(*A,nz,nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMixed(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJMixed(A,MATSEQAIJMIXED,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
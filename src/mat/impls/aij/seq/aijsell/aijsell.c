@@ -168,7 +168,7 @@ PetscErrorCode MatMult_SeqAIJSELL(Mat A,Vec xx,Vec yy)
 
   PetscFunctionBegin;
   ierr = MatSeqAIJSELL_build_shadow(A);CHKERRQ(ierr);
-  ierr = MatMult_SeqSELL(aijsell->S,xx,yy);CHKERRQ(ierr);
+  ierr = (*aijsell->S->ops->mult)(aijsell->S,xx,yy);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -190,7 +190,7 @@ PetscErrorCode MatMultAdd_SeqAIJSELL(Mat A,Vec xx,Vec yy,Vec zz)
 
   PetscFunctionBegin;
   ierr = MatSeqAIJSELL_build_shadow(A);CHKERRQ(ierr);
-  ierr = MatMultAdd_SeqSELL(aijsell->S,xx,yy,zz);CHKERRQ(ierr);
+  ierr = (*aijsell->S->ops->multadd)(aijsell->S,xx,yy,zz);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -211,6 +211,11 @@ PetscErrorCode MatSOR_SeqAIJSELL(Mat A,Vec bb,PetscReal omega,MatSORType flag,Pe
   PetscErrorCode    ierr;
 
   PetscFunctionBegin;
+  if (flag & SOR_MULTICOLOR) {
+    /* the sweeps by color are done on the AIJ storage */
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MatSeqAIJSELL_build_shadow(A);CHKERRQ(ierr);
   ierr = MatSOR_SeqSELL(aijsell->S,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -0,0 +1,219 @@
+/*
+  Level scheduled triangular solves of MATSEQAIJ LU and ILU factors, which run the rows of a level
+  concurrently with OpenMP threads.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/* each thread computes this many consecutive rows of the level order at a time */
+#define MAT_SOLVE_LEVELS_CHUNK 16
+
+/* sorts the rows by increasing level, the rows of a level are kept in their order of the sequential solve */
+static PetscErrorCode MatSeqAIJSolveLevelsSort_Private(PetscInt n,const PetscInt level[],PetscInt nlevels,PetscBool backward,PetscInt order[])
+{
+  PetscErrorCode ierr;
+  PetscInt       *start,i,l,row;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(nlevels+1,&start);CHKERRQ(ierr);
+  for (i=0; i<n; i++) start[level[i]+1]++;
+  for (l=0; l<nlevels; l++) start[l+1] += start[l];
+  for (i=0; i<n; i++) {
+    row                        = backward ? n-1-i : i;
+    order[start[level[row]]++] = row;
+  }
+  ierr = PetscFree(start);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the levels of the factor stored as by MatLUFactorNumeric_SeqAIJ(): row i of L is in
+   aj[ai[i]..ai[i+1]) and row i of U is in aj[adiag[i+1]+1..adiag[i]). The same arrays of
+   MATSEQBAIJ factors give the levels of the block rows.
+*/
+PetscErrorCode MatSeqAIJSolveLevelsCreate_Private(PetscInt n,const PetscInt ai[],const PetscInt aj[],const PetscInt adiag[],Mat_SeqAIJSolveLevels **levels)
+{
+  PetscErrorCode        ierr;
+  Mat_SeqAIJSolveLevels *lv;
+  PetscInt              *level,i,k,l,nl;
+
+  PetscFunctionBegin;
+  ierr  = PetscNew(&lv);CHKERRQ(ierr);
+  lv->n = n;
+  ierr  = PetscMalloc3(n,&lv->order[0],n,&lv->order[1],n,&lv->done);CHKERRQ(ierr);
+  ierr  = PetscArrayzero(lv->done,n);CHKERRQ(ierr);
+  ierr  = PetscMalloc1(n,&level);CHKERRQ(ierr);
+
+  nl = 0;
+  for (i=0; i<n; i++) {
+    l = 0;
+    for (k=ai[i]; k<ai[i+1]; k++) l = PetscMax(l,level[aj[k]]+1);
+    level[i] = l;
+    nl       = PetscMax(nl,l+1);
+  }
+  lv->nlevels[0] = nl;
+  ierr = MatSeqAIJSolveLevelsSort_Private(n,level,nl,PETSC_FALSE,lv->order[0]);CHKERRQ(ierr);
+
+  /* the rows of U only depend on rows below them, whose levels were already overwritten */
+  nl = 0;
+  for (i=n-1; i>=0; i--) {
+    l = 0;
+    for (k=adiag[i+1]+1; k<adiag[i]; k++) l = PetscMax(l,level[aj[k]]+1);
+    level[i] = l;
+    nl       = PetscMax(nl,l+1);
+  }
+  lv->nlevels[1] = nl;
+  ierr = MatSeqAIJSolveLevelsSort_Private(n,level,nl,PETSC_TRUE,lv->order[1]);CHKERRQ(ierr);
+
+  ierr    = PetscFree(level);CHKERRQ(ierr);
+  *levels = lv;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJSolveLevelsDestroy_Private(Mat_SeqAIJSolveLevels **levels)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*levels) PetscFunctionReturn(0);
+  ierr = PetscFree3((*levels)->order[0],(*levels)->order[1],(*levels)->done);CHKERRQ(ierr);
+  ierr = PetscFree(*levels);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Starts a solve: its L phase uses lv->epoch and its U phase the next one, so the counters
+   never need to be cleared between phases or solves
+*/
+PetscErrorCode MatSeqAIJSolveLevelsNextEpoch_Private(Mat_SeqAIJSolveLevels *lv)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (lv->epoch > PETSC_MAX_INT - 3) {
+    ierr      = PetscArrayzero(lv->done,lv->n);CHKERRQ(ierr);
+    lv->epoch = 0;
+  }
+  lv->epoch += 2;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatFactorSetUpSolveLevels_SeqAIJ - Called at the end of the numeric LU and ILU factorizations;
+   with the option -mat_factor_solve_levels it computes the levels of the factor and replaces
+   MatSolve() by MatSolve_SeqAIJ_Levels().
+
+   Each row is computed with the operations of MatSolve_SeqAIJ(), in the same order, so the
+   solution does not depend on the number of threads and matches MatSolve_SeqAIJ() bit for bit; the
+   I-node solve, which the factor would otherwise use, sums in another order.
+*/
+PetscErrorCode MatFactorSetUpSolveLevels_SeqAIJ(Mat fact)
+{
+  Mat_SeqAIJ     *b = (Mat_SeqAIJ*)fact->data;
+  PetscErrorCode ierr;
+  PetscBool      flg = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSolveLevelsDestroy_Private(&b->solvelevels);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(((PetscObject)fact)->options,((PetscObject)fact)->prefix,"-mat_factor_solve_levels",&flg,NULL);CHKERRQ(ierr);
+  if (!flg) PetscFunctionReturn(0);
+  ierr = MatSeqAIJSolveLevelsCreate_Private(fact->rmap->n,b->i,b->j,b->diag,&b->solvelevels);CHKERRQ(ierr);
+  ierr = PetscInfo3(fact,"%D rows in %D levels of L and %D levels of U\n",fact->rmap->n,b->solvelevels->nlevels[0],b->solvelevels->nlevels[1]);CHKERRQ(ierr);
+  fact->ops->solve = MatSolve_SeqAIJ_Levels;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The rows are handed out to the threads in chunks of the level order. A thread computes its rows
+   in that order and waits for the rows they depend on, which are in earlier levels, instead of
+   waiting for all threads at the end of each level.
+*/
+PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJSolveLevels *lv = a->solvelevels;
+  PetscErrorCode        ierr;
+  PetscInt              n = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag,*done,epoch;
+  const PetscInt        *rout,*cout,*r,*c,*orderL,*orderU;
+  PetscScalar           *x,*tmp;
+  const PetscScalar     *b;
+  const MatScalar       *aa = a->a;
+
+  PetscFunctionBegin;
+  if (!lv) {
+    /* a duplicate of the factor, which does not share the levels */
+    ierr = MatSolve_SeqAIJ(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (!n) PetscFunctionReturn(0);
+  ierr = MatSeqAIJSolveLevelsNextEpoch_Private(lv);CHKERRQ(ierr);
+
+  ierr   = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr   = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  tmp    = a->solve_work;
+  done   = lv->done;
+  epoch  = lv->epoch;
+  orderL = lv->order[0];
+  orderU = lv->order[1];
+
+  ierr = ISGetIndices(a->row,&rout);CHKERRQ(ierr); r = rout;
+  ierr = ISGetIndices(a->col,&cout);CHKERRQ(ierr); c = cout;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    PetscInt        tid = 0,nt = 1,p0,p,pend,i,k,nz;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar     sum;
+
+#if defined(PETSC_HAVE_OPENMP)
+    tid = omp_get_thread_num();
+    nt  = omp_get_num_threads();
+#endif
+    /* forward solve the lower triangular */
+    for (p0=tid*MAT_SOLVE_LEVELS_CHUNK; p0<n; p0+=nt*MAT_SOLVE_LEVELS_CHUNK) {
+      pend = PetscMin(p0+MAT_SOLVE_LEVELS_CHUNK,n);
+      for (p=p0; p<pend; p++) {
+        i   = orderL[p];
+        nz  = ai[i+1] - ai[i];
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        for (k=0; k<nz; k++) MatSeqAIJSolveLevelsWait_Private(done,vi[k],epoch);
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        tmp[i] = sum;
+        MatSeqAIJSolveLevelsSignal_Private(done,i,epoch);
+      }
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp barrier
+#endif
+    /* backward solve the upper triangular */
+    for (p0=tid*MAT_SOLVE_LEVELS_CHUNK; p0<n; p0+=nt*MAT_SOLVE_LEVELS_CHUNK) {
+      pend = PetscMin(p0+MAT_SOLVE_LEVELS_CHUNK,n);
+      for (p=p0; p<pend; p++) {
+        i   = orderU[p];
+        v   = aa + adiag[i+1]+1;
+        vi  = aj + adiag[i+1]+1;
+        nz  = adiag[i]-adiag[i+1]-1;
+        for (k=0; k<nz; k++) MatSeqAIJSolveLevelsWait_Private(done,vi[k],epoch+1);
+        sum = tmp[i];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+        MatSeqAIJSolveLevelsSignal_Private(done,i,epoch+1);
+      }
+    }
+  }
+
+  ierr = ISRestoreIndices(a->row,&rout);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&cout);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,134 @@
+/*
+  Multicolor SOR of MATSEQAIJ matrices, MatSOR() with SOR_MULTICOLOR. The rows of a color are
+  not coupled to each other so each color is relaxed with one SpMV-like loop run by the OpenMP threads.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/*
+   Computes a distance one coloring of the graph of A + A^T with MatColoring and sorts the rows
+   by color; it is recomputed only when the nonzero structure of A changes
+*/
+static PetscErrorCode MatSORMultiColorSetUp_SeqAIJ(Mat A)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode        ierr;
+  Mat                   G = A;
+  MatColoring           mc;
+  ISColoring            iscoloring;
+  const ISColoringValue *colors;
+  PetscInt              m = A->rmap->n,nc,i,c,*ptr,*rows;
+
+  PetscFunctionBegin;
+  if (a->sorcolorptr && a->sorcolorstate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = PetscFree2(a->sorcolorptr,a->sorcolorrows);CHKERRQ(ierr);
+
+  /* rows of the same color may not reference each other in either direction */
+  if (!(A->structurally_symmetric_set && A->structurally_symmetric) && !(A->symmetric_set && A->symmetric)) {
+    ierr = MatTranspose(A,MAT_INITIAL_MATRIX,&G);CHKERRQ(ierr);
+    ierr = MatAXPY(G,1.0,A,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  }
+  ierr = MatColoringCreate(G,&mc);CHKERRQ(ierr);
+  ierr = MatColoringSetType(mc,MATCOLORINGGREEDY);CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(mc,1);CHKERRQ(ierr);
+  ierr = MatColoringSetWeightType(mc,MAT_COLORING_WEIGHT_LEXICAL);CHKERRQ(ierr);
+  ierr = MatColoringApply(mc,&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
+  if (G != A) {ierr = MatDestroy(&G);CHKERRQ(ierr);}
+
+  ierr = ISColoringGetColors(iscoloring,NULL,&nc,&colors);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nc+1,&ptr,m,&rows);CHKERRQ(ierr);
+  ierr = PetscArrayzero(ptr,nc+1);CHKERRQ(ierr);
+  for (i=0; i<m; i++) ptr[colors[i]+1]++;
+  for (c=0; c<nc; c++) ptr[c+1] += ptr[c];
+  for (i=0; i<m; i++) rows[ptr[colors[i]]++] = i;
+  for (c=nc; c>0; c--) ptr[c] = ptr[c-1];
+  ptr[0] = 0;
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+
+  a->sorncolors    = nc;
+  a->sorcolorptr   = ptr;
+  a->sorcolorrows  = rows;
+  a->sorcolorstate = A->nonzerostate;
+  ierr = PetscLogObjectMemory((PetscObject)A,(nc+1+m)*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscInfo2(A,"%D rows in %D colors\n",m,nc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* relaxes the rows of color c, each row reads only entries of x of the other colors */
+static void MatSORMultiColorRelax_SeqAIJ(Mat_SeqAIJ *a,PetscInt c,PetscReal omega,const PetscScalar *b,PetscScalar *x)
+{
+  const PetscInt    *rows = a->sorcolorrows + a->sorcolorptr[c],*ai = a->i,*aj = a->j,*diag = a->diag;
+  const MatScalar   *aa = a->a;
+  const PetscScalar *idiag = a->idiag;
+  PetscInt          nr = a->sorcolorptr[c+1] - a->sorcolorptr[c],p;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+  for (p=0; p<nr; p++) {
+    const PetscInt  i = rows[p];
+    const PetscInt  *idx;
+    const MatScalar *v;
+    PetscInt        n;
+    PetscScalar     sum = b[i];
+
+    n   = diag[i] - ai[i];
+    idx = aj + ai[i];
+    v   = aa + ai[i];
+    PetscSparseDenseMinusDot(sum,x,v,idx,n);
+    n   = ai[i+1] - diag[i] - 1;
+    idx = aj + diag[i] + 1;
+    v   = aa + diag[i] + 1;
+    PetscSparseDenseMinusDot(sum,x,v,idx,n);
+    x[i] = (1.0 - omega)*x[i] + sum*idiag[i];
+  }
+}
+
+/*
+   MatSOR_SeqAIJ_MultiColor - SOR with the rows relaxed one color after the other, as if the matrix
+   were symmetrically permuted by color. Forward sweeps run through the colors in increasing order,
+   backward sweeps in decreasing order; the local and global sweeps are the same for MATSEQAIJ.
+
+   The result does not depend on the number of threads.
+*/
+PetscErrorCode MatSOR_SeqAIJ_MultiColor(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  PetscInt          c,nc,m = A->rmap->n,nsweeps;
+  PetscLogDouble    mbytes = MatSeqXAIJMatrixBytes(a->nz,1,m),vbytes = m*sizeof(PetscScalar);
+
+  PetscFunctionBegin;
+  if (flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"SOR_MULTICOLOR only supports the forward, backward and symmetric sweeps");
+  its = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+  ierr = MatSORMultiColorSetUp_SeqAIJ(A);CHKERRQ(ierr);
+  nc   = a->sorncolors;
+
+  if (flag & SOR_ZERO_INITIAL_GUESS) {ierr = VecSet(xx,0.0);CHKERRQ(ierr);}
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  nsweeps = 0;
+  while (its--) {
+    if (flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP)) {
+      for (c=0; c<nc; c++) MatSORMultiColorRelax_SeqAIJ(a,c,omega,b,x);
+      nsweeps++;
+    }
+    if (flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP)) {
+      for (c=nc-1; c>=0; c--) MatSORMultiColorRelax_SeqAIJ(a,c,omega,b,x);
+      nsweeps++;
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = PetscLogFlops(nsweeps*(2.0*a->nz + 2.0*m));CHKERRQ(ierr);
+  ierr = PetscLogBytes(nsweeps*(mbytes + 3.0*vbytes));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1445,63 +1445,65 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqDense(Mat A,Mat B,PetscReal fill,Mat
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat C)
+/*
+   C += A*X where the k columns of X are interleaved, X(j,c) = x[j*k+c], and C is stored by columns
+   with leading dimension ldc. Each row of A is read once for all the columns, which are accumulated
+   in groups of MAT_DENSE_INTERLEAVED_NCOLS; the group of X used by an entry of A is contiguous.
+*/
+PetscErrorCode MatMatMultNumericAdd_SeqAIJ_Interleaved(Mat A,PetscInt k,const PetscScalar x[],PetscScalar c[],PetscInt ldc)
 {
-  Mat_SeqAIJ        *a=(Mat_SeqAIJ*)A->data;
-  Mat_SeqDense      *bd = (Mat_SeqDense*)B->data;
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
   PetscErrorCode    ierr;
-  PetscScalar       *c,r1,r2,r3,r4,*c1,*c2,*c3,*c4,aatmp;
-  const PetscScalar *aa,*b,*b1,*b2,*b3,*b4,*av;
+  PetscScalar       r[MAT_DENSE_INTERLEAVED_NCOLS],aatmp;
+  const PetscScalar *aa,*av,*xj;
   const PetscInt    *aj;
-  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=bd->lda,am=A->rmap->n;
-  PetscInt          am4=4*am,bm4=4*bm,col,i,j,n,ajtmp;
+  PetscInt          am = A->rmap->n,i,j,n,col,ncols,t;
 
   PetscFunctionBegin;
-  if (!cm || !cn) PetscFunctionReturn(0);
+  if (!am || !k) PetscFunctionReturn(0);
   ierr = MatSeqAIJGetArrayRead(A,&av);CHKERRQ(ierr);
-  ierr = MatDenseGetArray(C,&c);CHKERRQ(ierr);
-  ierr = MatDenseGetArrayRead(B,&b);CHKERRQ(ierr);
-  b1 = b; b2 = b1 + bm; b3 = b2 + bm; b4 = b3 + bm;
-  c1 = c; c2 = c1 + am; c3 = c2 + am; c4 = c3 + am;
-  for (col=0; col<cn-4; col += 4) {  /* over columns of C */
-    for (i=0; i<am; i++) {        /* over rows of C in those columns */
-      r1 = r2 = r3 = r4 = 0.0;
-      n  = a->i[i+1] - a->i[i];
-      aj = a->j + a->i[i];
-      aa = av + a->i[i];
+  for (i=0; i<am; i++) {
+    n  = a->i[i+1] - a->i[i];
+    if (!n) continue;
+    aj = a->j + a->i[i];
+    aa = av + a->i[i];
+    for (col=0; col<k; col+=MAT_DENSE_INTERLEAVED_NCOLS) {
+      ncols = PetscMin(k-col,MAT_DENSE_INTERLEAVED_NCOLS);
+      for (t=0; t<ncols; t++) r[t] = 0.0;
       for (j=0; j<n; j++) {
-        aatmp = aa[j]; ajtmp = aj[j];
-        r1 += aatmp*b1[ajtmp];
-        r2 += aatmp*b2[ajtmp];
-        r3 += aatmp*b3[ajtmp];
-        r4 += aatmp*b4[ajtmp];
+        aatmp = aa[j];
+        xj    = x + aj[j]*k + col;
+        for (t=0; t<ncols; t++) r[t] += aatmp*xj[t];
       }
-      c1[i] += r1;
-      c2[i] += r2;
-      c3[i] += r3;
-      c4[i] += r4;
+      for (t=0; t<ncols; t++) c[i+(col+t)*ldc] += r[t];
     }
-    b1 += bm4; b2 += bm4; b3 += bm4; b4 += bm4;
-    c1 += am4; c2 += am4; c3 += am4; c4 += am4;
   }
-  for (; col<cn; col++) {   /* over extra columns of C */
-    for (i=0; i<am; i++) {  /* over rows of C in those columns */
-      r1 = 0.0;
-      n  = a->i[i+1] - a->i[i];
-      aj = a->j + a->i[i];
-      aa = av + a->i[i];
-      for (j=0; j<n; j++) {
-        r1 += aa[j]*b1[aj[j]];
-      }
-      c1[i] += r1;
-    }
-    b1 += bm;
-    c1 += am;
+  ierr = PetscLogFlops(k*(2.0*a->nz));CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(A,&av);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A,Mat B,Mat C)
+{
+  Mat_SeqDense      *bd = (Mat_SeqDense*)B->data,*cd = (Mat_SeqDense*)C->data;
+  PetscErrorCode    ierr;
+  PetscScalar       *c,*x;
+  const PetscScalar *b;
+  PetscInt          cm=C->rmap->n,cn=B->cmap->n,bm=B->rmap->n,i,col;
+
+  PetscFunctionBegin;
+  if (!cm || !cn) PetscFunctionReturn(0);
+  /* interleave the columns of B so the rows of A are read once for all of them */
+  ierr = PetscMalloc1(bm*cn,&x);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(B,&b);CHKERRQ(ierr);
+  for (col=0; col<cn; col++) {
+    for (i=0; i<bm; i++) x[i*cn+col] = b[i+col*bd->lda];
   }
-  ierr = PetscLogFlops(cn*(2.0*a->nz));CHKERRQ(ierr);
-  ierr = MatDenseRestoreArray(C,&c);CHKERRQ(ierr);
   ierr = MatDenseRestoreArrayRead(B,&b);CHKERRQ(ierr);
-  ierr = MatSeqAIJRestoreArrayRead(A,&av);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(C,&c);CHKERRQ(ierr);
+  ierr = MatMatMultNumericAdd_SeqAIJ_Interleaved(A,cn,x,c,cd->lda);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(C,&c);CHKERRQ(ierr);
+  ierr = PetscFree(x);CHKERRQ(ierr);
   ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   PetscFunctionReturn(0);
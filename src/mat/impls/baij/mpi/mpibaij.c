@@ -1,5 +1,6 @@
 
 #include <../src/mat/impls/baij/mpi/mpibaij.h>   /*I  "petscmat.h"  I*/
+#include <../src/mat/impls/dense/mpi/mpidense.h>
 
 #include <petscblaslapack.h>
 #include <petscsf.h>
@@ -1319,6 +1320,8 @@ PetscErrorCode MatDestroy_MPIBAIJ(Mat mat)
 #endif
   ierr = MatStashDestroy_Private(&mat->stash);CHKERRQ(ierr);
   ierr = MatStashDestroy_Private(&mat->bstash);CHKERRQ(ierr);
+  ierr = MatCOOStructDestroy_XAIJ(&baij->coo);CHKERRQ(ierr);
+  ierr = MatAXPYStructDestroy_XAIJ(&baij->axpy);CHKERRQ(ierr);
   ierr = MatDestroy(&baij->A);CHKERRQ(ierr);
   ierr = MatDestroy(&baij->B);CHKERRQ(ierr);
 #if defined(PETSC_USE_CTABLE)
@@ -1340,6 +1343,8 @@ PetscErrorCode MatDestroy_MPIBAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatRetrieveValues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIBAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIBAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetHashTableFactor_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpibaij_mpisbaij_C",NULL);CHKERRQ(ierr);
@@ -1956,6 +1961,27 @@ PetscErrorCode MatAXPYGetPreallocation_MPIBAIJ(Mat Y,const PetscInt *yltog,Mat X
   PetscFunctionReturn(0);
 }
 
+/* Keeps in Y the locations of the nonzero blocks of X, or none if they are not a subset of those of Y on some process */
+static PetscErrorCode MatAXPYSetUp_MPIBAIJ(Mat Y,Mat X)
+{
+  PetscErrorCode ierr;
+  Mat_MPIBAIJ    *xx = (Mat_MPIBAIJ*)X->data,*yy = (Mat_MPIBAIJ*)Y->data;
+  Mat_SeqBAIJ    *xa = (Mat_SeqBAIJ*)xx->A->data,*xb = (Mat_SeqBAIJ*)xx->B->data;
+  Mat_SeqBAIJ    *ya = (Mat_SeqBAIJ*)yy->A->data,*yb = (Mat_SeqBAIJ*)yy->B->data;
+  PetscBool      valid,lsubset,subset;
+
+  PetscFunctionBegin;
+  ierr = MatAXPYStructCheck_XAIJ(Y,X,ya->bs2,xa->nz,xb->nz,ya->nz,&yy->axpy,&valid);CHKERRQ(ierr);
+  if (valid) PetscFunctionReturn(0);
+  ierr = MatAXPYStructSetLocations_XAIJ(ya->mbs,xa->i,xa->j,NULL,ya->i,ya->j,NULL,0,yy->axpy->loc,&lsubset);CHKERRQ(ierr);
+  if (lsubset) {
+    ierr = MatAXPYStructSetLocations_XAIJ(yb->mbs,xb->i,xb->j,xx->garray,yb->i,yb->j,yy->garray,ya->nz,yy->axpy->loc+xa->nz,&lsubset);CHKERRQ(ierr);
+  }
+  ierr = MPIU_Allreduce(&lsubset,&subset,1,MPIU_BOOL,MPI_LAND,PetscObjectComm((PetscObject)Y));CHKERRQ(ierr);
+  if (!subset) {ierr = MatAXPYStructDestroy_XAIJ(&yy->axpy);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAXPY_MPIBAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
 {
   PetscErrorCode ierr;
@@ -1963,6 +1989,7 @@ PetscErrorCode MatAXPY_MPIBAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
   PetscBLASInt   bnz,one=1;
   Mat_SeqBAIJ    *x,*y;
   PetscInt       bs2 = Y->rmap->bs*Y->rmap->bs;
+  PetscBool      ismpibaij;
 
   PetscFunctionBegin;
   if (str == SAME_NONZERO_PATTERN) {
@@ -1976,26 +2003,47 @@ PetscErrorCode MatAXPY_MPIBAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
     ierr = PetscBLASIntCast(x->nz*bs2,&bnz);CHKERRQ(ierr);
     PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&bnz,&alpha,x->a,&one,y->a,&one));
     ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
-  } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
-    ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
   } else {
-    Mat      B;
-    PetscInt *nnz_d,*nnz_o,bs=Y->rmap->bs;
-    ierr = PetscMalloc1(yy->A->rmap->N,&nnz_d);CHKERRQ(ierr);
-    ierr = PetscMalloc1(yy->B->rmap->N,&nnz_o);CHKERRQ(ierr);
-    ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
-    ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
-    ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
-    ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
-    ierr = MatSetType(B,MATMPIBAIJ);CHKERRQ(ierr);
-    ierr = MatAXPYGetPreallocation_SeqBAIJ(yy->A,xx->A,nnz_d);CHKERRQ(ierr);
-    ierr = MatAXPYGetPreallocation_MPIBAIJ(yy->B,yy->garray,xx->B,xx->garray,nnz_o);CHKERRQ(ierr);
-    ierr = MatMPIBAIJSetPreallocation(B,bs,0,nnz_d,0,nnz_o);CHKERRQ(ierr);
-    /* MatAXPY_BasicWithPreallocation() for BAIJ matrix is much slower than AIJ, even for bs=1 ! */
-    ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
-    ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
-    ierr = PetscFree(nnz_d);CHKERRQ(ierr);
-    ierr = PetscFree(nnz_o);CHKERRQ(ierr);
+    /* as in MatAXPY_SeqAIJ() the locations of the nonzero blocks of X in Y are kept for the next calls */
+    if (Y->rmap->bs == X->rmap->bs) {
+      ierr = MatAXPYSetUp_MPIBAIJ(Y,X);CHKERRQ(ierr);
+    } else {
+      ierr = MatAXPYStructDestroy_XAIJ(&yy->axpy);CHKERRQ(ierr);
+    }
+    if (yy->axpy) {
+      ierr = MatAXPYStructApply_XAIJ(yy->axpy,a,((Mat_SeqBAIJ*)xx->A->data)->a,((Mat_SeqBAIJ*)xx->B->data)->a,((Mat_SeqBAIJ*)yy->A->data)->a,((Mat_SeqBAIJ*)yy->B->data)->a);CHKERRQ(ierr);
+      ((Mat_SeqBAIJ*)yy->A->data)->idiagvalid = PETSC_FALSE;
+      ierr = PetscObjectStateIncrease((PetscObject)yy->A);CHKERRQ(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)yy->B);CHKERRQ(ierr);
+      ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
+      /* derived formats keep their own copy of the values, which is refreshed at assembly */
+      ierr = PetscObjectTypeCompare((PetscObject)Y,MATMPIBAIJ,&ismpibaij);CHKERRQ(ierr);
+      if (!ismpibaij) {
+        ierr = MatAssemblyBegin(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      }
+    } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
+      ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
+    } else {
+      Mat      B;
+      PetscInt *nnz_d,*nnz_o,bs=Y->rmap->bs;
+      ierr = PetscMalloc1(yy->A->rmap->N,&nnz_d);CHKERRQ(ierr);
+      ierr = PetscMalloc1(yy->B->rmap->N,&nnz_o);CHKERRQ(ierr);
+      ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
+      ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
+      ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
+      ierr = MatSetType(B,MATMPIBAIJ);CHKERRQ(ierr);
+      ierr = MatAXPYGetPreallocation_SeqBAIJ(yy->A,xx->A,nnz_d);CHKERRQ(ierr);
+      ierr = MatAXPYGetPreallocation_MPIBAIJ(yy->B,yy->garray,xx->B,xx->garray,nnz_o);CHKERRQ(ierr);
+      ierr = MatMPIBAIJSetPreallocation(B,bs,0,nnz_d,0,nnz_o);CHKERRQ(ierr);
+      /* MatAXPY_BasicWithPreallocation() for BAIJ matrix is much slower than AIJ, even for bs=1 ! */
+      ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
+      ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
+      ierr = PetscFree(nnz_d);CHKERRQ(ierr);
+      ierr = PetscFree(nnz_o);CHKERRQ(ierr);
+      if (bs == X->rmap->bs) {ierr = MatAXPYSetUp_MPIBAIJ(Y,X);CHKERRQ(ierr);}
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -2556,6 +2604,89 @@ PetscErrorCode  MatGetDiagonalBlock_MPIBAIJ(Mat A,Mat *a)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatMPIBAIJ_MPIDenseDestroy(void *ctx)
+{
+  Mat_MPIDenseInterleaved *il = (Mat_MPIDenseInterleaved*)ctx;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMPIDenseInterleavedDestroy_Private(&il);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultSymbolic_MPIBAIJ_MPIDense(Mat A,Mat B,PetscReal fill,Mat *C)
+{
+  Mat_MPIBAIJ             *baij = (Mat_MPIBAIJ*)A->data;
+  Mat_MPIDenseInterleaved *il;
+  PetscContainer          container;
+  PetscInt                bs = A->rmap->bs;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  if (A->cmap->n != B->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Matrix local dimensions are incompatible, %D != %D",A->cmap->n,B->rmap->n);
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),C);CHKERRQ(ierr);
+  ierr = MatSetSizes(*C,A->rmap->n,B->cmap->n,A->rmap->N,B->cmap->N);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(*C,A,B);CHKERRQ(ierr);
+  ierr = MatSetType(*C,MATMPIDENSE);CHKERRQ(ierr);
+  ierr = MatMPIDenseSetPreallocation(*C,NULL);CHKERRQ(ierr);
+
+  /* the rows of all the columns of B needed by the off-diagonal part are sent at once, interleaved */
+  ierr = MatMPIDenseInterleavedCreate_Private(B,bs,baij->B->cmap->n/bs,baij->garray,&il);CHKERRQ(ierr);
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,il);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatMPIBAIJ_MPIDenseDestroy);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)*C,"MatMPIDenseInterleaved",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+
+  (*C)->ops->matmultnumeric = MatMatMultNumeric_MPIBAIJ_MPIDense;
+  ierr = MatAssemblyBegin(*C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_MPIBAIJ_MPIDense(Mat A,Mat B,Mat C)
+{
+  Mat_MPIBAIJ             *baij = (Mat_MPIBAIJ*)A->data;
+  Mat_MPIDense            *cdense = (Mat_MPIDense*)C->data;
+  Mat_MPIDenseInterleaved *il;
+  PetscContainer          container;
+  PetscScalar             *c;
+  PetscInt                ldc;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)C,"MatMPIDenseInterleaved",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Container does not exist");
+  ierr = PetscContainerGetPointer(container,(void**)&il);CHKERRQ(ierr);
+
+  /* the diagonal block of A times the local rows of B overlaps the communication of the other rows */
+  ierr = MatMPIDenseInterleavedBegin_Private(B,il);CHKERRQ(ierr);
+  ierr = MatZeroEntries(cdense->A);CHKERRQ(ierr);
+  ierr = MatDenseGetLDA(cdense->A,&ldc);CHKERRQ(ierr);
+  ierr = MatDenseGetArray(cdense->A,&c);CHKERRQ(ierr);
+  ierr = MatMatMultNumericAdd_SeqBAIJ_Interleaved(baij->A,il->k,il->xloc,c,ldc);CHKERRQ(ierr);
+  ierr = MatMPIDenseInterleavedEnd_Private(il);CHKERRQ(ierr);
+  ierr = MatMatMultNumericAdd_SeqBAIJ_Interleaved(baij->B,il->k,il->xghost,c,ldc);CHKERRQ(ierr);
+  ierr = MatDenseRestoreArray(cdense->A,&c);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMult_MPIBAIJ_MPIDense(Mat A,Mat B,MatReuse scall,PetscReal fill,Mat *C)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (scall == MAT_INITIAL_MATRIX) {
+    ierr = PetscLogEventBegin(MAT_MatMultSymbolic,A,B,0,0);CHKERRQ(ierr);
+    ierr = MatMatMultSymbolic_MPIBAIJ_MPIDense(A,B,fill,C);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(MAT_MatMultSymbolic,A,B,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventBegin(MAT_MatMultNumeric,A,B,0,0);CHKERRQ(ierr);
+  ierr = MatMatMultNumeric_MPIBAIJ_MPIDense(A,B,*C);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_MatMultNumeric,A,B,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------*/
 static struct _MatOps MatOps_Values = {MatSetValues_MPIBAIJ,
                                        MatGetRow_MPIBAIJ,
@@ -2780,6 +2911,52 @@ PetscErrorCode MatMPIBAIJSetPreallocationCSR_MPIBAIJ(Mat B,PetscInt bs,const Pet
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatSetPreallocationCOO_MPIBAIJ(Mat mat,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr;
+  Mat_MPIBAIJ    *baij;
+  Mat_COO        *coo;
+  PetscInt       bs,*ii,*jj,nzA,nzB;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  ierr = MatGetBlockSize(mat,&bs);CHKERRQ(ierr);
+  ierr = MatCOOStructCreate_XAIJ(mat,bs,PETSC_TRUE,n,coo_i,coo_j,&ii,&jj,&coo);CHKERRQ(ierr);
+  ierr = MatMPIBAIJSetPreallocationCSR(mat,bs,ii,jj,NULL);CHKERRQ(ierr);
+  ierr = PetscFree(ii);CHKERRQ(ierr);
+  ierr = PetscFree(jj);CHKERRQ(ierr);
+  baij = (Mat_MPIBAIJ*)mat->data;
+  nzA  = ((Mat_SeqBAIJ*)baij->A->data)->nz*baij->bs2;
+  nzB  = ((Mat_SeqBAIJ*)baij->B->data)->nz*baij->bs2;
+  if (nzA != coo->nA || nzB != coo->nB) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Matrix has %D+%D nonzeros, COO pattern has %D+%D",nzA,nzB,coo->nA,coo->nB);
+  coo->nonzerostate = mat->nonzerostate;
+  ierr = MatCOOStructDestroy_XAIJ(&baij->coo);CHKERRQ(ierr);
+  baij->coo = coo;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValuesCOO_MPIBAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  PetscErrorCode ierr;
+  Mat_MPIBAIJ    *baij = (Mat_MPIBAIJ*)mat->data;
+  PetscBool      ismpibaij;
+
+  PetscFunctionBegin;
+  if (!baij->coo) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  ierr = MatCOOStructSetValues_XAIJ(mat,baij->coo,v,imode,((Mat_SeqBAIJ*)baij->A->data)->a,((Mat_SeqBAIJ*)baij->B->data)->a);CHKERRQ(ierr);
+  ((Mat_SeqBAIJ*)baij->A->data)->idiagvalid = PETSC_FALSE;
+  ierr = PetscObjectStateIncrease((PetscObject)baij->A);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)baij->B);CHKERRQ(ierr);
+  /* derived formats keep their own copy of the values, which is refreshed at assembly */
+  ierr = PetscObjectTypeCompare((PetscObject)mat,MATMPIBAIJ,&ismpibaij);CHKERRQ(ierr);
+  if (!ismpibaij) {
+    ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
    MatMPIBAIJSetPreallocationCSR - Creates a sparse parallel matrix in BAIJ format using the given nonzero structure and (optional) numerical values
 
@@ -3064,6 +3241,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIBAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatRetrieveValues_C",MatRetrieveValues_MPIBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIBAIJSetPreallocation_C",MatMPIBAIJSetPreallocation_MPIBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIBAIJSetPreallocationCSR_C",MatMPIBAIJSetPreallocationCSR_MPIBAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIBAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetHashTableFactor_C",MatSetHashTableFactor_MPIBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_mpibaij_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
@@ -3387,6 +3566,125 @@ static PetscErrorCode MatDuplicate_MPIBAIJ(Mat matin,MatDuplicateOption cpvalues
   PetscFunctionReturn(0);
 }
 
+/* counts the diagonal and off-diagonal blocks of each local block row from the point rows read from a file */
+static PetscErrorCode MatLoad_MPIBAIJ_Preallocate_Private(Mat newmat,PetscInt bs,PetscInt mbs,PetscInt Mbs,PetscInt rstart,PetscInt rend,const PetscInt locrowlens[],const PetscInt mycols[])
+{
+  PetscErrorCode ierr;
+  PetscInt       *dlens,*odlens,*mask,*masked1,*masked2,rowcount,odcount,dcount,kmax,i,j,k,nzcount,tmp;
+
+  PetscFunctionBegin;
+  ierr     = PetscMalloc2(rend-rstart,&dlens,rend-rstart,&odlens);CHKERRQ(ierr);
+  ierr     = PetscCalloc3(Mbs,&mask,Mbs,&masked1,Mbs,&masked2);CHKERRQ(ierr);
+  rowcount = 0; nzcount = 0;
+  for (i=0; i<mbs; i++) {
+    dcount  = 0;
+    odcount = 0;
+    for (j=0; j<bs; j++) {
+      kmax = locrowlens[rowcount];
+      for (k=0; k<kmax; k++) {
+        tmp = mycols[nzcount++]/bs;
+        if (!mask[tmp]) {
+          mask[tmp] = 1;
+          if (tmp < rstart || tmp >= rend) masked2[odcount++] = tmp;
+          else masked1[dcount++] = tmp;
+        }
+      }
+      rowcount++;
+    }
+
+    dlens[i]  = dcount;
+    odlens[i] = odcount;
+
+    /* zero out the mask elements we set */
+    for (j=0; j<dcount; j++) mask[masked1[j]] = 0;
+    for (j=0; j<odcount; j++) mask[masked2[j]] = 0;
+  }
+  ierr = MatMPIBAIJSetPreallocation(newmat,bs,0,dlens,0,odlens);CHKERRQ(ierr);
+  ierr = PetscFree2(dlens,odlens);CHKERRQ(ierr);
+  ierr = PetscFree3(mask,masked1,masked2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_MPIIO)
+/* every process reads its own rows with collective MPI-IO, nothing goes through the first process */
+static PetscErrorCode MatLoad_MPIBAIJ_MPIIO(Mat newmat,PetscViewer viewer,PetscInt bs)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    rank,size;
+  PetscInt       header[4],M,N,Mbs,mbs,m,extra_rows,rstart,rend,frow,mfile,npad,lnz,i,row;
+  PetscInt       *locrowlens,*cols,*scols;
+  PetscScalar    *vals,*svals;
+  PetscBool      nooffprocentries;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,header,4,NULL,PETSC_INT);CHKERRQ(ierr);
+  if (header[0] != MAT_FILE_CLASSID) SETERRQ(comm,PETSC_ERR_FILE_UNEXPECTED,"not matrix object");
+  if (header[3] < 0) SETERRQ(comm,PETSC_ERR_FILE_UNEXPECTED,"Matrix stored in special format on disk, cannot load as MPIBAIJ");
+  M = header[1]; N = header[2];
+
+  if (newmat->rmap->N >= 0 && newmat->rmap->N != M) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Inconsistent # of rows:Matrix in file has (%D) and input matrix has (%D)",newmat->rmap->N,M);
+  if (newmat->cmap->N >= 0 && newmat->cmap->N != N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Inconsistent # of cols:Matrix in file has (%D) and input matrix has (%D)",newmat->cmap->N,N);
+  if (M != N) SETERRQ(comm,PETSC_ERR_SUP,"Can only do square matrices");
+
+  /* same padding and distribution as MatLoad_MPIBAIJ() */
+  Mbs        = M/bs;
+  extra_rows = bs - M + bs*Mbs;
+  if (extra_rows == bs) extra_rows = 0;
+  else                  Mbs++;
+  if (extra_rows && !rank) {
+    ierr = PetscInfo(viewer,"Padding loaded matrix to match blocksize\n");CHKERRQ(ierr);
+  }
+  if (newmat->rmap->n < 0) {
+    mbs = Mbs/size + ((Mbs % size) > rank);
+    m   = mbs*bs;
+  } else {
+    m   = newmat->rmap->n;
+    mbs = m/bs;
+  }
+  ierr   = MPI_Scan(&mbs,&rend,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  rstart = rend - mbs;
+
+  /* the padding rows are not in the file */
+  frow  = rstart*bs;
+  mfile = PetscMax(0,PetscMin(frow+m,M)-frow);
+  npad  = m - mfile;
+  ierr  = PetscMalloc1(m,&locrowlens);CHKERRQ(ierr);
+  ierr  = MatLoadBinaryReadRows_MPIIO(viewer,M,header[3],frow,mfile,locrowlens,&cols,&vals);CHKERRQ(ierr);
+  if (npad) {
+    for (i=0,lnz=0; i<mfile; i++) lnz += locrowlens[i];
+    ierr = PetscRealloc((lnz+npad)*sizeof(PetscInt),&cols);CHKERRQ(ierr);
+    ierr = PetscRealloc((lnz+npad)*sizeof(PetscScalar),&vals);CHKERRQ(ierr);
+    for (i=0; i<npad; i++) {
+      locrowlens[mfile+i] = 1;
+      cols[lnz+i]         = frow+mfile+i;
+      vals[lnz+i]         = 1.0;
+    }
+  }
+
+  ierr = MatSetSizes(newmat,m,m,M+extra_rows,N+extra_rows);CHKERRQ(ierr);
+  ierr = MatLoad_MPIBAIJ_Preallocate_Private(newmat,bs,mbs,Mbs,rstart,rend,locrowlens,cols);CHKERRQ(ierr);
+  for (i=0,row=frow,scols=cols,svals=vals; i<m; i++,row++) {
+    ierr   = MatSetValues_MPIBAIJ(newmat,1,&row,locrowlens[i],scols,svals,INSERT_VALUES);CHKERRQ(ierr);
+    scols += locrowlens[i];
+    svals += locrowlens[i];
+  }
+  ierr = PetscFree(locrowlens);CHKERRQ(ierr);
+  ierr = PetscFree(cols);CHKERRQ(ierr);
+  ierr = PetscFree(vals);CHKERRQ(ierr);
+
+  nooffprocentries         = newmat->nooffprocentries;
+  newmat->nooffprocentries = PETSC_TRUE;
+  ierr = MatAssemblyBegin(newmat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(newmat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  newmat->nooffprocentries = nooffprocentries;
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
 {
   PetscErrorCode ierr;
@@ -3400,9 +3698,11 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
   PetscInt       *locrowlens = NULL,*procsnz = NULL,*browners = NULL;
   PetscInt       jj,*mycols,*ibuf,bs = newmat->rmap->bs,Mbs,mbs,extra_rows,mmax;
   PetscMPIInt    tag    = ((PetscObject)viewer)->tag;
-  PetscInt       *dlens = NULL,*odlens = NULL,*mask = NULL,*masked1 = NULL,*masked2 = NULL,rowcount,odcount;
-  PetscInt       dcount,kmax,k,nzcount,tmp,mend;
+  PetscInt       mend;
   PetscBool      isbinary;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscBool      usempiio;
+#endif
 
   PetscFunctionBegin;
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary);CHKERRQ(ierr);
@@ -3415,6 +3715,13 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
   ierr = PetscOptionsInt("-matload_block_size","Set the blocksize used to store the matrix","MatLoad",bs,&bs,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   if (bs < 0) bs = 1;
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&usempiio);CHKERRQ(ierr);
+  if (usempiio) {
+    ierr = MatLoad_MPIBAIJ_MPIIO(newmat,viewer,bs);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
 
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
@@ -3547,36 +3854,8 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
     if (maxnz != nz) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"something is wrong with file");
   }
 
-  /* loop over local rows, determining number of off diagonal entries */
-  ierr     = PetscMalloc2(rend-rstart,&dlens,rend-rstart,&odlens);CHKERRQ(ierr);
-  ierr     = PetscCalloc3(Mbs,&mask,Mbs,&masked1,Mbs,&masked2);CHKERRQ(ierr);
-  rowcount = 0; nzcount = 0;
-  for (i=0; i<mbs; i++) {
-    dcount  = 0;
-    odcount = 0;
-    for (j=0; j<bs; j++) {
-      kmax = locrowlens[rowcount];
-      for (k=0; k<kmax; k++) {
-        tmp = mycols[nzcount++]/bs;
-        if (!mask[tmp]) {
-          mask[tmp] = 1;
-          if (tmp < rstart || tmp >= rend) masked2[odcount++] = tmp;
-          else masked1[dcount++] = tmp;
-        }
-      }
-      rowcount++;
-    }
-
-    dlens[i]  = dcount;
-    odlens[i] = odcount;
-
-    /* zero out the mask elements we set */
-    for (j=0; j<dcount; j++) mask[masked1[j]] = 0;
-    for (j=0; j<odcount; j++) mask[masked2[j]] = 0;
-  }
-
   ierr = MatSetSizes(newmat,m,m,M+extra_rows,N+extra_rows);CHKERRQ(ierr);
-  ierr = MatMPIBAIJSetPreallocation(newmat,bs,0,dlens,0,odlens);CHKERRQ(ierr);
+  ierr = MatLoad_MPIBAIJ_Preallocate_Private(newmat,bs,mbs,Mbs,rstart,rend,locrowlens,mycols);CHKERRQ(ierr);
 
   if (!rank) {
     ierr = PetscMalloc1(maxnz+1,&buf);CHKERRQ(ierr);
@@ -3636,8 +3915,6 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
   ierr = PetscFree(buf);CHKERRQ(ierr);
   ierr = PetscFree(ibuf);CHKERRQ(ierr);
   ierr = PetscFree2(rowners,browners);CHKERRQ(ierr);
-  ierr = PetscFree2(dlens,odlens);CHKERRQ(ierr);
-  ierr = PetscFree3(mask,masked1,masked2);CHKERRQ(ierr);
   ierr = MatAssemblyBegin(newmat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(newmat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -66,6 +66,8 @@
 
 typedef struct {
   MPIBAIJHEADER;
+  Mat_COO *coo;                         /* used by MatSetValuesCOO() */
+  Mat_AXPY *axpy;                       /* locations of the nonzero blocks of the last X of MatAXPY() */
 } Mat_MPIBAIJ;
 
 PETSC_INTERN PetscErrorCode MatLoad_MPIBAIJ(Mat,PetscViewer);
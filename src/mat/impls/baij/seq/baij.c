@@ -7,6 +7,7 @@
 #include <petscblaslapack.h>
 #include <petsc/private/kernels/blockinvert.h>
 #include <petsc/private/kernels/blockmatmult.h>
+#include <petsc/private/kernels/simd.h>
 
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat,MatType,MatReuse,Mat*);
@@ -1199,12 +1200,15 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
   ierr = PetscFree(a->idiag);CHKERRQ(ierr);
   if (a->free_imax_ilen) {ierr = PetscFree2(a->imax,a->ilen);CHKERRQ(ierr);}
   ierr = PetscFree(a->solve_work);CHKERRQ(ierr);
+  ierr = MatSeqAIJSolveLevelsDestroy_Private(&a->solvelevels);CHKERRQ(ierr);
   ierr = PetscFree(a->mult_work);CHKERRQ(ierr);
   ierr = PetscFree(a->sor_workt);CHKERRQ(ierr);
   ierr = PetscFree(a->sor_work);CHKERRQ(ierr);
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
+  ierr = MatCOOStructDestroy_XAIJ(&a->coo);CHKERRQ(ierr);
+  ierr = MatAXPYStructDestroy_XAIJ(&a->axpy);CHKERRQ(ierr);
 
   ierr = MatDestroy(&a->sbaijMat);CHKERRQ(ierr);
   ierr = MatDestroy(&a->parent);CHKERRQ(ierr);
@@ -1221,6 +1225,8 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqbaij_seqsbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqBAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqBAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqbaij_seqbstrm_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_HYPRE)
@@ -2423,12 +2429,28 @@ PetscErrorCode MatAXPYGetPreallocation_SeqBAIJ(Mat Y,Mat X,PetscInt *nnz)
   PetscFunctionReturn(0);
 }
 
+/* Keeps in Y the locations of the nonzero blocks of X, or none if they are not a subset of those of Y */
+static PetscErrorCode MatAXPYSetUp_SeqBAIJ(Mat Y,Mat X)
+{
+  PetscErrorCode ierr;
+  Mat_SeqBAIJ    *x = (Mat_SeqBAIJ*)X->data,*y = (Mat_SeqBAIJ*)Y->data;
+  PetscBool      valid,subset;
+
+  PetscFunctionBegin;
+  ierr = MatAXPYStructCheck_XAIJ(Y,X,y->bs2,x->nz,0,y->nz,&y->axpy,&valid);CHKERRQ(ierr);
+  if (valid) PetscFunctionReturn(0);
+  ierr = MatAXPYStructSetLocations_XAIJ(y->mbs,x->i,x->j,NULL,y->i,y->j,NULL,0,y->axpy->loc,&subset);CHKERRQ(ierr);
+  if (!subset) {ierr = MatAXPYStructDestroy_XAIJ(&y->axpy);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatAXPY_SeqBAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
 {
   Mat_SeqBAIJ    *x = (Mat_SeqBAIJ*)X->data,*y = (Mat_SeqBAIJ*)Y->data;
   PetscErrorCode ierr;
   PetscInt       bs=Y->rmap->bs,bs2=bs*bs;
   PetscBLASInt   one=1;
+  PetscBool      isseqbaij;
 
   PetscFunctionBegin;
   if (str == SAME_NONZERO_PATTERN) {
@@ -2437,23 +2459,42 @@ PetscErrorCode MatAXPY_SeqBAIJ(Mat Y,PetscScalar a,Mat X,MatStructure str)
     ierr = PetscBLASIntCast(x->nz*bs2,&bnz);CHKERRQ(ierr);
     PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&bnz,&alpha,x->a,&one,y->a,&one));
     ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
-  } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
-    ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
   } else {
-    Mat      B;
-    PetscInt *nnz;
-    if (bs != X->rmap->bs) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Matrices must have same block size");
-    ierr = PetscMalloc1(Y->rmap->N,&nnz);CHKERRQ(ierr);
-    ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
-    ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
-    ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
-    ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
-    ierr = MatSetType(B,(MatType) ((PetscObject)Y)->type_name);CHKERRQ(ierr);
-    ierr = MatAXPYGetPreallocation_SeqBAIJ(Y,X,nnz);CHKERRQ(ierr);
-    ierr = MatSeqBAIJSetPreallocation(B,bs,0,nnz);CHKERRQ(ierr);
-    ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
-    ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
-    ierr = PetscFree(nnz);CHKERRQ(ierr);
+    /* as in MatAXPY_SeqAIJ() the locations of the nonzero blocks of X in Y are kept for the next calls */
+    if (bs == X->rmap->bs) {
+      ierr = MatAXPYSetUp_SeqBAIJ(Y,X);CHKERRQ(ierr);
+    } else {
+      ierr = MatAXPYStructDestroy_XAIJ(&y->axpy);CHKERRQ(ierr);
+    }
+    if (y->axpy) {
+      ierr = MatAXPYStructApply_XAIJ(y->axpy,a,x->a,NULL,y->a,NULL);CHKERRQ(ierr);
+      y->idiagvalid = PETSC_FALSE;
+      ierr = PetscObjectStateIncrease((PetscObject)Y);CHKERRQ(ierr);
+      /* derived formats keep their own copy of the values, which is refreshed at assembly */
+      ierr = PetscObjectTypeCompare((PetscObject)Y,MATSEQBAIJ,&isseqbaij);CHKERRQ(ierr);
+      if (!isseqbaij) {
+        ierr = MatAssemblyBegin(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(Y,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      }
+    } else if (str == SUBSET_NONZERO_PATTERN) { /* nonzeros of X is a subset of Y's */
+      ierr = MatAXPY_Basic(Y,a,X,str);CHKERRQ(ierr);
+    } else {
+      Mat      B;
+      PetscInt *nnz;
+      if (bs != X->rmap->bs) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Matrices must have same block size");
+      ierr = PetscMalloc1(Y->rmap->N,&nnz);CHKERRQ(ierr);
+      ierr = MatCreate(PetscObjectComm((PetscObject)Y),&B);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject)B,((PetscObject)Y)->name);CHKERRQ(ierr);
+      ierr = MatSetSizes(B,Y->rmap->n,Y->cmap->n,Y->rmap->N,Y->cmap->N);CHKERRQ(ierr);
+      ierr = MatSetBlockSizesFromMats(B,Y,Y);CHKERRQ(ierr);
+      ierr = MatSetType(B,(MatType) ((PetscObject)Y)->type_name);CHKERRQ(ierr);
+      ierr = MatAXPYGetPreallocation_SeqBAIJ(Y,X,nnz);CHKERRQ(ierr);
+      ierr = MatSeqBAIJSetPreallocation(B,bs,0,nnz);CHKERRQ(ierr);
+      ierr = MatAXPY_BasicWithPreallocation(B,Y,a,X,str);CHKERRQ(ierr);
+      ierr = MatHeaderReplace(Y,&B);CHKERRQ(ierr);
+      ierr = PetscFree(nnz);CHKERRQ(ierr);
+      ierr = MatAXPYSetUp_SeqBAIJ(Y,X);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -2861,14 +2902,20 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
       B->ops->multadd = MatMultAdd_SeqBAIJ_7;
       break;
     case 9:
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-      B->ops->mult    = MatMult_SeqBAIJ_9_AVX2;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_9_AVX2;
-#else
+    {
+      PetscSIMDLevel level;
+
+      ierr = PetscSIMDGetLevel(&level);CHKERRQ(ierr);
       B->ops->mult    = MatMult_SeqBAIJ_N;
       B->ops->multadd = MatMultAdd_SeqBAIJ_N;
+#if defined(PETSC_SIMD_USE_AVX2)
+      if (level >= PETSC_SIMD_AVX2) {
+        B->ops->mult    = MatMult_SeqBAIJ_9_AVX2;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_9_AVX2;
+      }
 #endif
       break;
+    }
     case 11:
       B->ops->mult    = MatMult_SeqBAIJ_11;
       B->ops->multadd = MatMultAdd_SeqBAIJ_11;
@@ -3002,6 +3049,48 @@ PetscErrorCode MatSeqBAIJSetPreallocationCSR_SeqBAIJ(Mat B,PetscInt bs,const Pet
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatSetPreallocationCOO_SeqBAIJ(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr;
+  Mat_SeqBAIJ    *a;
+  Mat_COO        *coo;
+  PetscInt       bs,*ii,*jj;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+  ierr = MatCOOStructCreate_XAIJ(A,bs,PETSC_FALSE,n,coo_i,coo_j,&ii,&jj,&coo);CHKERRQ(ierr);
+  ierr = MatSeqBAIJSetPreallocationCSR(A,bs,ii,jj,NULL);CHKERRQ(ierr);
+  ierr = PetscFree(ii);CHKERRQ(ierr);
+  ierr = PetscFree(jj);CHKERRQ(ierr);
+  a    = (Mat_SeqBAIJ*)A->data;
+  if (a->nz*a->bs2 != coo->nA) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Matrix has %D nonzeros, COO pattern has %D",a->nz*a->bs2,coo->nA);
+  coo->nonzerostate = A->nonzerostate;
+  ierr = MatCOOStructDestroy_XAIJ(&a->coo);CHKERRQ(ierr);
+  a->coo = coo;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValuesCOO_SeqBAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  PetscErrorCode ierr;
+  Mat_SeqBAIJ    *a = (Mat_SeqBAIJ*)A->data;
+  PetscBool      isseqbaij;
+
+  PetscFunctionBegin;
+  if (!a->coo) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  ierr = MatCOOStructSetValues_XAIJ(A,a->coo,v,imode,a->a,NULL);CHKERRQ(ierr);
+  a->idiagvalid = PETSC_FALSE;
+  /* derived formats keep their own copy of the values, which is refreshed at assembly */
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQBAIJ,&isseqbaij);CHKERRQ(ierr);
+  if (!isseqbaij) {
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
    MatSeqBAIJGetArray - gives access to the array where the data for a MATSEQBAIJ matrix is stored
 
@@ -3103,6 +3192,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqBAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqbaij_seqsbaij_C",MatConvert_SeqBAIJ_SeqSBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqBAIJSetPreallocation_C",MatSeqBAIJSetPreallocation_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqBAIJSetPreallocationCSR_C",MatSeqBAIJSetPreallocationCSR_SeqBAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqBAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_SeqBAIJ);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqbaij_hypre_C",MatConvert_AIJ_HYPRE);CHKERRQ(ierr);
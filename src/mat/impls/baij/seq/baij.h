@@ -28,6 +28,8 @@
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
+  Mat_COO *coo;                         /* used by MatSetValuesCOO() */
+  Mat_AXPY *axpy;                       /* locations of the nonzero blocks of the last X of MatAXPY() */
 } Mat_SeqBAIJ;
 
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz,PetscInt *nnz);
@@ -128,6 +130,8 @@ PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_15_NaturalOrdering_ver2(Mat,Vec,Vec
 PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_N_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_N(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_N_NaturalOrdering(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_N_NaturalOrdering_Levels(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatFactorSetUpSolveLevels_SeqBAIJ(Mat);
 
 PETSC_INTERN PetscErrorCode MatSolveTranspose_SeqBAIJ_1_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolveTranspose_SeqBAIJ_1(Mat,Vec,Vec);
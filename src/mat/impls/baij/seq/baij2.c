@@ -5,9 +5,7 @@
 #include <petscbt.h>
 #include <petscblaslapack.h>
 
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-#include <immintrin.h>
-#endif
+#include <petsc/private/kernels/simd.h>
 
 PetscErrorCode MatIncreaseOverlap_SeqBAIJ(Mat A,PetscInt is_max,IS is[],PetscInt ov)
 {
@@ -319,6 +317,7 @@ PetscErrorCode MatMult_SeqBAIJ_1(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -368,6 +367,7 @@ PetscErrorCode MatMult_SeqBAIJ_2(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(8.0*a->nz - 2.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -425,6 +425,7 @@ PetscErrorCode MatMult_SeqBAIJ_3(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(18.0*a->nz - 3.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -481,6 +482,7 @@ PetscErrorCode MatMult_SeqBAIJ_4(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(32.0*a->nz - 4.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -534,6 +536,7 @@ PetscErrorCode MatMult_SeqBAIJ_5(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(50.0*a->nz - 5.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -596,6 +599,7 @@ PetscErrorCode MatMult_SeqBAIJ_6(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(72.0*a->nz - 6.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -660,11 +664,12 @@ PetscErrorCode MatMult_SeqBAIJ_7(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(98.0*a->nz - 7.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-PetscErrorCode MatMult_SeqBAIJ_9_AVX2(Mat A,Vec xx,Vec zz)
+#if defined(PETSC_SIMD_USE_AVX2)
+PetscErrorCode PETSC_SIMD_TARGET_AVX2 MatMult_SeqBAIJ_9_AVX2(Mat A,Vec xx,Vec zz)
 {
   Mat_SeqBAIJ    *a = (Mat_SeqBAIJ*)A->data;
   PetscScalar    *z = 0,*work,*workt,*zarray;
@@ -780,6 +785,7 @@ PetscErrorCode MatMult_SeqBAIJ_9_AVX2(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz*bs2 - bs*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 #endif
@@ -847,6 +853,7 @@ PetscErrorCode MatMult_SeqBAIJ_11(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(242.0*a->nz - 11.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -919,6 +926,7 @@ PetscErrorCode MatMult_SeqBAIJ_15_ver1(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(450.0*a->nz - 15.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1044,6 +1052,7 @@ PetscErrorCode MatMult_SeqBAIJ_15_ver2(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(450.0*a->nz - 15.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1133,6 +1142,7 @@ PetscErrorCode MatMult_SeqBAIJ_15_ver3(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(450.0*a->nz - 15.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1203,6 +1213,7 @@ PetscErrorCode MatMult_SeqBAIJ_15_ver4(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(450.0*a->nz - 15.0*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1261,6 +1272,7 @@ PetscErrorCode MatMult_SeqBAIJ_N(Mat A,Vec xx,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz*bs2 - bs*a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1314,6 +1326,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_1(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1374,6 +1387,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_2(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(4.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1431,6 +1445,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_3(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(18.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1490,6 +1505,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_4(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(32.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1551,6 +1567,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_5(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(50.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1613,6 +1630,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_6(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(72.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1676,11 +1694,12 @@ PetscErrorCode MatMultAdd_SeqBAIJ_7(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(98.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-PetscErrorCode MatMultAdd_SeqBAIJ_9_AVX2(Mat A,Vec xx,Vec yy,Vec zz)
+#if defined(PETSC_SIMD_USE_AVX2)
+PetscErrorCode PETSC_SIMD_TARGET_AVX2 MatMultAdd_SeqBAIJ_9_AVX2(Mat A,Vec xx,Vec yy,Vec zz)
 {
   Mat_SeqBAIJ    *a = (Mat_SeqBAIJ*)A->data;
   PetscScalar    *z = 0,*work,*workt,*zarray;
@@ -1796,6 +1815,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_9_AVX2(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(162.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 #endif
@@ -1866,6 +1886,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_11(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(yy,zz,&yarray,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(242.0*a->nz);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1921,6 +1942,7 @@ PetscErrorCode MatMultAdd_SeqBAIJ_N(Mat A,Vec xx,Vec yy,Vec zz)
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(zz,&zarray);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz*bs2);CHKERRQ(ierr);
+  ierr = PetscLogBytes(MatSeqXAIJMatrixBytes(a->nz,a->bs2,a->mbs) + (A->cmap->n + 2.0*A->rmap->n)*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2738,6 +2760,47 @@ PetscErrorCode MatMatMult_SeqBAIJ_5_Private(Mat A,PetscScalar* b,PetscInt bm,Pet
   PetscFunctionReturn(0);
 }
 
+/*
+   C += A*X for any block size, where the k columns of X are interleaved, X(j,c) = x[j*k+c], and C
+   is stored by columns with leading dimension ldc; see MatMatMultNumericAdd_SeqAIJ_Interleaved()
+*/
+PetscErrorCode MatMatMultNumericAdd_SeqBAIJ_Interleaved(Mat A,PetscInt k,const PetscScalar x[],PetscScalar c[],PetscInt ldc)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscScalar       sum[MAT_DENSE_INTERLEAVED_NCOLS],vtmp;
+  const PetscScalar *xj;
+  const MatScalar   *v;
+  const PetscInt    *idx;
+  PetscInt          mbs=a->mbs,bs=A->rmap->bs,bs2=a->bs2,i,j,n,r,cc,col,ncols,t;
+
+  PetscFunctionBegin;
+  if (!mbs || !k) PetscFunctionReturn(0);
+  for (i=0; i<mbs; i++) {
+    n   = a->i[i+1] - a->i[i];
+    if (!n) continue;
+    idx = a->j + a->i[i];
+    v   = a->a + bs2*a->i[i];
+    /* the blocks of the row stay in cache while their bs rows are processed */
+    for (r=0; r<bs; r++) {
+      for (col=0; col<k; col+=MAT_DENSE_INTERLEAVED_NCOLS) {
+        ncols = PetscMin(k-col,MAT_DENSE_INTERLEAVED_NCOLS);
+        for (t=0; t<ncols; t++) sum[t] = 0.0;
+        for (j=0; j<n; j++) {
+          for (cc=0; cc<bs; cc++) {
+            vtmp = v[j*bs2+cc*bs+r];
+            xj   = x + (bs*idx[j]+cc)*k + col;
+            for (t=0; t<ncols; t++) sum[t] += vtmp*xj[t];
+          }
+        }
+        for (t=0; t<ncols; t++) c[bs*i+r+(col+t)*ldc] += sum[t];
+      }
+    }
+  }
+  ierr = PetscLogFlops(k*(2.0*bs2*a->nz));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatMatMultNumeric_SeqBAIJ_SeqDense(Mat A,Mat B,Mat C)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
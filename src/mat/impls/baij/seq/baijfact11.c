@@ -550,6 +550,7 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_4_NaturalOrdering(Mat B,Mat A,const Ma
   C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_4_NaturalOrdering;
   C->assembled           = PETSC_TRUE;
 
+  ierr = MatFactorSetUpSolveLevels_SeqBAIJ(C);CHKERRQ(ierr);
   ierr = PetscLogFlops(1.333333333333*4*4*4*n);CHKERRQ(ierr); /* from inverting diagonal blocks */
   PetscFunctionReturn(0);
 }
@@ -784,6 +784,7 @@ PetscErrorCode MatLUFactorNumeric_SeqBAIJ_7_NaturalOrdering(Mat B,Mat A,const Ma
   C->ops->solvetranspose = MatSolveTranspose_SeqBAIJ_7_NaturalOrdering;
   C->assembled           = PETSC_TRUE;
 
+  ierr = MatFactorSetUpSolveLevels_SeqBAIJ(C);CHKERRQ(ierr);
   ierr = PetscLogFlops(1.333333333333*7*7*7*n);CHKERRQ(ierr); /* from inverting diagonal blocks */
   PetscFunctionReturn(0);
 }
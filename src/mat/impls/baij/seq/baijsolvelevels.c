@@ -0,0 +1,151 @@
+/*
+  Level scheduled triangular solves of MATSEQBAIJ LU and ILU factors with the natural ordering,
+  see MatFactorSetUpSolveLevels_SeqAIJ()
+*/
+
+#include <../src/mat/impls/baij/seq/baij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/* each thread computes this many consecutive block rows of the level order at a time */
+#define MAT_SOLVE_LEVELS_CHUNK 8
+
+/*
+   MatFactorSetUpSolveLevels_SeqBAIJ - Called at the end of the numeric LU and ILU factorizations
+   with the natural ordering; with the option -mat_factor_solve_levels it computes the levels of
+   the block rows and replaces MatSolve() by MatSolve_SeqBAIJ_N_NaturalOrdering_Levels().
+
+   The block kernels are written out rather than calling BLAS, which may not be called from the
+   threads, so the solution does not depend on the number of threads but may differ in the last
+   bits from the one of the sequential solve.
+*/
+PetscErrorCode MatFactorSetUpSolveLevels_SeqBAIJ(Mat fact)
+{
+  Mat_SeqBAIJ    *b = (Mat_SeqBAIJ*)fact->data;
+  PetscErrorCode ierr;
+  PetscBool      flg = PETSC_FALSE,row_identity,col_identity;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJSolveLevelsDestroy_Private(&b->solvelevels);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(((PetscObject)fact)->options,((PetscObject)fact)->prefix,"-mat_factor_solve_levels",&flg,NULL);CHKERRQ(ierr);
+  if (!flg) PetscFunctionReturn(0);
+  ierr = ISIdentity(b->row,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(b->col,&col_identity);CHKERRQ(ierr);
+  if (!row_identity || !col_identity) {
+    ierr = PetscInfo(fact,"Level scheduled solves need the natural ordering, keeping the sequential solve\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MatSeqAIJSolveLevelsCreate_Private(b->mbs,b->i,b->j,b->diag,&b->solvelevels);CHKERRQ(ierr);
+  ierr = PetscInfo3(fact,"%D block rows in %D levels of L and %D levels of U\n",b->mbs,b->solvelevels->nlevels[0],b->solvelevels->nlevels[1]);CHKERRQ(ierr);
+  fact->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering_Levels;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The same schedule as MatSolve_SeqAIJ_Levels() on the block rows. The U phase computes each
+   block of the solution in x before it is copied to the work array, so the threads need no
+   work space of their own.
+*/
+PetscErrorCode MatSolve_SeqBAIJ_N_NaturalOrdering_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqBAIJ           *a  = (Mat_SeqBAIJ*)A->data;
+  Mat_SeqAIJSolveLevels *lv = a->solvelevels;
+  PetscErrorCode        ierr;
+  const PetscInt        *ai = a->i,*aj = a->j,*adiag = a->diag,*orderL,*orderU;
+  PetscInt              n = a->mbs,bs = A->rmap->bs,bs2 = a->bs2,*done,epoch;
+  const MatScalar       *aa = a->a;
+  PetscScalar           *x,*t;
+  const PetscScalar     *b;
+
+  PetscFunctionBegin;
+  if (!lv) {
+    /* a duplicate of the factor, which does not share the levels */
+    ierr = MatSolve_SeqBAIJ_N_NaturalOrdering(A,bb,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (!n) PetscFunctionReturn(0);
+  ierr = MatSeqAIJSolveLevelsNextEpoch_Private(lv);CHKERRQ(ierr);
+
+  ierr   = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr   = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  t      = a->solve_work;
+  done   = lv->done;
+  epoch  = lv->epoch;
+  orderL = lv->order[0];
+  orderU = lv->order[1];
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel
+#endif
+  {
+    PetscInt          tid = 0,nt = 1,p0,p,pend,i,j,k,l,nz;
+    const PetscInt    *vi;
+    const MatScalar   *v;
+    PetscScalar       *s,*xi,sum;
+    const PetscScalar *w;
+
+#if defined(PETSC_HAVE_OPENMP)
+    tid = omp_get_thread_num();
+    nt  = omp_get_num_threads();
+#endif
+    /* forward solve the lower triangular, with unit diagonal blocks */
+    for (p0=tid*MAT_SOLVE_LEVELS_CHUNK; p0<n; p0+=nt*MAT_SOLVE_LEVELS_CHUNK) {
+      pend = PetscMin(p0+MAT_SOLVE_LEVELS_CHUNK,n);
+      for (p=p0; p<pend; p++) {
+        i  = orderL[p];
+        v  = aa + bs2*ai[i];
+        vi = aj + ai[i];
+        nz = ai[i+1] - ai[i];
+        s  = t + bs*i;
+        for (l=0; l<bs; l++) s[l] = b[bs*i+l];
+        for (k=0; k<nz; k++) {
+          MatSeqAIJSolveLevelsWait_Private(done,vi[k],epoch);
+          w = t + bs*vi[k];
+          for (j=0; j<bs; j++) {
+            for (l=0; l<bs; l++) s[l] -= v[l]*w[j];
+            v += bs;
+          }
+        }
+        MatSeqAIJSolveLevelsSignal_Private(done,i,epoch);
+      }
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp barrier
+#endif
+    /* backward solve the upper triangular, whose diagonal blocks are stored inverted */
+    for (p0=tid*MAT_SOLVE_LEVELS_CHUNK; p0<n; p0+=nt*MAT_SOLVE_LEVELS_CHUNK) {
+      pend = PetscMin(p0+MAT_SOLVE_LEVELS_CHUNK,n);
+      for (p=p0; p<pend; p++) {
+        i  = orderU[p];
+        v  = aa + bs2*(adiag[i+1]+1);
+        vi = aj + adiag[i+1]+1;
+        nz = adiag[i] - adiag[i+1]-1;
+        s  = t + bs*i;
+        xi = x + bs*i;
+        for (l=0; l<bs; l++) xi[l] = s[l];
+        for (k=0; k<nz; k++) {
+          MatSeqAIJSolveLevelsWait_Private(done,vi[k],epoch+1);
+          w = t + bs*vi[k];
+          for (j=0; j<bs; j++) {
+            for (l=0; l<bs; l++) xi[l] -= v[l]*w[j];
+            v += bs;
+          }
+        }
+        v = aa + bs2*adiag[i];
+        for (l=0; l<bs; l++) {
+          sum = 0.0;
+          for (j=0; j<bs; j++) sum += v[l+bs*j]*xi[j];
+          s[l] = sum;
+        }
+        for (l=0; l<bs; l++) xi[l] = s[l];
+        MatSeqAIJSolveLevelsSignal_Private(done,i,epoch+1);
+      }
+    }
+  }
+
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*(a->bs2)*(a->nz) - A->rmap->bs*A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -7,6 +7,7 @@
 #include <../src/mat/impls/dense/mpi/mpidense.h>    /*I   "petscmat.h"  I*/
 #include <../src/mat/impls/aij/mpi/mpiaij.h>
 #include <petscblaslapack.h>
+#include <petscsf.h>
 
 /*@
 
@@ -599,6 +600,9 @@ PetscErrorCode MatDestroy_MPIDense(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMult_mpiaij_mpidense_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultSymbolic_mpiaij_mpidense_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultNumeric_mpiaij_mpidense_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMult_mpibaij_mpidense_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultSymbolic_mpibaij_mpidense_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultNumeric_mpibaij_mpidense_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMult_nest_mpidense_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultSymbolic_nest_mpidense_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultNumeric_nest_mpidense_C",NULL);CHKERRQ(ierr);
@@ -1112,6 +1116,85 @@ static PetscErrorCode  MatSetRandom_MPIDense(Mat x,PetscRandom rctx)
   PetscFunctionReturn(0);
 }
 
+/*
+   Prepares the copies of the rows of B used by the product A*B of a MATMPIAIJ or MATMPIBAIJ matrix A, with
+   the columns of B interleaved so the kernels read A once for all of them. garray gives the global (block)
+   columns of the nghost (block) columns of the off-diagonal part of A; the rows of all the columns of B
+   that are needed from a process are sent in a single message.
+*/
+PetscErrorCode MatMPIDenseInterleavedCreate_Private(Mat B,PetscInt bs,PetscInt nghost,const PetscInt garray[],Mat_MPIDenseInterleaved **il)
+{
+  Mat_MPIDenseInterleaved *ctx;
+  PetscLayout             layout;
+  PetscInt                nloc = B->rmap->n,k = B->cmap->N;
+  PetscMPIInt             unitsize;
+  PetscErrorCode          ierr;
+
+  PetscFunctionBegin;
+  if (nloc%bs) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Local number of rows of B %D is not a multiple of the block size %D",nloc,bs);
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ctx->bs = bs;
+  ctx->k  = k;
+  ierr = PetscLayoutCreateFromSizes(PetscObjectComm((PetscObject)B),nloc/bs,PETSC_DECIDE,1,&layout);CHKERRQ(ierr);
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject)B),&ctx->sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(ctx->sf,layout,nghost,NULL,PETSC_OWN_POINTER,garray);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(ctx->sf);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(ctx->sf);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+
+  ierr = PetscMPIIntCast(bs*k,&unitsize);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(unitsize,MPIU_SCALAR,&ctx->unit);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&ctx->unit);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nloc*k,&ctx->xloc,nghost*bs*k,&ctx->xghost);CHKERRQ(ierr);
+  *il  = ctx;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Interleaves the local rows of B and starts sending them to the processes whose off-diagonal part uses them
+*/
+PetscErrorCode MatMPIDenseInterleavedBegin_Private(Mat B,Mat_MPIDenseInterleaved *il)
+{
+  const PetscScalar *b;
+  PetscInt          i,col,lda,nloc = B->rmap->n,k = il->k;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (B->cmap->N != k) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number of columns of B %D changed from %D",B->cmap->N,k);
+  if (!k) PetscFunctionReturn(0);
+  ierr = MatDenseGetLDA(B,&lda);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(B,&b);CHKERRQ(ierr);
+  for (col=0; col<k; col++) {
+    for (i=0; i<nloc; i++) il->xloc[i*k+col] = b[i+col*lda];
+  }
+  ierr = MatDenseRestoreArrayRead(B,&b);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(il->sf,il->unit,il->xloc,il->xghost);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMPIDenseInterleavedEnd_Private(Mat_MPIDenseInterleaved *il)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!il->k) PetscFunctionReturn(0);
+  ierr = PetscSFBcastEnd(il->sf,il->unit,il->xloc,il->xghost);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMPIDenseInterleavedDestroy_Private(Mat_MPIDenseInterleaved **il)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*il) PetscFunctionReturn(0);
+  ierr = PetscSFDestroy(&(*il)->sf);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&(*il)->unit);CHKERRQ(ierr);
+  ierr = PetscFree2((*il)->xloc,(*il)->xghost);CHKERRQ(ierr);
+  ierr = PetscFree(*il);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_MPIDense(Mat A,Mat,Mat);
 
 static PetscErrorCode MatMissingDiagonal_MPIDense(Mat A,PetscBool  *missing,PetscInt *d)
@@ -1431,6 +1514,9 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIDense(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMult_mpiaij_mpidense_C",MatMatMult_MPIAIJ_MPIDense);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultSymbolic_mpiaij_mpidense_C",MatMatMultSymbolic_MPIAIJ_MPIDense);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultNumeric_mpiaij_mpidense_C",MatMatMultNumeric_MPIAIJ_MPIDense);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMult_mpibaij_mpidense_C",MatMatMult_MPIBAIJ_MPIDense);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultSymbolic_mpibaij_mpidense_C",MatMatMultSymbolic_MPIBAIJ_MPIDense);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultNumeric_mpibaij_mpidense_C",MatMatMultNumeric_MPIBAIJ_MPIDense);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMult_nest_mpidense_C",MatMatMult_Nest_Dense);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultSymbolic_nest_mpidense_C",MatMatMultSymbolic_Nest_Dense);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMatMultNumeric_nest_mpidense_C",MatMatMultNumeric_Nest_Dense);CHKERRQ(ierr);
@@ -49,6 +49,13 @@ typedef struct {
   Mat_MatTransMultDense *abtdense;      /* used by MatMatTransposeMult_MPIDense_MPIDense */
 } Mat_MPIDense;
 
+typedef struct { /* used by MatMatMult_MPIAIJ_MPIDense() and MatMatMult_MPIBAIJ_MPIDense() */
+  PetscSF      sf;                      /* from the (block) columns of the off-diagonal part of A to the rows of B owning them */
+  MPI_Datatype unit;                    /* the bs rows of B of one root or leaf, with all the columns of B */
+  PetscInt     bs,k;                    /* block size of A, number of columns of B */
+  PetscScalar  *xloc,*xghost;           /* local rows of B and rows needed by the off-diagonal part, columns interleaved */
+} Mat_MPIDenseInterleaved;
+
 PETSC_INTERN PetscErrorCode MatLoad_MPIDense(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatSetUpMultiply_MPIDense(Mat);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrices_MPIDense(Mat,PetscInt,const IS[],const IS[],MatReuse,Mat *[]);
@@ -57,6 +64,13 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_MPIDense_MPIDense(Mat,Mat,PetscRe
 PETSC_INTERN PetscErrorCode MatMatMult_MPIAIJ_MPIDense(Mat,Mat,MatReuse,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_MPIAIJ_MPIDense(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_MPIAIJ_MPIDense(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMult_MPIBAIJ_MPIDense(Mat,Mat,MatReuse,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_MPIBAIJ_MPIDense(Mat,Mat,PetscReal,Mat*);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_MPIBAIJ_MPIDense(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMPIDenseInterleavedCreate_Private(Mat,PetscInt,PetscInt,const PetscInt[],Mat_MPIDenseInterleaved**);
+PETSC_INTERN PetscErrorCode MatMPIDenseInterleavedBegin_Private(Mat,Mat_MPIDenseInterleaved*);
+PETSC_INTERN PetscErrorCode MatMPIDenseInterleavedEnd_Private(Mat_MPIDenseInterleaved*);
+PETSC_INTERN PetscErrorCode MatMPIDenseInterleavedDestroy_Private(Mat_MPIDenseInterleaved**);
 PETSC_INTERN PetscErrorCode MatTransposeMatMult_MPIDense_MPIDense(Mat,Mat,MatReuse,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatTransposeMatMultSymbolic_MPIDense_MPIDense(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatTransposeMatMultNumeric_MPIDense_MPIDense(Mat,Mat,Mat);
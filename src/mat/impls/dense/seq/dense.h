@@ -26,6 +26,12 @@ typedef struct {
   Mat_MatTransMatMult *atb;       /* used by MatTransposeMatMult_SeqAIJ_SeqDense */
 } Mat_SeqDense;
 
+/*
+  Number of the interleaved columns of a dense matrix, X(j,c) = x[j*k+c], that the sparse kernels
+  MatMatMultNumericAdd_XXX_Interleaved() accumulate at once; the sparse matrix is read once for all of them
+*/
+#define MAT_DENSE_INTERLEAVED_NCOLS 16
+
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqDense_SeqDense(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqDense(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatTransposeMatMult_SeqDense_SeqDense(Mat,Mat,MatReuse,PetscReal,Mat*);
@@ -38,6 +44,8 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqDense(Mat,Mat,PetscReal
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqDense(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqBAIJ_SeqDense(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqBAIJ_SeqDense(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_Interleaved(Mat,PetscInt,const PetscScalar[],PetscScalar[],PetscInt);
+PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqBAIJ_Interleaved(Mat,PetscInt,const PetscScalar[],PetscScalar[],PetscInt);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqSBAIJ_SeqDense(Mat,Mat,PetscReal,Mat*);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqSBAIJ_SeqDense(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_Nest_Dense(Mat,Mat,PetscReal,Mat*);
@@ -5,33 +5,34 @@
 #include <../src/mat/impls/sell/seq/sell.h>  /*I   "petscmat.h"  I*/
 #include <petscblaslapack.h>
 #include <petsc/private/kernels/blocktranspose.h>
-#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX__)) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-
-  #include <immintrin.h>
+#include <petsc/private/kernels/simd.h>
 
+/* the kernels below load the column indices as 32 bit integers */
+#if (defined(PETSC_SIMD_USE_AVX) || defined(PETSC_SIMD_USE_AVX2) || defined(PETSC_SIMD_USE_AVX512)) && !defined(PETSC_USE_64BIT_INDICES)
   #if !defined(_MM_SCALE_8)
   #define _MM_SCALE_8    8
   #endif
+#endif
 
-  #if defined(__AVX512F__)
+#if defined(PETSC_SIMD_USE_AVX512) && !defined(PETSC_USE_64BIT_INDICES)
   /* these do not work
    vec_idx  = _mm512_loadunpackhi_epi32(vec_idx,acolidx);
    vec_vals = _mm512_loadunpackhi_pd(vec_vals,aval);
   */
-    #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
-    vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
-    vec_vals = _mm512_loadu_pd(aval); \
-    vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
-    vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
-  #elif defined(__AVX2__) && defined(__FMA__)
-    #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
-    vec_vals = _mm256_loadu_pd(aval); \
-    vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
-    vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
-    vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
-  #endif
-#endif  /* PETSC_HAVE_IMMINTRIN_H */
+  #define AVX512_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
+  /* if the mask bit is set, copy from acolidx, otherwise from vec_idx */ \
+  vec_idx  = _mm256_loadu_si256((__m256i const*)acolidx); \
+  vec_vals = _mm512_loadu_pd(aval); \
+  vec_x    = _mm512_i32gather_pd(vec_idx,x,_MM_SCALE_8); \
+  vec_y    = _mm512_fmadd_pd(vec_x,vec_vals,vec_y)
+#endif
+#if defined(PETSC_SIMD_USE_AVX2) && !defined(PETSC_USE_64BIT_INDICES)
+  #define AVX2_Mult_Private(vec_idx,vec_x,vec_vals,vec_y) \
+  vec_vals = _mm256_loadu_pd(aval); \
+  vec_idx  = _mm_loadu_si128((__m128i const*)acolidx); /* SSE2 */ \
+  vec_x    = _mm256_i32gather_pd(x,vec_idx,_MM_SCALE_8); \
+  vec_y    = _mm256_fmadd_pd(vec_x,vec_vals,vec_y)
+#endif
 
 /*@C
  MatSeqSELLSetPreallocation - For good matrix assembly performance
@@ -292,7 +293,8 @@ PetscErrorCode MatConvert_SeqAIJ_SeqSELL(Mat A,MatType newtype,MatReuse reuse,Ma
   PetscFunctionReturn(0);
 }
 
-PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+#if defined(PETSC_SIMD_USE_AVX512) && !defined(PETSC_USE_64BIT_INDICES)
+static PetscErrorCode PETSC_SIMD_TARGET_AVX512 MatMult_SeqSELL_AVX512(Mat A,Vec xx,Vec yy)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
   PetscScalar       *y;
@@ -302,34 +304,15 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
   const PetscInt    *acolidx=a->colidx;
   PetscInt          i,j;
   PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m512d           vec_x,vec_y,vec_vals;
   __m256i           vec_idx;
   __mmask8          mask;
   __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
   __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128i           vec_idx;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,rows_left,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
-
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-#pragma disjoint(*x,*y,*aval)
-#endif
 
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   for (i=0; i<totalslices; i++) { /* loop over slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -385,7 +368,33 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
       _mm512_storeu_pd(&y[8*i],vec_y);
     }
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(PETSC_SIMD_USE_AVX2) && !defined(PETSC_USE_64BIT_INDICES)
+static PetscErrorCode PETSC_SIMD_TARGET_AVX2 MatMult_SeqSELL_AVX2(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  __m128i           vec_idx;
+  __m256d           vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar         yval;
+  PetscInt          r,rows_left,row,nnz_in_row;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -419,7 +428,33 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     _mm256_storeu_pd(y+i*8,vec_y);
     _mm256_storeu_pd(y+i*8+4,vec_y2);
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(PETSC_SIMD_USE_AVX) && !defined(PETSC_USE_64BIT_INDICES)
+static PetscErrorCode PETSC_SIMD_TARGET_AVX MatMult_SeqSELL_AVX(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  __m128d           vec_x_tmp;
+  __m256d           vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar         yval;
+  PetscInt          r,rows_left,row,nnz_in_row;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -468,7 +503,33 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
     _mm256_storeu_pd(y + i*8,     vec_y);
     _mm256_storeu_pd(y + i*8 + 4, vec_y2);
   }
-#else
+
+  ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  PetscScalar       sum[8];
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=0; j<8; j++) sum[j] = 0.0;
     for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
@@ -487,7 +548,6 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
       for(j=0; j<8; j++) y[8*i+j] = sum[j];
     }
   }
-#endif
 
   ierr = PetscLogFlops(2.0*a->nz-a->nonzerorowcnt);CHKERRQ(ierr); /* theoretical minimal FLOPs */
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
@@ -496,7 +556,8 @@ PetscErrorCode MatMult_SeqSELL(Mat A,Vec xx,Vec yy)
 }
 
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmultadd.h>
-PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+#if defined(PETSC_SIMD_USE_AVX512) && !defined(PETSC_USE_64BIT_INDICES)
+static PetscErrorCode PETSC_SIMD_TARGET_AVX512 MatMultAdd_SeqSELL_AVX512(Mat A,Vec xx,Vec yy,Vec zz)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
   PetscScalar       *y,*z;
@@ -506,29 +567,15 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
   const PetscInt    *acolidx=a->colidx;
   PetscInt          i,j;
   PetscErrorCode    ierr;
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m512d           vec_x,vec_y,vec_vals;
   __m256i           vec_idx;
   __mmask8          mask;
   __m512d           vec_x2,vec_y2,vec_vals2,vec_x3,vec_y3,vec_vals3,vec_x4,vec_y4,vec_vals4;
   __m256i           vec_idx2,vec_idx3,vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  __m128d           vec_x_tmp;
-  __m256d           vec_x,vec_y,vec_y2,vec_vals;
-  MatScalar         yval;
-  PetscInt          r,row,nnz_in_row;
-#else
-  PetscScalar       sum[8];
-#endif
-
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-#pragma disjoint(*x,*y,*aval)
-#endif
 
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
-#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   for (i=0; i<totalslices; i++) { /* loop over slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -588,7 +635,33 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
       _mm512_storeu_pd(&z[8*i],vec_y);
     }
   }
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#if defined(PETSC_SIMD_USE_AVX) && !defined(PETSC_USE_64BIT_INDICES)
+static PetscErrorCode PETSC_SIMD_TARGET_AVX MatMultAdd_SeqSELL_AVX(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  __m128d           vec_x_tmp;
+  __m256d           vec_x,vec_y,vec_y2,vec_vals;
+  MatScalar         yval;
+  PetscInt          r,row,nnz_in_row;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over full slices */
     PetscPrefetchBlock(acolidx,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
     PetscPrefetchBlock(aval,a->sliidx[i+1]-a->sliidx[i],0,PETSC_PREFETCH_HINT_T0);
@@ -634,7 +707,33 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
     _mm256_storeu_pd(z+i*8,vec_y);
     _mm256_storeu_pd(z+i*8+4,vec_y2);
   }
-#else
+
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
+  PetscScalar       *y,*z;
+  const PetscScalar *x;
+  const MatScalar   *aval=a->val;
+  PetscInt          totalslices=a->totalslices;
+  const PetscInt    *acolidx=a->colidx;
+  PetscInt          i,j;
+  PetscErrorCode    ierr;
+  PetscScalar       sum[8];
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+#pragma disjoint(*x,*y,*aval)
+#endif
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   for (i=0; i<totalslices; i++) { /* loop over slices */
     for (j=0; j<8; j++) sum[j] = 0.0;
     for (j=a->sliidx[i]; j<a->sliidx[i+1]; j+=8) {
@@ -653,7 +752,6 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
       for (j=0; j<8; j++) z[8*i+j] = y[8*i+j] + sum[j];
     }
   }
-#endif
 
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
@@ -661,6 +759,36 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A,Vec xx,Vec yy,Vec zz)
   PetscFunctionReturn(0);
 }
 
+/*
+   Installs the widest MatMult() and MatMultAdd() kernels allowed by PetscSIMDGetLevel()
+*/
+static PetscErrorCode MatSeqSELLSetSIMDOps_Private(Mat A)
+{
+  PetscSIMDLevel level;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSIMDGetLevel(&level);CHKERRQ(ierr);
+  A->ops->mult    = MatMult_SeqSELL;
+  A->ops->multadd = MatMultAdd_SeqSELL;
+#if defined(PETSC_SIMD_USE_AVX) && !defined(PETSC_USE_64BIT_INDICES)
+  if (level >= PETSC_SIMD_AVX) {
+    A->ops->mult    = MatMult_SeqSELL_AVX;
+    A->ops->multadd = MatMultAdd_SeqSELL_AVX;
+  }
+#endif
+#if defined(PETSC_SIMD_USE_AVX2) && !defined(PETSC_USE_64BIT_INDICES)
+  if (level >= PETSC_SIMD_AVX2) A->ops->mult = MatMult_SeqSELL_AVX2;
+#endif
+#if defined(PETSC_SIMD_USE_AVX512) && !defined(PETSC_USE_64BIT_INDICES)
+  if (level >= PETSC_SIMD_AVX512) {
+    A->ops->mult    = MatMult_SeqSELL_AVX512;
+    A->ops->multadd = MatMultAdd_SeqSELL_AVX512;
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
 {
   Mat_SeqSELL       *a=(Mat_SeqSELL*)A->data;
@@ -677,7 +805,7 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A,Vec xx,Vec zz,Vec yy)
 
   PetscFunctionBegin;
   if (A->symmetric) {
-    ierr = MatMultAdd_SeqSELL(A,xx,zz,yy);CHKERRQ(ierr);
+    ierr = (*A->ops->multadd)(A,xx,zz,yy);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
   if (zz != yy) { ierr = VecCopy(zz,yy);CHKERRQ(ierr); }
@@ -715,7 +843,7 @@ PetscErrorCode MatMultTranspose_SeqSELL(Mat A,Vec xx,Vec yy)
 
   PetscFunctionBegin;
   if (A->symmetric) {
-    ierr = MatMult_SeqSELL(A,xx,yy);CHKERRQ(ierr);
+    ierr = (*A->ops->mult)(A,xx,yy);CHKERRQ(ierr);
   } else {
     ierr = VecSet(yy,0.0);CHKERRQ(ierr);
     ierr = MatMultTransposeAdd_SeqSELL(A,xx,yy,yy);CHKERRQ(ierr);
@@ -1959,6 +2087,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqSELL(Mat B)
   B->data = (void*)b;
 
   ierr = PetscMemcpy(B->ops,&MatOps_Values,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr = MatSeqSELLSetSIMDOps_Private(B);CHKERRQ(ierr);
 
   b->row                = 0;
   b->col                = 0;
@@ -35,6 +35,7 @@ PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
 PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
+PetscLogEvent MAT_PreallCOO,MAT_SetVCOO;
 PetscLogEvent MAT_FactorFactS,MAT_FactorInvS;
 PetscLogEvent MATCOLORING_Apply,MATCOLORING_Comm,MATCOLORING_Local,MATCOLORING_ISCreate,MATCOLORING_SetUp,MATCOLORING_Weights;
 
@@ -836,11 +837,12 @@ PetscErrorCode MatResetPreallocation(Mat A)
 
    If a suitable preallocation routine is used, this function does not need to be called.
 
-   See the Performance chapter of the PETSc users manual for how to preallocate matrices
+   See the Performance chapter of the PETSc users manual for how to preallocate matrices; with MatSetHashAssembly()
+   AIJ, BAIJ and SBAIJ matrices that are not preallocated allocate their storage exactly at the first final assembly.
 
    Level: beginner
 
-.seealso: MatCreate(), MatDestroy()
+.seealso: MatCreate(), MatDestroy(), MatSetHashAssembly()
 @*/
 PetscErrorCode MatSetUp(Mat A)
 {
@@ -857,7 +859,10 @@ PetscErrorCode MatSetUp(Mat A)
       ierr = MatSetType(A, MATMPIAIJ);CHKERRQ(ierr);
     }
   }
-  if (!A->preallocated && A->ops->setup) {
+  if (!A->preallocated && A->hashassembly) {
+    ierr = MatSetUpHash_Private(A);CHKERRQ(ierr);
+  }
+  if (!A->preallocated && !A->hash && A->ops->setup) {
     ierr = PetscInfo(A,"Warning not preallocating matrix storage\n");CHKERRQ(ierr);
     ierr = (*A->ops->setup)(A);CHKERRQ(ierr);
   }
@@ -2047,6 +2052,100 @@ PetscErrorCode MatSetValuesBatch(Mat mat, PetscInt nb, PetscInt bs, PetscInt row
   PetscFunctionReturn(0);
 }
 
+/*@
+   MatSetPreallocationCOO - set the nonzero pattern of a matrix from a list of entries given in coordinate (COO) format,
+   and compute once where each entry is stored so that the values can later be set with MatSetValuesCOO()
+
+   Collective
+
+   Input Parameters:
++  A - the matrix, its type and sizes must have been set
+.  n - number of entries given on this process
+.  coo_i - global row index of each entry
+-  coo_j - global column index of each entry
+
+   Notes:
+   Entries may be given on any process, in any order, and may be repeated; repeated entries are summed by MatSetValuesCOO().
+   Entries with a negative row or column index are ignored. This routine replaces any previous preallocation of the matrix
+   and leaves it assembled with zero values in the given locations. The arrays coo_i and coo_j are not referenced
+   after this routine returns.
+
+   For MATSEQAIJ, MATMPIAIJ, MATSEQBAIJ and MATMPIBAIJ the location of every entry in the storage of the matrix is computed
+   here, together with a PetscSF that sends the entries owned by other processes directly to their owners; each later call
+   to MatSetValuesCOO() then moves only values, without searching the rows or using the MatStash. Other matrix types fall
+   back to MatSetValues().
+
+   Level: beginner
+
+.seealso: MatSetValuesCOO(), MatSeqAIJSetPreallocation(), MatMPIAIJSetPreallocation(), MatSeqAIJSetPreallocationCSR(),
+          MatMPIAIJSetPreallocationCSR(), MatSetValues()
+@*/
+PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr,(*f)(Mat,PetscInt,const PetscInt[],const PetscInt[]) = NULL;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  if (n) {
+    PetscValidIntPointer(coo_i,3);
+    PetscValidIntPointer(coo_j,4);
+  }
+  if (n < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of COO entries cannot be negative: %D",n);
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetPreallocationCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,n,coo_i,coo_j);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetPreallocationCOO_Basic(A,n,coo_i,coo_j);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_PreallCOO,A,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSetValuesCOO - set the values of a matrix whose nonzero pattern was given with MatSetPreallocationCOO()
+
+   Collective
+
+   Input Parameters:
++  A - the matrix
+.  coo_v - the values, in the same order as the coo_i and coo_j arrays passed to MatSetPreallocationCOO()
+-  imode - INSERT_VALUES to replace the values of the matrix, ADD_VALUES to add to them
+
+   Notes:
+   Repeated entries are always summed; with INSERT_VALUES their sum replaces the previous value of the matrix entry.
+   The matrix is assembled on return, there is no need to call MatAssemblyBegin() and MatAssemblyEnd().
+
+   If the nonzero pattern of the matrix is changed after MatSetPreallocationCOO(), for example by MatSetValues()
+   introducing a new nonzero, MatSetPreallocationCOO() must be called again.
+
+   Level: beginner
+
+.seealso: MatSetPreallocationCOO(), MatSetValues(), InsertMode, INSERT_VALUES, ADD_VALUES
+@*/
+PetscErrorCode MatSetValuesCOO(Mat A,const PetscScalar coo_v[],InsertMode imode)
+{
+  PetscErrorCode ierr,(*f)(Mat,const PetscScalar[],InsertMode) = NULL;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidType(A,1);
+  PetscValidLogicalCollectiveEnum(A,imode,3);
+  ierr = PetscObjectQueryFunction((PetscObject)A,"MatSetValuesCOO_C",&f);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  if (f) {
+    ierr = (*f)(A,coo_v,imode);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetValuesCOO_Basic(A,coo_v,imode);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(MAT_SetVCOO,A,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatSetLocalToGlobalMapping - Sets a local-to-global numbering for use by
    the routine MatSetValuesLocal() to allow users to insert matrix entries
@@ -3929,13 +4028,20 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat,Vec b,Vec y,Vec x)
 .     SOR_APPLY_UPPER, SOR_APPLY_LOWER - applies
          upper/lower triangular part of matrix to
          vector (with omega)
--     SOR_ZERO_INITIAL_GUESS - zero initial guess
+.     SOR_ZERO_INITIAL_GUESS - zero initial guess
+-     SOR_MULTICOLOR - combined with one of the sweeps, relaxes the rows one color of a distance one coloring at a time
 
    Notes:
    SOR_LOCAL_FORWARD_SWEEP, SOR_LOCAL_BACKWARD_SWEEP, and
    SOR_LOCAL_SYMMETRIC_SWEEP perform separate independent smoothings
    on each processor.
 
+   With SOR_MULTICOLOR the rows of a color, which do not couple to each other, are relaxed
+   concurrently by the OpenMP threads, the rows are visited in a different order so the iterates
+   differ from those of the lexicographic sweeps. The coloring is computed with MatColoring the first
+   time and again whenever the nonzero structure changes. It is only supported by MATSEQAIJ and MATMPIAIJ
+   matrices and their subclasses, in parallel for the local sweeps; other types generate an error.
+
    Application programmers will not generally use MatSOR() directly,
    but instead will employ the KSP/PC interface.
 
@@ -3978,6 +4084,14 @@ PetscErrorCode MatSOR(Mat mat,Vec b,PetscReal omega,MatSORType flag,PetscReal sh
   if (its <= 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D positive",its);
   if (lits <= 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires local its %D positive",lits);
   if (b == x) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_IDN,"b and x vector cannot be the same");
+  if (flag & SOR_MULTICOLOR) {
+    PetscErrorCode (*seqaij)(Mat,PetscInt,const PetscInt[]),(*mpiaij)(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[]);
+
+    /* the other types would silently ignore the flag and do the lexicographic sweeps */
+    ierr = PetscObjectQueryFunction((PetscObject)mat,"MatSeqAIJSetPreallocation_C",&seqaij);CHKERRQ(ierr);
+    ierr = PetscObjectQueryFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",&mpiaij);CHKERRQ(ierr);
+    if (!seqaij && !mpiaij) SETERRQ1(PetscObjectComm((PetscObject)mat),PETSC_ERR_SUP,"SOR_MULTICOLOR is not supported for Mat type %s",((PetscObject)mat)->type_name);
+  }
 
   MatCheckPreallocated(mat,1);
   ierr = PetscLogEventBegin(MAT_SOR,mat,b,x,0);CHKERRQ(ierr);
@@ -4390,45 +4504,58 @@ PetscErrorCode MatSolverTypeGet(MatSolverType package,MatType mtype,MatFactorTyp
 {
   PetscErrorCode              ierr;
   MatSolverTypeHolder         next = MatSolverTypeHolders;
-  PetscBool                   flg;
-  MatSolverTypeForSpecifcType inext;
+  PetscBool                   flg,exact;
+  MatSolverTypeForSpecifcType inext,match;
 
   PetscFunctionBegin;
   if (foundpackage) *foundpackage = PETSC_FALSE;
   if (foundmtype)   *foundmtype   = PETSC_FALSE;
   if (getfactor)    *getfactor    = NULL;
 
+  /* a handler registered for mtype itself is preferred to one registered for a base type whose name is a prefix of mtype */
   if (package) {
     while (next) {
       ierr = PetscStrcasecmp(package,next->name,&flg);CHKERRQ(ierr);
       if (flg) {
         if (foundpackage) *foundpackage = PETSC_TRUE;
         inext = next->handlers;
+        match = NULL;
         while (inext) {
           ierr = PetscStrbeginswith(mtype,inext->mtype,&flg);CHKERRQ(ierr);
           if (flg) {
-            if (foundmtype) *foundmtype = PETSC_TRUE;
-            if (getfactor)  *getfactor  = inext->getfactor[(int)ftype-1];
-            PetscFunctionReturn(0);
+            ierr = PetscStrcasecmp(mtype,inext->mtype,&exact);CHKERRQ(ierr);
+            if (!match || exact) match = inext;
+            if (exact) break;
           }
           inext = inext->next;
         }
+        if (match) {
+          if (foundmtype) *foundmtype = PETSC_TRUE;
+          if (getfactor)  *getfactor  = match->getfactor[(int)ftype-1];
+          PetscFunctionReturn(0);
+        }
       }
       next = next->next;
     }
   } else {
     while (next) {
       inext = next->handlers;
+      match = NULL;
       while (inext) {
         ierr = PetscStrbeginswith(mtype,inext->mtype,&flg);CHKERRQ(ierr);
         if (flg && inext->getfactor[(int)ftype-1]) {
-          if (foundpackage) *foundpackage = PETSC_TRUE;
-          if (foundmtype)   *foundmtype   = PETSC_TRUE;
-          if (getfactor)    *getfactor    = inext->getfactor[(int)ftype-1];
-          PetscFunctionReturn(0);
+          ierr = PetscStrcasecmp(mtype,inext->mtype,&exact);CHKERRQ(ierr);
+          if (!match || exact) match = inext;
+          if (exact) break;
         }
         inext = inext->next;
       }
+      if (match) {
+        if (foundpackage) *foundpackage = PETSC_TRUE;
+        if (foundmtype)   *foundmtype   = PETSC_TRUE;
+        if (getfactor)    *getfactor    = match->getfactor[(int)ftype-1];
+        PetscFunctionReturn(0);
+      }
       next = next->next;
     }
   }
@@ -310,6 +310,47 @@ PetscErrorCode  MatFDColoringSetFunction(MatFDColoring matfd,PetscErrorCode (*f)
   PetscFunctionReturn(0);
 }
 
+/*@C
+   MatFDColoringSetFunctionBatch - Sets a function that evaluates the function used for computing the Jacobian
+   at several perturbed vectors at once.
+
+   Logically Collective on MatFDColoring
+
+   Input Parameters:
++  coloring - the coloring context
+.  f - the function
+-  fctx - the optional user-defined function context
+
+   Calling sequence of (*f) function:
+    For SNES:    PetscErrorCode (*f)(SNES,PetscInt n,Vec X[],Vec F[],void*)
+    If not using SNES: PetscErrorCode (*f)(void *dummy,PetscInt n,Vec X[],Vec F[],void*) and dummy is ignored
+
+   Level: advanced
+
+   Notes:
+    MatFDColoringApply() with AIJ matrices builds the perturbed vectors of the colors of a block of columns,
+    see MatFDColoringSetBlockSize() and -mat_fd_coloring_bcols, and calls f once to compute F[i] = F(X[i]) for all of them;
+    with BAIJ matrices a call covers the block size columns of a color. The values of the whole block are then inserted
+    into the Jacobian together. This lets a function evaluate all the perturbed vectors in one traversal of the mesh.
+
+    If both functions are set the batched function is used only when several vectors are evaluated together; F(x) at the
+    unperturbed vector, and the perturbed vectors when the block size is one, are given to the function set with
+    MatFDColoringSetFunction(). MatFDColoringGetPerturbedColumns() returns no columns during a call of the batched function.
+
+    DMSNESSetFunctionBatch() and DMSNESSetFunctionBatchLocal() provide a batched function to the MatFDColoring used by SNES.
+
+.seealso: MatFDColoringCreate(), MatFDColoringSetFunction(), MatFDColoringSetBlockSize(), MatFDColoringApply()
+
+@*/
+PetscErrorCode  MatFDColoringSetFunctionBatch(MatFDColoring matfd,PetscErrorCode (*f)(void),void *fctx)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(matfd,MAT_FDCOLORING_CLASSID,1);
+  matfd->fbatch    = f;
+  matfd->fbatchctx = fctx;
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatFDColoringSetFromOptions - Sets coloring finite difference parameters from
    the options database.
@@ -532,6 +573,10 @@ PetscErrorCode  MatFDColoringDestroy(MatFDColoring *c)
   ierr = VecDestroy(&color->w1);CHKERRQ(ierr);
   ierr = VecDestroy(&color->w2);CHKERRQ(ierr);
   ierr = VecDestroy(&color->w3);CHKERRQ(ierr);
+  if (color->nbatch) {
+    ierr = VecDestroyVecs(color->nbatch,&color->xbatch);CHKERRQ(ierr);
+    ierr = VecDestroyVecs(color->nbatch,&color->ybatch);CHKERRQ(ierr);
+  }
   ierr = PetscHeaderDestroy(c);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -599,7 +644,7 @@ PetscErrorCode  MatFDColoringGetPerturbedColumns(MatFDColoring coloring,PetscInt
 
     Level: intermediate
 
-.seealso: MatFDColoringCreate(), MatFDColoringDestroy(), MatFDColoringView(), MatFDColoringSetFunction()
+.seealso: MatFDColoringCreate(), MatFDColoringDestroy(), MatFDColoringView(), MatFDColoringSetFunction(), MatFDColoringSetFunctionBatch()
 
 @*/
 PetscErrorCode  MatFDColoringApply(Mat J,MatFDColoring coloring,Vec x1,void *sctx)
@@ -613,7 +658,7 @@ PetscErrorCode  MatFDColoringApply(Mat J,MatFDColoring coloring,Vec x1,void *sct
   PetscValidHeaderSpecific(x1,VEC_CLASSID,3);
   ierr = PetscObjectCompareId((PetscObject)J,coloring->matid,&eq);CHKERRQ(ierr);
   if (!eq) SETERRQ(PetscObjectComm((PetscObject)J),PETSC_ERR_ARG_WRONG,"Matrix used with MatFDColoringApply() must be that used with MatFDColoringCreate()");
-  if (!coloring->f) SETERRQ(PetscObjectComm((PetscObject)J),PETSC_ERR_ARG_WRONGSTATE,"Must call MatFDColoringSetFunction()");
+  if (!coloring->f && !coloring->fbatch) SETERRQ(PetscObjectComm((PetscObject)J),PETSC_ERR_ARG_WRONGSTATE,"Must call MatFDColoringSetFunction() or MatFDColoringSetFunctionBatch()");
   if (!J->ops->fdcoloringapply) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Not supported for this matrix type %s",((PetscObject)J)->type_name);
   if (!coloring->setupcalled) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatFDColoringSetUp()");
 
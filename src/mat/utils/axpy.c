@@ -48,6 +48,10 @@ static PetscErrorCode MatTransposeAXPY_Private(Mat Y,PetscScalar a,Mat X,MatStru
 
    Notes: No operation is performed when a is zero.
 
+   With DIFFERENT_NONZERO_PATTERN, AIJ and BAIJ matrices Y are replaced by the sum on the union of the nonzero
+   patterns. Y then keeps the locations of the nonzeros of X, so that later calls with the same X, whose nonzero
+   patterns have not changed, only add the values.
+
    Level: intermediate
 
 .seealso: MatAYPX()
@@ -261,6 +265,96 @@ PetscErrorCode MatAXPY_BasicWithPreallocation(Mat B,Mat Y,PetscScalar a,Mat X,Ma
   PetscFunctionReturn(0);
 }
 
+/*
+   Checks if the locations kept by Y are still those of the blocks of X. If not, they are replaced by
+   an allocated Mat_AXPY whose locations the caller must compute with MatAXPYStructSetLocations_XAIJ().
+   The nonzero states catch the changes of the nonzero patterns, the number of blocks the reallocations.
+*/
+PetscErrorCode MatAXPYStructCheck_XAIJ(Mat Y,Mat X,PetscInt bs2,PetscInt nA,PetscInt nB,PetscInt nyA,Mat_AXPY **axpy,PetscBool *valid)
+{
+  PetscErrorCode ierr;
+  Mat_AXPY       *p = *axpy;
+  PetscObjectId  xid;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetId((PetscObject)X,&xid);CHKERRQ(ierr);
+  *valid = (PetscBool)(p && p->xid == xid && p->xstate == X->nonzerostate && p->ystate == Y->nonzerostate && p->bs2 == bs2 && p->nA == nA && p->nB == nB && p->nyA == nyA);
+  if (*valid) PetscFunctionReturn(0);
+  ierr = MatAXPYStructDestroy_XAIJ(axpy);CHKERRQ(ierr);
+  ierr = PetscNew(&p);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nA+nB,&p->loc);CHKERRQ(ierr);
+  p->xid    = xid;
+  p->xstate = X->nonzerostate;
+  p->ystate = Y->nonzerostate;
+  p->bs2    = bs2;
+  p->nA     = nA;
+  p->nB     = nB;
+  p->nyA    = nyA;
+  *axpy     = p;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Merges the sorted rows of X and Y to find the location in the value array of Y of each block of X,
+   shifted by shift. The local-to-global maps of the columns may be NULL. Stops with subset false as
+   soon as a block of X is not in Y.
+*/
+PetscErrorCode MatAXPYStructSetLocations_XAIJ(PetscInt m,const PetscInt xi[],const PetscInt xj[],const PetscInt xltog[],const PetscInt yi[],const PetscInt yj[],const PetscInt yltog[],PetscInt shift,PetscInt loc[],PetscBool *subset)
+{
+  PetscInt i,j,k,xcol;
+
+  PetscFunctionBegin;
+  *subset = PETSC_TRUE;
+  for (i=0; i<m; i++) {
+    for (j=xi[i],k=yi[i]; j<xi[i+1]; j++) {
+      xcol = xltog ? xltog[xj[j]] : xj[j];
+      while (k<yi[i+1] && (yltog ? yltog[yj[k]] : yj[k]) < xcol) k++;
+      if (k == yi[i+1] || (yltog ? yltog[yj[k]] : yj[k]) != xcol) {
+        *subset = PETSC_FALSE;
+        PetscFunctionReturn(0);
+      }
+      loc[j] = shift + k++;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Adds a times the values of X to those of Y in one pass over the blocks of X */
+PetscErrorCode MatAXPYStructApply_XAIJ(Mat_AXPY *axpy,PetscScalar a,const MatScalar *xa,const MatScalar *xb,MatScalar *ya,MatScalar *yb)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,l,p,bs2 = axpy->bs2,nA = axpy->nA,nB = axpy->nB,nyA = axpy->nyA;
+  const PetscInt *loc = axpy->loc;
+
+  PetscFunctionBegin;
+  if (bs2 == 1) {
+    for (k=0; k<nA; k++) ya[loc[k]] += a*xa[k];
+    for (k=0; k<nB; k++) yb[loc[nA+k]-nyA] += a*xb[k];
+  } else {
+    for (k=0; k<nA; k++) {
+      p = loc[k]*bs2;
+      for (l=0; l<bs2; l++) ya[p+l] += a*xa[k*bs2+l];
+    }
+    for (k=0; k<nB; k++) {
+      p = (loc[nA+k]-nyA)*bs2;
+      for (l=0; l<bs2; l++) yb[p+l] += a*xb[k*bs2+l];
+    }
+  }
+  ierr = PetscLogFlops(2.0*bs2*(nA+nB));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAXPYStructDestroy_XAIJ(Mat_AXPY **axpy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*axpy) PetscFunctionReturn(0);
+  ierr = PetscFree((*axpy)->loc);CHKERRQ(ierr);
+  ierr = PetscFree(*axpy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatShift - Computes Y =  Y + a I, where a is a PetscScalar and I is the identity matrix.
 
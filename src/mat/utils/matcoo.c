@@ -0,0 +1,317 @@
+#include <petsc/private/matimpl.h>       /*I "petscmat.h"  I*/
+#include <petscsf.h>
+
+/*
+   MatCOOStructCreate_XAIJ - Computes, once, where each entry given in coordinate format lands in the value
+   arrays of an XAIJ matrix, together with the PetscSF that sends the entries owned by other processes to their owners.
+
+   Input Parameters:
++  mat   - the matrix, its layouts are set up by this routine
+.  bs    - the block size of the storage (1 for AIJ)
+.  split - PETSC_TRUE if the local rows are stored as a diagonal and an off-diagonal block (MPIAIJ, MPIBAIJ)
+.  n     - number of COO entries on this process
+-  coo_i, coo_j - global row and column indices of the entries, entries with a negative index are ignored
+
+   Output Parameters:
++  Ii, Jj - block CSR of the local rows with global (block) column indices, sorted and without duplicates, to be
+            passed to Mat[Seq,MPI][B]AIJSetPreallocationCSR()
+-  coo    - the plan used by MatCOOStructSetValues_XAIJ()
+
+   Notes:
+   The locations are computed assuming that the preallocation routine lays out each block row exactly as given by
+   Ii and Jj (with the off-diagonal block columns in increasing global order); locations below nA refer to the diagonal
+   block value array, the others to the off-diagonal one, shifted by nA. Inside a block, values are stored by columns.
+*/
+PetscErrorCode MatCOOStructCreate_XAIJ(Mat mat,PetscInt bs,PetscBool split,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[],PetscInt **Ii,PetscInt **Jj,Mat_COO **newcoo)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    size,owner;
+  Mat_COO        *coo;
+  PetscInt       M,N,rstart,rend,mbs,cstart,cend,bs2 = bs*bs;
+  PetscInt       k,r,s,e,nlocal = 0,nremote = 0,nrecv = 0,ntot,nu,nzA,nzB,row,cur,prev;
+  PetscInt       *recv_i = NULL,*recv_j = NULL,*brow,*bcol,*src,*ii,*jj,*aoff,*boff;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  M      = mat->rmap->N;
+  N      = mat->cmap->N;
+  rstart = mat->rmap->rstart;
+  rend   = mat->rmap->rend;
+  mbs    = mat->rmap->n/bs;
+  cstart = mat->cmap->rstart/bs;
+  cend   = mat->cmap->rend/bs;
+
+  ierr = PetscNew(&coo);CHKERRQ(ierr);
+  coo->n = n;
+  ierr = PetscMalloc1(n,&coo->perm);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    coo->perm[k] = -1;
+    if (coo_i[k] < 0 || coo_j[k] < 0) continue;
+    if (coo_i[k] >= M) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has row %D, global number of rows is %D",k,coo_i[k],M);
+    if (coo_j[k] >= N) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"COO entry %D has column %D, global number of columns is %D",k,coo_j[k],N);
+    if (coo_i[k] >= rstart && coo_i[k] < rend) nlocal++;
+    else nremote++;
+  }
+
+  if (size > 1) {
+    PetscSF     csf;
+    PetscSFNode *cremote,*iremote;
+    PetscInt    *rowner,*ridx,nranks = 0,counter = 0,*rcount,*roffset;
+
+    /* group the off-process entries by owner, keeping them in input order for each owner */
+    ierr = PetscMalloc1(nremote,&rowner);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nremote,&ridx);CHKERRQ(ierr);
+    for (k=0,r=0; k<n; k++) {
+      if (coo_i[k] < 0 || coo_j[k] < 0 || (coo_i[k] >= rstart && coo_i[k] < rend)) continue;
+      ierr      = PetscLayoutFindOwner(mat->rmap,coo_i[k],&owner);CHKERRQ(ierr);
+      rowner[r] = owner;
+      ridx[r++] = k;
+    }
+    ierr = PetscSortIntWithArray(nremote,rowner,ridx);CHKERRQ(ierr);
+    for (s=0; s<nremote; s=e) {
+      for (e=s+1; e<nremote && rowner[e] == rowner[s]; e++) ;
+      ierr = PetscSortInt(e-s,ridx+s);CHKERRQ(ierr);
+      nranks++;
+    }
+
+    /* each process gets its offset in the receive buffer of every owner with a fetch-and-add on a counter held by the owner */
+    ierr = PetscMalloc3(nranks,&cremote,nranks,&rcount,nranks,&roffset);CHKERRQ(ierr);
+    for (s=0,r=0; s<nremote; s=e,r++) {
+      for (e=s+1; e<nremote && rowner[e] == rowner[s]; e++) ;
+      cremote[r].rank  = rowner[s];
+      cremote[r].index = 0;
+      rcount[r]        = e-s;
+    }
+    ierr = PetscSFCreate(comm,&csf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(csf,1,nranks,NULL,PETSC_COPY_VALUES,cremote,PETSC_COPY_VALUES);CHKERRQ(ierr);
+    ierr = PetscSFFetchAndOpBegin(csf,MPIU_INT,&counter,rcount,roffset,MPI_SUM);CHKERRQ(ierr);
+    ierr = PetscSFFetchAndOpEnd(csf,MPIU_INT,&counter,rcount,roffset,MPI_SUM);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&csf);CHKERRQ(ierr);
+    nrecv = counter;
+
+    ierr = PetscMalloc1(nremote,&iremote);CHKERRQ(ierr);
+    for (s=0,r=0; s<nremote; s=e,r++) {
+      for (e=s; e<nremote && rowner[e] == rowner[s]; e++) {
+        iremote[e].rank  = rowner[s];
+        iremote[e].index = roffset[r] + e - s;
+      }
+    }
+    ierr = PetscFree3(cremote,rcount,roffset);CHKERRQ(ierr);
+    ierr = PetscFree(rowner);CHKERRQ(ierr);
+
+    /* the leaves are the positions of the off-process entries in the user arrays, so no packing is needed on the send side */
+    ierr = PetscSFCreate(comm,&coo->sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(coo->sf,nrecv,nremote,ridx,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFSetUp(coo->sf);CHKERRQ(ierr);
+    ierr = PetscMalloc2(nrecv,&recv_i,nrecv,&recv_j);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(coo->sf,MPIU_INT,coo_i,recv_i,MPIU_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(coo->sf,MPIU_INT,coo_i,recv_i,MPIU_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFReduceBegin(coo->sf,MPIU_INT,coo_j,recv_j,MPIU_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFReduceEnd(coo->sf,MPIU_INT,coo_j,recv_j,MPIU_REPLACE);CHKERRQ(ierr);
+  }
+  coo->nrecv = nrecv;
+  ierr = PetscMalloc2(nrecv,&coo->recvperm,nrecv,&coo->recvbuf);CHKERRQ(ierr);
+
+  /* sort all entries of the local rows by block row and block column; src[] remembers where each came from */
+  ntot = nlocal + nrecv;
+  ierr = PetscMalloc3(ntot,&brow,ntot,&bcol,ntot,&src);CHKERRQ(ierr);
+  for (k=0,e=0; k<n; k++) {
+    if (coo_i[k] < 0 || coo_j[k] < 0 || coo_i[k] < rstart || coo_i[k] >= rend) continue;
+    brow[e] = (coo_i[k]-rstart)/bs;
+    bcol[e] = coo_j[k]/bs;
+    src[e++] = k;
+  }
+  for (r=0; r<nrecv; r++,e++) {
+    if (recv_i[r] < rstart || recv_i[r] >= rend) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Received COO entry for row %D that is not owned by this process",recv_i[r]);
+    brow[e] = (recv_i[r]-rstart)/bs;
+    bcol[e] = recv_j[r]/bs;
+    src[e]  = n + r;
+  }
+  ierr = PetscSortIntWithArrayPair(ntot,brow,bcol,src);CHKERRQ(ierr);
+  for (s=0; s<ntot; s=e) {
+    for (e=s+1; e<ntot && brow[e] == brow[s]; e++) ;
+    ierr = PetscSortIntWithArray(e-s,bcol+s,src+s);CHKERRQ(ierr);
+  }
+
+  /* first pass: the block CSR and the number of diagonal and off-diagonal blocks in each block row */
+  ierr = PetscCalloc1(mbs+1,&ii);CHKERRQ(ierr);
+  ierr = PetscCalloc2(mbs+1,&aoff,mbs+1,&boff);CHKERRQ(ierr);
+  ierr = PetscMalloc1(ntot,&jj);CHKERRQ(ierr);
+  for (e=0,nu=0,prev=-1,row=-1; e<ntot; e++) {
+    if (brow[e] != row) {row = brow[e]; prev = -1;}
+    if (bcol[e] == prev) continue;
+    prev     = bcol[e];
+    jj[nu++] = prev;
+    ii[row+1]++;
+    if (split && (prev < cstart || prev >= cend)) boff[row+1]++;
+    else aoff[row+1]++;
+  }
+  for (row=0; row<mbs; row++) {
+    ii[row+1]   += ii[row];
+    aoff[row+1] += aoff[row];
+    boff[row+1] += boff[row];
+  }
+  nzA = aoff[mbs];
+  nzB = boff[mbs];
+
+  /* second pass: the location of every entry */
+  for (e=0,prev=-1,row=-1,cur=-1; e<ntot; e++) {
+    PetscInt gi,gj;
+
+    if (brow[e] != row) {row = brow[e]; prev = -1;}
+    if (bcol[e] != prev) {
+      prev = bcol[e];
+      if (split && (prev < cstart || prev >= cend)) cur = nzA + boff[row]++;
+      else cur = aoff[row]++;
+    }
+    if (src[e] < n) {gi = coo_i[src[e]]; gj = coo_j[src[e]];}
+    else            {gi = recv_i[src[e]-n]; gj = recv_j[src[e]-n];}
+    k = cur*bs2 + (gj%bs)*bs + (gi%bs);
+    if (src[e] < n) coo->perm[src[e]] = k;
+    else coo->recvperm[src[e]-n] = k;
+  }
+  coo->nA = nzA*bs2;
+  coo->nB = nzB*bs2;
+
+  ierr = PetscFree3(brow,bcol,src);CHKERRQ(ierr);
+  ierr = PetscFree2(aoff,boff);CHKERRQ(ierr);
+  ierr = PetscFree2(recv_i,recv_j);CHKERRQ(ierr);
+  *Ii     = ii;
+  *Jj     = jj;
+  *newcoo = coo;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatCOOStructSetValues_XAIJ - Scatters the COO values into the diagonal (aa) and off-diagonal (ba) value arrays,
+   the off-process values are sent while the local ones are being added
+*/
+PetscErrorCode MatCOOStructSetValues_XAIJ(Mat mat,Mat_COO *coo,const PetscScalar v[],InsertMode imode,MatScalar *aa,MatScalar *ba)
+{
+  PetscErrorCode ierr;
+  PetscInt       k,p,n = coo->n,nA = coo->nA;
+  const PetscInt *perm = coo->perm;
+
+  PetscFunctionBegin;
+  if (mat->nonzerostate != coo->nonzerostate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The nonzero pattern has changed since MatSetPreallocationCOO() was called");
+  if (imode != INSERT_VALUES && imode != ADD_VALUES) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Only INSERT_VALUES and ADD_VALUES are supported");
+  if (coo->sf) {ierr = PetscSFReduceBegin(coo->sf,MPIU_SCALAR,v,coo->recvbuf,MPIU_REPLACE);CHKERRQ(ierr);}
+  if (imode == INSERT_VALUES) {
+    ierr = PetscArrayzero(aa,coo->nA);CHKERRQ(ierr);
+    if (coo->nB) {ierr = PetscArrayzero(ba,coo->nB);CHKERRQ(ierr);}
+  }
+  for (k=0; k<n; k++) {
+    p = perm[k];
+    if (p < 0) continue;
+    if (p < nA) aa[p] += v[k];
+    else ba[p-nA] += v[k];
+  }
+  if (coo->sf) {
+    const PetscInt    *rperm = coo->recvperm;
+    const PetscScalar *rbuf  = coo->recvbuf;
+
+    ierr = PetscSFReduceEnd(coo->sf,MPIU_SCALAR,v,coo->recvbuf,MPIU_REPLACE);CHKERRQ(ierr);
+    for (k=0; k<coo->nrecv; k++) {
+      p = rperm[k];
+      if (p < nA) aa[p] += rbuf[k];
+      else ba[p-nA] += rbuf[k];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatCOOStructDestroy_XAIJ(Mat_COO **coo)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*coo) PetscFunctionReturn(0);
+  ierr = PetscFree((*coo)->perm);CHKERRQ(ierr);
+  ierr = PetscFree2((*coo)->recvperm,(*coo)->recvbuf);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&(*coo)->sf);CHKERRQ(ierr);
+  ierr = PetscFree(*coo);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+typedef struct { /* kept by the matrix types that do not provide their own COO support */
+  PetscInt n,*i,*j;
+} Mat_COO_Basic;
+
+static PetscErrorCode MatCOOBasicDestroy_Private(void *ptr)
+{
+  Mat_COO_Basic  *coo = (Mat_COO_Basic*)ptr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(coo->i,coo->j);CHKERRQ(ierr);
+  ierr = PetscFree(coo);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetPreallocationCOO_Basic(Mat A,PetscInt n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  PetscErrorCode ierr;
+  Mat            preallocator;
+  PetscContainer container;
+  Mat_COO_Basic  *coo;
+  PetscScalar    zero = 0.0;
+  PetscInt       k;
+  PetscBool      isdense;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompareAny((PetscObject)A,&isdense,MATSEQDENSE,MATMPIDENSE,"");CHKERRQ(ierr);
+  /* a dense matrix needs no nonzero pattern */
+  if (isdense) {
+    ierr = MatSetUp(A);CHKERRQ(ierr);
+  } else {
+    ierr = MatCreate(PetscObjectComm((PetscObject)A),&preallocator);CHKERRQ(ierr);
+    ierr = MatSetType(preallocator,MATPREALLOCATOR);CHKERRQ(ierr);
+    ierr = MatSetSizes(preallocator,A->rmap->n,A->cmap->n,A->rmap->N,A->cmap->N);CHKERRQ(ierr);
+    ierr = MatSetBlockSizesFromMats(preallocator,A,A);CHKERRQ(ierr);
+    ierr = MatSetUp(preallocator);CHKERRQ(ierr);
+    for (k=0; k<n; k++) {
+      ierr = MatSetValues(preallocator,1,coo_i+k,1,coo_j+k,&zero,INSERT_VALUES);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(preallocator,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatPreallocatorPreallocate(preallocator,PETSC_TRUE,A);CHKERRQ(ierr);
+    ierr = MatDestroy(&preallocator);CHKERRQ(ierr);
+  }
+
+  ierr = PetscNew(&coo);CHKERRQ(ierr);
+  coo->n = n;
+  ierr = PetscMalloc2(n,&coo->i,n,&coo->j);CHKERRQ(ierr);
+  ierr = PetscArraycpy(coo->i,coo_i,n);CHKERRQ(ierr);
+  ierr = PetscArraycpy(coo->j,coo_j,n);CHKERRQ(ierr);
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,coo);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatCOOBasicDestroy_Private);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)A,"__PETSc_MatCOO_Basic",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_Basic(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  PetscErrorCode ierr;
+  PetscContainer container;
+  Mat_COO_Basic  *coo;
+  PetscInt       k;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)A,"__PETSc_MatCOO_Basic",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  if (imode != INSERT_VALUES && imode != ADD_VALUES) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"Only INSERT_VALUES and ADD_VALUES are supported");
+  ierr = PetscContainerGetPointer(container,(void**)&coo);CHKERRQ(ierr);
+  if (imode == INSERT_VALUES) {ierr = MatZeroEntries(A);CHKERRQ(ierr);}
+  for (k=0; k<coo->n; k++) {
+    ierr = MatSetValues(A,1,coo->i+k,1,coo->j+k,v+k,ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,338 @@
+#include <petsc/private/matimpl.h>       /*I "petscmat.h"  I*/
+#include <petsc/private/hashmapijv.h>
+#include <petsc/private/hashsetij.h>
+
+/*
+   State of a matrix between MatSetUp() and its first final assembly with -mat_hash_assembly: the matrix has no
+   storage yet, MatSetValues() accumulates the locally owned entries in a hash table and MatAssemblyEnd() preallocates
+   the storage exactly before inserting them, sorted by row and column, with the operations of the matrix type.
+*/
+struct _n_Mat_Hash {
+  struct _MatOps ops;                                   /* the operations of the matrix type */
+  PetscHMapIJV   ht;                                    /* the locally owned entries, by global row and column */
+  PetscBool      aij,sbaij,mpi;                         /* the storage format; BAIJ if neither AIJ nor SBAIJ */
+  PetscBool      roworiented,ignorezeroentries,donotstash;
+  PetscInt       nopt;                                  /* options set before the storage exists, in the order they */
+  MatOption      opt[MAT_OPTION_MAX-MAT_OPTION_MIN];    /* were last set, they are applied again once it is allocated */
+  PetscBool      optflg[MAT_OPTION_MAX-MAT_OPTION_MIN];
+};
+
+static PetscErrorCode MatSetValues_Hash(Mat A,PetscInt m,const PetscInt rows[],PetscInt n,const PetscInt cols[],const PetscScalar v[],InsertMode addv)
+{
+  Mat_Hash       h = A->hash;
+  PetscErrorCode ierr;
+  PetscInt       rstart = A->rmap->rstart,rend = A->rmap->rend,i,j;
+  PetscHashIJKey key;
+  PetscScalar    value;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    if (rows[i] < 0) continue;
+    if (rows[i] >= A->rmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",rows[i],A->rmap->N-1);
+    if (rows[i] >= rstart && rows[i] < rend) {
+      key.i = rows[i];
+      for (j=0; j<n; j++) {
+        if (cols[j] < 0) continue;
+        if (cols[j] >= A->cmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",cols[j],A->cmap->N-1);
+        if (v) value = h->roworiented ? v[i*n+j] : v[i+j*m];
+        else   value = 0.0;
+        if (h->ignorezeroentries && value == 0.0 && addv == ADD_VALUES) continue;
+        key.j = cols[j];
+        if (addv == ADD_VALUES) {ierr = PetscHMapIJVAddValue(h->ht,key,value);CHKERRQ(ierr);}
+        else                    {ierr = PetscHMapIJVSet(h->ht,key,value);CHKERRQ(ierr);}
+      }
+    } else {
+      if (A->nooffprocentries) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Setting off process row %D even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set",rows[i]);
+      if (!h->donotstash) {
+        if (h->roworiented) {
+          ierr = MatStashValuesRow_Private(&A->stash,rows[i],n,cols,v+i*n,(PetscBool)(h->ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        } else {
+          ierr = MatStashValuesCol_Private(&A->stash,rows[i],n,cols,v+i,m,(PetscBool)(h->ignorezeroentries && (addv == ADD_VALUES)));CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetOption_Hash(Mat A,MatOption op,PetscBool flg)
+{
+  Mat_Hash h = A->hash;
+  PetscInt k;
+
+  PetscFunctionBegin;
+  switch (op) {
+  case MAT_ROW_ORIENTED:
+    h->roworiented = flg;
+    break;
+  case MAT_IGNORE_ZERO_ENTRIES:
+    h->ignorezeroentries = flg;
+    break;
+  case MAT_IGNORE_OFF_PROC_ENTRIES:
+    h->donotstash = flg;
+    break;
+  default:
+    break;
+  }
+  for (k=0; k<h->nopt && h->opt[k] != op; k++) ;
+  for (; k<h->nopt-1; k++) {
+    h->opt[k]    = h->opt[k+1];
+    h->optflg[k] = h->optflg[k+1];
+  }
+  if (k == h->nopt) h->nopt++;
+  h->opt[h->nopt-1]    = op;
+  h->optflg[h->nopt-1] = flg;
+  PetscFunctionReturn(0);
+}
+
+/* like MatZeroEntries() of an assembled matrix, the entries keep their locations */
+static PetscErrorCode MatZeroEntries_Hash(Mat A)
+{
+  Mat_Hash      h = A->hash;
+  PetscHashIter hi;
+
+  PetscFunctionBegin;
+  PetscHashIterBegin(h->ht,hi);
+  while (!PetscHashIterAtEnd(h->ht,hi)) {
+    PetscHashIterSetVal(h->ht,hi,0.0);
+    PetscHashIterNext(h->ht,hi);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_Hash(Mat A)
+{
+  Mat_Hash       h = A->hash;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscMemcpy(A->ops,&h->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr    = PetscHMapIJVDestroy(&h->ht);CHKERRQ(ierr);
+  ierr    = PetscFree(A->hash);CHKERRQ(ierr);
+  if (A->ops->destroy) {ierr = (*A->ops->destroy)(A);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyBegin_Hash(Mat A,MatAssemblyType type)
+{
+  Mat_Hash       h = A->hash;
+  PetscErrorCode ierr;
+  PetscInt       nstash,reallocs;
+
+  PetscFunctionBegin;
+  if (!h->mpi || h->donotstash || A->nooffprocentries) PetscFunctionReturn(0);
+  ierr = MatStashScatterBegin_Private(A,&A->stash,A->rmap->range);CHKERRQ(ierr);
+  ierr = MatStashGetInfo_Private(&A->stash,&nstash,&reallocs);CHKERRQ(ierr);
+  ierr = PetscInfo2(A,"Stash has %D entries, uses %D mallocs.\n",nstash,reallocs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Counts the (block) nonzeros of each local (block) row, restores the operations of the matrix type, preallocates
+   the storage exactly and inserts the entries. The hash table is freed before the storage is allocated.
+*/
+static PetscErrorCode MatHashBuild_Private(Mat A)
+{
+  Mat_Hash       h = A->hash;
+  PetscErrorCode ierr;
+  PetscInt       bs = h->aij ? 1 : A->rmap->bs,m = A->rmap->n,rstart = A->rmap->rstart,mbs = m/bs;
+  PetscInt       cstart = A->cmap->rstart/bs,cend = A->cmap->rend/bs,nz,i,k,ib,jb,row;
+  PetscInt       *dnz,*onz,*rowptr,*cols;
+  PetscScalar    *vals,value;
+  PetscHashIter  hi;
+  PetscHashIJKey key,bkey;
+  PetscHSetIJ    blocks = NULL;
+  PetscBool      missing;
+
+  PetscFunctionBegin;
+  ierr = PetscHMapIJVGetSize(h->ht,&nz);CHKERRQ(ierr);
+  ierr = PetscCalloc3(mbs,&dnz,mbs,&onz,m+1,&rowptr);CHKERRQ(ierr);
+  if (bs > 1) {ierr = PetscHSetIJCreate(&blocks);CHKERRQ(ierr);}
+  PetscHashIterBegin(h->ht,hi);
+  while (!PetscHashIterAtEnd(h->ht,hi)) {
+    PetscHashIterGetKey(h->ht,hi,key);
+    PetscHashIterNext(h->ht,hi);
+    rowptr[key.i-rstart+1]++;
+    ib = key.i/bs;
+    jb = key.j/bs;
+    if (h->sbaij && jb < ib) continue;
+    if (blocks) {
+      bkey.i = ib;
+      bkey.j = jb;
+      ierr   = PetscHSetIJQueryAdd(blocks,bkey,&missing);CHKERRQ(ierr);
+      if (!missing) continue;
+    }
+    if (jb >= cstart && jb < cend) dnz[ib-rstart/bs]++;
+    else                           onz[ib-rstart/bs]++;
+  }
+  ierr = PetscHSetIJDestroy(&blocks);CHKERRQ(ierr);
+
+  /* sort the entries by row with a counting sort, then each row by column */
+  for (i=0; i<m; i++) rowptr[i+1] += rowptr[i];
+  ierr = PetscMalloc2(nz,&cols,nz,&vals);CHKERRQ(ierr);
+  PetscHashIterBegin(h->ht,hi);
+  while (!PetscHashIterAtEnd(h->ht,hi)) {
+    PetscHashIterGetKey(h->ht,hi,key);
+    PetscHashIterGetVal(h->ht,hi,value);
+    PetscHashIterNext(h->ht,hi);
+    k       = rowptr[key.i-rstart]++;
+    cols[k] = key.j;
+    vals[k] = value;
+  }
+  for (i=m; i>0; i--) rowptr[i] = rowptr[i-1];
+  rowptr[0] = 0;
+  ierr = PetscHMapIJVDestroy(&h->ht);CHKERRQ(ierr);
+
+  ierr = PetscMemcpy(A->ops,&h->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  A->preallocated = PETSC_FALSE; /* MatSetUp() skipped the setup of the matrix type */
+  if (h->aij) {
+    ierr = MatSeqAIJSetPreallocation(A,0,dnz);CHKERRQ(ierr);
+    ierr = MatMPIAIJSetPreallocation(A,0,dnz,0,onz);CHKERRQ(ierr);
+  } else if (h->sbaij) {
+    ierr = MatSeqSBAIJSetPreallocation(A,bs,0,dnz);CHKERRQ(ierr);
+    ierr = MatMPISBAIJSetPreallocation(A,bs,0,dnz,0,onz);CHKERRQ(ierr);
+  } else {
+    ierr = MatSeqBAIJSetPreallocation(A,bs,0,dnz);CHKERRQ(ierr);
+    ierr = MatMPIBAIJSetPreallocation(A,bs,0,dnz,0,onz);CHKERRQ(ierr);
+  }
+  /* like a matrix set up without preallocation, unless the option was given, new nonzeros are allocated when needed */
+  ierr = (*A->ops->setoption)(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (k=0; k<h->nopt; k++) {
+    ierr = (*A->ops->setoption)(A,h->opt[k],h->optflg[k]);CHKERRQ(ierr);
+  }
+  ierr = PetscInfo2(A,"Preallocated %D (block) rows for %D entries from the hash table\n",mbs,nz);CHKERRQ(ierr);
+
+  for (i=0; i<m; i++) {
+    row  = rstart + i;
+    ierr = PetscSortIntWithScalarArray(rowptr[i+1]-rowptr[i],cols+rowptr[i],vals+rowptr[i]);CHKERRQ(ierr);
+    ierr = (*A->ops->setvalues)(A,1,&row,rowptr[i+1]-rowptr[i],cols+rowptr[i],vals+rowptr[i],INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(cols,vals);CHKERRQ(ierr);
+  ierr = PetscFree3(dnz,onz,rowptr);CHKERRQ(ierr);
+  ierr = PetscFree(A->hash);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_Hash(Mat A,MatAssemblyType type)
+{
+  Mat_Hash       h = A->hash;
+  PetscErrorCode ierr;
+  PetscMPIInt    n;
+  PetscInt       i,j,rstart,ncols,flg;
+  PetscInt       *row,*col;
+  PetscScalar    *val;
+
+  PetscFunctionBegin;
+  if (h->mpi && !h->donotstash && !A->nooffprocentries) {
+    while (1) {
+      ierr = MatStashScatterGetMesg_Private(&A->stash,&n,&row,&col,&val,&flg);CHKERRQ(ierr);
+      if (!flg) break;
+
+      for (i=0; i<n; ) {
+        /* Now identify the consecutive vals belonging to the same row */
+        for (j=i,rstart=row[j]; j<n; j++) {
+          if (row[j] != rstart) break;
+        }
+        if (j < n) ncols = j-i;
+        else       ncols = n-i;
+        /* Now assemble all these values with a single function call */
+        ierr = MatSetValues_Hash(A,1,row+i,ncols,col+i,val+i,A->insertmode);CHKERRQ(ierr);
+        i = j;
+      }
+    }
+    ierr = MatStashScatterEnd_Private(&A->stash);CHKERRQ(ierr);
+  }
+  if (type == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+
+  ierr = MatHashBuild_Private(A);CHKERRQ(ierr);
+  if (A->ops->assemblybegin) {ierr = (*A->ops->assemblybegin)(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);}
+  if (A->ops->assemblyend) {ierr = (*A->ops->assemblyend)(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSetUpHash_Private - Called by MatSetUp() for a matrix without preallocation when hash assembly was requested;
+   for the AIJ, BAIJ and SBAIJ formats it replaces the operations of the matrix until its first final assembly.
+*/
+PetscErrorCode MatSetUpHash_Private(Mat A)
+{
+  PetscErrorCode ierr;
+  Mat_Hash       h;
+  PetscBool      aij,baij,sbaij,mpi;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)A,&aij,MATSEQAIJ,MATMPIAIJ,"");CHKERRQ(ierr);
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)A,&baij,MATSEQBAIJ,MATMPIBAIJ,"");CHKERRQ(ierr);
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)A,&sbaij,MATSEQSBAIJ,MATMPISBAIJ,"");CHKERRQ(ierr);
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)A,&mpi,MATMPIAIJ,MATMPIBAIJ,MATMPISBAIJ,"");CHKERRQ(ierr);
+  if (!aij && !baij && !sbaij) {
+    ierr = PetscInfo1(A,"Hash assembly is not available for matrix type %s\n",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+
+  ierr = PetscNew(&h);CHKERRQ(ierr);
+  ierr = PetscHMapIJVCreate(&h->ht);CHKERRQ(ierr);
+  h->aij         = aij;
+  h->sbaij       = sbaij;
+  h->mpi         = mpi;
+  h->roworiented = PETSC_TRUE;
+  A->hash        = h;
+
+  ierr = PetscMemcpy(&h->ops,A->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  ierr = PetscMemzero(A->ops,sizeof(struct _MatOps));CHKERRQ(ierr);
+  A->ops->setvalues     = MatSetValues_Hash;
+  A->ops->setoption     = MatSetOption_Hash;
+  A->ops->zeroentries   = MatZeroEntries_Hash;
+  A->ops->assemblybegin = MatAssemblyBegin_Hash;
+  A->ops->assemblyend   = MatAssemblyEnd_Hash;
+  A->ops->destroy       = MatDestroy_Hash;
+  A->ops->setblocksizes = h->ops.setblocksizes;
+  ierr = PetscInfo(A,"Entries are kept in a hash table until the first final assembly\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatSetHashAssembly - Assemble a matrix that is set up without preallocation by keeping the entries
+   in a hash table until its first final assembly, which allocates the storage exactly.
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A   - the matrix, of type AIJ, BAIJ or SBAIJ
+-  flg - PETSC_TRUE to use hash assembly
+
+   Options Database Key:
+.  -mat_hash_assembly - use hash assembly, processed by MatSetFromOptions()
+
+   Notes:
+   This must be called before MatSetUp(); it has no effect on matrices preallocated with, for example,
+   MatXAIJSetPreallocation(). Without preallocation, MatSetValues() repeatedly reallocates the storage
+   of AIJ, BAIJ and SBAIJ matrices and parallel matrices rebuild their off-diagonal part when new
+   columns appear. With hash assembly MatSetValues() and MatSetValuesBlocked() accumulate the locally
+   owned entries in one hash table keyed by row and column and MatAssemblyEnd() counts the nonzeros
+   of each row, preallocates exactly, and inserts the entries of each row sorted by column. Entries
+   of rows owned by other processes go through the usual stash.
+
+   The memory used is the hash table, about twice the size of the values and column indices of the
+   entries, which is freed before the matrix storage is allocated.
+
+   Until the first final assembly the matrix only supports setting values, MatZeroEntries(),
+   MatSetOption() and assembly. MatZeroEntries() zeros the values but keeps the entries set so far. Options set before the assembly are applied to the storage once
+   it is allocated. Later assemblies use the storage of the matrix type as usual, new nonzeros
+   are allocated when needed unless MAT_NEW_NONZERO_ALLOCATION_ERR is set.
+
+   Level: intermediate
+
+.seealso: MatSetUp(), MatSetValues(), MatXAIJSetPreallocation(), MATPREALLOCATOR, MatSetPreallocationCOO()
+@*/
+PetscErrorCode MatSetHashAssembly(Mat A,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidLogicalCollectiveBool(A,flg,2);
+  if (A->preallocated) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"Call MatSetHashAssembly() before MatSetUp()");
+  A->hashassembly = flg;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,57 @@
+#include <petsc/private/matimpl.h>       /*I "petscmat.h"  I*/
+#include <petscviewer.h>
+
+#if defined(PETSC_HAVE_MPIIO)
+/*
+   MatLoadBinaryReadRows_MPIIO - Reads the rows [rstart,rstart+m) of a matrix stored in PETSc binary format with
+   collective MPI-IO; every process reads only its own part of the row lengths, column indices and values.
+
+   Input Parameters:
++  viewer - binary viewer using MPI-IO, positioned just after the matrix header
+.  M      - global number of rows stored in the file
+.  nz     - global number of nonzeros stored in the file
+.  rstart - first row read by this process
+-  m      - number of rows read by this process
+
+   Output Parameters:
++  rowlens - the length of each row read, provided by the caller
+.  cols    - the column indices of the rows read, free with PetscFree()
+-  vals    - the values of the rows read, free with PetscFree()
+
+   Notes:
+   The MPI-IO offset of the viewer is advanced past the whole matrix.
+*/
+PetscErrorCode MatLoadBinaryReadRows_MPIIO(PetscViewer viewer,PetscInt M,PetscInt nz,PetscInt rstart,PetscInt m,PetscInt rowlens[],PetscInt **cols,PetscScalar **vals)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  MPI_File       mfdes;
+  MPI_Offset     off;
+  PetscMPIInt    cnt;
+  PetscInt       i,lnz = 0,nzend,nzfile;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetMPIIODescriptor(viewer,&mfdes);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetMPIIOOffset(viewer,&off);CHKERRQ(ierr);
+
+  ierr = PetscMPIIntCast(m,&cnt);CHKERRQ(ierr);
+  ierr = MPIU_File_read_at_all(mfdes,off+(MPI_Offset)rstart*sizeof(PetscInt),rowlens,cnt,MPIU_INT,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  for (i=0; i<m; i++) lnz += rowlens[i];
+  ierr = MPI_Scan(&lnz,&nzend,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  /* every process checks the total, so that none of them is left waiting in the collective reads below */
+  nzfile = (rstart + m == M) ? nzend : 0;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&nzfile,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  if (nzfile != nz) SETERRQ2(comm,PETSC_ERR_FILE_UNEXPECTED,"Row lengths in file add up to %D nonzeros, header says %D",nzfile,nz);
+  off += (MPI_Offset)M*sizeof(PetscInt);
+
+  ierr = PetscMalloc1(lnz,cols);CHKERRQ(ierr);
+  ierr = PetscMalloc1(lnz,vals);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(lnz,&cnt);CHKERRQ(ierr);
+  ierr = MPIU_File_read_at_all(mfdes,off+(MPI_Offset)(nzend-lnz)*sizeof(PetscInt),*cols,cnt,MPIU_INT,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  off += (MPI_Offset)nz*sizeof(PetscInt);
+  ierr = MPIU_File_read_at_all(mfdes,off+(MPI_Offset)(nzend-lnz)*sizeof(PetscScalar),*vals,cnt,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryAddMPIIOOffset(viewer,(MPI_Offset)(M+nz)*sizeof(PetscInt)+(MPI_Offset)nz*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
@@ -579,6 +579,8 @@ static PetscErrorCode MatStashScatterBegin_Ref(Mat mat,MatStash *stash,PetscInt
     if (sizes[i]) {
       ierr = MPI_Isend(sindices+2*startv[i],2*nlengths[i],MPIU_INT,i,tag1,comm,send_waits+count++);CHKERRQ(ierr);
       ierr = MPI_Isend(svalues+bs2*startv[i],bs2*nlengths[i],MPIU_SCALAR,i,tag2,comm,send_waits+count++);CHKERRQ(ierr);
+      ierr = PetscLogCommSend(comm,i,2*nlengths[i],MPIU_INT);CHKERRQ(ierr);
+      ierr = PetscLogCommSend(comm,i,bs2*nlengths[i],MPIU_SCALAR);CHKERRQ(ierr);
     }
   }
 #if defined(PETSC_USE_INFO)
@@ -804,6 +806,7 @@ static PetscErrorCode MatStashBTSSend_Private(MPI_Comm comm,const PetscMPIInt ta
   PetscFunctionBegin;
   if (rank != stash->sendranks[rankid]) SETERRQ3(comm,PETSC_ERR_PLIB,"BTS Send rank %d does not match sendranks[%d] %d",rank,rankid,stash->sendranks[rankid]);
   ierr = MPI_Isend(stash->sendframes[rankid].buffer,hdr->count,stash->blocktype,rank,tag[0],comm,&req[0]);CHKERRQ(ierr);
+  ierr = PetscLogCommSend(comm,rank,hdr->count,stash->blocktype);CHKERRQ(ierr);
   stash->sendframes[rankid].count = hdr->count;
   stash->sendframes[rankid].pending = 1;
   PetscFunctionReturn(0);
@@ -0,0 +1,160 @@
+static char help[] = "Tests the Jacobian computed by coloring with a batched local residual, DMSNESSetFunctionBatchLocal(),\n\
+against the one computed with the residual of DMSNESSetFunctionLocal().\n\
+  -lambda <lambda> : the parameter of the Bratu problem\n\n";
+
+#include <petscsnes.h>
+#include <petscdm.h>
+#include <petscdmda.h>
+
+typedef struct {
+  PetscReal lambda;
+  PetscInt  nbatch;  /* number of calls of the batched residual */
+} AppCtx;
+
+/* the Bratu residual at the points of one vector, x and f are the arrays of the local vectors */
+static void FormFunctionPoint(DMDALocalInfo *info,PetscReal lambda,PetscInt i,PetscInt j,PetscScalar **x,PetscScalar **f)
+{
+  PetscReal   hx = 1.0/(PetscReal)(info->mx-1),hy = 1.0/(PetscReal)(info->my-1),hxdhy = hx/hy,hydhx = hy/hx,sc = hx*hy*lambda;
+  PetscScalar u,uxx,uyy;
+
+  if (i == 0 || j == 0 || i == info->mx-1 || j == info->my-1) {
+    f[j][i] = 2.0*(hydhx+hxdhy)*x[j][i];
+  } else {
+    u       = x[j][i];
+    uxx     = (2.0*u - x[j][i-1] - x[j][i+1])*hydhx;
+    uyy     = (2.0*u - x[j-1][i] - x[j+1][i])*hxdhy;
+    f[j][i] = uxx + uyy - sc*PetscExpScalar(u);
+  }
+}
+
+static PetscErrorCode FormFunctionLocal(DM da,Vec xloc,Vec floc,void *ptr)
+{
+  AppCtx         *user = (AppCtx*)ptr;
+  DMDALocalInfo  info;
+  PetscScalar    **x,**f;
+  PetscInt       i,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  ierr = DMDAVecGetArrayRead(da,xloc,&x);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(da,floc,&f);CHKERRQ(ierr);
+  for (j=info.ys; j<info.ys+info.ym; j++) {
+    for (i=info.xs; i<info.xs+info.xm; i++) FormFunctionPoint(&info,user->lambda,i,j,x,f);
+  }
+  ierr = DMDAVecRestoreArray(da,floc,&f);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArrayRead(da,xloc,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* evaluates the residual of all the vectors in a single traversal of the grid */
+static PetscErrorCode FormFunctionBatchLocal(DM da,PetscInt n,Vec xloc[],Vec floc[],void *ptr)
+{
+  AppCtx         *user = (AppCtx*)ptr;
+  DMDALocalInfo  info;
+  PetscScalar    ***x,***f;
+  PetscInt       i,j,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  user->nbatch++;
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n,&x,n,&f);CHKERRQ(ierr);
+  for (k=0; k<n; k++) {
+    ierr = DMDAVecGetArrayRead(da,xloc[k],&x[k]);CHKERRQ(ierr);
+    ierr = DMDAVecGetArray(da,floc[k],&f[k]);CHKERRQ(ierr);
+  }
+  for (j=info.ys; j<info.ys+info.ym; j++) {
+    for (i=info.xs; i<info.xs+info.xm; i++) {
+      for (k=0; k<n; k++) FormFunctionPoint(&info,user->lambda,i,j,x[k],f[k]);
+    }
+  }
+  for (k=0; k<n; k++) {
+    ierr = DMDAVecRestoreArray(da,floc[k],&f[k]);CHKERRQ(ierr);
+    ierr = DMDAVecRestoreArrayRead(da,xloc[k],&x[k]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(x,f);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the colored Jacobian at x of the problem on the grid da, with or without the batched residual */
+static PetscErrorCode ComputeJacobian(DM da,AppCtx *user,PetscBool batch,Vec x,Mat *J)
+{
+  SNES           snes;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = SNESCreate(PetscObjectComm((PetscObject)da),&snes);CHKERRQ(ierr);
+  ierr = SNESSetDM(snes,da);CHKERRQ(ierr);
+  ierr = DMSNESSetFunctionLocal(da,FormFunctionLocal,user);CHKERRQ(ierr);
+  if (batch) {ierr = DMSNESSetFunctionBatchLocal(da,FormFunctionBatchLocal,user);CHKERRQ(ierr);}
+  ierr = SNESSetFromOptions(snes);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,J);CHKERRQ(ierr);
+  ierr = SNESComputeJacobian(snes,x,*J,*J);CHKERRQ(ierr);
+  ierr = SNESDestroy(&snes);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM             da,dab;
+  Vec            x;
+  Mat            J,Jb;
+  AppCtx         user;
+  PetscRandom    rand;
+  PetscReal      norm,err;
+  PetscInt       bcols = 1;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  user.lambda = 6.0;
+  user.nbatch = 0;
+  ierr = PetscOptionsGetReal(NULL,NULL,"-lambda",&user.lambda,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mat_fd_coloring_bcols",&bcols,NULL);CHKERRQ(ierr);
+
+  /* the colorings are cached on the DM, so each Jacobian is computed on its own grid */
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,8,7,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,8,7,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&dab);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dab);CHKERRQ(ierr);
+  ierr = DMSetUp(dab);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&x);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+
+  ierr = ComputeJacobian(da,&user,PETSC_FALSE,x,&J);CHKERRQ(ierr);
+  ierr = ComputeJacobian(dab,&user,PETSC_TRUE,x,&Jb);CHKERRQ(ierr);
+  if (bcols > 1 && !user.nbatch) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"The batched residual was not used\n");CHKERRQ(ierr);
+  } else if (bcols == 1 && user.nbatch) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"The batched residual was used for single vectors\n");CHKERRQ(ierr);
+  }
+
+  ierr = MatNorm(J,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  ierr = MatAXPY(Jb,-1.0,J,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(Jb,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*norm) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"The Jacobian with the batched residual differs by %g\n",(double)(err/norm));CHKERRQ(ierr);
+  }
+
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = MatDestroy(&J);CHKERRQ(ierr);
+  ierr = MatDestroy(&Jb);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = DMDestroy(&dab);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     nsize: 2
+     output_file: output/ex70_1.out
+     args: -mat_fd_coloring_bcols {{1 2 4}}
+
+TEST*/
@@ -11,6 +11,54 @@ static PetscErrorCode SNESComputeFunctionCtx(SNES snes,Vec x,Vec f,void *ctx)
   return SNESComputeFunction(snes,x,f);
 }
 
+/*
+   The batched counterpart of SNESComputeFunction() given to MatFDColoringSetFunctionBatch(), it calls the
+   function set with DMSNESSetFunctionBatch(). Like SNESComputeFunction() it evaluates the residual of the DM
+   only: a nonlinear preconditioner is never applied here (that is done by SNESComputeFunctionDefaultNPC() in
+   the line search and in SNESMF), so the colored Jacobian is the same with and without the batched function.
+*/
+static PetscErrorCode SNESComputeFunctionBatchCtx(SNES snes,PetscInt n,Vec x[],Vec f[],void *ctx)
+{
+  PetscErrorCode ierr;
+  DM             dm;
+  DMSNES         sdm;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
+  ierr = DMGetDMSNES(dm,&sdm);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(SNES_FunctionEval,snes,x[0],f[0],0);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {ierr = VecLockReadPush(x[i]);CHKERRQ(ierr);}
+  PetscStackPush("SNES user batched function");
+  snes->domainerror = PETSC_FALSE;
+  ierr = (*sdm->ops->computefunctionbatch)(snes,n,x,f,sdm->functionbatchctx);CHKERRQ(ierr);
+  PetscStackPop;
+  for (i=0; i<n; i++) {ierr = VecLockReadPop(x[i]);CHKERRQ(ierr);}
+  ierr = PetscLogEventEnd(SNES_FunctionEval,snes,x[0],f[0],0);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (snes->vec_rhs) {ierr = VecAXPY(f[i],-1.0,snes->vec_rhs);CHKERRQ(ierr);}
+    if (snes->domainerror) {ierr = VecSetInf(f[i]);CHKERRQ(ierr);}
+  }
+  snes->nfuncs += n;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Gives the MatFDColoring created by SNES the batched residual of the DM, if it has one
+*/
+PetscErrorCode SNESMatFDColoringSetFunctionBatch_Private(DM dm,MatFDColoring color)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+
+  PetscFunctionBegin;
+  ierr = DMGetDMSNES(dm,&sdm);CHKERRQ(ierr);
+  if (sdm->ops->computefunctionbatch) {
+    ierr = MatFDColoringSetFunctionBatch(color,(PetscErrorCode (*)(void))SNESComputeFunctionBatchCtx,NULL);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*@C
     SNESComputeJacobianDefaultColor - Computes the Jacobian using
     finite differences and coloring to exploit matrix sparsity.
@@ -43,12 +91,15 @@ static PetscErrorCode SNESComputeFunctionCtx(SNES snes,Vec x,Vec f,void *ctx)
         get the coloring from the matrix.  This requires that the matrix have nonzero entries
         precomputed.
 
+        If the DM has a batched residual, see DMSNESSetFunctionBatch(), it evaluates the perturbed states of
+        several colors at once.
+
        SNES supports three approaches for computing (approximate) Jacobians: user provided via SNESSetJacobian(), matrix free via SNESSetUseMatrixFree,
        and computing explictly with finite differences and coloring using MatFDColoring. It is also possible to use automatic differentiation and the MatFDColoring object.
 
 
 .seealso: SNESSetJacobian(), SNESTestJacobian(), SNESComputeJacobianDefault(), SNESSetUseMatrixFree(),
-          MatFDColoringCreate(), MatFDColoringSetFunction()
+          MatFDColoringCreate(), MatFDColoringSetFunction(), DMSNESSetFunctionBatch()
 
 @*/
 
@@ -75,6 +126,7 @@ PetscErrorCode  SNESComputeJacobianDefaultColor(SNES snes,Vec x1,Mat J,Mat B,voi
       ierr = DMCreateColoring(dm,IS_COLORING_GLOBAL,&iscoloring);CHKERRQ(ierr);
       ierr = MatFDColoringCreate(B,iscoloring,&color);CHKERRQ(ierr);
       ierr = MatFDColoringSetFunction(color,(PetscErrorCode (*)(void))SNESComputeFunctionCtx,NULL);CHKERRQ(ierr);
+      ierr = SNESMatFDColoringSetFunctionBatch_Private(dm,color);CHKERRQ(ierr);
       ierr = MatFDColoringSetFromOptions(color);CHKERRQ(ierr);
       ierr = MatFDColoringSetUp(B,iscoloring,color);CHKERRQ(ierr);
       ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
@@ -87,6 +139,7 @@ PetscErrorCode  SNESComputeJacobianDefaultColor(SNES snes,Vec x1,Mat J,Mat B,voi
       ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
       ierr = MatFDColoringCreate(B,iscoloring,&color);CHKERRQ(ierr);
       ierr = MatFDColoringSetFunction(color,(PetscErrorCode (*)(void))SNESComputeFunctionCtx,NULL);CHKERRQ(ierr);
+      ierr = SNESMatFDColoringSetFunctionBatch_Private(dm,color);CHKERRQ(ierr);
       ierr = MatFDColoringSetFromOptions(color);CHKERRQ(ierr);
       ierr = MatFDColoringSetUp(B,iscoloring,color);CHKERRQ(ierr);
       ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
@@ -3,9 +3,11 @@
 
 typedef struct {
   PetscErrorCode (*residuallocal)(DM,Vec,Vec,void*);
+  PetscErrorCode (*residualbatchlocal)(DM,PetscInt,Vec[],Vec[],void*);
   PetscErrorCode (*jacobianlocal)(DM,Vec,Mat,Mat,void*);
   PetscErrorCode (*boundarylocal)(DM,Vec,void*);
   void *residuallocalctx;
+  void *residualbatchlocalctx;
   void *jacobianlocalctx;
   void *boundarylocalctx;
 } DMSNES_Local;
@@ -101,6 +103,47 @@ static PetscErrorCode SNESComputeFunction_DMLocal(SNES snes,Vec X,Vec F,void *ct
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode SNESComputeFunctionBatch_DMLocal(SNES snes,PetscInt n,Vec X[],Vec F[],void *ctx)
+{
+  DMSNES_Local   *dmlocalsnes = (DMSNES_Local *) ctx;
+  DM             dm;
+  Vec            *Xloc,*Floc;
+  PetscBool      transform;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(snes,SNES_CLASSID,1);
+  ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
+  ierr = DMHasBasisTransform(dm, &transform);CHKERRQ(ierr);
+  ierr = PetscMalloc2(n,&Xloc,n,&Floc);CHKERRQ(ierr);
+  /* the ghost updates are done one vector at a time, only the evaluation of the residual is batched */
+  for (i=0; i<n; i++) {
+    ierr = DMGetLocalVector(dm,&Xloc[i]);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&Floc[i]);CHKERRQ(ierr);
+    ierr = VecZeroEntries(Xloc[i]);CHKERRQ(ierr);
+    ierr = VecZeroEntries(Floc[i]);CHKERRQ(ierr);
+    /* Non-conforming routines needs boundary values before G2L */
+    if (dmlocalsnes->boundarylocal) {ierr = (*dmlocalsnes->boundarylocal)(dm,Xloc[i],dmlocalsnes->boundarylocalctx);CHKERRQ(ierr);}
+    ierr = DMGlobalToLocalBegin(dm,X[i],INSERT_VALUES,Xloc[i]);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm,X[i],INSERT_VALUES,Xloc[i]);CHKERRQ(ierr);
+    /* Need to reset boundary values if we transformed */
+    if (transform && dmlocalsnes->boundarylocal) {ierr = (*dmlocalsnes->boundarylocal)(dm,Xloc[i],dmlocalsnes->boundarylocalctx);CHKERRQ(ierr);}
+  }
+  CHKMEMQ;
+  ierr = (*dmlocalsnes->residualbatchlocal)(dm,n,Xloc,Floc,dmlocalsnes->residualbatchlocalctx);CHKERRQ(ierr);
+  CHKMEMQ;
+  for (i=0; i<n; i++) {
+    ierr = VecZeroEntries(F[i]);CHKERRQ(ierr);
+    ierr = DMLocalToGlobalBegin(dm,Floc[i],ADD_VALUES,F[i]);CHKERRQ(ierr);
+    ierr = DMLocalToGlobalEnd(dm,Floc[i],ADD_VALUES,F[i]);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Floc[i]);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&Xloc[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(Xloc,Floc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode SNESComputeJacobian_DMLocal(SNES snes,Vec X,Mat A,Mat B,void *ctx)
 {
   DMSNES_Local  *dmlocalsnes = (DMSNES_Local *) ctx;
@@ -137,6 +180,7 @@ static PetscErrorCode SNESComputeJacobian_DMLocal(SNES snes,Vec X,Mat A,Mat B,vo
       switch (dm->coloringtype) {
       case IS_COLORING_GLOBAL:
         ierr = MatFDColoringSetFunction(fdcoloring,(PetscErrorCode (*)(void))SNESComputeFunction_DMLocal,dmlocalsnes);CHKERRQ(ierr);
+        ierr = SNESMatFDColoringSetFunctionBatch_Private(dm,fdcoloring);CHKERRQ(ierr);
         break;
       default: SETERRQ1(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"No support for coloring type '%s'",ISColoringTypes[dm->coloringtype]);
       }
@@ -201,6 +245,52 @@ PetscErrorCode DMSNESSetFunctionLocal(DM dm,PetscErrorCode (*func)(DM,Vec,Vec,vo
   PetscFunctionReturn(0);
 }
 
+/*@C
+   DMSNESSetFunctionBatchLocal - set a local residual evaluation function that is called with several local vectors at
+      once, each containing the local vector information PLUS ghost point information. It should compute a result for
+      all local elements of each vector and DMSNES will automatically accumulate the overlapping values.
+
+   Logically Collective
+
+   Input Arguments:
++  dm - DM to associate callback with
+.  func - batched local residual evaluation
+-  ctx - optional context for batched local residual evaluation
+
+   Calling sequence of func:
+$  PetscErrorCode func(DM dm,PetscInt n,Vec xloc[],Vec floc[],void *ctx)
+
+   Level: advanced
+
+   Notes:
+   The batched function is only used to compute Jacobians by finite differences with coloring, where it is given the
+   perturbed states of several colors at once so they can all be evaluated in a single traversal of the mesh; see
+   MatFDColoringSetFunctionBatch(). The residual set with DMSNESSetFunctionLocal() is still used for everything else,
+   including the evaluations of a single vector.
+
+   Only the callback is batched, the ghost updates are not: each vector of the batch is still scattered to its local
+   vector and its residual accumulated back to the global vector separately, so the number of messages is unchanged.
+
+.seealso: DMSNESSetFunctionLocal(), DMSNESSetFunctionBatch(), MatFDColoringSetFunctionBatch(), MatFDColoringSetBlockSize()
+@*/
+PetscErrorCode DMSNESSetFunctionBatchLocal(DM dm,PetscErrorCode (*func)(DM,PetscInt,Vec[],Vec[],void*),void *ctx)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+  DMSNES_Local   *dmlocalsnes;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  ierr = DMGetDMSNESWrite(dm,&sdm);CHKERRQ(ierr);
+  ierr = DMLocalSNESGetContext(dm,sdm,&dmlocalsnes);CHKERRQ(ierr);
+
+  dmlocalsnes->residualbatchlocal    = func;
+  dmlocalsnes->residualbatchlocalctx = ctx;
+
+  ierr = DMSNESSetFunctionBatch(dm,func ? SNESComputeFunctionBatch_DMLocal : NULL,dmlocalsnes);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMSNESSetBoundaryLocal - set a local boundary value function. This function is called with local vector
       containing the local vector information PLUS ghost point information. It should insert values into the local
@@ -297,6 +387,37 @@ PetscErrorCode DMSNESGetFunctionLocal(DM dm,PetscErrorCode (**func)(DM,Vec,Vec,v
   PetscFunctionReturn(0);
 }
 
+/*@C
+   DMSNESGetFunctionBatchLocal - get the batched local residual evaluation function set with DMSNESSetFunctionBatchLocal.
+
+   Not Collective
+
+   Input Arguments:
++  dm - DM with the associated callback
+
+   Output Arguments:
++  func - batched local residual evaluation
+-  ctx - context for batched local residual evaluation
+
+   Level: advanced
+
+.seealso: DMSNESSetFunctionBatchLocal(), DMSNESGetFunctionLocal()
+@*/
+PetscErrorCode DMSNESGetFunctionBatchLocal(DM dm,PetscErrorCode (**func)(DM,PetscInt,Vec[],Vec[],void*),void **ctx)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+  DMSNES_Local   *dmlocalsnes;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  ierr = DMGetDMSNES(dm,&sdm);CHKERRQ(ierr);
+  ierr = DMLocalSNESGetContext(dm,sdm,&dmlocalsnes);CHKERRQ(ierr);
+  if (func) *func = dmlocalsnes->residualbatchlocal;
+  if (ctx)  *ctx  = dmlocalsnes->residualbatchlocalctx;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMSNESGetBoundaryLocal - get the local boundary value function set with DMSNESSetBoundaryLocal.
 
@@ -148,21 +148,23 @@ PetscErrorCode DMSNESCopy(DMSNES kdm,DMSNES nkdm)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(kdm,DMSNES_CLASSID,1);
   PetscValidHeaderSpecific(nkdm,DMSNES_CLASSID,2);
-  nkdm->ops->computefunction  = kdm->ops->computefunction;
-  nkdm->ops->computejacobian  = kdm->ops->computejacobian;
-  nkdm->ops->computegs        = kdm->ops->computegs;
-  nkdm->ops->computeobjective = kdm->ops->computeobjective;
-  nkdm->ops->computepjacobian = kdm->ops->computepjacobian;
-  nkdm->ops->computepfunction = kdm->ops->computepfunction;
-  nkdm->ops->destroy          = kdm->ops->destroy;
-  nkdm->ops->duplicate        = kdm->ops->duplicate;
-
-  nkdm->functionctx  = kdm->functionctx;
-  nkdm->gsctx        = kdm->gsctx;
-  nkdm->pctx         = kdm->pctx;
-  nkdm->jacobianctx  = kdm->jacobianctx;
-  nkdm->objectivectx = kdm->objectivectx;
-  nkdm->originaldm   = kdm->originaldm;
+  nkdm->ops->computefunction      = kdm->ops->computefunction;
+  nkdm->ops->computefunctionbatch = kdm->ops->computefunctionbatch;
+  nkdm->ops->computejacobian      = kdm->ops->computejacobian;
+  nkdm->ops->computegs            = kdm->ops->computegs;
+  nkdm->ops->computeobjective     = kdm->ops->computeobjective;
+  nkdm->ops->computepjacobian     = kdm->ops->computepjacobian;
+  nkdm->ops->computepfunction     = kdm->ops->computepfunction;
+  nkdm->ops->destroy              = kdm->ops->destroy;
+  nkdm->ops->duplicate            = kdm->ops->duplicate;
+
+  nkdm->functionctx      = kdm->functionctx;
+  nkdm->functionbatchctx = kdm->functionbatchctx;
+  nkdm->gsctx            = kdm->gsctx;
+  nkdm->pctx             = kdm->pctx;
+  nkdm->jacobianctx      = kdm->jacobianctx;
+  nkdm->objectivectx     = kdm->objectivectx;
+  nkdm->originaldm       = kdm->originaldm;
 
   /*
   nkdm->fortran_func_pointers[0] = kdm->fortran_func_pointers[0];
@@ -348,6 +350,76 @@ PetscErrorCode DMSNESGetFunction(DM dm,PetscErrorCode (**f)(SNES,Vec,Vec,void*),
   PetscFunctionReturn(0);
 }
 
+/*@C
+   DMSNESSetFunctionBatch - set a SNES residual evaluation function that evaluates the residual at several vectors at once
+
+   Not Collective
+
+   Input Arguments:
++  dm - DM to be used with SNES
+.  f - batched residual evaluation function
+-  ctx - context for the batched residual evaluation
+
+   Calling sequence of f:
+$  PetscErrorCode f(SNES snes,PetscInt n,Vec x[],Vec f[],void *ctx)
+
++  snes - the SNES context
+.  n - the number of vectors
+.  x - the states at which to evaluate the residual
+.  f - the residuals, computed for each state
+-  ctx - the optional user-defined context
+
+   Level: advanced
+
+   Note:
+   The batched function is only used to compute Jacobians by finite differences with coloring, such as with
+   SNESComputeJacobianDefaultColor(), where it is given the perturbed states of several colors at once; see
+   MatFDColoringSetFunctionBatch(). The residual set with DMSNESSetFunction() or SNESSetFunction() is still required.
+
+.seealso: DMSNESSetFunction(), DMSNESSetFunctionBatchLocal(), MatFDColoringSetFunctionBatch(), SNESComputeJacobianDefaultColor()
+@*/
+PetscErrorCode DMSNESSetFunctionBatch(DM dm,PetscErrorCode (*f)(SNES,PetscInt,Vec[],Vec[],void*),void *ctx)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  ierr = DMGetDMSNESWrite(dm,&sdm);CHKERRQ(ierr);
+  sdm->ops->computefunctionbatch = f;
+  sdm->functionbatchctx          = ctx;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMSNESGetFunctionBatch - get the batched SNES residual evaluation function
+
+   Not Collective
+
+   Input Argument:
+.  dm - DM to be used with SNES
+
+   Output Arguments:
++  f - batched residual evaluation function; see DMSNESSetFunctionBatch() for details
+-  ctx - context for the batched residual evaluation
+
+   Level: advanced
+
+.seealso: DMSNESSetFunctionBatch(), DMSNESGetFunction()
+@*/
+PetscErrorCode DMSNESGetFunctionBatch(DM dm,PetscErrorCode (**f)(SNES,PetscInt,Vec[],Vec[],void*),void **ctx)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  ierr = DMGetDMSNES(dm,&sdm);CHKERRQ(ierr);
+  if (f) *f = sdm->ops->computefunctionbatch;
+  if (ctx) *ctx = sdm->functionbatchctx;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMSNESSetObjective - set SNES objective evaluation function
 
@@ -39,6 +39,7 @@ const char *const PetscViewerFormats[] = {
   "HDF5_MAT",
   "NOFORMAT",
   "LOAD_BALANCE",
+  "ASCII_FLAMEGRAPH",
   "PetscViewerFormat",
   "PETSC_VIEWER_",
   NULL
@@ -133,7 +134,8 @@ PetscErrorCode  PetscViewerSetFormat(PetscViewer viewer,PetscViewerFormat format
 .    PETSC_VIEWER_DRAW_BASIC - views the vector with a simple 1d plot
 .    PETSC_VIEWER_DRAW_LG - views the vector with a line graph
 .    PETSC_VIEWER_DRAW_CONTOUR - views the vector with a contour plot
--    PETSC_VIEWER_ASCII_XML - saves the data in XML format, needed for PetscLogView() when viewing with PetscLogNestedBegin()
+.    PETSC_VIEWER_ASCII_XML - saves the data in XML format, needed for PetscLogView() when viewing with PetscLogNestedBegin()
+-    PETSC_VIEWER_ASCII_FLAMEGRAPH - saves the nested logging data as folded stacks for flame graphs, for PetscLogView() when viewing with PetscLogNestedBegin()
 
    These formats are most often used for viewing matrices and vectors.
    Currently, the object name is used only in the MATLAB format.
@@ -0,0 +1,90 @@
+static char help[] = "Tests PetscLogTimelineBegin() and PetscLogTimelineDump().\n\n";
+
+#include <petscsys.h>
+
+/* counts the occurrences of a string in the file */
+static PetscErrorCode CountInFile(const char fname[],const char str[],PetscInt *count)
+{
+  PetscErrorCode ierr;
+  FILE           *fd;
+  char           *buf,*p;
+  long           len;
+  size_t         slen;
+
+  PetscFunctionBegin;
+  fd = fopen(fname,"r");
+  if (!fd) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Cannot open file %s",fname);
+  fseek(fd,0,SEEK_END);
+  len = ftell(fd);
+  fseek(fd,0,SEEK_SET);
+  ierr = PetscMalloc1(len+1,&buf);CHKERRQ(ierr);
+  if (fread(buf,1,len,fd) != (size_t)len) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Cannot read file %s",fname);
+  buf[len] = 0;
+  fclose(fd);
+  ierr   = PetscStrlen(str,&slen);CHKERRQ(ierr);
+  *count = 0;
+  for (p=buf; (p=strstr(p,str)); p+=slen) (*count)++;
+  ierr = PetscFree(buf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscLogStage  stage;
+  PetscLogEvent  outer,inner;
+  PetscMPIInt    rank;
+  PetscInt       i,size = PETSC_DEFAULT,count;
+  const char     *fname = "ex54.json";
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-size",&size,NULL);CHKERRQ(ierr);
+  ierr = PetscLogStageRegister("Timeline Stage",&stage);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Timeline Outer",PETSC_OBJECT_CLASSID,&outer);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Timeline Inner",PETSC_OBJECT_CLASSID,&inner);CHKERRQ(ierr);
+
+  ierr = PetscLogTimelineBegin(size);CHKERRQ(ierr);
+  ierr = PetscLogStagePush(stage);CHKERRQ(ierr);
+  for (i=0; i<5; i++) {
+    ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogFlops(10.0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+  }
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+  ierr = PetscLogTimelineDump(fname);CHKERRQ(ierr);
+
+  if (!rank) {
+    ierr = CountInFile(fname,"\"name\":\"Timeline Outer\"",&count);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Outer events %D\n",count);CHKERRQ(ierr);
+    ierr = CountInFile(fname,"\"name\":\"Timeline Inner\"",&count);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Inner events %D\n",count);CHKERRQ(ierr);
+    ierr = CountInFile(fname,"\"flops\":10,",&count);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Events with 10 flops %D\n",count);CHKERRQ(ierr);
+    ierr = CountInFile(fname,"\"name\":\"Timeline Stage\"",&count);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Stages %D\n",count);CHKERRQ(ierr);
+    ierr = CountInFile(fname,"\"name\":\"process_name\"",&count);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Tracks %D\n",count);CHKERRQ(ierr);
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     nsize: 2
+
+   test:
+     suffix: 2
+     nsize: 2
+     args: -size 7
+     output_file: output/ex54_2.out
+
+   test:
+     suffix: 3
+     args: -log_view ascii:log.txt
+
+TEST*/
@@ -0,0 +1,59 @@
+static char help[] = "Tests reading performance counters for events with PetscLogSetHWCounters().\n\n";
+
+#include <petscsys.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode     ierr;
+  PetscLogEvent      event;
+  PetscEventPerfInfo info;
+  PetscInt           i,n,npages = 256;
+  size_t             pagesize = 4096;
+  const char *const  *names;
+  char               *buf;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscLogEventRegister("Touch Pages",PETSC_OBJECT_CLASSID,&event);CHKERRQ(ierr);
+  ierr = PetscLogGetHWCounters(&n,&names);CHKERRQ(ierr);
+  if (!n) {
+    const char *const defaults[] = {"page-faults","task-clock"};
+
+    ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
+    ierr = PetscLogSetHWCounters(2,defaults);CHKERRQ(ierr);
+    ierr = PetscLogGetHWCounters(&n,&names);CHKERRQ(ierr);
+  }
+
+  /* every page touched the first time is a page fault */
+  ierr = PetscLogEventBegin(event,0,0,0,0);CHKERRQ(ierr);
+  buf  = (char*)malloc(npages*pagesize);
+  for (i=0; i<npages; i++) buf[i*pagesize] = 1;
+  ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
+  free(buf);
+
+  ierr = PetscLogEventGetPerfInfo(PETSC_DETERMINE,event,&info);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscPrintf(PETSC_COMM_SELF,"%s %s\n",names[i],info.hwCounters[i] > 0.0 ? "counted" : "not counted");CHKERRQ(ierr);
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+     requires: define(PETSC_USE_LOG) define(PETSC_HAVE_LINUX_PERF_EVENT_H)
+
+   test:
+
+   test:
+     suffix: 2
+     args: -log_view ascii:log.txt -log_view_hwcounters page-faults,task-clock
+     output_file: output/ex55_2.out
+
+   test:
+     suffix: 3
+     nsize: 2
+     args: -log_view ascii:log.csv:ascii_csv -log_view_hwcounters task-clock
+     output_file: output/ex55_3.out
+
+TEST*/
@@ -0,0 +1,62 @@
+static char help[] = "Tests the pooled allocator and scoped arenas.\n\n";
+
+#include <petscsys.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,n = 1000,*a[100],*big;
+  PetscScalar    *x;
+  PetscReal      *y;
+  PetscBool      misaligned = PETSC_FALSE,wrong = PETSC_FALSE;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+
+  /* blocks of all the size classes, recycled through the free lists */
+  for (j=0; j<3; j++) {
+    for (i=0; i<100; i++) {
+      ierr = PetscMalloc1(i+1,&a[i]);CHKERRQ(ierr);
+      if ((size_t)a[i] % PETSC_MEMALIGN) misaligned = PETSC_TRUE;
+      a[i][i] = i;
+    }
+    for (i=0; i<100; i+=2) {ierr = PetscFree(a[i]);CHKERRQ(ierr);}
+    for (i=1; i<100; i+=2) {
+      ierr = PetscRealloc((i+1+n)*sizeof(PetscInt),&a[i]);CHKERRQ(ierr);
+      if (a[i][i] != i) wrong = PETSC_TRUE;
+      ierr = PetscFree(a[i]);CHKERRQ(ierr);
+    }
+  }
+
+  /* coalesced allocations and a block too large to be pooled */
+  ierr = PetscMalloc2(7,&x,13,&y);CHKERRQ(ierr);
+  if ((size_t)x % PETSC_MEMALIGN || (size_t)y % PETSC_MEMALIGN) misaligned = PETSC_TRUE;
+  ierr = PetscCalloc1(100*n,&big);CHKERRQ(ierr);
+  for (i=0; i<100*n; i++) if (big[i]) wrong = PETSC_TRUE;
+  ierr = PetscFree2(x,y);CHKERRQ(ierr);
+  ierr = PetscFree(big);CHKERRQ(ierr);
+
+  /* everything allocated in the arenas is released when they are popped, whether it was freed or not */
+  ierr = PetscMallocArenaPush();CHKERRQ(ierr);
+  for (i=0; i<100; i++) {ierr = PetscMalloc1(i+1,&a[i]);CHKERRQ(ierr);}
+  ierr = PetscMallocArenaPush();CHKERRQ(ierr);
+  ierr = PetscMalloc1(100*n,&big);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  for (i=0; i<100; i+=3) {ierr = PetscFree(a[i]);CHKERRQ(ierr);}
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Misaligned blocks %s, wrong contents %s\n",PetscBools[misaligned],PetscBools[wrong]);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     args: -malloc_pool -malloc_debug no
+
+   test:
+     suffix: 2
+     args: -malloc_pool -malloc_debug -malloc_dump
+     output_file: output/ex56_1.out
+
+TEST*/
@@ -0,0 +1,72 @@
+static char help[] = "Tests the heap profile written by PetscMallocProfileDump().\n\n";
+
+#include <petscsys.h>
+
+static PetscErrorCode Allocate(PetscInt n,PetscScalar **a)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(n,a);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* sums the bytes of the lines of a folded stack file that contain name */
+static PetscErrorCode SumBytes(const char fname[],const char name[],double *bytes)
+{
+  char line[4096],*sp;
+  FILE *fp;
+
+  PetscFunctionBegin;
+  *bytes = 0;
+  fp = fopen(fname,"r");
+  if (!fp) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Cannot open file: %s",fname);
+  while (fgets(line,sizeof(line),fp)) {
+    sp = strrchr(line,' ');
+    if (sp && strstr(line,name)) *bytes += atof(sp+1);
+  }
+  fclose(fp);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscLogStage  stage;
+  PetscScalar    *a,*b;
+  PetscMPIInt    rank;
+  char           fname[PETSC_MAX_PATH_LEN];
+  double         live,peak;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscLogStageRegister("Assembly",&stage);CHKERRQ(ierr);
+
+  /* b is freed before the end of the stage, so it is only counted at the peak */
+  ierr = PetscLogStagePush(stage);CHKERRQ(ierr);
+  ierr = Allocate(1000,&a);CHKERRQ(ierr);
+  ierr = Allocate(100000,&b);CHKERRQ(ierr);
+  ierr = PetscFree(b);CHKERRQ(ierr);
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+
+  ierr = PetscSNPrintf(fname,sizeof(fname),"heap_Assembly_0_live.%d.folded",rank);CHKERRQ(ierr);
+  ierr = SumBytes(fname,"Allocate",&live);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(fname,sizeof(fname),"heap_Assembly_0_peak.%d.folded",rank);CHKERRQ(ierr);
+  ierr = SumBytes(fname,"Allocate",&peak);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Live bytes from Allocate() cover a %s, peak bytes cover a and b %s\n",
+                     PetscBools[live >= 1000*sizeof(PetscScalar) && live < 100000*sizeof(PetscScalar)],PetscBools[peak >= 101000*sizeof(PetscScalar)]);CHKERRQ(ierr);
+  ierr = PetscFree(a);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+     requires: define(PETSC_USE_LOG)
+
+   test:
+     nsize: 2
+     args: -malloc_profile heap -malloc_profile_stages Assembly
+
+TEST*/
@@ -0,0 +1,82 @@
+static char help[] = "Tests the folded stacks of nested events written by PetscLogView() with PETSC_VIEWER_ASCII_FLAMEGRAPH.\n\n";
+
+#include <petscsys.h>
+#include <petscviewer.h>
+
+/* largest value on the lines of a folded stack file that contain path followed by the value */
+static PetscErrorCode MaxTime(const char fname[],const char path[],double *usec)
+{
+  char line[4096],*sp;
+  FILE *fp;
+
+  PetscFunctionBegin;
+  *usec = 0;
+  fp = fopen(fname,"r");
+  if (!fp) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Cannot open file: %s",fname);
+  while (fgets(line,sizeof(line),fp)) {
+    sp = strrchr(line,' ');
+    if (!sp) continue;
+    *sp = 0;
+    if (strstr(line,path) && !strcmp(strstr(line,path),path)) *usec = PetscMax(*usec,atof(sp+1));
+  }
+  fclose(fp);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscLogEvent  outer,inner;
+  PetscViewer    viewer;
+  PetscMPIInt    rank;
+  double         outerusec,innerusec;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscLogNestedBegin();CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Outer",PETSC_OBJECT_CLASSID,&outer);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("Inner",PETSC_OBJECT_CLASSID,&inner);CHKERRQ(ierr);
+
+  ierr = PetscLogEventBegin(outer,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSleep(0.01);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscSleep(0.1);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(inner,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(outer,0,0,0,0);CHKERRQ(ierr);
+
+  ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD,"flame.txt",&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_FLAMEGRAPH);CHKERRQ(ierr);
+  ierr = PetscLogView(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  /* the sleeps only bound the times from below; the self time of Outer excludes the time in Inner, so it stays
+     below the self time of Inner, ten times longer, unless the machine is badly overloaded */
+  if (!rank) {
+    ierr = MaxTime("flame.txt","Main Stage;Outer",&outerusec);CHKERRQ(ierr);
+    ierr = MaxTime("flame.txt","Main Stage;Outer;Inner",&innerusec);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_SELF,"Self time of Outer %s, self time of Inner %s\n",PetscBools[outerusec >= 0.9e4 && outerusec < innerusec],PetscBools[innerusec >= 0.9e5]);CHKERRQ(ierr);
+  }
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+     requires: define(PETSC_USE_LOG)
+
+   test:
+
+   test:
+     suffix: 2
+     nsize: 2
+     output_file: output/ex58_1.out
+
+   test:
+     suffix: 3
+     nsize: 2
+     args: -log_view_flamegraph_reduction max
+     output_file: output/ex58_1.out
+
+TEST*/
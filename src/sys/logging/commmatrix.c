@@ -0,0 +1,255 @@
+/*
+   Communication matrix logging: the point-to-point sends of PetscSF, VecScatter and MatStash are recorded with the
+   innermost active event and the destination rank in PETSC_COMM_WORLD, so PetscLogView() can show who talks to whom.
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petsc/private/hashmapij.h>
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+PetscBool PetscLogCommMatrix = PETSC_FALSE;
+
+#define PETSC_LOG_COMM_MAX_DEPTH 128
+
+static PetscHMapIJ    commIndex = NULL;     /* (event, destination) -> entry in the arrays below */
+static PetscInt       commN = 0, commNalloc = 0;
+static PetscHashIJKey *commKeys = NULL;
+static PetscLogDouble *commMessages = NULL, *commBytes = NULL;
+static PetscLogEvent  commEvents[PETSC_LOG_COMM_MAX_DEPTH];
+static int            commDepth = 0;
+static PetscMPIInt    Petsc_CommMatrix_keyval = MPI_KEYVAL_INVALID;
+
+/*
+   The attribute of a communicator is the PETSC_COMM_WORLD rank of each of its ranks. It is allocated with malloc()
+   since the inner communicators of PETSc are freed after -malloc_dump has checked for unfreed memory.
+*/
+static PetscMPIInt MPIAPI Petsc_DelComm_CommMatrix(MPI_Comm comm,PetscMPIInt keyval,void *val,void *extra_state)
+{
+  free(val);
+  return MPI_SUCCESS;
+}
+
+/*@C
+  PetscLogCommMatrixBegin - Turns on the logging of the messages sent to each process by PetscSF, VecScatter and MatStash
+
+  Not Collective
+
+  Options Database Keys:
+. -log_view_comm_matrix - Logs the communication matrix and shows it in -log_view
+
+  Notes:
+  The messages and bytes are recorded with the innermost event that is active when they are sent and with the rank of
+  the destination in PETSC_COMM_WORLD. PetscLogView() then prints, for each event, the largest and average number of
+  neighbors of a process and the largest volume sent by a process or between two processes, which show the quality
+  of the partition. With the PETSC_VIEWER_ASCII_CSV format it prints every nonzero of the matrix as a row
+  Event,Source,Destination,Messages,Bytes, which can be used to map the heavy neighbors onto the node topology.
+
+  Only messages logged with PetscLogCommSend() are recorded; collectives are not.
+
+  Level: advanced
+
+.seealso: PetscLogCommSend(), PetscLogCommMatrixView(), PetscLogView(), PetscLogDefaultBegin()
+@*/
+PetscErrorCode PetscLogCommMatrixBegin(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscLogCommMatrix) PetscFunctionReturn(0);
+  ierr = PetscHMapIJCreate(&commIndex);CHKERRQ(ierr);
+  ierr = MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN,Petsc_DelComm_CommMatrix,&Petsc_CommMatrix_keyval,(void*)0);CHKERRQ(ierr);
+  commDepth          = 0;
+  PetscLogCommMatrix = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogCommMatrixDestroy_Internal(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!PetscLogCommMatrix) PetscFunctionReturn(0);
+  ierr = PetscHMapIJDestroy(&commIndex);CHKERRQ(ierr);
+  ierr = PetscFree3(commKeys,commMessages,commBytes);CHKERRQ(ierr);
+  ierr = MPI_Comm_free_keyval(&Petsc_CommMatrix_keyval);CHKERRQ(ierr);
+  commN              = 0;
+  commNalloc         = 0;
+  PetscLogCommMatrix = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* called by PetscLogEventBeginDefault()/PetscLogEventEndDefault() for the outermost begin and end of an event */
+PetscErrorCode PetscLogCommMatrixEventPush_Internal(PetscLogEvent event)
+{
+  PetscFunctionBegin;
+  if (commDepth < PETSC_LOG_COMM_MAX_DEPTH) commEvents[commDepth] = event;
+  commDepth++;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogCommMatrixEventPop_Internal(void)
+{
+  PetscFunctionBegin;
+  if (commDepth > 0) commDepth--;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogCommSend_Internal(MPI_Comm comm,PetscMPIInt dest,PetscInt count,MPI_Datatype type)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    *worldranks,typesize,flg;
+  PetscHashIJKey key;
+  PetscInt       entry;
+
+  PetscFunctionBegin;
+  if (!count) PetscFunctionReturn(0);
+  /* translate dest to PETSC_COMM_WORLD once per communicator */
+  ierr = MPI_Comm_get_attr(comm,Petsc_CommMatrix_keyval,&worldranks,&flg);CHKERRQ(ierr);
+  if (!flg) {
+    MPI_Group   group,worldgroup;
+    PetscMPIInt i,size,*ranks;
+
+    ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+    ierr = PetscMalloc1(size,&ranks);CHKERRQ(ierr);
+    worldranks = (PetscMPIInt*)malloc(size*sizeof(PetscMPIInt));
+    if (!worldranks) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Out of memory");
+    for (i=0; i<size; i++) ranks[i] = i;
+    ierr = MPI_Comm_group(comm,&group);CHKERRQ(ierr);
+    ierr = MPI_Comm_group(PETSC_COMM_WORLD,&worldgroup);CHKERRQ(ierr);
+    ierr = MPI_Group_translate_ranks(group,size,ranks,worldgroup,worldranks);CHKERRQ(ierr);
+    ierr = MPI_Group_free(&group);CHKERRQ(ierr);
+    ierr = MPI_Group_free(&worldgroup);CHKERRQ(ierr);
+    ierr = PetscFree(ranks);CHKERRQ(ierr);
+    ierr = MPI_Comm_set_attr(comm,Petsc_CommMatrix_keyval,worldranks);CHKERRQ(ierr);
+  }
+  key.i = commDepth ? commEvents[PetscMin(commDepth,PETSC_LOG_COMM_MAX_DEPTH)-1] : -1;
+  key.j = worldranks[dest];
+  ierr  = PetscHMapIJGet(commIndex,key,&entry);CHKERRQ(ierr);
+  if (entry < 0) {
+    if (commN == commNalloc) {
+      PetscInt       nalloc = commNalloc ? 2*commNalloc : 64;
+      PetscHashIJKey *keys;
+      PetscLogDouble *messages,*bytes;
+
+      ierr = PetscMalloc3(nalloc,&keys,nalloc,&messages,nalloc,&bytes);CHKERRQ(ierr);
+      ierr = PetscArraycpy(keys,commKeys,commN);CHKERRQ(ierr);
+      ierr = PetscArraycpy(messages,commMessages,commN);CHKERRQ(ierr);
+      ierr = PetscArraycpy(bytes,commBytes,commN);CHKERRQ(ierr);
+      ierr = PetscFree3(commKeys,commMessages,commBytes);CHKERRQ(ierr);
+      commKeys     = keys;
+      commMessages = messages;
+      commBytes    = bytes;
+      commNalloc   = nalloc;
+    }
+    entry               = commN++;
+    commKeys[entry]     = key;
+    commMessages[entry] = 0.0;
+    commBytes[entry]    = 0.0;
+    ierr = PetscHMapIJSet(commIndex,key,entry);CHKERRQ(ierr);
+  }
+  ierr = MPI_Type_size(type,&typesize);CHKERRQ(ierr);
+  commMessages[entry] += 1.0;
+  commBytes[entry]    += (PetscLogDouble)count*typesize;
+  PetscFunctionReturn(0);
+}
+
+static int compareCommKeys(const void *a_,const void *b_)
+{
+  const PetscHashIJKey *a = (const PetscHashIJKey*)a_,*b = (const PetscHashIJKey*)b_;
+
+  if (a->i != b->i) return a->i < b->i ? -1 : 1;
+  if (a->j != b->j) return a->j < b->j ? -1 : 1;
+  return 0;
+}
+
+/*@C
+  PetscLogCommMatrixView - Prints the messages sent by each event to each process, logged after PetscLogCommMatrixBegin()
+
+  Collective over the viewer
+
+  Input Parameter:
+. viewer - an ASCII viewer
+
+  Notes:
+  With the default format one line per event shows the number of messages, the largest and average number of
+  processes a process sends to, and the largest number of bytes sent by one process and between two processes.
+  With PETSC_VIEWER_ASCII_CSV every process prints its nonzeros of the matrix as rows Event,Source,Destination,Messages,Bytes.
+
+  This is called by PetscLogView() when the communication matrix is logged.
+
+  Level: advanced
+
+.seealso: PetscLogCommMatrixBegin(), PetscLogView()
+@*/
+PetscErrorCode PetscLogCommMatrixView(PetscViewer viewer)
+{
+  PetscErrorCode    ierr;
+  PetscStageLog     stageLog;
+  PetscEventRegInfo *eventInfo;
+  PetscViewerFormat format;
+  PetscHashIJKey    *keys;
+  PetscInt          e,k,entry;
+  PetscMPIInt       rank,size;
+  int               nevents,n;
+  PetscLogDouble    *local,*lmax,*lsum;
+  MPI_Comm          comm;
+
+  PetscFunctionBegin;
+  if (!PetscLogCommMatrix) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  eventInfo = stageLog->eventLog->eventInfo;
+
+  /* sort the local nonzeros by event, then destination */
+  ierr = PetscMalloc1(commN,&keys);CHKERRQ(ierr);
+  ierr = PetscArraycpy(keys,commKeys,commN);CHKERRQ(ierr);
+  qsort(keys,commN,sizeof(PetscHashIJKey),compareCommKeys);
+
+  if (format == PETSC_VIEWER_ASCII_CSV) {
+    ierr = PetscViewerASCIIPrintf(viewer,"Event,Source,Destination,Messages,Bytes\n");CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+    for (k=0; k<commN; k++) {
+      ierr = PetscHMapIJGet(commIndex,keys[k],&entry);CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s,%d,%D,%.0f,%.0f\n",keys[k].i < 0 ? "None" : eventInfo[keys[k].i].name,rank,keys[k].j,commMessages[entry],commBytes[entry]);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+    ierr = PetscFree(keys);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  /* per event, slot 0 for messages outside events: messages, neighbors, bytes, largest bytes to one neighbor */
+  n    = stageLog->eventLog->numEvents;
+  ierr = MPIU_Allreduce(&n,&nevents,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  nevents++;
+  ierr = PetscCalloc3(4*nevents,&local,4*nevents,&lmax,4*nevents,&lsum);CHKERRQ(ierr);
+  for (k=0; k<commN; k++) {
+    ierr = PetscHMapIJGet(commIndex,keys[k],&entry);CHKERRQ(ierr);
+    e    = keys[k].i+1;
+    local[4*e+0] += commMessages[entry];
+    local[4*e+1] += 1.0;
+    local[4*e+2] += commBytes[entry];
+    local[4*e+3]  = PetscMax(local[4*e+3],commBytes[entry]);
+  }
+  ierr = PetscFree(keys);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(local,lmax,4*nevents,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(local,lsum,4*nevents,MPIU_PETSCLOGDOUBLE,MPI_SUM,comm);CHKERRQ(ierr);
+
+  ierr = PetscViewerASCIIPrintf(viewer,"\nCommunication matrix: point-to-point messages of PetscSF, VecScatter and MatStash by the innermost event\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"   Nbrs: number of processes one process sends to, largest and average\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"   Bytes: total, largest sent by one process, and largest sent from one process to another\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"Event                       Messages   Nbrs Max   Nbrs Avg     Total Bytes  Max Bytes/Proc  Max Bytes/Pair\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"----------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
+  for (e=0; e<nevents; e++) {
+    if (lsum[4*e] == 0.0) continue;
+    ierr = PetscViewerASCIIPrintf(viewer,"%-25.25s %10.0f %10.0f %10.1f %15.4e %15.4e %15.4e\n",!e ? "None" : (e-1 < n ? eventInfo[e-1].name : "Unknown"),lsum[4*e+0],lmax[4*e+1],lsum[4*e+1]/size,lsum[4*e+2],lmax[4*e+2],lmax[4*e+3]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(local,lmax,lsum);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
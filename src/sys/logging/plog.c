@@ -65,6 +65,7 @@ int       petsc_numObjectsDestroyed = 0;
 PetscLogDouble petsc_BaseTime        = 0.0;
 PetscLogDouble petsc_TotalFlops      = 0.0;  /* The number of flops */
 PetscLogDouble petsc_tmp_flops       = 0.0;  /* The incremental number of flops */
+PetscLogDouble petsc_TotalBytes      = 0.0;  /* The modeled memory traffic in bytes */
 PetscLogDouble petsc_send_ct         = 0.0;  /* The number of sends */
 PetscLogDouble petsc_recv_ct         = 0.0;  /* The number of receives */
 PetscLogDouble petsc_send_len        = 0.0;  /* The total length of all sent messages */
@@ -103,6 +104,8 @@ char             petsc_tracespace[128]       = " ";
 PetscLogDouble   petsc_tracetime             = 0.0;
 static PetscBool PetscLogInitializeCalled = PETSC_FALSE;
 
+PETSC_INTERN PetscErrorCode PetscMallocProfileStagePop_Private(const char[]);
+
 PETSC_INTERN PetscErrorCode PetscLogInitialize(void)
 {
   int            stage;
@@ -145,6 +148,9 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   ierr = PetscFree(petsc_actions);CHKERRQ(ierr);
   ierr = PetscFree(petsc_objects);CHKERRQ(ierr);
   ierr = PetscLogNestedEnd();CHKERRQ(ierr);
+  ierr = PetscLogTimelineDestroy_Internal();CHKERRQ(ierr);
+  ierr = PetscLogCommMatrixDestroy_Internal();CHKERRQ(ierr);
+  ierr = PetscLogSetHWCounters(0,NULL);CHKERRQ(ierr);
   ierr = PetscLogSet(NULL, NULL);CHKERRQ(ierr);
 
   /* Resetting phase */
@@ -164,6 +170,7 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   petsc_BaseTime              = 0.0;
   petsc_TotalFlops            = 0.0;
   petsc_tmp_flops             = 0.0;
+  petsc_TotalBytes            = 0.0;
   petsc_send_ct               = 0.0;
   petsc_recv_ct               = 0.0;
   petsc_send_len              = 0.0;
@@ -454,6 +461,7 @@ PetscErrorCode  PetscLogStagePush(PetscLogStage stage)
   PetscFunctionBegin;
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = PetscStageLogPush(stageLog, stage);CHKERRQ(ierr);
+  if (petsc_logTimeline) {ierr = PetscLogTimelineStage_Internal(stage,PETSC_TRUE);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -491,6 +499,18 @@ PetscErrorCode  PetscLogStagePop(void)
 
   PetscFunctionBegin;
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  if (petsc_logTimeline) {
+    int stage;
+
+    ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
+    ierr = PetscLogTimelineStage_Internal(stage,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  {
+    int stage;
+
+    ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
+    if (stage >= 0) {ierr = PetscMallocProfileStagePop_Private(stageLog->stageInfo[stage].name);CHKERRQ(ierr);}
+  }
   ierr = PetscStageLogPop(stageLog);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1258,6 +1278,8 @@ PetscErrorCode  PetscLogView_CSV(PetscViewer viewer)
   PetscEventPerfInfo *eventInfo = NULL;
   PetscLogDouble     locTotalTime, maxMem;
   int                numStages,numEvents,stage,event;
+  PetscInt           numHWCounters,c;
+  const char *const  *hwCounterNames;
   MPI_Comm           comm = PetscObjectComm((PetscObject) viewer);
   PetscMPIInt        rank,size;
   PetscErrorCode     ierr;
@@ -1271,8 +1293,11 @@ PetscErrorCode  PetscLogView_CSV(PetscViewer viewer)
   ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
   ierr = MPIU_Allreduce(&stageLog->numStages, &numStages, 1, MPI_INT, MPI_MAX, comm);CHKERRQ(ierr);
   ierr = PetscMallocGetMaximumUsage(&maxMem);CHKERRQ(ierr);
+  ierr = PetscLogGetHWCounters(&numHWCounters,&hwCounterNames);CHKERRQ(ierr);
   ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
-  ierr = PetscViewerASCIIPrintf(viewer,"Stage Name,Event Name,Rank,Time,Num Messages,Message Length,Num Reductions,FLOP,dof0,dof1,dof2,dof3,dof4,dof5,dof6,dof7,e0,e1,e2,e3,e4,e5,e6,e7,%d\n", size);
+  ierr = PetscViewerASCIIPrintf(viewer,"Stage Name,Event Name,Rank,Time,Num Messages,Message Length,Num Reductions,FLOP");CHKERRQ(ierr);
+  for (c=0; c<numHWCounters; c++) {ierr = PetscViewerASCIIPrintf(viewer,",%s",hwCounterNames[c]);CHKERRQ(ierr);}
+  ierr = PetscViewerASCIIPrintf(viewer,",dof0,dof1,dof2,dof3,dof4,dof5,dof6,dof7,e0,e1,e2,e3,e4,e5,e6,e7,%d\n", size);CHKERRQ(ierr);
   ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
   for (stage=0; stage<numStages; stage++) {
     PetscEventPerfInfo *stageInfo = &stageLog->stageInfo[stage].perfInfo;
@@ -1285,6 +1310,9 @@ PetscErrorCode  PetscLogView_CSV(PetscViewer viewer)
       ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s,%s,%d,%g,%g,%g,%g,%g",stageLog->stageInfo[stage].name,
                                                 stageLog->eventLog->eventInfo[event].name,rank,eventInfo->time,eventInfo->numMessages,
                                                 eventInfo->messageLength,eventInfo->numReductions,eventInfo->flops);CHKERRQ(ierr);
+      for (c=0; c<numHWCounters; c++) {
+        ierr = PetscViewerASCIISynchronizedPrintf(viewer,",%g",eventInfo->hwCounters[c]);CHKERRQ(ierr);
+      }
       if (eventInfo->dof[0] >= 0.) {
         PetscInt d, e;
 
@@ -1366,10 +1394,14 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   PetscLogDouble     fracTime, fracFlops, fracMessages, fracLength, fracReductions, fracMess, fracMessLen, fracRed;
   PetscLogDouble     fracStageTime, fracStageFlops, fracStageMess, fracStageMessLen, fracStageRed;
   PetscLogDouble     min, max, tot, ratio, avg, x, y;
-  PetscLogDouble     minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr, mal, malmax, emalmax;
+  PetscLogDouble     minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr, mal, malmax, emalmax, totb;
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   PetscLogDouble     cct, gct, csz, gsz, gmaxt, gflops, gflopr, fracgflops;
   #endif
+  PetscLogDouble     hwc[PETSC_LOG_MAX_HW_COUNTERS], zeros[PETSC_LOG_MAX_HW_COUNTERS] = {0.0, 0.0, 0.0, 0.0}, llcMisses;
+  PetscInt           numHWCounters, c;
+  const char *const  *hwCounterNames;
+  PetscBool          hwLLC[PETSC_LOG_MAX_HW_COUNTERS], hasLLC = PETSC_FALSE;
   PetscMPIInt        minC, maxC;
   PetscMPIInt        size, rank;
   PetscBool          *localStageUsed,    *stageUsed;
@@ -1448,6 +1480,16 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   avg  = tot/((PetscLogDouble) size);
   if (min != 0.0) ratio = max/min; else ratio = 0.0;
   ierr = PetscFPrintf(comm, fd, "Flop/sec:             %5.3e   %7.3f   %5.3e  %5.3e\n", max, ratio, avg, tot);CHKERRQ(ierr);
+  /*   Modeled memory traffic */
+  if (PetscLogRoofline) {
+    ierr = MPIU_Allreduce(&petsc_TotalBytes,  &min, 1, MPIU_PETSCLOGDOUBLE, MPI_MIN, comm);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&petsc_TotalBytes,  &max, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&petsc_TotalBytes,  &tot, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+    avg  = tot/((PetscLogDouble) size);
+    if (min != 0.0) ratio = max/min; else ratio = 0.0;
+    ierr = PetscFPrintf(comm, fd, "Bytes:                %5.3e   %7.3f   %5.3e  %5.3e\n", max, ratio, avg, tot);CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "Bandwidth (STREAM):                                        %5.3e\n", petsc_MemoryBandwidth);CHKERRQ(ierr);
+  }
   /*   Memory */
   ierr = PetscMallocGetMaximumUsage(&mem);CHKERRQ(ierr);
   if (mem > 0.0) {
@@ -1571,6 +1613,22 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
     ierr = PetscFPrintf(comm, fd, "   MMalloc Mbytes: Increase in high water mark of allocated memory (sum over all calls to event)\n");CHKERRQ(ierr);
     ierr = PetscFPrintf(comm, fd, "   RMI Mbytes: Increase in resident memory (sum over all calls to event)\n");CHKERRQ(ierr);
   }
+  ierr = PetscLogGetHWCounters(&numHWCounters,&hwCounterNames);CHKERRQ(ierr);
+  for (c = 0; c < numHWCounters; c++) {
+    /* last level cache misses are the lines moved to or from memory */
+    hwLLC[c] = (PetscBool)(!strncmp(hwCounterNames[c],"LLC-",4) && strstr(hwCounterNames[c],"misses"));
+    hasLLC   = (PetscBool)(hasLLC || hwLLC[c]);
+    ierr = PetscFPrintf(comm, fd, "   %s: sum over all processors of this perf_event_open() counter\n",hwCounterNames[c]);CHKERRQ(ierr);
+  }
+  if (hasLLC) {
+    ierr = PetscFPrintf(comm, fd, "   MemBW Mbytes/s: 10e-6 * 64 * (sum of LLC misses over all processors)/(max time over all processors)\n");CHKERRQ(ierr);
+  }
+  if (PetscLogRoofline) {
+    ierr = PetscFPrintf(comm, fd, "   Roofline flop/B: arithmetic intensity, (sum of flop over all processors)/(sum of bytes moved over all processors)\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   Roofline GB/s: 10e-9 * (sum of bytes moved over all processors)/(max time over all processors)\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "   Roofline %%BW: percent of the bandwidth measured with the STREAM triad\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "      The bytes moved are modeled by the kernels, assuming nothing is in cache, see PetscLogBytes()\n");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd, "   GPU Mflop/s: 10e-6 * (sum of flop on GPU over all processors)/(max GPU time over all processors)\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "   CpuToGpu Count: total number of CPU to GPU copies per processor\n");CHKERRQ(ierr);
@@ -1588,6 +1646,15 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd,"  Malloc EMalloc MMalloc RMI");CHKERRQ(ierr);
   } 
+  for (c = 0; c < numHWCounters; c++) {
+    ierr = PetscFPrintf(comm, fd," %9.9s",hwCounterNames[c]);CHKERRQ(ierr);
+  }
+  if (hasLLC) {
+    ierr = PetscFPrintf(comm, fd,"     MemBW");CHKERRQ(ierr);
+  }
+  if (PetscLogRoofline) {
+    ierr = PetscFPrintf(comm, fd,"   ---- Roofline ---");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd,"   GPU    - CpuToGpu -   - GpuToCpu - GPU");CHKERRQ(ierr);
   #endif
@@ -1596,6 +1663,15 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd," Mbytes Mbytes Mbytes Mbytes");CHKERRQ(ierr);
   }
+  for (c = 0; c < numHWCounters; c++) {
+    ierr = PetscFPrintf(comm, fd,"     Total");CHKERRQ(ierr);
+  }
+  if (hasLLC) {
+    ierr = PetscFPrintf(comm, fd,"  Mbytes/s");CHKERRQ(ierr);
+  }
+  if (PetscLogRoofline) {
+    ierr = PetscFPrintf(comm, fd," flop/B   GB/s  %%BW");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd," Mflop/s Count   Size   Count   Size  %%F");CHKERRQ(ierr); 
   #endif
@@ -1604,6 +1680,12 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd,"-----------------------------");CHKERRQ(ierr);
   }
+  for (c = 0; c < numHWCounters + (hasLLC ? 1 : 0); c++) {
+    ierr = PetscFPrintf(comm, fd,"----------");CHKERRQ(ierr);
+  }
+  if (PetscLogRoofline) {
+    ierr = PetscFPrintf(comm, fd,"-------------------");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd,"---------------------------------------");CHKERRQ(ierr); 
   #endif
@@ -1664,6 +1746,12 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
           ierr  = MPI_Allreduce(&eventInfo[event].mallocIncrease, &malmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
           ierr  = MPI_Allreduce(&eventInfo[event].mallocIncreaseEvent, &emalmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         }
+        if (PetscLogRoofline) {
+          ierr  = MPI_Allreduce(&eventInfo[event].bytes,        &totb,  1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        }
+        if (numHWCounters) {
+          ierr  = MPI_Allreduce(eventInfo[event].hwCounters,    hwc,    (PetscMPIInt)numHWCounters, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
         ierr  = MPI_Allreduce(&eventInfo[event].CpuToGpuCount,    &cct,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr  = MPI_Allreduce(&eventInfo[event].GpuToCpuCount,    &gct,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
@@ -1692,6 +1780,12 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
           ierr  = MPI_Allreduce(&zero,                        &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
           ierr  = MPI_Allreduce(&zero,                        &emalmax,1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         }
+        if (PetscLogRoofline) {
+          ierr  = MPI_Allreduce(&zero,                        &totb,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        }
+        if (numHWCounters) {
+          ierr  = MPI_Allreduce(zeros,                        hwc,    (PetscMPIInt)numHWCounters, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
         ierr  = MPI_Allreduce(&zero,                          &cct,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr  = MPI_Allreduce(&zero,                          &gct,    1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
@@ -1735,6 +1829,20 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         if (PetscLogMemory) {
           ierr = PetscFPrintf(comm, fd," %5.0f   %5.0f   %5.0f   %5.0f",mal/1.0e6,emalmax/1.0e6,malmax/1.0e6,mem/1.0e6);CHKERRQ(ierr);
         } 
+        for (c = 0, llcMisses = 0.0; c < numHWCounters; c++) {
+          ierr = PetscFPrintf(comm, fd," %9.2e",hwc[c]);CHKERRQ(ierr);
+          if (hwLLC[c]) llcMisses += hwc[c];
+        }
+        if (hasLLC) {
+          ierr = PetscFPrintf(comm, fd," %9.0f",maxt != 0.0 ? 64.0*llcMisses/(1.0e6*maxt) : 0.0);CHKERRQ(ierr);
+        }
+        if (PetscLogRoofline) {
+          PetscLogDouble ai = 0.0,bw = 0.0;
+
+          if (totb != 0.0) ai = totf/totb;
+          if (maxt != 0.0) bw = totb/maxt;
+          ierr = PetscFPrintf(comm, fd," %6.2f %6.2f %5.0f",ai,bw/1.0e9,petsc_MemoryBandwidth != 0.0 ? 100.0*bw/petsc_MemoryBandwidth : 0.0);CHKERRQ(ierr);
+        }
         #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
         if (totf  != 0.0) fracgflops = gflops/totf;  else fracgflops = 0.0;
         if (gmaxt != 0.0) gflopr     = gflops/gmaxt; else gflopr     = 0.0;
@@ -1750,6 +1858,12 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   if (PetscLogMemory) {
     ierr = PetscFPrintf(comm, fd, "-----------------------------");CHKERRQ(ierr);
   }
+  for (c = 0; c < numHWCounters + (hasLLC ? 1 : 0); c++) {
+    ierr = PetscFPrintf(comm, fd, "----------");CHKERRQ(ierr);
+  }
+  if (PetscLogRoofline) {
+    ierr = PetscFPrintf(comm, fd, "-------------------");CHKERRQ(ierr);
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   ierr = PetscFPrintf(comm, fd, "---------------------------------------");CHKERRQ(ierr); 
   #endif
@@ -1872,6 +1986,9 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
 +  -log_view [:filename] - Prints summary of log information
 .  -log_view :filename.py:ascii_info_detail - Saves logging information from each process as a Python file
 .  -log_view :filename.xml:ascii_xml - Saves a summary of the logging information in a nested format (see below for how to view it)
+.  -log_view :filename.txt:ascii_flamegraph - Saves the time spent in each nested calling path as folded stacks, the input format of flame graph tools
+.  -log_view_comm_matrix - Adds the messages sent by each event between each pair of processes, see PetscLogCommMatrixBegin()
+.  -log_view_flamegraph_reduction <none,max,mean> - With ascii_flamegraph, print the stacks of each process prefixed by its rank, or the maximum or mean over the processes
 .  -log_all - Saves a file Log.rank for each MPI process with details of each step of the computation
 -  -log_trace [filename] - Displays a trace of what each process is doing
 
@@ -1895,6 +2012,10 @@ $    Safari - see https://ccm.net/faq/36342-safari-how-to-enable-local-file-acce
 
   The nested XML format was kindly donated by Koos Huijssen and Christiaan M. Klaij  MARITIME  RESEARCH  INSTITUTE  NETHERLANDS
 
+  The ascii_flamegraph format writes one line per nested calling path, for example "Main Stage;SNESSolve;KSPSolve;PCApply;MatMult 1234",
+  with the time in microseconds spent in the last event of the path but not in the events nested inside it. It can be turned into
+  an interactive SVG with flamegraph.pl from https://github.com/brendangregg/FlameGraph or opened directly with speedscope.
+
   Level: beginner
 
 .seealso: PetscLogDefaultBegin(), PetscLogDump()
@@ -1923,12 +2044,16 @@ PetscErrorCode  PetscLogView(PetscViewer viewer)
   ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
   if (format == PETSC_VIEWER_DEFAULT || format == PETSC_VIEWER_ASCII_INFO) {
     ierr = PetscLogView_Default(viewer);CHKERRQ(ierr);
+    ierr = PetscLogCommMatrixView(viewer);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
     ierr = PetscLogView_Detailed(viewer);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_CSV) {
     ierr = PetscLogView_CSV(viewer);CHKERRQ(ierr);
+    ierr = PetscLogCommMatrixView(viewer);CHKERRQ(ierr);
   } else if (format == PETSC_VIEWER_ASCII_XML) {
     ierr = PetscLogView_Nested(viewer);CHKERRQ(ierr);
+  } else if (format == PETSC_VIEWER_ASCII_FLAMEGRAPH) {
+    ierr = PetscLogView_Flamegraph(viewer);CHKERRQ(ierr);
   }
   ierr = PetscStageLogPush(stageLog, lastStage);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -0,0 +1,68 @@
+/*
+   Roofline logging: the memory bandwidth the processes can reach together is measured with the triad kernel of
+   src/benchmarks/streams and compared in PetscLogView() with the bandwidth achieved by each event, computed from
+   the bytes logged with PetscLogBytes().
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+
+#if defined(PETSC_USE_LOG)
+
+PetscLogDouble petsc_MemoryBandwidth = 0.0;
+
+/*@C
+  PetscLogMeasureBandwidth - Measures the memory bandwidth with the STREAM triad kernel a[i] = b[i] + s*c[i],
+  run at the same time by all the processes of a communicator
+
+  Collective
+
+  Input Parameters:
++ comm - the processes that share the memory system, usually PETSC_COMM_WORLD
+- n    - the length of each of the three arrays, or PETSC_DEFAULT for 2,000,000 which is much larger than the caches
+
+  Output Parameter:
+. bandwidth - the sum over the processes of the best bandwidth in bytes per second
+
+  Options Database Keys:
++ -log_view_roofline - Measures the bandwidth in PetscInitialize() and reports the achieved bandwidth of each event in -log_view
+- -log_view_roofline_size <n> - The array length used for the measurement
+
+  Notes:
+  This is the triad of src/benchmarks/streams, which should be used for a careful study of the memory system since it
+  also reports the copy, scale and add kernels and how the bandwidth scales with the number of processes.
+
+  Level: intermediate
+
+.seealso: PetscLogBytes(), PetscLogView()
+@*/
+PetscErrorCode PetscLogMeasureBandwidth(MPI_Comm comm,PetscInt n,PetscLogDouble *bandwidth)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,ntimes = 10;
+  double         *a,*b,*c,scalar = 3.0;
+  PetscLogDouble t,tmin = PETSC_MAX_REAL,rate;
+
+  PetscFunctionBegin;
+  PetscValidPointer(bandwidth,3);
+  if (n == PETSC_DEFAULT) n = 2000000;
+  if (n < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Array length %D must be positive",n);
+  ierr = PetscMalloc3(n,&a,n,&b,n,&c);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    a[i] = 1.0;
+    b[i] = 2.0;
+    c[i] = 0.0;
+  }
+  for (k=0; k<ntimes; k++) {
+    ierr = MPI_Barrier(comm);CHKERRQ(ierr);
+    ierr = PetscTime(&t);CHKERRQ(ierr);
+    for (i=0; i<n; i++) a[i] = b[i] + scalar*c[i];
+    ierr = PetscTimeSubtract(&t);CHKERRQ(ierr);
+    tmin = PetscMin(tmin,-t);
+    ierr = MPI_Barrier(comm);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(a,b,c);CHKERRQ(ierr);
+  rate = tmin > 0.0 ? 3.0*sizeof(double)*n/tmin : 0.0;
+  ierr = MPIU_Allreduce(&rate,bandwidth,1,MPIU_PETSCLOGDOUBLE,MPI_SUM,comm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
@@ -0,0 +1,324 @@
+/*
+   Timeline logging: timestamped begin and end records of every event and stage are kept in a fixed size
+   ring buffer on each process and written at the end in the Chrome Trace Event format (JSON), which can be
+   displayed by chrome://tracing or https://ui.perfetto.dev with one track per process.
+*/
+#include <petsc/private/logimpl.h>        /*I    "petscsys.h"   I*/
+#include <petscviewer.h>
+
+#if defined(PETSC_USE_LOG)
+
+#define TIMELINE_EVENT_BEGIN 0
+#define TIMELINE_EVENT_END   1
+#define TIMELINE_STAGE_BEGIN 2
+#define TIMELINE_STAGE_END   3
+
+typedef struct {
+  PetscLogDouble time;       /* seconds since PetscInitialize() */
+  PetscLogDouble flops;      /* flops counted so far on this process */
+  PetscLogDouble messages;   /* messages sent and received so far */
+  PetscLogDouble length;     /* bytes sent and received so far */
+  PetscLogDouble reductions; /* reductions done so far */
+  int            id;         /* the event or stage */
+  int            kind;       /* TIMELINE_EVENT_BEGIN, ... */
+} PetscTimelineRecord;
+
+PetscBool                  petsc_logTimeline = PETSC_FALSE;
+static PetscTimelineRecord *timeline         = NULL;
+static PetscInt            timelineSize      = 0;   /* capacity of the ring buffer */
+static PetscInt64          timelineCount     = 0;   /* records written, the oldest ones are overwritten */
+static PetscErrorCode      (*timelinePLB)(PetscLogEvent,int,PetscObject,PetscObject,PetscObject,PetscObject) = NULL;
+static PetscErrorCode      (*timelinePLE)(PetscLogEvent,int,PetscObject,PetscObject,PetscObject,PetscObject) = NULL;
+
+PETSC_STATIC_INLINE void PetscLogTimelineRecord_Private(int kind,int id)
+{
+  PetscTimelineRecord *r = &timeline[timelineCount++ % timelineSize];
+
+  PetscTime(&r->time);
+  r->time      -= petsc_BaseTime;
+  r->flops      = petsc_TotalFlops;
+  r->messages   = petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
+  r->length     = petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
+  r->reductions = petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  r->id         = id;
+  r->kind       = kind;
+}
+
+static PetscErrorCode PetscLogEventBeginTimeline(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (timelinePLB) {ierr = (*timelinePLB)(event,t,o1,o2,o3,o4);CHKERRQ(ierr);}
+  PetscLogTimelineRecord_Private(TIMELINE_EVENT_BEGIN,event);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscLogEventEndTimeline(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscLogTimelineRecord_Private(TIMELINE_EVENT_END,event);
+  if (timelinePLE) {ierr = (*timelinePLE)(event,t,o1,o2,o3,o4);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* called by PetscLogStagePush() and PetscLogStagePop() */
+PetscErrorCode PetscLogTimelineStage_Internal(PetscLogStage stage,PetscBool push)
+{
+  PetscFunctionBegin;
+  PetscLogTimelineRecord_Private(push ? TIMELINE_STAGE_BEGIN : TIMELINE_STAGE_END,stage);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogTimelineDestroy_Internal(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(timeline);CHKERRQ(ierr);
+  petsc_logTimeline = PETSC_FALSE;
+  timelineSize      = 0;
+  timelineCount     = 0;
+  timelinePLB       = NULL;
+  timelinePLE       = NULL;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogTimelineBegin - Turns on recording of a timeline of all events and stages, to be written with
+  PetscLogTimelineDump() in the Chrome Trace Event format.
+
+  Logically Collective over PETSC_COMM_WORLD
+
+  Input Parameter:
+. size - the number of records kept on each process, or PETSC_DEFAULT
+
+  Options Database Keys:
++ -log_timeline [filename] - Records the timeline and writes it during PetscFinalize()
+- -log_timeline_size <size> - Number of records kept on each process (default 100000)
+
+  Notes:
+  Each PetscLogEventBegin(), PetscLogEventEnd(), PetscLogStagePush() and PetscLogStagePop() stores the time
+  and the flop, message and reduction counters in a ring buffer of the given size; when it is full the oldest records
+  are overwritten, so the cost does not grow with the length of the run. The handlers set before this call, for example
+  by PetscLogDefaultBegin(), keep being called so -log_view can be used at the same time; call this after them.
+
+  Level: advanced
+
+.seealso: PetscLogTimelineDump(), PetscLogDefaultBegin(), PetscLogTraceBegin(), PetscLogView()
+@*/
+PetscErrorCode PetscLogTimelineBegin(PetscInt size)
+{
+  PetscStageLog  stageLog;
+  int            stage;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (petsc_logTimeline) PetscFunctionReturn(0);
+  if (size == PETSC_DEFAULT || size == PETSC_DECIDE) size = 100000;
+  if (size < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Timeline size %D must be positive",size);
+  ierr = PetscMalloc1(size,&timeline);CHKERRQ(ierr);
+  timelineSize  = size;
+  timelineCount = 0;
+  timelinePLB   = PetscLogPLB;
+  timelinePLE   = PetscLogPLE;
+  ierr = PetscLogSet(PetscLogEventBeginTimeline,PetscLogEventEndTimeline);CHKERRQ(ierr);
+  petsc_logTimeline = PETSC_TRUE;
+
+  /* the stage active now, usually the main stage, starts here */
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
+  if (stage >= 0) {ierr = PetscLogTimelineStage_Internal(stage,PETSC_TRUE);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  PetscTimelineRecord *rec;
+  PetscInt            n,max;
+} PetscTimelineStack;
+
+static PetscErrorCode PetscTimelineStackPush(PetscTimelineStack *s,const PetscTimelineRecord *r)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s->n == s->max) {
+    PetscTimelineRecord *tmp;
+
+    s->max = PetscMax(2*s->max,64);
+    ierr   = PetscMalloc1(s->max,&tmp);CHKERRQ(ierr);
+    ierr   = PetscArraycpy(tmp,s->rec,s->n);CHKERRQ(ierr);
+    ierr   = PetscFree(s->rec);CHKERRQ(ierr);
+    s->rec = tmp;
+  }
+  s->rec[s->n++] = *r;
+  PetscFunctionReturn(0);
+}
+
+/* writes one complete ("X") trace event from a begin record and the matching end record */
+static PetscErrorCode PetscTimelineWriteSlice(FILE *fd,PetscMPIInt rank,const char name[],int tid,const PetscTimelineRecord *b,const PetscTimelineRecord *e,PetscBool *first)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = PetscFPrintf(PETSC_COMM_SELF,fd,"%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"flops\":%.0f,\"messages\":%.0f,\"bytes\":%.0f,\"reductions\":%.0f}}",
+                         *first ? "" : ",",name,tid ? "stage" : "event",rank,tid,1.e6*b->time,1.e6*(e->time-b->time),
+                         e->flops-b->flops,e->messages-b->messages,e->length-b->length,e->reductions-b->reductions);CHKERRQ(ierr);
+  *first = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* matches the begin and end records of one process; records whose begin was overwritten are dropped and those
+   still open are closed at the last record */
+static PetscErrorCode PetscTimelineWriteRecords(FILE *fd,PetscMPIInt rank,PetscStageLog stageLog,const PetscTimelineRecord *rec,PetscInt n,PetscTimelineStack stack[],PetscBool *first)
+{
+  PetscEventRegLog eventRegLog;
+  PetscInt         i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscStageLogGetEventRegLog(stageLog,&eventRegLog);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    const PetscTimelineRecord *r = &rec[i];
+    PetscTimelineStack        *s = &stack[r->kind/2];
+    const char                *name;
+
+    if (r->kind == TIMELINE_EVENT_BEGIN || r->kind == TIMELINE_STAGE_BEGIN) {
+      ierr = PetscTimelineStackPush(s,r);CHKERRQ(ierr);
+      continue;
+    }
+    if (!s->n || s->rec[s->n-1].id != r->id) continue;
+    s->n--;
+    if (r->kind == TIMELINE_EVENT_END) name = r->id < eventRegLog->numEvents ? eventRegLog->eventInfo[r->id].name : "unknown event";
+    else name = r->id < stageLog->numStages ? stageLog->stageInfo[r->id].name : "unknown stage";
+    ierr = PetscTimelineWriteSlice(fd,rank,name,r->kind/2,&s->rec[s->n],r,first);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscTimelineCloseOpen(FILE *fd,PetscMPIInt rank,PetscStageLog stageLog,const PetscTimelineRecord *last,PetscTimelineStack stack[],PetscBool *first)
+{
+  PetscEventRegLog eventRegLog;
+  PetscInt         k;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscStageLogGetEventRegLog(stageLog,&eventRegLog);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    while (stack[k].n) {
+      const PetscTimelineRecord *b = &stack[k].rec[--stack[k].n];
+      const char                *name;
+
+      if (k) name = b->id < stageLog->numStages ? stageLog->stageInfo[b->id].name : "unknown stage";
+      else   name = b->id < eventRegLog->numEvents ? eventRegLog->eventInfo[b->id].name : "unknown event";
+      ierr = PetscTimelineWriteSlice(fd,rank,name,(int)k,b,last,first);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogTimelineDump - Writes the timeline recorded since PetscLogTimelineBegin() in the Chrome Trace Event format.
+
+  Collective over PETSC_COMM_WORLD
+
+  Input Parameter:
+. sname - the name of the file, or NULL for the default name (the program name with the .json suffix)
+
+  Notes:
+  The first process writes one file; every process is a separate track ("pid" is the rank) with the events on the
+  thread "tid":0 and the stages on "tid":1. Each event carries as arguments the flops, the number of messages, the
+  bytes of the messages and the number of reductions counted during it. The records are sent to the first process
+  in chunks, so it never holds the timeline of another process at once. The file can be opened with chrome://tracing
+  or https://ui.perfetto.dev.
+
+  Level: advanced
+
+.seealso: PetscLogTimelineBegin(), PetscLogDump(), PetscLogView()
+@*/
+PetscErrorCode PetscLogTimelineDump(const char sname[])
+{
+  const PetscInt      chunk = 4096;
+  PetscStageLog       stageLog;
+  PetscTimelineRecord *buf = NULL,last;
+  PetscTimelineStack  stack[2];
+  MPI_Comm            comm;
+  PetscMPIInt         rank,size,tag,r,cnt;
+  MPI_Status          status;
+  PetscInt            n,start,i,k,m;
+  PetscBool           first = PETSC_TRUE;
+  FILE                *fd   = NULL;
+  char                name[PETSC_MAX_PATH_LEN],fname[PETSC_MAX_PATH_LEN];
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  if (!petsc_logTimeline) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call PetscLogTimelineBegin() or use -log_timeline first");
+  ierr = PetscCommDuplicate(PETSC_COMM_WORLD,&comm,&tag);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+
+  /* the records of this process in chronological order are [start,timelineSize) followed by [0,start) */
+  n     = (PetscInt)PetscMin(timelineCount,(PetscInt64)timelineSize);
+  start = timelineCount > timelineSize ? (PetscInt)(timelineCount % timelineSize) : 0;
+  if (n) last = timeline[(timelineCount-1) % timelineSize];
+
+  if (!rank) {
+    if (sname && sname[0]) {
+      ierr = PetscStrcpy(name,sname);CHKERRQ(ierr);
+    } else {
+      ierr = PetscGetProgramName(name,sizeof(name));CHKERRQ(ierr);
+      ierr = PetscStrlcat(name,".json",sizeof(name));CHKERRQ(ierr);
+    }
+    ierr = PetscFixFilename(name,fname);CHKERRQ(ierr);
+    fd   = fopen(fname,"w");
+    if (!fd) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Cannot open file: %s",fname);
+    ierr = PetscMemzero(stack,sizeof(stack));CHKERRQ(ierr);
+    ierr = PetscMalloc1(chunk,&buf);CHKERRQ(ierr);
+    ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");CHKERRQ(ierr);
+    for (r=0; r<size; r++) {
+      ierr  = PetscFPrintf(PETSC_COMM_SELF,fd,"%s\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}},",first ? "" : ",",r,r);CHKERRQ(ierr);
+      ierr  = PetscFPrintf(PETSC_COMM_SELF,fd,"\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"events\"}},",r);CHKERRQ(ierr);
+      ierr  = PetscFPrintf(PETSC_COMM_SELF,fd,"\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":1,\"args\":{\"name\":\"stages\"}}",r);CHKERRQ(ierr);
+      first = PETSC_FALSE;
+    }
+    /* the own records are formatted in place */
+    ierr = PetscTimelineWriteRecords(fd,0,stageLog,timeline+start,n-start,stack,&first);CHKERRQ(ierr);
+    ierr = PetscTimelineWriteRecords(fd,0,stageLog,timeline,start,stack,&first);CHKERRQ(ierr);
+    if (n) {ierr = PetscTimelineCloseOpen(fd,0,stageLog,&last,stack,&first);CHKERRQ(ierr);}
+    for (r=1; r<size; r++) {
+      ierr = MPI_Recv(&n,1,MPIU_INT,r,tag,comm,&status);CHKERRQ(ierr);
+      for (i=0; i<n; i+=m) {
+        ierr = PetscMPIIntCast(chunk*sizeof(PetscTimelineRecord),&cnt);CHKERRQ(ierr);
+        ierr = MPI_Recv(buf,cnt,MPI_BYTE,r,tag,comm,&status);CHKERRQ(ierr);
+        ierr = MPI_Get_count(&status,MPI_BYTE,&cnt);CHKERRQ(ierr);
+        m    = cnt/(PetscInt)sizeof(PetscTimelineRecord);
+        ierr = PetscTimelineWriteRecords(fd,r,stageLog,buf,m,stack,&first);CHKERRQ(ierr);
+        last = buf[m-1];
+      }
+      if (n) {ierr = PetscTimelineCloseOpen(fd,r,stageLog,&last,stack,&first);CHKERRQ(ierr);}
+    }
+    ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\n]}\n");CHKERRQ(ierr);
+    if (fclose(fd)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"fclose() failed on file");
+    ierr = PetscFree(buf);CHKERRQ(ierr);
+    for (k=0; k<2; k++) {ierr = PetscFree(stack[k].rec);CHKERRQ(ierr);}
+  } else {
+    ierr = MPI_Send(&n,1,MPIU_INT,0,tag,comm);CHKERRQ(ierr);
+    for (k=0; k<2; k++) {
+      const PetscTimelineRecord *seg = k ? timeline : timeline+start;
+      PetscInt                  ns   = k ? start : n-start;
+
+      for (i=0; i<ns; i+=m) {
+        m    = PetscMin(chunk,ns-i);
+        ierr = PetscMPIIntCast(m*sizeof(PetscTimelineRecord),&cnt);CHKERRQ(ierr);
+        ierr = MPI_Send((void*)(seg+i),cnt,MPI_BYTE,0,tag,comm);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = PetscCommDestroy(&comm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
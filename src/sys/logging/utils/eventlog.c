@@ -6,12 +6,24 @@
 
 */
 #include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+#include <linux/perf_event.h>
+#include <errno.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 PetscBool PetscLogSyncOn = PETSC_FALSE;
 PetscBool PetscLogMemory = PETSC_FALSE;
+PetscBool PetscLogRoofline = PETSC_FALSE;
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
 PetscBool PetscLogGpuTraffic = PETSC_FALSE;
 #endif
+PetscInt petsc_numHWCounters = 0;
+static char *PetscLogHWCounterNames[PETSC_LOG_MAX_HW_COUNTERS];
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+static int  PetscLogHWCounterFd[PETSC_LOG_MAX_HW_COUNTERS];
+#endif
 
 /*----------------------------------------------- Creation Functions -------------------------------------------------*/
 /* Note: these functions do not have prototypes in a public directory, so they are considered "internal" and not exported. */
@@ -131,6 +143,8 @@ PetscErrorCode PetscEventPerfLogDestroy(PetscEventPerfLog eventLog)
 @*/
 PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
 {
+  int i;
+
   PetscFunctionBegin;
   eventInfo->id            = -1;
   eventInfo->active        = PETSC_TRUE;
@@ -140,6 +154,7 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->flops         = 0.0;
   eventInfo->flops2        = 0.0;
   eventInfo->flopsTmp      = 0.0;
+  eventInfo->bytes         = 0.0;
   eventInfo->time          = 0.0;
   eventInfo->time2         = 0.0;
   eventInfo->timeTmp       = 0.0;
@@ -163,6 +178,7 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  for (i=0; i<PETSC_LOG_MAX_HW_COUNTERS; i++) eventInfo->hwCounters[i] = 0.0;
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventInfo->CpuToGpuCount = 0.0;
   eventInfo->GpuToCpuCount = 0.0;
@@ -654,9 +670,11 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
   PetscTimeSubtract(&eventLog->eventInfo[event].timeTmp);
   eventLog->eventInfo[event].flopsTmp       = 0.0;
   eventLog->eventInfo[event].flopsTmp      -= petsc_TotalFlops;
+  eventLog->eventInfo[event].bytes         -= petsc_TotalBytes;
   eventLog->eventInfo[event].numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventLog->eventInfo[event].messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventLog->eventInfo[event].numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (PetscLogCommMatrix) {ierr = PetscLogCommMatrixEventPush_Internal(event);CHKERRQ(ierr);}
   if (PetscLogMemory) {
     PetscLogDouble usage;
     ierr = PetscMemoryGetCurrentUsage(&usage);CHKERRQ(ierr);
@@ -667,6 +685,13 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
     eventLog->eventInfo[event].mallocIncrease -= usage;
     ierr = PetscMallocPushMaximumUsage((int)event);CHKERRQ(ierr);
   }
+  if (petsc_numHWCounters) {
+    PetscLogDouble counters[PETSC_LOG_MAX_HW_COUNTERS];
+    PetscInt       i;
+
+    ierr = PetscLogReadHWCounters_Internal(counters);CHKERRQ(ierr);
+    for (i=0; i<petsc_numHWCounters; i++) eventLog->eventInfo[event].hwCounters[i] -= counters[i];
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventLog->eventInfo[event].CpuToGpuCount -= petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount -= petsc_gtoc_ct;
@@ -700,9 +725,11 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event,int t,PetscObject o1,
   eventLog->eventInfo[event].flopsTmp      += petsc_TotalFlops;
   eventLog->eventInfo[event].flops         += eventLog->eventInfo[event].flopsTmp;
   eventLog->eventInfo[event].flops2        += eventLog->eventInfo[event].flopsTmp*eventLog->eventInfo[event].flopsTmp;
+  eventLog->eventInfo[event].bytes         += petsc_TotalBytes;
   eventLog->eventInfo[event].numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventLog->eventInfo[event].messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventLog->eventInfo[event].numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (PetscLogCommMatrix) {ierr = PetscLogCommMatrixEventPop_Internal();CHKERRQ(ierr);}
   if (PetscLogMemory) {
     PetscLogDouble usage,musage;
     ierr = PetscMemoryGetCurrentUsage(&usage);CHKERRQ(ierr);
@@ -714,6 +741,13 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event,int t,PetscObject o1,
     ierr = PetscMallocGetMaximumUsage(&usage);CHKERRQ(ierr);
     eventLog->eventInfo[event].mallocIncrease += usage;
   }
+  if (petsc_numHWCounters) {
+    PetscLogDouble counters[PETSC_LOG_MAX_HW_COUNTERS];
+    PetscInt       i;
+
+    ierr = PetscLogReadHWCounters_Internal(counters);CHKERRQ(ierr);
+    for (i=0; i<petsc_numHWCounters; i++) eventLog->eventInfo[event].hwCounters[i] += counters[i];
+  }
   #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) 
   eventLog->eventInfo[event].CpuToGpuCount += petsc_ctog_ct;
   eventLog->eventInfo[event].GpuToCpuCount += petsc_gtoc_ct;
@@ -984,3 +1018,148 @@ PetscErrorCode PetscLogEventSetError(PetscLogEvent event, PetscInt n, PetscLogDo
   eventLog->eventInfo[event].errors[n] = error;
   PetscFunctionReturn(0);
 }
+
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+typedef struct {
+  const char *name;
+  __u32      type;
+  __u64      config;
+} PetscHWCounterType;
+
+#define PetscHWCacheConfig(cache,op,result) ((cache) | ((op) << 8) | ((result) << 16))
+
+/* the names are those of the perf tool */
+static const PetscHWCounterType PetscHWCounterTypes[] = {
+  {"cycles",                  PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+  {"instructions",            PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+  {"cache-references",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+  {"cache-misses",            PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+  {"branch-instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+  {"branch-misses",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+  {"stalled-cycles-frontend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+  {"stalled-cycles-backend",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+  {"ref-cycles",              PERF_TYPE_HARDWARE, PERF_COUNT_HW_REF_CPU_CYCLES},
+  {"L1-dcache-loads",         PERF_TYPE_HW_CACHE, PetscHWCacheConfig(PERF_COUNT_HW_CACHE_L1D,PERF_COUNT_HW_CACHE_OP_READ,PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+  {"L1-dcache-load-misses",   PERF_TYPE_HW_CACHE, PetscHWCacheConfig(PERF_COUNT_HW_CACHE_L1D,PERF_COUNT_HW_CACHE_OP_READ,PERF_COUNT_HW_CACHE_RESULT_MISS)},
+  {"LLC-loads",               PERF_TYPE_HW_CACHE, PetscHWCacheConfig(PERF_COUNT_HW_CACHE_LL,PERF_COUNT_HW_CACHE_OP_READ,PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+  {"LLC-load-misses",         PERF_TYPE_HW_CACHE, PetscHWCacheConfig(PERF_COUNT_HW_CACHE_LL,PERF_COUNT_HW_CACHE_OP_READ,PERF_COUNT_HW_CACHE_RESULT_MISS)},
+  {"LLC-stores",              PERF_TYPE_HW_CACHE, PetscHWCacheConfig(PERF_COUNT_HW_CACHE_LL,PERF_COUNT_HW_CACHE_OP_WRITE,PERF_COUNT_HW_CACHE_RESULT_ACCESS)},
+  {"LLC-store-misses",        PERF_TYPE_HW_CACHE, PetscHWCacheConfig(PERF_COUNT_HW_CACHE_LL,PERF_COUNT_HW_CACHE_OP_WRITE,PERF_COUNT_HW_CACHE_RESULT_MISS)},
+  {"task-clock",              PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+  {"page-faults",             PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+  {"context-switches",        PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+  {"cpu-migrations",          PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS}
+};
+#endif
+
+/*@C
+  PetscLogSetHWCounters - Selects the hardware performance counters that are read at the beginning and end of each event
+  and reported by PetscLogView()
+
+  Not Collective
+
+  Input Parameters:
++ n     - The number of counters, at most PETSC_LOG_MAX_HW_COUNTERS, or 0 to stop reading counters
+- names - The names of the counters, as used by the Linux perf tool, for example cycles, instructions, cache-misses,
+          LLC-load-misses, LLC-store-misses or page-faults
+
+  Options Database Keys:
+. -log_view_hwcounters <name1,name2,...> - Selects the counters during PetscInitialize()
+
+  Notes:
+  The counters are read with the Linux perf_event_open() system call for the calling thread in user mode, so no
+  external library such as PAPI is needed. The kernel must allow it, see /proc/sys/kernel/perf_event_paranoid, and
+  hardware (as opposed to software) counters are usually not available in virtual machines.
+
+  Call this before any event is begun, usually right after PetscInitialize(), since the counter values of the events
+  that are currently running would be wrong.
+
+  The counters are read only by the default event handlers, see PetscLogDefaultBegin().
+
+  Level: intermediate
+
+.seealso: PetscLogGetHWCounters(), PetscLogView(), PetscLogEventGetPerfInfo()
+@*/
+PetscErrorCode PetscLogSetHWCounters(PetscInt n,const char *const names[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  if (n < 0 || n > PETSC_LOG_MAX_HW_COUNTERS) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of hardware counters %D must be in [0, %d]",n,PETSC_LOG_MAX_HW_COUNTERS);
+  if (n) PetscValidPointer(names,2);
+  for (i=0; i<petsc_numHWCounters; i++) {
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+    close(PetscLogHWCounterFd[i]);
+#endif
+    ierr = PetscFree(PetscLogHWCounterNames[i]);CHKERRQ(ierr);
+  }
+  petsc_numHWCounters = 0;
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (i=0; i<n; i++) {
+    struct perf_event_attr attr;
+    size_t                 t,ntypes = sizeof(PetscHWCounterTypes)/sizeof(PetscHWCounterTypes[0]);
+    PetscBool              match = PETSC_FALSE;
+    int                    fd;
+
+    for (t=0; t<ntypes; t++) {
+      ierr = PetscStrcasecmp(names[i],PetscHWCounterTypes[t].name,&match);CHKERRQ(ierr);
+      if (match) break;
+    }
+    if (!match) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_UNKNOWN_TYPE,"Unknown hardware counter %s",names[i]);
+    ierr = PetscMemzero(&attr,sizeof(attr));CHKERRQ(ierr);
+    attr.size           = sizeof(attr);
+    attr.type           = PetscHWCounterTypes[t].type;
+    attr.config         = PetscHWCounterTypes[t].config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    fd = (int)syscall(__NR_perf_event_open,&attr,0,-1,-1,0);
+    if (fd < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to open hardware counter %s with perf_event_open(): %s",names[i],strerror(errno));
+    PetscLogHWCounterFd[i] = fd;
+    ierr = PetscStrallocpy(PetscHWCounterTypes[t].name,&PetscLogHWCounterNames[i]);CHKERRQ(ierr);
+    petsc_numHWCounters++;
+  }
+#else
+  if (n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Hardware counters require Linux perf_event_open()");
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogGetHWCounters - Gets the hardware performance counters that are read at the beginning and end of each event
+
+  Not Collective
+
+  Output Parameters:
++ n     - The number of counters
+- names - The names of the counters, in the order of the PetscEventPerfInfo hwCounters entries
+
+  Level: intermediate
+
+.seealso: PetscLogSetHWCounters(), PetscLogEventGetPerfInfo()
+@*/
+PetscErrorCode PetscLogGetHWCounters(PetscInt *n,const char *const **names)
+{
+  PetscFunctionBegin;
+  if (n)     *n     = petsc_numHWCounters;
+  if (names) *names = (const char *const *)PetscLogHWCounterNames;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogReadHWCounters_Internal(PetscLogDouble counters[])
+{
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  PetscInt i;
+  __u64    value;
+
+  PetscFunctionBegin;
+  for (i=0; i<petsc_numHWCounters; i++) {
+    if (read(PetscLogHWCounterFd[i],&value,sizeof(value)) != sizeof(value)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to read hardware counter %s",PetscLogHWCounterNames[i]);
+    counters[i] = (PetscLogDouble)value;
+  }
+  PetscFunctionReturn(0);
+#else
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+#endif
+}
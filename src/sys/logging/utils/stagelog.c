@@ -261,6 +261,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
     if (stageLog->stageInfo[curStage].perfInfo.active) {
       PetscTimeAdd(&stageLog->stageInfo[curStage].perfInfo.time);
       stageLog->stageInfo[curStage].perfInfo.flops         += petsc_TotalFlops;
+      stageLog->stageInfo[curStage].perfInfo.bytes         += petsc_TotalBytes;
       stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
@@ -276,6 +277,7 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
   if (stageLog->stageInfo[stage].perfInfo.active) {
     PetscTimeSubtract(&stageLog->stageInfo[stage].perfInfo.time);
     stageLog->stageInfo[stage].perfInfo.flops         -= petsc_TotalFlops;
+    stageLog->stageInfo[stage].perfInfo.bytes         -= petsc_TotalBytes;
     stageLog->stageInfo[stage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[stage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[stage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
@@ -325,6 +327,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
   if (stageLog->stageInfo[curStage].perfInfo.active) {
     PetscTimeAdd(&stageLog->stageInfo[curStage].perfInfo.time);
     stageLog->stageInfo[curStage].perfInfo.flops         += petsc_TotalFlops;
+    stageLog->stageInfo[curStage].perfInfo.bytes         += petsc_TotalBytes;
     stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
@@ -336,6 +339,7 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
     if (stageLog->stageInfo[curStage].perfInfo.active) {
       PetscTimeSubtract(&stageLog->stageInfo[curStage].perfInfo.time);
       stageLog->stageInfo[curStage].perfInfo.flops         -= petsc_TotalFlops;
+      stageLog->stageInfo[curStage].perfInfo.bytes         -= petsc_TotalBytes;
       stageLog->stageInfo[curStage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
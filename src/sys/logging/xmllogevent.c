@@ -101,6 +101,7 @@ static PetscLogDouble   thresholdTime          = 0.01; /* initial value was 0.1
 static PetscErrorCode PetscLogEventBeginNested(NestedEventId nstEvent, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4);
 static PetscErrorCode PetscLogEventEndNested(NestedEventId nstEvent, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4);
 PETSC_INTERN PetscErrorCode PetscLogView_Nested(PetscViewer);
+PETSC_INTERN PetscErrorCode PetscLogView_Flamegraph(PetscViewer);
 
 
 /*@C
@@ -110,7 +111,8 @@ PETSC_INTERN PetscErrorCode PetscLogView_Nested(PetscViewer);
   Logically Collective over PETSC_COMM_WORLD
 
   Options Database Keys:
-. -log_view :filename.xml:ascii_xml - Prints an XML summary of flop and timing information to the file
++ -log_view :filename.xml:ascii_xml - Prints an XML summary of flop and timing information to the file
+- -log_view :filename.txt:ascii_flamegraph - Prints the time of each nested calling path as folded stacks for flame graphs to the file
 
   Usage:
 .vb
@@ -1397,6 +1399,97 @@ PetscErrorCode PetscLogView_Nested(PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+/*
+ * Print the nested timer tree as folded stacks, the input format of flame graph tools:
+ * one line per calling path, with the time in microseconds spent in the last timer of the path
+ * but not in the timers nested inside it,
+ *
+ *     Main Stage;SNESSolve;KSPSolve;PCApply;MatMult 1234
+ *
+ * The root frame collects the time spent outside of all timers. With -log_view_flamegraph_reduction
+ * none (the default) each process prints its own stacks, prefixed with its rank; with max or mean the
+ * first process prints the maximum or mean of the self times over all processes.
+ */
+PetscErrorCode PetscLogView_Flamegraph(PetscViewer viewer)
+{
+  PetscErrorCode       ierr;
+  const char           *reductions[] = {"none","max","mean"};
+  PetscInt             reduction = 0;
+  PetscLogDouble       locTotalTime, *incl, *self, *red;
+  PetscNestedEventTree *tree = NULL;
+  PetscStageLog        stageLog;
+  PetscEventRegInfo    *eventRegInfo;
+  PetscEventPerfInfo   *eventPerfInfo;
+  const char           *root;
+  char                 line[4096];
+  int                  nTimers = 0, i, j, k;
+  PetscMPIInt          rank, size;
+  MPI_Comm             comm;
+
+  PetscFunctionBegin;
+  if (!nestedEvents) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call PetscLogNestedBegin() or use -log_view :filename:ascii_flamegraph to view the log as a flame graph");
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetEList(NULL,NULL,"-log_view_flamegraph_reduction",reductions,3,&reduction,NULL);CHKERRQ(ierr);
+
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  eventRegInfo  = stageLog->eventLog->eventInfo;
+  eventPerfInfo = stageLog->stageInfo[MAINSTAGE].eventLog->eventInfo;
+  root          = stageLog->stageInfo[MAINSTAGE].name;
+  ierr = PetscTime(&locTotalTime);CHKERRQ(ierr);  locTotalTime -= petsc_BaseTime;
+
+  /* Collect nested timer tree info from all processes; the tree is the same on every process */
+  ierr = PetscLogNestedTreeCreate(viewer, &tree, &nTimers);CHKERRQ(ierr);
+
+  /* Self time of each path is its inclusive time minus that of its children; entry nTimers is the root */
+  ierr = PetscMalloc3(nTimers+1,&incl,nTimers+1,&self,nTimers+1,&red);CHKERRQ(ierr);
+  for (i=0; i<nTimers; i++) incl[i] = tree[i].own ? eventPerfInfo[tree[i].dftEvent].time : 0.0;
+  incl[nTimers] = locTotalTime;
+  for (i=0; i<=nTimers; i++) self[i] = incl[i];
+  for (i=0; i<nTimers; i++) {
+    if (tree[i].depth == 1) self[nTimers] -= incl[i];
+    for (j=i+1; j<nTimers && tree[j].depth > tree[i].depth; j++) {
+      if (tree[j].depth == tree[i].depth + 1) self[i] -= incl[j];
+    }
+  }
+  for (i=0; i<=nTimers; i++) self[i] = PetscMax(self[i],0.0)*1.e6;
+
+  if (reduction) {
+    ierr = MPIU_Allreduce(self, red, nTimers+1, MPIU_PETSCLOGDOUBLE, reduction == 1 ? MPI_MAX : MPI_SUM, comm);CHKERRQ(ierr);
+    if (reduction == 2) for (i=0; i<=nTimers; i++) red[i] /= size;
+  } else {
+    ierr = PetscArraycpy(red,self,nTimers+1);CHKERRQ(ierr);
+  }
+
+  if (!reduction) {ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);}
+  for (i=0; i<=nTimers; i++) {
+    if (red[i] < 0.5) continue;
+    line[0] = 0;
+    if (!reduction) {ierr = PetscSNPrintf(line,sizeof(line),"rank %d;",rank);CHKERRQ(ierr);}
+    ierr = PetscStrlcat(line,root,sizeof(line));CHKERRQ(ierr);
+    if (i < nTimers) {
+      for (k=0; k<tree[i].depth; k++) {
+        ierr = PetscStrlcat(line,";",sizeof(line));CHKERRQ(ierr);
+        ierr = PetscStrlcat(line,eventRegInfo[(PetscLogEvent)tree[i].nstPath[k]].name,sizeof(line));CHKERRQ(ierr);
+      }
+    }
+    if (reduction) {
+      ierr = PetscViewerASCIIPrintf(viewer,"%s %.0f\n",line,red[i]);CHKERRQ(ierr);
+    } else {
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"%s %.0f\n",line,red[i]);CHKERRQ(ierr);
+    }
+  }
+  if (!reduction) {
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree3(incl,self,red);CHKERRQ(ierr);
+  ierr = PetscLogNestedTreeDestroy(tree, nTimers);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_EXTERN PetscErrorCode PetscASend(int count, int datatype)
 {
 #if !defined(MPIUNI_H) && !defined(PETSC_HAVE_BROKEN_RECURSIVE_MACRO) && !defined(PETSC_HAVE_MPI_MISSING_TYPESIZE)
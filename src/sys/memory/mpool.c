@@ -0,0 +1,307 @@
+/*
+    A pooled allocator that can be selected with PetscMallocSet() or -malloc_pool.
+
+    Requests up to POOL_MAXSIZE bytes are rounded up to a power of two size class. Each size class carves its
+    blocks from its own chunks and recycles freed blocks through a free list, so the many small allocations made
+    when objects are created and destroyed do not go to the system malloc(). Larger requests go to PetscMallocAlign().
+
+    A scoped arena, opened with PetscMallocArenaPush(), has its own chunks and free lists; everything allocated
+    while it is open is released in one step by PetscMallocArenaPop().
+*/
+#include <petscsys.h>             /*I   "petscsys.h"   I*/
+
+/*
+   These are defined in mal.c and ensure that malloced space is PetscScalar aligned
+*/
+PETSC_EXTERN PetscErrorCode PetscMallocAlign(size_t,PetscBool,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscFreeAlign(void*,int,const char[],const char[]);
+PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t,int,const char[],const char[],void**);
+
+/*
+   These are defined in mtr.c and let the tracing malloc of -malloc_debug obtain its blocks from the pool
+*/
+PETSC_INTERN PetscErrorCode PetscTrSetBase_Private(PetscErrorCode (*)(size_t,PetscBool,int,const char[],const char[],void**),PetscErrorCode (*)(void*,int,const char[],const char[]),PetscErrorCode (*)(size_t,int,const char[],const char[],void**));
+PETSC_INTERN PetscErrorCode PetscTrForget_Private(void*);
+PETSC_INTERN PetscBool      petscsetmallocvisited;
+
+#define POOL_NCLASSES  9                                        /* number of size classes */
+#define POOL_MINSIZE   (PETSC_MEMALIGN > 16 ? PETSC_MEMALIGN : 16) /* size of the smallest class, a multiple of PETSC_MEMALIGN */
+#define POOL_MAXSIZE   ((size_t)POOL_MINSIZE << (POOL_NCLASSES-1))
+#define POOL_CHUNKSIZE 65536                                    /* bytes requested at a time for a size class */
+
+typedef struct _n_PoolArena *PoolArena;
+
+/*  this is the header put at the beginning of each block handed out by the pool */
+typedef struct _PoolBlock {
+  PoolArena         arena;        /* arena the block was obtained from */
+  struct _PoolBlock *prev,*next;  /* free list of the size class, or live blocks of a scoped arena */
+  size_t            size;         /* usable bytes in the block */
+  int               sclass;       /* size class, -1 for blocks too large to be pooled */
+} PoolBlock;
+
+/* POOL_HEADER is sizeof(PoolBlock) padded to be a multiple of PETSC_MEMALIGN, and POOL_CHUNKHEADER the space for the chunk link */
+#define POOL_HEADER      ((sizeof(PoolBlock)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+#define POOL_CHUNKHEADER ((sizeof(void*)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+
+struct _n_PoolArena {
+  PoolArena previous;                 /* enclosing scoped arena, NULL for the outermost */
+  PetscBool scoped;                   /* released all at once by PetscMallocArenaPop() */
+  void      *chunks;                  /* chunks of all the size classes, linked through their first word */
+  char      *cur[POOL_NCLASSES];      /* unused part of the current chunk of each size class */
+  char      *end[POOL_NCLASSES];
+  PoolBlock *freed[POOL_NCLASSES];    /* freed blocks of each size class */
+  PoolBlock *live;                    /* blocks in use, only tracked for scoped arenas */
+};
+
+static struct _n_PoolArena poolglobal;            /* arena used when no scoped arena is open */
+static PoolArena           poolcurrent = NULL;    /* innermost open scoped arena */
+static PetscBool           pooltraced  = PETSC_FALSE; /* the pool lies underneath the tracing malloc of -malloc_debug */
+
+/*@C
+   PetscMallocPool - Pooled malloc.
+
+   Input Parameters:
++   mem - number of bytes to allocate
+.   clear - zero the space
+.   line - line number where used
+.   func - function calling routine
+-   file  - file name where used
+
+   Output Parameter:
+.   result - PETSC_MEMALIGN aligned pointer to requested storage
+
+   Level: developer
+
+   Notes:
+   Use PetscMallocSet(PetscMallocPool,PetscFreePool,PetscReallocPool) or -malloc_pool to use the pooled allocator.
+
+.seealso: PetscFreePool(), PetscReallocPool(), PetscMallocArenaPush(), PetscMallocSet()
+@*/
+PetscErrorCode PetscMallocPool(size_t mem,PetscBool clear,int line,const char func[],const char file[],void **result)
+{
+  PoolArena      arena = poolcurrent ? poolcurrent : &poolglobal;
+  PoolBlock      *b;
+  int            c;
+  PetscErrorCode ierr;
+
+  if (!mem) {*result = NULL; return 0;}
+  for (c=0; c<POOL_NCLASSES && ((size_t)POOL_MINSIZE << c) < mem; c++) ;
+  if (c == POOL_NCLASSES) {
+    ierr = PetscMallocAlign(POOL_HEADER+mem,PETSC_FALSE,line,func,file,(void**)&b);if (ierr) return ierr;
+    b->size   = mem;
+    b->sclass = -1;
+  } else if (arena->freed[c]) {
+    b               = arena->freed[c];
+    arena->freed[c] = b->next;
+  } else {
+    size_t stride = POOL_HEADER + ((size_t)POOL_MINSIZE << c);
+
+    if ((size_t)(arena->end[c] - arena->cur[c]) < stride) {
+      size_t len = POOL_CHUNKHEADER + PetscMax(POOL_CHUNKSIZE/stride,1)*stride;
+      char   *chunk;
+
+      ierr = PetscMallocAlign(len,PETSC_FALSE,line,func,file,(void**)&chunk);if (ierr) return ierr;
+      *(void**)chunk = arena->chunks;
+      arena->chunks  = chunk;
+      arena->cur[c]  = chunk + POOL_CHUNKHEADER;
+      arena->end[c]  = chunk + len;
+    }
+    b              = (PoolBlock*)arena->cur[c];
+    arena->cur[c] += stride;
+    b->size        = (size_t)POOL_MINSIZE << c;
+    b->sclass      = c;
+  }
+  b->arena = arena;
+  if (arena->scoped) {
+    b->prev = NULL;
+    b->next = arena->live;
+    if (arena->live) arena->live->prev = b;
+    arena->live = b;
+  }
+  *result = (void*)((char*)b + POOL_HEADER);
+  if (clear || PetscLogMemory) {ierr = PetscMemzero(*result,mem);if (ierr) return ierr;}
+  return 0;
+}
+
+/*@C
+   PetscFreePool - Pooled free.
+
+   Input Parameters:
++   ptr - block obtained from PetscMallocPool()
+.   line - line number where used
+.   func - function calling routine
+-   file  - file name where used
+
+   Level: developer
+
+.seealso: PetscMallocPool(), PetscReallocPool()
+@*/
+PetscErrorCode PetscFreePool(void *ptr,int line,const char func[],const char file[])
+{
+  PoolBlock *b;
+  PoolArena arena;
+
+  if (!ptr) return 0;
+  b     = (PoolBlock*)((char*)ptr - POOL_HEADER);
+  arena = b->arena;
+  if (!arena || b->sclass < -1 || b->sclass >= POOL_NCLASSES) return PetscError(PETSC_COMM_SELF,line,func,file,PETSC_ERR_PLIB,PETSC_ERROR_INITIAL,"Likely memory corruption in heap");
+  if (arena->scoped) {
+    if (b->prev) b->prev->next = b->next;
+    else arena->live = b->next;
+    if (b->next) b->next->prev = b->prev;
+  }
+  if (b->sclass < 0) return PetscFreeAlign(b,line,func,file);
+  b->next                 = arena->freed[b->sclass];
+  arena->freed[b->sclass] = b;
+  return 0;
+}
+
+/*@C
+   PetscReallocPool - Pooled realloc.
+
+   Input Parameters:
++   mem - number of bytes to allocate
+.   line - line number where used
+.   func - function calling routine
+.   file  - file name where used
+-   result - block obtained from PetscMallocPool(), or NULL
+
+   Output Parameter:
+.   result - PETSC_MEMALIGN aligned pointer to requested storage
+
+   Level: developer
+
+   Notes:
+   The block is kept when it is already large enough, otherwise it is moved into the innermost open arena.
+
+.seealso: PetscMallocPool(), PetscFreePool()
+@*/
+PetscErrorCode PetscReallocPool(size_t mem,int line,const char func[],const char file[],void **result)
+{
+  PoolBlock      *b;
+  void           *newresult;
+  PetscErrorCode ierr;
+
+  if (!mem) {
+    ierr = PetscFreePool(*result,line,func,file);if (ierr) return ierr;
+    *result = NULL;
+    return 0;
+  }
+  if (!*result) return PetscMallocPool(mem,PETSC_FALSE,line,func,file,result);
+  b = (PoolBlock*)((char*)*result - POOL_HEADER);
+  if (mem <= b->size) return 0;
+  ierr = PetscMallocPool(mem,PETSC_FALSE,line,func,file,&newresult);if (ierr) return ierr;
+  ierr = PetscMemcpy(newresult,*result,b->size);if (ierr) return ierr;
+  ierr = PetscFreePool(*result,line,func,file);if (ierr) return ierr;
+  *result = newresult;
+  return 0;
+}
+
+/* Releases all the memory of an arena, including the blocks still in use */
+static PetscErrorCode PetscMallocArenaRelease_Private(PoolArena arena)
+{
+  PoolBlock      *b,*next;
+  void           *chunk,*nextchunk;
+  PetscErrorCode ierr;
+
+  for (b=arena->live; b; b=next) {
+    next = b->next;
+    if (pooltraced) {ierr = PetscTrForget_Private((char*)b + POOL_HEADER);if (ierr) return ierr;}
+    if (b->sclass < 0) {ierr = PetscFreeAlign(b,__LINE__,PETSC_FUNCTION_NAME,__FILE__);if (ierr) return ierr;}
+  }
+  for (chunk=arena->chunks; chunk; chunk=nextchunk) {
+    nextchunk = *(void**)chunk;
+    ierr = PetscFreeAlign(chunk,__LINE__,PETSC_FUNCTION_NAME,__FILE__);if (ierr) return ierr;
+  }
+  return 0;
+}
+
+/*@C
+   PetscMallocArenaPush - Opens a scoped arena; the memory allocated until the matching PetscMallocArenaPop() is taken from it
+
+   Not Collective
+
+   Level: developer
+
+   Notes:
+   Requires the pooled allocator, selected with -malloc_pool or PetscMallocSet(PetscMallocPool,PetscFreePool,PetscReallocPool).
+
+   Memory allocated in the arena may be freed with PetscFree() as usual, its space is then reused by later allocations
+   in the arena. Whatever is left is released by PetscMallocArenaPop(), so the pointers obtained while the arena
+   was open must not be used, nor freed, afterwards. Arenas may be nested.
+
+.seealso: PetscMallocArenaPop(), PetscMallocPool()
+@*/
+PetscErrorCode PetscMallocArenaPush(void)
+{
+  PoolArena      arena;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscTrMalloc != PetscMallocPool && !pooltraced) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Scoped arenas require the pooled allocator, run with -malloc_pool");
+  ierr = PetscMallocAlign(sizeof(struct _n_PoolArena),PETSC_TRUE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(void**)&arena);CHKERRQ(ierr);
+  arena->previous = poolcurrent;
+  arena->scoped   = PETSC_TRUE;
+  poolcurrent     = arena;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaPop - Closes the scoped arena opened by the last PetscMallocArenaPush(), releasing all the memory allocated in it
+
+   Not Collective
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocPool()
+@*/
+PetscErrorCode PetscMallocArenaPop(void)
+{
+  PoolArena      arena = poolcurrent;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!arena) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"No open arena, PetscMallocArenaPop() called more times than PetscMallocArenaPush()");
+  ierr = PetscMallocArenaRelease_Private(arena);CHKERRQ(ierr);
+  poolcurrent = arena->previous;
+  ierr = PetscFreeAlign(arena,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Selects the pooled allocator for -malloc_pool; if the tracing malloc is in use the pool is placed underneath it,
+   if another malloc has been set with PetscMallocSet() the option is ignored
+*/
+PETSC_INTERN PetscErrorCode PetscSetUsePoolMalloc_Private(void)
+{
+  PetscBool      basic;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocGetDebug(&basic,NULL,NULL);CHKERRQ(ierr);
+  if (basic) {
+    ierr       = PetscTrSetBase_Private(PetscMallocPool,PetscFreePool,PetscReallocPool);CHKERRQ(ierr);
+    pooltraced = PETSC_TRUE;
+  } else if (!petscsetmallocvisited) {
+    ierr = PetscMallocSet(PetscMallocPool,PetscFreePool,PetscReallocPool);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Releases all the memory held by the pool, called at the end of PetscFinalize()
+*/
+PETSC_INTERN PetscErrorCode PetscMallocPoolFinalize_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  while (poolcurrent) {ierr = PetscMallocArenaPop();CHKERRQ(ierr);}
+  ierr = PetscMallocArenaRelease_Private(&poolglobal);CHKERRQ(ierr);
+  ierr = PetscMemzero(&poolglobal,sizeof(poolglobal));CHKERRQ(ierr);
+  if (pooltraced) {
+    ierr       = PetscTrSetBase_Private(PetscMallocAlign,PetscFreeAlign,PetscReallocAlign);CHKERRQ(ierr);
+    pooltraced = PETSC_FALSE;
+  }
+  PetscFunctionReturn(0);
+}
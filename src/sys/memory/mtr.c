@@ -4,6 +4,7 @@
 */
 #include <petscsys.h>           /*I "petscsys.h" I*/
 #include <petscviewer.h>
+#include <petsc/private/hashtable.h>
 #if defined(PETSC_HAVE_MALLOC_H)
 #include <malloc.h>
 #endif
@@ -29,6 +30,7 @@ typedef struct _trSPACE {
 #if defined(PETSC_USE_DEBUG)
   PetscStack      stack;
 #endif
+  struct _trPROFILE *profile;
   struct _trSPACE *next,*prev;
 } TRSPACE;
 
@@ -65,6 +67,153 @@ static size_t     PetscLogMallocThreshold = 0;
 static size_t     *PetscLogMallocLength;
 static const char **PetscLogMallocFile,**PetscLogMallocFunction;
 
+/*
+     Heap profile for PetscMallocProfileDump(): the allocations are aggregated by the call stack they were made from.
+     The bytes of each stack at the maximum of TRallocated are kept lazily: TRpeakepoch is increased at each new
+     maximum and a stack whose epoch is older has not changed since, so its bytes at the maximum are its current bytes.
+*/
+typedef struct _trPROFILE {
+  int         n;              /* number of frames, the last one is where PetscMalloc() was called */
+  const char  **function;
+  int         *line;
+  size_t      live;           /* bytes currently allocated from this stack */
+  size_t      peak;           /* bytes allocated from this stack at the last maximum of TRallocated, valid if epoch is TRpeakepoch */
+  int         epoch;
+} TRPROFILE;
+
+PETSC_STATIC_INLINE khint_t TRProfileHash(const TRPROFILE *p)
+{
+  khint_t h = (khint_t)p->n;
+  int     i;
+  for (i=0; i<p->n; i++) h = 31*(31*h + (khint_t)(PETSC_UINTPTR_T)p->function[i]) + (khint_t)p->line[i];
+  return h;
+}
+
+PETSC_STATIC_INLINE int TRProfileEqual(const TRPROFILE *a,const TRPROFILE *b)
+{
+  int i;
+  if (a->n != b->n) return 0;
+  for (i=0; i<a->n; i++) if (a->function[i] != b->function[i] || a->line[i] != b->line[i]) return 0;
+  return 1;
+}
+
+KHASH_INIT(TRP, const TRPROFILE*, char, 0, TRProfileHash, TRProfileEqual)
+
+#define MAXTRPROFILESTAGES 16
+static khash_t(TRP) *TRprofile    = NULL;  /* the stacks, NULL when the heap is not profiled */
+static int          TRpeakepoch   = 0;
+static char         TRprofileprefix[PETSC_MAX_PATH_LEN];
+static int          TRprofileNstages = 0;
+static char         *TRprofilestages[MAXTRPROFILESTAGES];
+static int          TRprofilestagecount[MAXTRPROFILESTAGES];
+
+PETSC_STATIC_INLINE void TRProfileTouch(TRPROFILE *p)
+{
+  if (p->epoch != TRpeakepoch) {
+    p->peak  = p->live;
+    p->epoch = TRpeakepoch;
+  }
+}
+
+/*
+   Adds a block to the stack it is allocated from. Uses malloc() since it is called from within PetscTrMallocDefault()
+*/
+static PetscErrorCode PetscTrProfileAdd(TRSPACE *head,int lineno,const char function[])
+{
+  const char *fnames[PETSCSTACKSIZE+1];
+  int        lines[PETSCSTACKSIZE+1],n = 0,ret;
+  TRPROFILE  key,*p;
+  khiter_t   it;
+
+  head->profile = NULL;
+  if (!TRprofile) return 0;
+#if defined(PETSC_USE_DEBUG)
+  if (PetscStackActive()) {
+    int i;
+    for (i=0; i<petscstack->currentsize; i++) {
+      const char *f = petscstack->function[i];
+      /* the allocation routines themselves are not part of the stack */
+      if (!strcmp(f,"PetscMallocA") || !strcmp(f,"PetscTrMallocDefault") || !strcmp(f,"PetscTrReallocDefault")) continue;
+      fnames[n]  = f;
+      lines[n++] = petscstack->line[i];
+    }
+  }
+#endif
+  if (n && !strcmp(fnames[n-1],function)) lines[n-1] = lineno;
+  else {fnames[n] = function; lines[n++] = lineno;}
+
+  key.n        = n;
+  key.function = fnames;
+  key.line     = lines;
+  it = kh_get(TRP,TRprofile,&key);
+  if (it != kh_end(TRprofile)) p = (TRPROFILE*)kh_key(TRprofile,it);
+  else {
+    p = (TRPROFILE*)calloc(1,sizeof(TRPROFILE));
+    if (!p) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Out of memory");
+    p->function = (const char**)malloc(n*sizeof(char*));
+    p->line     = (int*)malloc(n*sizeof(int));
+    if (!p->function || !p->line) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Out of memory");
+    memcpy(p->function,fnames,n*sizeof(char*));
+    memcpy(p->line,lines,n*sizeof(int));
+    p->n     = n;
+    p->epoch = TRpeakepoch;
+    kh_put(TRP,TRprofile,p,&ret);
+    if (ret < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Hash table allocation failed");
+  }
+  TRProfileTouch(p);
+  p->live      += head->size;
+  head->profile = p;
+  return 0;
+}
+
+PETSC_STATIC_INLINE void PetscTrProfileRemove(TRSPACE *head)
+{
+  TRPROFILE *p = head->profile;
+
+  if (!p) return;
+  TRProfileTouch(p);
+  p->live -= head->size;
+}
+
+/*
+     The allocator the traced blocks (with their header and trailing classid) are obtained from
+*/
+static PetscErrorCode (*PetscTrMallocBase)(size_t,PetscBool,int,const char[],const char[],void**) = PetscMallocAlign;
+static PetscErrorCode (*PetscTrFreeBase)(void*,int,const char[],const char[])                     = PetscFreeAlign;
+static PetscErrorCode (*PetscTrReallocBase)(size_t,int,const char[],const char[],void**)          = PetscReallocAlign;
+
+/*
+   PetscTrSetBase_Private - Sets the allocator underneath the tracing malloc, used by the pool allocator in mpool.c
+*/
+PETSC_INTERN PetscErrorCode PetscTrSetBase_Private(PetscErrorCode (*imalloc)(size_t,PetscBool,int,const char[],const char[],void**),
+                                                   PetscErrorCode (*ifree)(void*,int,const char[],const char[]),
+                                                   PetscErrorCode (*irealloc)(size_t,int,const char[],const char[],void**))
+{
+  PetscTrMallocBase  = imalloc;
+  PetscTrFreeBase    = ifree;
+  PetscTrReallocBase = irealloc;
+  return 0;
+}
+
+/*
+   PetscTrForget_Private - Removes from the list of allocated blocks a block obtained from the underlying allocator,
+   when the underlying allocator releases it itself, as the pool allocator does when a scoped arena is popped
+*/
+PETSC_INTERN PetscErrorCode PetscTrForget_Private(void *a)
+{
+  TRSPACE *head = (TRSPACE*)a;
+
+  if (head->classid != CLASSID_VALUE) return 0;
+  PetscTrProfileRemove(head);
+  TRallocated -= head->size;
+  TRfrags--;
+  if (head->prev) head->prev->next = head->next;
+  else TRhead = head->next;
+  if (head->next) head->next->prev = head->prev;
+  head->classid = ALREADY_FREED;
+  return 0;
+}
+
 /*@C
    PetscMallocValidate - Test the memory for corruption.  This can be called at any time between PetscInitialize() and PetscFinalize()
 
@@ -161,7 +310,7 @@ PetscErrorCode  PetscTrMallocDefault(size_t a,PetscBool clear,int lineno,const c
   ierr = PetscMallocValidate(lineno,function,filename); if (ierr) PetscFunctionReturn(ierr);
 
   nsize = (a + (PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1);
-  ierr  = PetscMallocAlign(nsize+sizeof(TrSPACE)+sizeof(PetscClassId),clear,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+  ierr  = (*PetscTrMallocBase)(nsize+sizeof(TrSPACE)+sizeof(PetscClassId),clear,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
 
   head  = (TRSPACE*)inew;
   inew += sizeof(TrSPACE);
@@ -178,9 +327,10 @@ PetscErrorCode  PetscTrMallocDefault(size_t a,PetscBool clear,int lineno,const c
   head->functionname             = function;
   head->classid                  = CLASSID_VALUE;
   *(PetscClassId*)(inew + nsize) = CLASSID_VALUE;
+  ierr = PetscTrProfileAdd(head,lineno,function);CHKERRQ(ierr);
 
   TRallocated += nsize;
-  if (TRallocated > TRMaxMem) TRMaxMem = TRallocated;
+  if (TRallocated > TRMaxMem) {TRMaxMem = TRallocated; TRpeakepoch++;}
   if (PetscLogMemory) {
     PetscInt i;
     for (i=0; i<NumTRMaxMems; i++) {
@@ -298,13 +448,14 @@ PetscErrorCode  PetscTrFreeDefault(void *aa,int line,const char function[],const
     head->lineno = -head->lineno;
   }
   if (TRallocated < head->size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEMC,"TRallocate is smaller than memory just freed");
+  PetscTrProfileRemove(head);
   TRallocated -= head->size;
   TRfrags--;
   if (head->prev) head->prev->next = head->next;
   else TRhead = head->next;
 
   if (head->next) head->next->prev = head->prev;
-  ierr = PetscFreeAlign(a,line,function,file);CHKERRQ(ierr);
+  ierr = (*PetscTrFreeBase)(a,line,function,file);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -379,6 +530,7 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
   }
 
   /* remove original reference to the memory allocated from the PETSc debugging heap */
+  PetscTrProfileRemove(head);
   TRallocated -= head->size;
   TRfrags--;
   if (head->prev) head->prev->next = head->next;
@@ -386,7 +538,7 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
   if (head->next) head->next->prev = head->prev;
 
   nsize = (len + (PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1);
-  ierr  = PetscReallocAlign(nsize+sizeof(TrSPACE)+sizeof(PetscClassId),lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+  ierr  = (*PetscTrReallocBase)(nsize+sizeof(TrSPACE)+sizeof(PetscClassId),lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
 
   head  = (TRSPACE*)inew;
   inew += sizeof(TrSPACE);
@@ -403,9 +555,10 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
   head->functionname             = function;
   head->classid                  = CLASSID_VALUE;
   *(PetscClassId*)(inew + nsize) = CLASSID_VALUE;
+  ierr = PetscTrProfileAdd(head,lineno,function);CHKERRQ(ierr);
 
   TRallocated += nsize;
-  if (TRallocated > TRMaxMem) TRMaxMem = TRallocated;
+  if (TRallocated > TRMaxMem) {TRMaxMem = TRallocated; TRpeakepoch++;}
   if (PetscLogMemory) {
     PetscInt i;
     for (i=0; i<NumTRMaxMems; i++) {
@@ -858,6 +1011,162 @@ foundit:;
 
 /* ---------------------------------------------------------------------------- */
 
+static PetscErrorCode PetscMallocProfileDestroy_Private(void)
+{
+  khiter_t it;
+  int      i;
+
+  if (!TRprofile) return 0;
+  for (it=kh_begin(TRprofile); it!=kh_end(TRprofile); it++) {
+    TRPROFILE *p;
+    if (!kh_exist(TRprofile,it)) continue;
+    p = (TRPROFILE*)kh_key(TRprofile,it);
+    free(p->function);
+    free(p->line);
+    free(p);
+  }
+  kh_destroy(TRP,TRprofile);
+  TRprofile = NULL;
+  for (i=0; i<TRprofileNstages; i++) free(TRprofilestages[i]);
+  TRprofileNstages = 0;
+  return 0;
+}
+
+/*@C
+    PetscMallocProfileSet - Activates the heap profile, which aggregates the memory allocated with PetscMalloc() by call stack
+
+    Not Collective
+
+    Input Arguments:
++   prefix - prefix of the files written by PetscMallocProfileDump(), or NULL for malloc_profile
+.   nstages - number of stages at the end of which the profile is written
+-   stages - names of these stages
+
+    Options Database Key:
++  -malloc_profile [prefix] - Activates the heap profile and writes it during PetscFinalize()
+-  -malloc_profile_stages <stage1,stage2,...> - Also write it each time one of these stages is popped
+
+    Level: advanced
+
+    Notes: Must be called after PetscMallocSetDebug(). The call stacks are those kept by PetscFunctionBegin, so they are
+    complete only for debugging builds; otherwise each allocation is attributed to the function that calls PetscMalloc().
+
+.seealso: PetscMallocProfileDump(), PetscMallocDump(), PetscMallocView(), PetscLogStagePop()
+@*/
+PetscErrorCode PetscMallocProfileSet(const char prefix[],PetscInt nstages,const char *const stages[])
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscTrMalloc != PetscTrMallocDefault) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"The heap profile requires the tracing malloc, run with -malloc_debug");
+  if (nstages > MAXTRPROFILESTAGES) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of stages %D exceeds the maximum %d",nstages,MAXTRPROFILESTAGES);
+  ierr = PetscMallocProfileDestroy_Private();CHKERRQ(ierr);
+  ierr = PetscStrncpy(TRprofileprefix,prefix && prefix[0] ? prefix : "malloc_profile",sizeof(TRprofileprefix));CHKERRQ(ierr);
+  for (i=0; i<nstages; i++) {
+    size_t len;
+    ierr = PetscStrlen(stages[i],&len);CHKERRQ(ierr);
+    TRprofilestages[i] = (char*)malloc(len+1);
+    if (!TRprofilestages[i]) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Out of memory");
+    ierr = PetscStrcpy(TRprofilestages[i],stages[i]);CHKERRQ(ierr);
+    TRprofilestagecount[i] = 0;
+  }
+  TRprofileNstages = (int)nstages;
+  TRprofile        = kh_init(TRP);
+  if (!TRprofile) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Hash table allocation failed");
+  PetscFunctionReturn(0);
+}
+
+/*@C
+    PetscMallocProfileDump - Writes the heap profile of this process, in the folded stack format read by flamegraph.pl and speedscope
+
+    Not Collective
+
+    Input Parameter:
+.   label - included in the names of the files
+
+    Level: advanced
+
+    Notes:
+    Two files are written by each process: prefix_label_live.rank.folded with the bytes currently allocated from
+    each call stack, and prefix_label_peak.rank.folded with the bytes allocated from each call stack when the total
+    allocated by the process was at its maximum.
+
+    Each line gives the functions of a call stack from the outermost, separated by semicolons, the line where PetscMalloc()
+    was called and the number of bytes.
+
+.seealso: PetscMallocProfileSet(), PetscMallocDump(), PetscMallocGetMaximumUsage()
+@*/
+PetscErrorCode PetscMallocProfileDump(const char label[])
+{
+  const char     *kind[2] = {"live","peak"};
+  char           lbl[PETSC_MAX_PATH_LEN],fname[PETSC_MAX_PATH_LEN];
+  PetscMPIInt    rank;
+  khiter_t       it;
+  FILE           *fp;
+  int            k,i,err;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!TRprofile) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"PetscMallocProfileDump() called without call to PetscMallocProfileSet(), run with -malloc_profile");
+  ierr = MPI_Comm_rank(MPI_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscStrncpy(lbl,label,sizeof(lbl));CHKERRQ(ierr);
+  for (i=0; lbl[i]; i++) if (lbl[i] == ' ' || lbl[i] == '/') lbl[i] = '_';
+  for (k=0; k<2; k++) {
+    ierr = PetscSNPrintf(fname,sizeof(fname),"%s_%s_%s.%d.folded",TRprofileprefix,lbl,kind[k],rank);CHKERRQ(ierr);
+    fp   = fopen(fname,"w");
+    if (!fp) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Cannot open heap profile file: %s",fname);
+    for (it=kh_begin(TRprofile); it!=kh_end(TRprofile); it++) {
+      const TRPROFILE *p;
+      size_t          bytes;
+
+      if (!kh_exist(TRprofile,it)) continue;
+      p     = kh_key(TRprofile,it);
+      bytes = (k && p->epoch == TRpeakepoch) ? p->peak : p->live;
+      if (!bytes) continue;
+      for (i=0; i<p->n-1; i++) fprintf(fp,"%s;",p->function[i]);
+      fprintf(fp,"%s:%d %.0f\n",p->function[p->n-1],p->line[p->n-1],(PetscLogDouble)bytes);
+    }
+    err = fclose(fp);
+    if (err) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"fclose() failed on file");
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscMallocProfileStagePop_Private - Called by PetscLogStagePop() before the stage is popped, writes the heap profile if the stage was given to PetscMallocProfileSet()
+*/
+PETSC_INTERN PetscErrorCode PetscMallocProfileStagePop_Private(const char stage[])
+{
+  char           label[PETSC_MAX_PATH_LEN];
+  PetscBool      match;
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<TRprofileNstages; i++) {
+    ierr = PetscStrcmp(TRprofilestages[i],stage,&match);CHKERRQ(ierr);
+    if (!match) continue;
+    ierr = PetscSNPrintf(label,sizeof(label),"%s_%d",stage,TRprofilestagecount[i]++);CHKERRQ(ierr);
+    ierr = PetscMallocProfileDump(label);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscMallocProfileFinalize_Private - Writes the final heap profile and frees it, called in PetscFinalize()
+*/
+PETSC_INTERN PetscErrorCode PetscMallocProfileFinalize_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!TRprofile) PetscFunctionReturn(0);
+  ierr = PetscMallocProfileDump("final");CHKERRQ(ierr);
+  ierr = PetscMallocProfileDestroy_Private();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
     PetscMallocSetDebug - Set's PETSc memory debugging
 
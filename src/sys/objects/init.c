@@ -12,6 +12,7 @@
 #include <petscviewer.h>
 #if defined(PETSC_USE_LOG)
 PETSC_INTERN PetscErrorCode PetscLogInitialize(void);
+PETSC_INTERN PetscLogDouble petsc_MemoryBandwidth;
 #endif
 
 #if defined(PETSC_HAVE_SYS_SYSINFO_H)
@@ -309,6 +310,7 @@ PetscErrorCode  PetscEnd(void)
 
 PetscBool PetscOptionsPublish = PETSC_FALSE;
 PETSC_INTERN PetscErrorCode PetscSetUseHBWMalloc_Private(void);
+PETSC_INTERN PetscErrorCode PetscSetUsePoolMalloc_Private(void);
 PETSC_INTERN PetscBool      petscsetmallocvisited;
 static       char           emacsmachinename[256];
 
@@ -378,7 +380,7 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     /*
       Setup the memory management; support for tracing malloc() usage
     */
-    PetscBool         mdebug = PETSC_FALSE, eachcall = PETSC_FALSE, initializenan = PETSC_FALSE, mlog = PETSC_FALSE;
+    PetscBool         mdebug = PETSC_FALSE, eachcall = PETSC_FALSE, initializenan = PETSC_FALSE, mlog = PETSC_FALSE, mprofile = PETSC_FALSE;
 
 #if defined(PETSC_USE_DEBUG)
     mdebug        = PETSC_TRUE;
@@ -404,6 +406,10 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     if (mlog) {
       mdebug = PETSC_TRUE;
     }
+    ierr = PetscOptionsHasName(NULL,NULL,"-malloc_profile",&mprofile);CHKERRQ(ierr);
+    if (mprofile) {
+      mdebug = PETSC_TRUE;
+    }
     /* the next line is deprecated */
     ierr = PetscOptionsGetBool(NULL,NULL,"-malloc",&mdebug,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_dump",&mdebug,NULL);CHKERRQ(ierr);
@@ -416,6 +422,15 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
       ierr = PetscOptionsGetReal(NULL,NULL,"-malloc_view_threshold",&logthreshold,NULL);CHKERRQ(ierr);
       ierr = PetscMallocViewSet(logthreshold);CHKERRQ(ierr);
     }
+    if (mprofile && mdebug) {
+      char     prefix[PETSC_MAX_PATH_LEN] = "",*stages[16];
+      PetscInt i,nstages = 16;
+
+      ierr = PetscOptionsGetString(NULL,NULL,"-malloc_profile",prefix,sizeof(prefix),NULL);CHKERRQ(ierr);
+      ierr = PetscOptionsGetStringArray(NULL,NULL,"-malloc_profile_stages",stages,&nstages,NULL);CHKERRQ(ierr);
+      ierr = PetscMallocProfileSet(prefix,nstages,(const char *const*)stages);CHKERRQ(ierr);
+      for (i=0; i<nstages; i++) {ierr = PetscFree(stages[i]);CHKERRQ(ierr);}
+    }
 #if defined(PETSC_USE_LOG)
     ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_memory",&PetscLogMemory,NULL);CHKERRQ(ierr);
 #endif
@@ -427,6 +442,9 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_hbw",&flg1,NULL);CHKERRQ(ierr);
   /* ignore this option if malloc is already set */
   if (flg1 && !petscsetmallocvisited) {ierr = PetscSetUseHBWMalloc_Private();CHKERRQ(ierr);}
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_pool",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscSetUsePoolMalloc_Private();CHKERRQ(ierr);}
 
   flg1 = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_info",&flg1,NULL);CHKERRQ(ierr);
@@ -612,6 +630,20 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     }
   }
 #endif
+
+  /*
+      Choose the vector instruction set of the hand written kernels
+  */
+  {
+    PetscSIMDLevel hardware,simd;
+
+    ierr = PetscSIMDGetHardwareLevel(&hardware);CHKERRQ(ierr);
+    simd = hardware;
+    ierr = PetscOptionsGetEnum(NULL,NULL,"-simd_level",PetscSIMDLevels,(PetscEnum*)&simd,&flg1);CHKERRQ(ierr);
+    if (flg1) {ierr = PetscSIMDSetLevel(simd);CHKERRQ(ierr);}
+    ierr = PetscInfo2(NULL,"SIMD level of the hardware %s, of the kernels %s\n",PetscSIMDLevels[hardware],PetscSIMDLevels[simd]);CHKERRQ(ierr);
+  }
+
 #if defined(PETSC_USE_LOG)
   mname[0] = 0;
   ierr = PetscOptionsGetString(NULL,NULL,"-history",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
@@ -652,7 +684,7 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
 
   ierr = PetscOptionsGetViewer(comm,NULL,NULL,"-log_view",NULL,&format,&flg4);CHKERRQ(ierr);
   if (flg4) {
-    if (format == PETSC_VIEWER_ASCII_XML) {
+    if (format == PETSC_VIEWER_ASCII_XML || format == PETSC_VIEWER_ASCII_FLAMEGRAPH) {
       ierr = PetscLogNestedBegin();CHKERRQ(ierr);
     } else {
       ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
@@ -663,6 +695,35 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = PetscOptionsGetReal(NULL,NULL,"-log_threshold",&threshold,&flg1);CHKERRQ(ierr);
     if (flg1) {ierr = PetscLogSetThreshold((PetscLogDouble)threshold,NULL);CHKERRQ(ierr);}
   }
+
+  {
+    char     *names[PETSC_LOG_MAX_HW_COUNTERS];
+    PetscInt i,n = PETSC_LOG_MAX_HW_COUNTERS;
+
+    ierr = PetscOptionsGetStringArray(NULL,NULL,"-log_view_hwcounters",names,&n,&flg1);CHKERRQ(ierr);
+    if (flg1) {
+      ierr = PetscLogSetHWCounters(n,(const char *const*)names);CHKERRQ(ierr);
+      for (i=0; i<n; i++) {ierr = PetscFree(names[i]);CHKERRQ(ierr);}
+    }
+  }
+
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_roofline",&PetscLogRoofline,NULL);CHKERRQ(ierr);
+  if (PetscLogRoofline) {
+    PetscInt n = PETSC_DEFAULT;
+    ierr = PetscOptionsGetInt(NULL,NULL,"-log_view_roofline_size",&n,NULL);CHKERRQ(ierr);
+    ierr = PetscLogMeasureBandwidth(PETSC_COMM_WORLD,n,&petsc_MemoryBandwidth);CHKERRQ(ierr);
+  }
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_comm_matrix",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogCommMatrixBegin();CHKERRQ(ierr);}
+
+  /* after the other handlers, which the timeline calls */
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_timeline",&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscInt size = PETSC_DEFAULT;
+    ierr = PetscOptionsGetInt(NULL,NULL,"-log_timeline_size",&size,NULL);CHKERRQ(ierr);
+    ierr = PetscLogTimelineBegin(size);CHKERRQ(ierr);
+  }
 #endif
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-saws_options",&PetscOptionsPublish,NULL);CHKERRQ(ierr);
@@ -704,7 +765,10 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -malloc no: don't use PETSc error checking malloc (deprecated, use -malloc_debug no)\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_info: prints total memory usage\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_view <optional filename>: keeps log of all memory allocations, displays in PetscFinalize()\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_profile <optional prefix>: writes the memory allocated by each call stack in folded stack format in PetscFinalize()\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_profile_stages <stage1,stage2,...>: also writes it at the end of these stages\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_debug <true or false>: enables or disables extended checking for memory corruption\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_pool: use the pooled allocator, which recycles small blocks through size class free lists\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_view: dump list of options inputted\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left: dump list of unused options\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left no: don't dump list of unused options\n");CHKERRQ(ierr);
@@ -712,10 +776,17 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -shared_tmp: tmp directory is shared by all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -not_shared_tmp: each processor has separate tmp directory\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -memory_view: print memory usage at end of run\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -simd_level <none,avx,avx2,avx512>: widest vector instruction set used by the matrix kernels, defaults to what the processor supports\n");CHKERRQ(ierr);
 #if defined(PETSC_USE_LOG)
     ierr = (*PetscHelpPrintf)(comm," -get_total_flops: total flops over all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_view [:filename:[format]]: logging objects and events\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_trace [filename]: prints trace of all PETSc calls\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_hwcounters <name1,name2,...>: hardware counters read for each event, such as cycles,instructions,LLC-load-misses\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_roofline: measures the memory bandwidth and shows the arithmetic intensity and bandwidth of each event\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_roofline_size <n>: array length of the bandwidth measurement\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_comm_matrix: logs the messages sent by each event to each process and shows them in -log_view\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline [filename]: writes a timeline of events and stages in Chrome Trace Event format\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_timeline_size <n>: number of timeline records kept on each process\n");CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPE)
     ierr = (*PetscHelpPrintf)(comm," -log_mpe: Also create logfile viewable through Jumpshot\n");CHKERRQ(ierr);
 #endif
@@ -59,13 +59,25 @@ PETSC_STATIC_INLINE int PetscOptEqual(const char a[],const char b[])
   return !PetscOptNameCmp(a,b);
 }
 
+/* Case-insensitive check whether name begins with pre */
+PETSC_STATIC_INLINE int PetscOptBeginsWith(const char name[],const char pre[])
+{
+  while (*pre) {
+    if (PetscToLower(*name++) != PetscToLower(*pre++)) return 0;
+  }
+  return 1;
+}
+
 KHASH_INIT(HO, kh_cstr_t, int, 1, PetscOptHash, PetscOptEqual)
 
 /*
-    This table holds all the options set by the user. For simplicity, we use a static size database
+    This table holds all the options set by the user. Each option keeps its slot in the names, values and
+    used arrays while it is set, and order lists the slots sorted by name (ignoring case) so that the
+    position of a name, or of all the names beginning with a prefix, is found with a binary search.
+    The hash table maps each name to its slot for the frequent exact lookups in PetscOptionsFindPair(),
+    so only the entry of the inserted or removed option changes when the database is modified.
 */
 #define MAXOPTNAME 512
-#define MAXOPTIONS 512
 #define MAXALIASES  25
 #define MAXPREFIXES 25
 #define MAXOPTIONSMONITORS 5
@@ -73,9 +85,11 @@ KHASH_INIT(HO, kh_cstr_t, int, 1, PetscOptHash, PetscOptEqual)
 struct  _n_PetscOptions {
   PetscOptions   previous;
   int            N;                    /* number of options */
-  char           *names[MAXOPTIONS];   /* option names */
-  char           *values[MAXOPTIONS];  /* option values */
-  PetscBool      used[MAXOPTIONS];     /* flag option use */
+  int            Nalloc;               /* length of the arrays below */
+  int            *order;               /* slots of the options sorted by name */
+  char           **names;              /* option names */
+  char           **values;             /* option values */
+  PetscBool      *used;                /* flag option use */
 
   /* Hash table */
   khash_t(HO)    *ht;
@@ -102,6 +116,48 @@ struct  _n_PetscOptions {
 
 static PetscOptions defaultoptions = NULL;  /* the options database routines query this object for options */
 
+/*
+    Binary search for a name in the sorted option names. Returns the position in order of the name if it
+    is found, otherwise the position where it should be inserted, which is also the position of the first
+    name that begins with it if there is any.
+*/
+PETSC_STATIC_INLINE int PetscOptionsLocate_Private(PetscOptions options,const char name[],PetscBool *found)
+{
+  int lo = 0,hi = options->N;
+
+  *found = PETSC_FALSE;
+  while (lo < hi) {
+    int mid    = lo + (hi-lo)/2;
+    int result = PetscOptNameCmp(options->names[options->order[mid]],name);
+    if (!result) {*found = PETSC_TRUE; return mid;}
+    if (result < 0) lo = mid+1;
+    else            hi = mid;
+  }
+  return lo;
+}
+
+/*
+    Stores in the hash table, if it has been built, the slot k of the option names[k] after it has been
+    inserted or moved. Uses no PETSc routines since it is called by PetscOptionsSetValue() which may be
+    called before PetscInitialize().
+*/
+static PetscErrorCode PetscOptionsHashUpdate_Private(PetscOptions options,int k)
+{
+  khash_t(HO) *ht = options->ht;
+  khiter_t    it;
+  int         ret;
+
+  if (!ht) return 0;
+  it = kh_put(HO,ht,options->names[k],&ret);
+  if (ret < 0) {
+    kh_destroy(HO,ht);
+    options->ht = NULL;
+    return PETSC_ERR_MEM;
+  }
+  kh_val(ht,it) = k;
+  return 0;
+}
+
 /*
     Options events monitor
 */
@@ -753,10 +809,11 @@ PetscErrorCode PetscOptionsView(PetscOptions options,PetscViewer viewer)
 
   ierr = PetscViewerASCIIPrintf(viewer,"#PETSc Option Table entries:\n");CHKERRQ(ierr);
   for (i=0; i<options->N; i++) {
-    if (options->values[i]) {
-      ierr = PetscViewerASCIIPrintf(viewer,"-%s %s\n",options->names[i],options->values[i]);CHKERRQ(ierr);
+    int k = options->order[i];
+    if (options->values[k]) {
+      ierr = PetscViewerASCIIPrintf(viewer,"-%s %s\n",options->names[k],options->values[k]);CHKERRQ(ierr);
     } else {
-      ierr = PetscViewerASCIIPrintf(viewer,"-%s\n",options->names[i]);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPrintf(viewer,"-%s\n",options->names[k]);CHKERRQ(ierr);
     }
   }
   ierr = PetscViewerASCIIPrintf(viewer,"#End of PETSc Option Table entries\n");CHKERRQ(ierr);
@@ -778,10 +835,11 @@ PETSC_EXTERN PetscErrorCode PetscOptionsViewError(void)
     (*PetscErrorPrintf)("No PETSc Option Table entries\n");
   }
   for (i=0; i<options->N; i++) {
-    if (options->values[i]) {
-      (*PetscErrorPrintf)("-%s %s\n",options->names[i],options->values[i]);
+    int k = options->order[i];
+    if (options->values[k]) {
+      (*PetscErrorPrintf)("-%s %s\n",options->names[k],options->values[k]);
     } else {
-      (*PetscErrorPrintf)("-%s\n",options->names[i]);
+      (*PetscErrorPrintf)("-%s\n",options->names[k]);
     }
   }
   PetscFunctionReturn(0);
@@ -893,7 +951,16 @@ PetscErrorCode PetscOptionsClear(PetscOptions options)
     if (options->names[i])  free(options->names[i]);
     if (options->values[i]) free(options->values[i]);
   }
-  options->N = 0;
+  free(options->order);
+  free(options->names);
+  free(options->values);
+  free(options->used);
+  options->order  = NULL;
+  options->names  = NULL;
+  options->values = NULL;
+  options->used   = NULL;
+  options->N      = 0;
+  options->Nalloc = 0;
 
   for (i=0; i<options->Naliases; i++) {
     free(options->aliases1[i]);
@@ -991,8 +1058,8 @@ PetscErrorCode PetscOptionsSetValue(PetscOptions options,const char name[],const
 {
   size_t         len;
   int            N,n,i;
-  char           **names;
-  char           fullname[MAXOPTNAME] = "";
+  PetscBool      found;
+  char           fullname[MAXOPTNAME] = "",*newname;
   PetscErrorCode ierr;
 
   if (!options && !defaultoptions) {
@@ -1023,38 +1090,46 @@ PetscErrorCode PetscOptionsSetValue(PetscOptions options,const char name[],const
     if (!result) { name = options->aliases2[i]; break; }
   }
 
-  /* slow search */
-  N = n = options->N;
-  names = options->names;
-  for (i=0; i<N; i++) {
-    int result = PetscOptNameCmp(names[i],name);
-    if (!result) {
-      n = i; goto setvalue;
-    } else if (result > 0) {
-      n = i; break;
-    }
-  }
-  if (N >= MAXOPTIONS) return PETSC_ERR_MEM;
-  /* shift remaining values up 1 */
-  for (i=N; i>n; i--) {
-    options->names[i]  = options->names[i-1];
-    options->values[i] = options->values[i-1];
-    options->used[i]   = options->used[i-1];
+  n = PetscOptionsLocate_Private(options,name,&found);
+  if (found) {n = options->order[n]; goto setvalue;}
+
+  N = options->N;
+  if (N == options->Nalloc) {
+    int       nalloc = options->Nalloc ? 2*options->Nalloc : 128;
+    int       *order;
+    char      **names,**values;
+    PetscBool *used;
+
+    order  = (int*)realloc(options->order,nalloc*sizeof(int));
+    if (!order) return PETSC_ERR_MEM;
+    options->order  = order;
+    names  = (char**)realloc(options->names,nalloc*sizeof(char*));
+    if (!names) return PETSC_ERR_MEM;
+    options->names  = names;
+    values = (char**)realloc(options->values,nalloc*sizeof(char*));
+    if (!values) return PETSC_ERR_MEM;
+    options->values = values;
+    used   = (PetscBool*)realloc(options->used,nalloc*sizeof(PetscBool));
+    if (!used) return PETSC_ERR_MEM;
+    options->used   = used;
+    options->Nalloc = nalloc;
   }
-  options->names[n]  = NULL;
+
+  /* set new name */
+  len     = strlen(name);
+  newname = (char*)malloc((len+1)*sizeof(char));
+  if (!newname) return PETSC_ERR_MEM;
+  strcpy(newname,name);
+
+  /* the new option takes the next free slot, its position in the sorted order is n */
+  for (i=N; i>n; i--) options->order[i] = options->order[i-1];
+  options->order[n]  = N;
+  n = N;
+  options->names[n]  = newname;
   options->values[n] = NULL;
   options->used[n]   = PETSC_FALSE;
   options->N++;
-
-  /* destroy hash table */
-  kh_destroy(HO,options->ht);
-  options->ht = NULL;
-
-  /* set new name */
-  len = strlen(name);
-  options->names[n] = (char*)malloc((len+1)*sizeof(char));
-  if (!options->names[n]) return PETSC_ERR_MEM;
-  strcpy(options->names[n],name);
+  ierr = PetscOptionsHashUpdate_Private(options,n);if (ierr) return ierr;
 
 setvalue:
   /* set new value */
@@ -1093,8 +1168,8 @@ setvalue:
 @*/
 PetscErrorCode PetscOptionsClearValue(PetscOptions options,const char name[])
 {
-  int            N,n,i;
-  char           **names;
+  int            N,n,i,k;
+  PetscBool      found;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -1107,33 +1182,30 @@ PetscErrorCode PetscOptionsClearValue(PetscOptions options,const char name[])
 
   name++; /* skip starting dash */
 
-  /* slow search */
-  N = n = options->N;
-  names = options->names;
-  for (i=0; i<N; i++) {
-    int result = PetscOptNameCmp(names[i],name);
-    if (!result) {
-      n = i; break;
-    } else if (result > 0) {
-      n = N; break;
-    }
-  }
-  if (n == N) PetscFunctionReturn(0); /* it was not present */
+  N = options->N;
+  n = PetscOptionsLocate_Private(options,name,&found);
+  if (!found) PetscFunctionReturn(0); /* it was not present */
+  k = options->order[n];
 
   /* remove name and value */
-  if (options->names[n])  free(options->names[n]);
-  if (options->values[n]) free(options->values[n]);
-  /* shift remaining values down 1 */
-  for (i=n; i<N-1; i++) {
-    options->names[i]  = options->names[i+1];
-    options->values[i] = options->values[i+1];
-    options->used[i]   = options->used[i+1];
+  if (options->ht) {
+    khiter_t it = kh_get(HO,options->ht,options->names[k]);
+    if (it != kh_end(options->ht)) kh_del(HO,options->ht,it);
   }
+  if (options->names[k])  free(options->names[k]);
+  if (options->values[k]) free(options->values[k]);
+  for (i=n; i<N-1; i++) options->order[i] = options->order[i+1];
   options->N--;
-
-  /* destroy hash table */
-  kh_destroy(HO,options->ht);
-  options->ht = NULL;
+  /* the option in the last slot moves to the freed slot */
+  if (k < N-1) {
+    options->names[k]  = options->names[N-1];
+    options->values[k] = options->values[N-1];
+    options->used[k]   = options->used[N-1];
+    n = PetscOptionsLocate_Private(options,options->names[k],&found);
+    options->order[n] = k;
+    ierr = PetscOptionsHashUpdate_Private(options,k);
+    if (ierr) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MEM,"Hash table allocation failed");
+  }
 
   ierr = PetscOptionsMonitor(options,name,NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1221,18 +1293,15 @@ PetscErrorCode PetscOptionsFindPair(PetscOptions options,const char pre[],const
       PetscFunctionReturn(0);
     }
   } else
-  { /* slow search */
-    int i, N = options->N;
-    for (i=0; i<N; i++) {
-      int result = PetscOptNameCmp(options->names[i],name);
-      if (!result) {
-        options->used[i]  = PETSC_TRUE;
-        if (value) *value = options->values[i];
-        if (set)   *set   = PETSC_TRUE;
-        PetscFunctionReturn(0);
-      } else if (result > 0) {
-        break;
-      }
+  { /* binary search */
+    PetscBool found;
+    int       i = PetscOptionsLocate_Private(options,name,&found);
+    if (found) {
+      i = options->order[i];
+      options->used[i]  = PETSC_TRUE;
+      if (value) *value = options->values[i];
+      if (set)   *set   = PETSC_TRUE;
+      PetscFunctionReturn(0);
     }
   }
 
@@ -1323,10 +1392,10 @@ PETSC_EXTERN PetscErrorCode PetscOptionsFindPairPrefix_Private(PetscOptions opti
     }
   }
 
-  { /* slow search */
-    int       c, i;
+  { /* binary search, the names beginning with opt (ignoring case) follow each other in the sorted names */
+    int       c, i, k;
     size_t    len;
-    PetscBool match;
+    PetscBool match,found;
 
     for (c = -1; c < numCnt; ++c) {
       char opt[MAXOPTNAME+1] = "", tmp[MAXOPTNAME];
@@ -1339,11 +1408,12 @@ PETSC_EXTERN PetscErrorCode PetscOptionsFindPairPrefix_Private(PetscOptions opti
         ierr = PetscStrlcat(opt,name+loce[c],sizeof(opt));CHKERRQ(ierr);
       }
       ierr = PetscStrlen(opt,&len);CHKERRQ(ierr);
-      for (i=0; i<options->N; i++) {
-        ierr = PetscStrncmp(options->names[i],opt,len,&match);CHKERRQ(ierr);
+      for (i=PetscOptionsLocate_Private(options,opt,&found); i<options->N && PetscOptBeginsWith(options->names[options->order[i]],opt); i++) {
+        k    = options->order[i];
+        ierr = PetscStrncmp(options->names[k],opt,len,&match);CHKERRQ(ierr);
         if (match) {
-          options->used[i]  = PETSC_TRUE;
-          if (value) *value = options->values[i];
+          options->used[k]  = PETSC_TRUE;
+          if (value) *value = options->values[k];
           if (set)   *set   = PETSC_TRUE;
           PetscFunctionReturn(0);
         }
@@ -1494,11 +1564,12 @@ PetscErrorCode PetscOptionsGetAll(PetscOptions options,char *copts[])
   ierr = PetscMalloc1(len,&coptions);CHKERRQ(ierr);
   coptions[0] = 0;
   for (i=0; i<options->N; i++) {
+    int k = options->order[i];
     ierr = PetscStrcat(coptions,"-");CHKERRQ(ierr);
-    ierr = PetscStrcat(coptions,options->names[i]);CHKERRQ(ierr);
+    ierr = PetscStrcat(coptions,options->names[k]);CHKERRQ(ierr);
     ierr = PetscStrcat(coptions," ");CHKERRQ(ierr);
-    if (options->values[i]) {
-      ierr = PetscStrcat(coptions,options->values[i]);CHKERRQ(ierr);
+    if (options->values[k]) {
+      ierr = PetscStrcat(coptions,options->values[k]);CHKERRQ(ierr);
       ierr = PetscStrcat(coptions," ");CHKERRQ(ierr);
     }
   }
@@ -1528,7 +1599,8 @@ PetscErrorCode PetscOptionsGetAll(PetscOptions options,char *copts[])
 @*/
 PetscErrorCode PetscOptionsUsed(PetscOptions options,const char *name,PetscBool *used)
 {
-  PetscInt       i;
+  int            i;
+  PetscBool      found;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -1536,12 +1608,11 @@ PetscErrorCode PetscOptionsUsed(PetscOptions options,const char *name,PetscBool
   PetscValidPointer(used,3);
   options = options ? options : defaultoptions;
   *used = PETSC_FALSE;
-  for (i=0; i<options->N; i++) {
+  i = PetscOptionsLocate_Private(options,name,&found);
+  if (found) {
+    i    = options->order[i];
     ierr = PetscStrcmp(options->names[i],name,used);CHKERRQ(ierr);
-    if (*used) {
-      *used = options->used[i];
-      break;
-    }
+    if (*used) *used = options->used[i];
   }
   PetscFunctionReturn(0);
 }
@@ -1611,11 +1682,12 @@ PetscErrorCode PetscOptionsLeft(PetscOptions options)
   PetscFunctionBegin;
   toptions = options ? options : defaultoptions;
   for (i=0; i<toptions->N; i++) {
-    if (!toptions->used[i]) {
-      if (toptions->values[i]) {
-        ierr = PetscPrintf(PETSC_COMM_WORLD,"Option left: name:-%s value: %s\n",toptions->names[i],toptions->values[i]);CHKERRQ(ierr);
+    int k = toptions->order[i];
+    if (!toptions->used[k]) {
+      if (toptions->values[k]) {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"Option left: name:-%s value: %s\n",toptions->names[k],toptions->values[k]);CHKERRQ(ierr);
       } else {
-        ierr = PetscPrintf(PETSC_COMM_WORLD,"Option left: name:-%s (no value)\n",toptions->names[i]);CHKERRQ(ierr);
+        ierr = PetscPrintf(PETSC_COMM_WORLD,"Option left: name:-%s (no value)\n",toptions->names[k]);CHKERRQ(ierr);
       }
     }
   }
@@ -1677,9 +1749,10 @@ PetscErrorCode PetscOptionsLeftGet(PetscOptions options,PetscInt *N,char **names
   n = 0;
   if (names || values) {
     for (i=0; i<options->N; i++) {
-      if (!options->used[i]) {
-        if (names)  (*names)[n]  = options->names[i];
-        if (values) (*values)[n] = options->values[i];
+      int k = options->order[i];
+      if (!options->used[k]) {
+        if (names)  (*names)[n]  = options->names[k];
+        if (values) (*values)[n] = options->values[k];
         n++;
       }
     }
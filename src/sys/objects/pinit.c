@@ -32,6 +32,8 @@ PETSC_INTERN PetscErrorCode PetscFunctionListPrintAll(void);
 PETSC_INTERN PetscErrorCode PetscSequentialPhaseBegin_Private(MPI_Comm,int);
 PETSC_INTERN PetscErrorCode PetscSequentialPhaseEnd_Private(MPI_Comm,int);
 PETSC_INTERN PetscErrorCode PetscCloseHistoryFile(FILE**);
+PETSC_INTERN PetscErrorCode PetscMallocPoolFinalize_Private(void);
+PETSC_INTERN PetscErrorCode PetscMallocProfileFinalize_Private(void);
 
 /* user may set this BEFORE calling PetscInitialize() */
 MPI_Comm PETSC_COMM_WORLD = MPI_COMM_NULL;
@@ -715,12 +717,16 @@ PetscInt PetscNumOMPThreads;
 .  -malloc_test - like -malloc_dump -malloc_debug, but only active for debugging builds, ignored in optimized build. May want to set in PETSC_OPTIONS environmental variable
 .  -malloc_view - show a list of all allocated memory during PetscFinalize()
 .  -malloc_view_threshold <t> - only list memory allocations of size greater than t with -malloc_view
+.  -malloc_profile [prefix] - write the memory allocated by each call stack, live and at the peak, during PetscFinalize(), see PetscMallocProfileDump()
+.  -malloc_profile_stages <stage1,stage2,...> - with -malloc_profile also write it each time one of these stages is popped
+.  -malloc_pool - use the pooled allocator PetscMallocPool(), needed for PetscMallocArenaPush()
 .  -fp_trap - Stops on floating point exceptions
 .  -no_signal_handler - Indicates not to trap error signals
 .  -shared_tmp - indicates /tmp directory is shared by all processors
 .  -not_shared_tmp - each processor has own /tmp
 .  -tmp - alternative name of /tmp directory
 .  -get_total_flops - returns total flops done by all processors
+.  -simd_level <none,avx,avx2,avx512> - limits the vector instructions of the matrix kernels, see PetscSIMDSetLevel()
 -  -memory_view - Print memory usage at end of run
 
    Options Database Keys for Profiling:
@@ -733,12 +739,17 @@ PetscInt PetscNumOMPThreads;
         hangs without running in the debugger).  See PetscLogTraceBegin().
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see PetscLogView().
 .  -log_view_memory - Includes in the summary from -log_view the memory used in each method, see PetscLogView().
+.  -log_view_roofline - Includes in the summary from -log_view the arithmetic intensity and memory bandwidth of each method, see PetscLogBytes().
+.  -log_view_hwcounters <name1,name2,...> - Includes in the summary from -log_view the hardware counters of each method, see PetscLogSetHWCounters().
+.  -log_view_comm_matrix - Includes in the summary from -log_view the messages sent by each method between each pair of processes, see PetscLogCommMatrixBegin().
+.  -log_view_flamegraph_reduction <none,max,mean> - With -log_view :filename:ascii_flamegraph, prints the folded stacks of each process, or their maximum or mean over the processes, see PetscLogView().
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
 .  -log_exclude: <vec,mat,pc,ksp,snes> - excludes subset of object classes from logging
 .  -log_all [filename] - Logs extensive profiling information  See PetscLogDump().
 .  -log [filename] - Logs basic profiline information  See PetscLogDump().
 .  -log_mpe [filename] - Creates a logfile viewable by the utility Jumpshot (in MPICH distribution)
+.  -log_timeline [filename] - Writes a timeline of all events and stages of every process in Chrome Trace Event format, see PetscLogTimelineBegin()
 .  -viewfromoptions on,off - Enable or disable XXXSetFromOptions() calls, for applications with many small solves turn this off
 -  -check_pointer_intensity 0,1,2 - if pointers are checked for validity (debug version only), using 0 will result in faster code
 
@@ -1401,6 +1412,10 @@ PetscErrorCode  PetscFinalize(void)
   ierr = PetscOptionsGetString(NULL,NULL,"-log_all",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
   ierr = PetscOptionsGetString(NULL,NULL,"-log",mname,PETSC_MAX_PATH_LEN,&flg2);CHKERRQ(ierr);
   if (flg1 || flg2) {ierr = PetscLogDump(mname);CHKERRQ(ierr);}
+
+  mname[0] = 0;
+  ierr = PetscOptionsGetString(NULL,NULL,"-log_timeline",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogTimelineDump(mname);CHKERRQ(ierr);}
 #endif
 
   ierr = PetscStackDestroy();CHKERRQ(ierr);
@@ -1515,6 +1530,7 @@ PetscErrorCode  PetscFinalize(void)
   ierr = PetscOptionsHelpPrintedDestroy(&PetscOptionsHelpPrintedSingleton);CHKERRQ(ierr);
 
   ierr = PetscInfoAllow(PETSC_FALSE,NULL);CHKERRQ(ierr);
+  ierr = PetscMallocProfileFinalize_Private();CHKERRQ(ierr);
 
 #if !defined(PETSC_HAVE_THREADSAFETY)
   if (!(PETSC_RUNNING_ON_VALGRIND)) {
@@ -1644,6 +1660,7 @@ PetscErrorCode  PetscFinalize(void)
    memory was not freed.
 
 */
+  ierr = PetscMallocPoolFinalize_Private();CHKERRQ(ierr);
   ierr = PetscMallocClear();CHKERRQ(ierr);
 
   PetscInitializeCalled = PETSC_FALSE;
@@ -0,0 +1,120 @@
+
+#include <petsc/private/petscimpl.h> /*I "petscsys.h" I*/
+
+const char *const PetscSIMDLevels[] = {
+  "NONE",
+  "AVX",
+  "AVX2",
+  "AVX512",
+  "PetscSIMDLevel",
+  "PETSC_SIMD_",
+  NULL
+};
+
+static PetscBool      petsc_simd_detected = PETSC_FALSE;
+static PetscSIMDLevel petsc_simd_hardware = PETSC_SIMD_NONE;
+static PetscSIMDLevel petsc_simd_level    = PETSC_SIMD_NONE;
+
+/*@
+     PetscSIMDGetHardwareLevel - Determines the widest x86 vector instruction set that the processor
+     and the operating system support
+
+     Not Collective
+
+     Output Parameter:
+.    level - the hardware level
+
+     Notes:
+     The processor is queried once, during PetscInitialize(). With compilers that cannot query it the
+     level is the one enabled by the compiler flags.
+
+     Level: developer
+
+.seealso: PetscSIMDGetLevel(), PetscSIMDSetLevel(), PetscSIMDLevel
+@*/
+PetscErrorCode PetscSIMDGetHardwareLevel(PetscSIMDLevel *level)
+{
+  PetscFunctionBegin;
+  PetscValidPointer(level,1);
+  if (!petsc_simd_detected) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || __GNUC__ >= 5) && !defined(__INTEL_COMPILER) && !defined(__PGI)
+    /* these also check that the operating system saves the wide registers */
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) petsc_simd_hardware = PETSC_SIMD_AVX512;
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) petsc_simd_hardware = PETSC_SIMD_AVX2;
+    else if (__builtin_cpu_supports("avx")) petsc_simd_hardware = PETSC_SIMD_AVX;
+#elif defined(__AVX512F__)
+    petsc_simd_hardware = PETSC_SIMD_AVX512;
+#elif defined(__AVX2__) && defined(__FMA__)
+    petsc_simd_hardware = PETSC_SIMD_AVX2;
+#elif defined(__AVX__)
+    petsc_simd_hardware = PETSC_SIMD_AVX;
+#endif
+    petsc_simd_level    = petsc_simd_hardware;
+    petsc_simd_detected = PETSC_TRUE;
+  }
+  *level = petsc_simd_hardware;
+  PetscFunctionReturn(0);
+}
+
+/*@
+     PetscSIMDSetLevel - Limits the x86 vector instruction set used by the kernels installed in the
+     Mat operation tables from now on
+
+     Not Collective
+
+     Input Parameter:
+.    level - the widest instruction set to use, it may not exceed the hardware level
+
+     Options Database Key:
+.    -simd_level <none,avx,avx2,avx512> - Sets the level in PetscInitialize()
+
+     Notes:
+     This is meant for comparing the kernels on the same machine. Matrices that already have their
+     operations set keep their kernels.
+
+     Level: developer
+
+.seealso: PetscSIMDGetLevel(), PetscSIMDGetHardwareLevel(), PetscSIMDLevel
+@*/
+PetscErrorCode PetscSIMDSetLevel(PetscSIMDLevel level)
+{
+  PetscErrorCode ierr;
+  PetscSIMDLevel hardware;
+
+  PetscFunctionBegin;
+  ierr = PetscSIMDGetHardwareLevel(&hardware);CHKERRQ(ierr);
+  if (level < PETSC_SIMD_NONE || level > PETSC_SIMD_AVX512) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Unknown SIMD level %d",(int)level);
+  if (level > hardware) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"SIMD level %s is not supported by this processor, which supports up to %s",PetscSIMDLevels[level],PetscSIMDLevels[hardware]);
+  petsc_simd_level = level;
+  PetscFunctionReturn(0);
+}
+
+/*@
+     PetscSIMDGetLevel - Gets the widest x86 vector instruction set that the kernels may use
+
+     Not Collective
+
+     Output Parameter:
+.    level - the level set with PetscSIMDSetLevel(), by default the hardware level
+
+     Notes:
+     Matrix types with several kernels for an operation install the one for this level in their
+     operation table when they are created or preallocated. A variant is only available if the compiler
+     could build it, see include/petsc/private/kernels/simd.h.
+
+     Level: developer
+
+.seealso: PetscSIMDSetLevel(), PetscSIMDGetHardwareLevel(), PetscSIMDLevel
+@*/
+PetscErrorCode PetscSIMDGetLevel(PetscSIMDLevel *level)
+{
+  PetscErrorCode ierr;
+  PetscSIMDLevel hardware;
+
+  PetscFunctionBegin;
+  PetscValidPointer(level,1);
+  ierr   = PetscSIMDGetHardwareLevel(&hardware);CHKERRQ(ierr);
+  *level = petsc_simd_level;
+  PetscFunctionReturn(0);
+}
@@ -48,6 +48,27 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFGetLeafInfo_Basic(PetscSF sf,PetscInt
   PetscFunctionReturn(0);
 }
 
+/* Log the messages sent in one direction to the ranks outside the distinguished set, for -log_view_comm_matrix */
+PETSC_STATIC_INLINE PetscErrorCode PetscSFLogCommSends_Basic(PetscSF sf,PetscSFDirection direction,MPI_Datatype unit)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,nranks,ndranks;
+  const PetscMPIInt *ranks;
+  const PetscInt    *offset;
+
+  PetscFunctionBegin;
+  if (!PetscLogCommMatrix) PetscFunctionReturn(0);
+  if (direction == PETSCSF_ROOT2LEAF_BCAST) {
+    ierr = PetscSFGetRootInfo_Basic(sf,&nranks,&ndranks,&ranks,&offset,NULL);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSFGetLeafInfo_Basic(sf,&nranks,&ndranks,&ranks,&offset,NULL,NULL);CHKERRQ(ierr);
+  }
+  for (i=ndranks; i<nranks; i++) {
+    ierr = PetscLogCommSend(PetscObjectComm((PetscObject)sf),ranks[i],offset[i+1]-offset[i],unit);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /* Get root locations either on Host or Device */
 PETSC_STATIC_INLINE PetscErrorCode PetscSFGetRootIndicesWithMemType_Basic(PetscSF sf,PetscMemType mtype, const PetscInt **rootloc)
 {
@@ -133,6 +154,8 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFPackRootData(PetscSF sf,PetscSFPack li
   ierr = PetscSFPackGetPack(link,link->rootmtype,&Pack);CHKERRQ(ierr);
   /* Only do packing when count != 0 so that we can avoid invoking empty CUDA kernels */
   for (i=0; i<2; i++) {if (p[i].count) {ierr = (*Pack)(p[i].count,p[i].idx,link,p[i].opt,rootdata,p[i].buf);CHKERRQ(ierr);}}
+  /* Each unit is read from rootdata and written to the buffer */
+  if (link->rootmtype == PETSC_MEMTYPE_HOST) {ierr = PetscLogBytes(2.0*(p[0].count+p[1].count)*link->unitbytes);CHKERRQ(ierr);}
 
 #if defined(PETSC_HAVE_CUDA)
   if (link->rootmtype == PETSC_MEMTYPE_DEVICE && p[1].count) { /* We only care p[1], which is for remote and involves MPI */
@@ -169,6 +192,7 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFPackLeafData(PetscSF sf,PetscSFPack li
 
   ierr = PetscSFPackGetPack(link,link->leafmtype,&Pack);CHKERRQ(ierr);
   for (i=0; i<2; i++) {if (p[i].count) {ierr = (*Pack)(p[i].count,p[i].idx,link,p[i].opt,leafdata,p[i].buf);CHKERRQ(ierr);}}
+  if (link->leafmtype == PETSC_MEMTYPE_HOST) {ierr = PetscLogBytes(2.0*(p[0].count+p[1].count)*link->unitbytes);CHKERRQ(ierr);}
 #if defined(PETSC_HAVE_CUDA)
   if (link->leafmtype == PETSC_MEMTYPE_DEVICE && p[1].count) {
     cudaError_t err;
@@ -239,6 +263,8 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFUnpackAndOpRootData(PetscSF sf,PetscSF
 #endif
     }
   }
+  /* Each unit is read from the buffer and combined into rootdata */
+  if (link->rootmtype == PETSC_MEMTYPE_HOST) {ierr = PetscLogBytes(2.0*(p[0].count+p[1].count)*link->unitbytes);CHKERRQ(ierr);}
 #if defined(PETSC_HAVE_CUDA)
   /* Make sure rootdata is ready to use by SF client */
   if (link->rootmtype == PETSC_MEMTYPE_DEVICE && p[1].count) {cudaError_t err = cudaStreamSynchronize(link->stream);CHKERRCUDA(err);}
@@ -299,6 +325,7 @@ PETSC_STATIC_INLINE PetscErrorCode PetscSFUnpackAndOpLeafData(PetscSF sf,PetscSF
 #endif
     }
   }
+  if (link->leafmtype == PETSC_MEMTYPE_HOST) {ierr = PetscLogBytes(2.0*(p[0].count+p[1].count)*link->unitbytes);CHKERRQ(ierr);}
 #if defined(PETSC_HAVE_CUDA)
   if (link->leafmtype == PETSC_MEMTYPE_DEVICE && p[1].count) {cudaError_t err = cudaStreamSynchronize(link->stream);CHKERRCUDA(err);}
 #endif
@@ -0,0 +1,73 @@
+static char help[] = "Tests the memory traffic logged with PetscLogBytes() by the vector and matrix kernels.\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode     ierr;
+  Vec                x,y;
+  Mat                A;
+  PetscLogStage      stage;
+  PetscLogEvent      event;
+  PetscEventPerfInfo info;
+  PetscInt           i,n = 1000,nz,its = 5,cols[3];
+  PetscScalar        vals[3] = {-1.0,2.0,-1.0};
+  PetscLogDouble     expected;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
+  ierr = PetscLogStageRegister("Bytes",&stage);CHKERRQ(ierr);
+
+  ierr = VecCreateSeq(PETSC_COMM_SELF,n,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,n,n,3,NULL,&A);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    cols[0] = i-1; cols[1] = i; cols[2] = i+1;
+    if (i == 0) {ierr = MatSetValues(A,1,&i,2,cols+1,vals+1,INSERT_VALUES);CHKERRQ(ierr);}
+    else if (i == n-1) {ierr = MatSetValues(A,1,&i,2,cols,vals,INSERT_VALUES);CHKERRQ(ierr);}
+    else {ierr = MatSetValues(A,1,&i,3,cols,vals,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  nz   = 3*n-2;
+
+  ierr = PetscLogStagePush(stage);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {
+    ierr = MatMult(A,x,y);CHKERRQ(ierr);
+    ierr = VecAXPY(x,0.5,y);CHKERRQ(ierr);
+  }
+  ierr = PetscLogStagePop();CHKERRQ(ierr);
+
+  /* y = a*x + y reads x and y and writes y */
+  ierr     = PetscLogEventGetId("VecAXPY",&event);CHKERRQ(ierr);
+  ierr     = PetscLogEventGetPerfInfo(stage,event,&info);CHKERRQ(ierr);
+  expected = its*3.0*n*sizeof(PetscScalar);
+  ierr     = PetscPrintf(PETSC_COMM_SELF,"VecAXPY() bytes %s\n",info.bytes == expected ? "match the model" : "do not match the model");CHKERRQ(ierr);
+  /* y = A*x reads the values and column indices of A, its row offsets, x, and writes y */
+  ierr     = PetscLogEventGetId("MatMult",&event);CHKERRQ(ierr);
+  ierr     = PetscLogEventGetPerfInfo(stage,event,&info);CHKERRQ(ierr);
+  expected = its*(nz*(sizeof(MatScalar)+sizeof(PetscInt)) + (n+1.0)*sizeof(PetscInt) + 2.0*n*sizeof(PetscScalar));
+  ierr     = PetscPrintf(PETSC_COMM_SELF,"MatMult() bytes %s\n",info.bytes == expected ? "match the model" : "do not match the model");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+     requires: define(PETSC_USE_LOG)
+
+   test:
+
+   test:
+     suffix: 2
+     args: -log_view ascii:log.txt -log_view_roofline -log_view_roofline_size 100000
+     output_file: output/ex51_1.out
+
+TEST*/
@@ -0,0 +1,59 @@
+static char help[] = "Tests the communication matrix logged with PetscLogCommMatrixBegin() for a VecScatter.\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  Vec            x,y;
+  IS             is;
+  VecScatter     scatter;
+  PetscViewer    viewer;
+  PetscInt       n = 4,its = 3,i;
+  PetscMPIInt    rank,size;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  viewer = PETSC_VIEWER_STDOUT_WORLD;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscLogDefaultBegin();CHKERRQ(ierr);
+
+  /* every process gets the entries of the next process, so each process sends one message to the previous one */
+  ierr = VecCreateMPI(PETSC_COMM_WORLD,n,PETSC_DETERMINE,&x);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF,n,&y);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF,n,((rank+1)%size)*n,1,&is);CHKERRQ(ierr);
+  ierr = VecScatterCreate(x,is,y,NULL,&scatter);CHKERRQ(ierr);
+
+  ierr = PetscLogCommMatrixBegin();CHKERRQ(ierr);
+  for (i=0; i<its; i++) {
+    ierr = VecScatterBegin(scatter,x,y,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(scatter,x,y,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  }
+  ierr = PetscLogCommMatrixView(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(viewer,PETSC_VIEWER_ASCII_CSV);CHKERRQ(ierr);
+  ierr = PetscLogCommMatrixView(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(viewer);CHKERRQ(ierr);
+
+  ierr = VecScatterDestroy(&scatter);CHKERRQ(ierr);
+  ierr = ISDestroy(&is);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+     requires: define(PETSC_USE_LOG) double !complex
+
+   test:
+     nsize: 3
+
+   test:
+     suffix: 2
+     nsize: 3
+     args: -vecscatter_type sf
+
+TEST*/
@@ -0,0 +1,119 @@
+static char help[] = "Tests VecFused() against the unfused vector operations.\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode FillVec(Vec v,PetscInt shift)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,rstart,rend;
+
+  PetscFunctionBegin;
+  ierr = VecGetOwnershipRange(v,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = VecSetValue(v,i,(PetscScalar)PetscSinReal((PetscReal)(i+shift)),INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = VecAssemblyBegin(v);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 1037,i;
+  Vec            x,y,w,xr,yr,wr,z;
+  VecFusedOp     ops[6];
+  PetscScalar    res[3],ref[3],alpha = 0.5,beta = -1.25;
+  PetscReal      norm,err = 0.0;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = FillVec(x,0);CHKERRQ(ierr);
+  ierr = FillVec(y,7);CHKERRQ(ierr);
+  ierr = FillVec(z,13);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&xr);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&yr);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&wr);CHKERRQ(ierr);
+  ierr = VecCopy(x,xr);CHKERRQ(ierr);
+  ierr = VecCopy(y,yr);CHKERRQ(ierr);
+
+  /* unfused reference */
+  ierr = VecAXPY(yr,alpha,xr);CHKERRQ(ierr);
+  ierr = VecAYPX(xr,beta,z);CHKERRQ(ierr);
+  ierr = VecWAXPY(wr,-alpha,xr,yr);CHKERRQ(ierr);
+  ierr = VecDot(wr,yr,&ref[0]);CHKERRQ(ierr);
+  ierr = VecTDot(xr,z,&ref[1]);CHKERRQ(ierr);
+  ierr = VecNorm(wr,NORM_2,&norm);CHKERRQ(ierr);
+  ref[2] = norm;
+
+  ops[0] = VecFusedOpAXPY(y,alpha,x);
+  ops[1] = VecFusedOpAYPX(x,beta,z);
+  ops[2] = VecFusedOpWAXPY(w,-alpha,x,y);
+  ops[3] = VecFusedOpDot(w,y);
+  ops[4] = VecFusedOpTDot(x,z);
+  ops[5] = VecFusedOpNorm(w);
+  ierr = VecFused(6,ops,res);CHKERRQ(ierr);
+
+  for (i=0; i<3; i++) err = PetscMax(err,PetscAbsScalar(res[i]-ref[i])/PetscMax(1.0,PetscAbsScalar(ref[i])));
+  ierr = VecAXPY(wr,-1.0,w);CHKERRQ(ierr);
+  ierr = VecNorm(wr,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  err  = PetscMax(err,norm);
+  ierr = VecAXPY(xr,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(xr,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  err  = PetscMax(err,norm);
+  if (err > 100*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Fused and unfused results differ by %g\n",(double)err);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Fused and unfused results agree\n");CHKERRQ(ierr);
+  }
+
+  /* the split phase form combines with other reductions */
+  ops[0] = VecFusedOpAXPY(y,alpha,x);
+  ops[1] = VecFusedOpNorm(y);
+  ierr = VecFusedBegin(2,ops);CHKERRQ(ierr);
+  ierr = VecDotBegin(x,z,&ref[0]);CHKERRQ(ierr);
+  ierr = VecFusedEnd(2,ops,res);CHKERRQ(ierr);
+  ierr = VecDotEnd(x,z,&ref[0]);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&norm);CHKERRQ(ierr);
+  ierr = VecDot(x,z,&ref[1]);CHKERRQ(ierr);
+  err  = PetscMax(PetscAbsReal(norm-PetscRealPart(res[0]))/norm,PetscAbsScalar(ref[0]-ref[1])/PetscMax(1.0,PetscAbsScalar(ref[1])));
+  if (err > 100*PETSC_MACHINE_EPSILON) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Split phase fused results differ by %g\n",(double)err);CHKERRQ(ierr);
+  } else {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Split phase fused results agree\n");CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&xr);CHKERRQ(ierr);
+  ierr = VecDestroy(&yr);CHKERRQ(ierr);
+  ierr = VecDestroy(&wr);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/ex56_1.out
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/ex56_1.out
+
+   test:
+      suffix: simd_none
+      args: -simd_level none
+      output_file: output/ex56_1.out
+
+TEST*/
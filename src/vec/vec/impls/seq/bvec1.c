@@ -24,6 +24,7 @@ PetscErrorCode VecDot_Seq(Vec xin,Vec yin,PetscScalar *z)
   if (xin->map->n > 0) {
     ierr = PetscLogFlops(2.0*xin->map->n-1);CHKERRQ(ierr);
   }
+  ierr = PetscLogBytes(2.0*xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -43,6 +44,7 @@ PetscErrorCode VecTDot_Seq(Vec xin,Vec yin,PetscScalar *z)
   if (xin->map->n > 0) {
     ierr = PetscLogFlops(2.0*xin->map->n-1);CHKERRQ(ierr);
   }
+  ierr = PetscLogBytes(2.0*xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -60,6 +62,7 @@ PetscErrorCode VecScale_Seq(Vec xin, PetscScalar alpha)
     ierr = VecGetArray(xin,&xarray);CHKERRQ(ierr);
     PetscStackCallBLAS("BLASscal",BLASscal_(&bn,&a,xarray,&one));
     ierr = VecRestoreArray(xin,&xarray);CHKERRQ(ierr);
+    ierr = PetscLogBytes(2.0*xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
   ierr = PetscLogFlops(xin->map->n);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -82,6 +85,7 @@ PetscErrorCode VecAXPY_Seq(Vec yin,PetscScalar alpha,Vec xin)
     ierr = VecRestoreArrayRead(xin,&xarray);CHKERRQ(ierr);
     ierr = VecRestoreArray(yin,&yarray);CHKERRQ(ierr);
     ierr = PetscLogFlops(2.0*yin->map->n);CHKERRQ(ierr);
+    ierr = PetscLogBytes(3.0*yin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -107,6 +111,7 @@ PetscErrorCode VecAXPBY_Seq(Vec yin,PetscScalar a,PetscScalar b,Vec xin)
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecRestoreArray(yin,(PetscScalar**)&yy);CHKERRQ(ierr);
     ierr = PetscLogFlops(xin->map->n);CHKERRQ(ierr);
+    ierr = PetscLogBytes(2.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   } else {
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecGetArray(yin,(PetscScalar**)&yy);CHKERRQ(ierr);
@@ -114,6 +119,7 @@ PetscErrorCode VecAXPBY_Seq(Vec yin,PetscScalar a,PetscScalar b,Vec xin)
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecRestoreArray(yin,(PetscScalar**)&yy);CHKERRQ(ierr);
     ierr = PetscLogFlops(3.0*xin->map->n);CHKERRQ(ierr);
+    ierr = PetscLogBytes(3.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -145,5 +151,6 @@ PetscErrorCode VecAXPBYPCZ_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscS
   ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);
   ierr = VecRestoreArray(zin,&zz);CHKERRQ(ierr);
+  ierr = PetscLogBytes((gamma == (PetscScalar)0.0 ? 3.0 : 4.0)*n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -230,6 +230,7 @@ PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
 #endif
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+    ierr = PetscLogBytes(1.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   } else if (type == NORM_INFINITY) {
     PetscInt  i;
     PetscReal max = 0.0,tmp;
@@ -242,6 +243,7 @@ PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
       xx++;
     }
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+    ierr = PetscLogBytes(1.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
     *z   = max;
   } else if (type == NORM_1) {
 #if defined(PETSC_USE_COMPLEX)
@@ -260,6 +262,7 @@ PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
 #endif
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = PetscLogFlops(PetscMax(n-1.0,0.0));CHKERRQ(ierr);
+    ierr = PetscLogBytes(1.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   } else if (type == NORM_1_AND_2) {
     ierr = VecNorm_Seq(xin,NORM_1,z);CHKERRQ(ierr);
     ierr = VecNorm_Seq(xin,NORM_2,z+1);CHKERRQ(ierr);
@@ -889,7 +892,15 @@ static struct _VecOps DvOps = {VecDuplicate_Seq, /* 1 */
                                VecStrideSubSetGather_Default,
                                VecStrideSubSetScatter_Default,
                                0,
-                               0
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               0,
+                               VecFusedLocal_Seq
 };
 
 
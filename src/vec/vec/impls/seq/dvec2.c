@@ -87,6 +87,7 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   }
   ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
   ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
+  ierr = PetscLogBytes((nv+1.0)*xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -286,6 +287,7 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   }
   ierr = VecRestoreArrayRead(xin,&xbase);CHKERRQ(ierr);
   ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
+  ierr = PetscLogBytes((nv+1.0)*xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 #endif
@@ -484,6 +486,7 @@ PetscErrorCode VecMTDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   }
   ierr = VecRestoreArrayRead(xin,&xbase);CHKERRQ(ierr);
   ierr = PetscLogFlops(PetscMax(nv*(2.0*xin->map->n-1),0.0));CHKERRQ(ierr);
+  ierr = PetscLogBytes((nv+1.0)*xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -509,6 +512,7 @@ PetscErrorCode VecMax_Seq(Vec xin,PetscInt *idx,PetscReal *z)
   *z = max;
   if (idx) *idx = j;
   ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = PetscLogBytes(1.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -533,6 +537,7 @@ PetscErrorCode VecMin_Seq(Vec xin,PetscInt *idx,PetscReal *z)
   *z = min;
   if (idx) *idx = j;
   ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = PetscLogBytes(1.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -550,6 +555,7 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
     for (i=0; i<n; i++) xx[i] = alpha;
   }
   ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  ierr = PetscLogBytes(1.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -566,6 +572,7 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
 
   PetscFunctionBegin;
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  ierr = PetscLogBytes((nv+2.0)*n*sizeof(PetscScalar));CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   switch (j_rem=nv&0x3) {
   case 3:
@@ -647,6 +654,7 @@ PetscErrorCode VecAYPX_Seq(Vec yin,PetscScalar alpha,Vec xin)
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
     ierr = PetscLogFlops(1.0*n);CHKERRQ(ierr);
+    ierr = PetscLogBytes(3.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   } else {
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
@@ -665,6 +673,7 @@ PetscErrorCode VecAYPX_Seq(Vec yin,PetscScalar alpha,Vec xin)
     ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
     ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+    ierr = PetscLogBytes(3.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -708,6 +717,7 @@ PetscErrorCode VecWAXPY_Seq(Vec win, PetscScalar alpha,Vec xin,Vec yin)
   ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
   ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);
   ierr = VecRestoreArray(win,&ww);CHKERRQ(ierr);
+  ierr = PetscLogBytes((alpha == (PetscScalar)0.0 ? 2.0 : 3.0)*n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -732,6 +742,7 @@ PetscErrorCode VecMaxPointwiseDivide_Seq(Vec xin,Vec yin,PetscReal *max)
   ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);
   ierr = MPIU_Allreduce(&m,max,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
   ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  ierr = PetscLogBytes(2.0*n*sizeof(PetscScalar));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -0,0 +1,280 @@
+
+/*
+   Applies a short sequence of vector operations, see VecFusedBegin(), in one pass over the
+   entries; shared by sequential and parallel vectors.
+*/
+#include <../src/vec/vec/impls/dvecimpl.h>
+#include <petsc/private/kernels/simd.h>
+
+#define VEC_FUSED_MAXOPS 16
+/* number of entries that all the operations process before moving on, small enough for the chunks to stay in the L1 cache */
+#define VEC_FUSED_CHUNK  512
+
+typedef struct {
+  void        (*axpy)(PetscInt,PetscScalar,const PetscScalar*,PetscScalar*);
+  void        (*aypx)(PetscInt,PetscScalar,const PetscScalar*,PetscScalar*);
+  void        (*waxpy)(PetscInt,PetscScalar,const PetscScalar*,const PetscScalar*,PetscScalar*);
+  PetscScalar (*dot)(PetscInt,const PetscScalar*,const PetscScalar*);
+  PetscScalar (*tdot)(PetscInt,const PetscScalar*,const PetscScalar*);
+  PetscReal   (*norm2)(PetscInt,const PetscScalar*);
+} VecFusedKernels;
+
+static void VecFusedAXPY_Private(PetscInt n,PetscScalar alpha,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  for (i=0; i<n; i++) y[i] += alpha*x[i];
+}
+
+static void VecFusedAYPX_Private(PetscInt n,PetscScalar alpha,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i;
+
+  for (i=0; i<n; i++) y[i] = x[i] + alpha*y[i];
+}
+
+static void VecFusedWAXPY_Private(PetscInt n,PetscScalar alpha,const PetscScalar *x,const PetscScalar *y,PetscScalar *w)
+{
+  PetscInt i;
+
+  for (i=0; i<n; i++) w[i] = alpha*x[i] + y[i];
+}
+
+static PetscScalar VecFusedDot_Private(PetscInt n,const PetscScalar *x,const PetscScalar *y)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    i;
+
+  for (i=0; i<n; i++) sum += x[i]*PetscConj(y[i]);
+  return sum;
+}
+
+static PetscScalar VecFusedTDot_Private(PetscInt n,const PetscScalar *x,const PetscScalar *y)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    i;
+
+  for (i=0; i<n; i++) sum += x[i]*y[i];
+  return sum;
+}
+
+static PetscReal VecFusedNorm2_Private(PetscInt n,const PetscScalar *x)
+{
+  PetscReal sum = 0.0;
+  PetscInt  i;
+
+  for (i=0; i<n; i++) sum += PetscRealPart(x[i]*PetscConj(x[i]));
+  return sum;
+}
+
+static const VecFusedKernels VecFusedKernels_Private = {VecFusedAXPY_Private,VecFusedAYPX_Private,VecFusedWAXPY_Private,VecFusedDot_Private,VecFusedTDot_Private,VecFusedNorm2_Private};
+
+#if defined(PETSC_SIMD_USE_AVX2)
+static void PETSC_SIMD_TARGET_AVX2 VecFusedAXPY_AVX2(PetscInt n,PetscScalar alpha,const PetscScalar *x,PetscScalar *y)
+{
+  __m256d  va = _mm256_set1_pd(alpha);
+  PetscInt i;
+
+  for (i=0; i+4<=n; i+=4) _mm256_storeu_pd(y+i,_mm256_fmadd_pd(va,_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i)));
+  for (; i<n; i++) y[i] += alpha*x[i];
+}
+
+static void PETSC_SIMD_TARGET_AVX2 VecFusedAYPX_AVX2(PetscInt n,PetscScalar alpha,const PetscScalar *x,PetscScalar *y)
+{
+  __m256d  va = _mm256_set1_pd(alpha);
+  PetscInt i;
+
+  for (i=0; i+4<=n; i+=4) _mm256_storeu_pd(y+i,_mm256_fmadd_pd(va,_mm256_loadu_pd(y+i),_mm256_loadu_pd(x+i)));
+  for (; i<n; i++) y[i] = x[i] + alpha*y[i];
+}
+
+static void PETSC_SIMD_TARGET_AVX2 VecFusedWAXPY_AVX2(PetscInt n,PetscScalar alpha,const PetscScalar *x,const PetscScalar *y,PetscScalar *w)
+{
+  __m256d  va = _mm256_set1_pd(alpha);
+  PetscInt i;
+
+  for (i=0; i+4<=n; i+=4) _mm256_storeu_pd(w+i,_mm256_fmadd_pd(va,_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i)));
+  for (; i<n; i++) w[i] = alpha*x[i] + y[i];
+}
+
+static PetscScalar PETSC_SIMD_TARGET_AVX2 VecFusedDot_AVX2(PetscInt n,const PetscScalar *x,const PetscScalar *y)
+{
+  __m256d     acc0 = _mm256_setzero_pd(),acc1 = _mm256_setzero_pd();
+  PetscScalar sum[4];
+  PetscInt    i;
+
+  /* two accumulators hide the latency of the fused multiply-add */
+  for (i=0; i+8<=n; i+=8) {
+    acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i),_mm256_loadu_pd(y+i),acc0);
+    acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i+4),_mm256_loadu_pd(y+i+4),acc1);
+  }
+  _mm256_storeu_pd(sum,_mm256_add_pd(acc0,acc1));
+  sum[0] += sum[1] + sum[2] + sum[3];
+  for (; i<n; i++) sum[0] += x[i]*y[i];
+  return sum[0];
+}
+
+static PetscReal PETSC_SIMD_TARGET_AVX2 VecFusedNorm2_AVX2(PetscInt n,const PetscScalar *x)
+{
+  return VecFusedDot_AVX2(n,x,x);
+}
+
+static const VecFusedKernels VecFusedKernels_AVX2 = {VecFusedAXPY_AVX2,VecFusedAYPX_AVX2,VecFusedWAXPY_AVX2,VecFusedDot_AVX2,VecFusedDot_AVX2,VecFusedNorm2_AVX2};
+#endif
+
+#if defined(PETSC_SIMD_USE_AVX512)
+static void PETSC_SIMD_TARGET_AVX512 VecFusedAXPY_AVX512(PetscInt n,PetscScalar alpha,const PetscScalar *x,PetscScalar *y)
+{
+  __m512d  va = _mm512_set1_pd(alpha);
+  PetscInt i;
+
+  for (i=0; i+8<=n; i+=8) _mm512_storeu_pd(y+i,_mm512_fmadd_pd(va,_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i)));
+  for (; i<n; i++) y[i] += alpha*x[i];
+}
+
+static void PETSC_SIMD_TARGET_AVX512 VecFusedAYPX_AVX512(PetscInt n,PetscScalar alpha,const PetscScalar *x,PetscScalar *y)
+{
+  __m512d  va = _mm512_set1_pd(alpha);
+  PetscInt i;
+
+  for (i=0; i+8<=n; i+=8) _mm512_storeu_pd(y+i,_mm512_fmadd_pd(va,_mm512_loadu_pd(y+i),_mm512_loadu_pd(x+i)));
+  for (; i<n; i++) y[i] = x[i] + alpha*y[i];
+}
+
+static void PETSC_SIMD_TARGET_AVX512 VecFusedWAXPY_AVX512(PetscInt n,PetscScalar alpha,const PetscScalar *x,const PetscScalar *y,PetscScalar *w)
+{
+  __m512d  va = _mm512_set1_pd(alpha);
+  PetscInt i;
+
+  for (i=0; i+8<=n; i+=8) _mm512_storeu_pd(w+i,_mm512_fmadd_pd(va,_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i)));
+  for (; i<n; i++) w[i] = alpha*x[i] + y[i];
+}
+
+static PetscScalar PETSC_SIMD_TARGET_AVX512 VecFusedDot_AVX512(PetscInt n,const PetscScalar *x,const PetscScalar *y)
+{
+  __m512d     acc0 = _mm512_setzero_pd(),acc1 = _mm512_setzero_pd();
+  PetscScalar sum[8];
+  PetscInt    i;
+
+  for (i=0; i+16<=n; i+=16) {
+    acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i),_mm512_loadu_pd(y+i),acc0);
+    acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i+8),_mm512_loadu_pd(y+i+8),acc1);
+  }
+  _mm512_storeu_pd(sum,_mm512_add_pd(acc0,acc1));
+  sum[0] += sum[1] + sum[2] + sum[3] + sum[4] + sum[5] + sum[6] + sum[7];
+  for (; i<n; i++) sum[0] += x[i]*y[i];
+  return sum[0];
+}
+
+static PetscReal PETSC_SIMD_TARGET_AVX512 VecFusedNorm2_AVX512(PetscInt n,const PetscScalar *x)
+{
+  return VecFusedDot_AVX512(n,x,x);
+}
+
+static const VecFusedKernels VecFusedKernels_AVX512 = {VecFusedAXPY_AVX512,VecFusedAYPX_AVX512,VecFusedWAXPY_AVX512,VecFusedDot_AVX512,VecFusedDot_AVX512,VecFusedNorm2_AVX512};
+#endif
+
+/*
+   Adds v to the list of distinct vectors used by the operations, returns its position
+*/
+static PetscErrorCode VecFusedAddVec_Private(Vec v,PetscBool write,PetscInt *nvecs,Vec vecs[],PetscBool written[],PetscInt *idx)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0; i<*nvecs; i++) if (vecs[i] == v) break;
+  if (i == *nvecs) {
+    vecs[i]    = v;
+    written[i] = PETSC_FALSE;
+    (*nvecs)++;
+  }
+  if (write) written[i] = PETSC_TRUE;
+  *idx = i;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecFusedLocal_Seq(Vec v,PetscInt n,const VecFusedOp ops[],PetscScalar *lvalues)
+{
+  PetscErrorCode        ierr;
+  const VecFusedKernels *kernels = &VecFusedKernels_Private;
+  PetscSIMDLevel        level;
+  PetscInt              nloc = v->map->n,nvecs = 0,nwritten = 0,nred = 0,i,k,start,len;
+  PetscInt              ix[VEC_FUSED_MAXOPS],iy[VEC_FUSED_MAXOPS],iw[VEC_FUSED_MAXOPS];
+  Vec                   vecs[3*VEC_FUSED_MAXOPS];
+  PetscBool             written[3*VEC_FUSED_MAXOPS];
+  PetscScalar           *arrays[3*VEC_FUSED_MAXOPS],sum[VEC_FUSED_MAXOPS];
+
+  PetscFunctionBegin;
+  if (n > VEC_FUSED_MAXOPS) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"At most %D fused operations, given %D",(PetscInt)VEC_FUSED_MAXOPS,n);
+  ierr = PetscSIMDGetLevel(&level);CHKERRQ(ierr);
+#if defined(PETSC_SIMD_USE_AVX2)
+  if (level >= PETSC_SIMD_AVX2) kernels = &VecFusedKernels_AVX2;
+#endif
+#if defined(PETSC_SIMD_USE_AVX512)
+  if (level >= PETSC_SIMD_AVX512) kernels = &VecFusedKernels_AVX512;
+#endif
+
+  /* get the array of each distinct vector once, for writing if any of the operations changes it */
+  for (k=0; k<n; k++) {
+    iy[k] = iw[k] = -1;
+    ierr = VecFusedAddVec_Private(ops[k].x,PETSC_FALSE,&nvecs,vecs,written,&ix[k]);CHKERRQ(ierr);
+    switch (ops[k].type) {
+    case VEC_FUSED_AXPY:
+    case VEC_FUSED_AYPX:
+      ierr = VecFusedAddVec_Private(ops[k].y,PETSC_TRUE,&nvecs,vecs,written,&iy[k]);CHKERRQ(ierr);
+      break;
+    case VEC_FUSED_WAXPY:
+      ierr = VecFusedAddVec_Private(ops[k].y,PETSC_FALSE,&nvecs,vecs,written,&iy[k]);CHKERRQ(ierr);
+      ierr = VecFusedAddVec_Private(ops[k].w,PETSC_TRUE,&nvecs,vecs,written,&iw[k]);CHKERRQ(ierr);
+      break;
+    case VEC_FUSED_DOT:
+    case VEC_FUSED_TDOT:
+      ierr = VecFusedAddVec_Private(ops[k].y,PETSC_FALSE,&nvecs,vecs,written,&iy[k]);CHKERRQ(ierr);
+      sum[k] = 0.0;
+      break;
+    case VEC_FUSED_NORM:
+      sum[k] = 0.0;
+      break;
+    default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Unknown fused operation %d",(int)ops[k].type);
+    }
+  }
+  for (i=0; i<nvecs; i++) {
+    if (vecs[i]->map->n != nloc) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Incompatible local vector lengths %D %D",vecs[i]->map->n,nloc);
+    if (written[i]) {
+      ierr = VecGetArray(vecs[i],&arrays[i]);CHKERRQ(ierr);
+      nwritten++;
+    } else {
+      ierr = VecGetArrayRead(vecs[i],(const PetscScalar**)&arrays[i]);CHKERRQ(ierr);
+    }
+  }
+
+  for (start=0; start<nloc; start+=VEC_FUSED_CHUNK) {
+    len = PetscMin(VEC_FUSED_CHUNK,nloc-start);
+    for (k=0; k<n; k++) {
+      const PetscScalar *x = arrays[ix[k]] + start;
+
+      switch (ops[k].type) {
+      case VEC_FUSED_AXPY:  (*kernels->axpy)(len,ops[k].alpha,x,arrays[iy[k]]+start); break;
+      case VEC_FUSED_AYPX:  (*kernels->aypx)(len,ops[k].alpha,x,arrays[iy[k]]+start); break;
+      case VEC_FUSED_WAXPY: (*kernels->waxpy)(len,ops[k].alpha,x,arrays[iy[k]]+start,arrays[iw[k]]+start); break;
+      case VEC_FUSED_DOT:   sum[k] += (*kernels->dot)(len,x,arrays[iy[k]]+start); break;
+      case VEC_FUSED_TDOT:  sum[k] += (*kernels->tdot)(len,x,arrays[iy[k]]+start); break;
+      case VEC_FUSED_NORM:  sum[k] += (*kernels->norm2)(len,x); break;
+      }
+    }
+  }
+
+  for (k=0; k<n; k++) {
+    if (ops[k].type == VEC_FUSED_DOT || ops[k].type == VEC_FUSED_TDOT || ops[k].type == VEC_FUSED_NORM) lvalues[nred++] = sum[k];
+  }
+  for (i=0; i<nvecs; i++) {
+    if (written[i]) {
+      ierr = VecRestoreArray(vecs[i],&arrays[i]);CHKERRQ(ierr);
+    } else {
+      ierr = VecRestoreArrayRead(vecs[i],(const PetscScalar**)&arrays[i]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscLogFlops(2.0*n*nloc);CHKERRQ(ierr);
+  ierr = PetscLogBytes((nvecs + nwritten)*nloc*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -752,3 +752,246 @@ PetscErrorCode  VecMTDotEnd(Vec x,PetscInt nv,const Vec y[],PetscScalar result[]
   ierr = VecMDotEnd(x,nv,y,result);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* -------------------------------------------------------------------------*/
+
+static PetscBool VecFusedOpIsReduction(VecFusedOpType type)
+{
+  return (type == VEC_FUSED_DOT || type == VEC_FUSED_TDOT || type == VEC_FUSED_NORM) ? PETSC_TRUE : PETSC_FALSE;
+}
+
+/*@
+   VecFusedBegin - Applies a sequence of vector updates and starts the split phase reductions
+   that follow them, reading and writing the entries once for the whole sequence
+
+   Collective on Vec
+
+   Input Parameters:
++  n - number of operations
+-  ops - the operations, built with VecFusedOpAXPY(), VecFusedOpAYPX(), VecFusedOpWAXPY(), VecFusedOpDot(),
+         VecFusedOpTDot() and VecFusedOpNorm()
+
+   Level: advanced
+
+   Notes:
+   The operations are done in the order given, so a reduction sees the updates that come before it.
+   The updates are complete when this returns; the reductions are combined with any other split phase
+   reductions started on the communicator and their results are obtained with VecFusedEnd(), called with
+   the same operations.
+
+   When all the vectors share an implementation of the fused kernel the operations are applied chunk by chunk
+   so each entry is loaded from memory once, using the vector instructions selected with PetscSIMDGetLevel().
+   Otherwise, for example with vectors whose current values are on a GPU, the operations are done one at a
+   time with VecAXPY(), VecDotBegin() and friends. The results can differ from the unfused ones in the last bits.
+
+   At most 16 operations can be fused.
+
+   KSPCG, KSPBCGS, KSPPIPECG, KSPPIPECGRR and KSPGROPPCG use the fused operations. KSPPIPELCG does not: it keeps
+   several reductions in flight at once with its own nonblocking allreduces, while a communicator has a single
+   set of split phase reductions, and its recurrences use VecMAXPY() and VecScale(), which have no fused form.
+
+   Example Usage:
+.vb
+     VecFusedOp  ops[3];
+     PetscScalar res[2];
+
+     ops[0] = VecFusedOpAXPY(x,a,p);
+     ops[1] = VecFusedOpAXPY(r,-a,w);
+     ops[2] = VecFusedOpNorm(r);
+     VecFusedBegin(3,ops);
+     ... other split phase reductions or work that does not change the vectors ...
+     VecFusedEnd(3,ops,res);
+.ve
+
+.seealso: VecFusedEnd(), VecFused(), VecFusedOp, VecDotBegin(), VecNormBegin(), PetscCommSplitReductionBegin()
+@*/
+PetscErrorCode VecFusedBegin(PetscInt n,const VecFusedOp ops[])
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  MPI_Comm            comm;
+  PetscErrorCode      (*fused_local)(Vec,PetscInt,const VecFusedOp[],PetscScalar*);
+  PetscBool           fused = PETSC_TRUE;
+  PetscInt            k,j,nred = 0;
+
+  PetscFunctionBegin;
+  if (n <= 0) PetscFunctionReturn(0);
+  PetscValidPointer(ops,2);
+  if (n > 16) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"At most 16 fused operations, given %D",n);
+  fused_local = ops[0].x ? ops[0].x->ops->fused_local : NULL;
+  for (k=0; k<n; k++) {
+    Vec vecs[3];
+
+    vecs[0] = ops[k].x; vecs[1] = ops[k].y; vecs[2] = ops[k].w;
+    PetscValidHeaderSpecific(ops[k].x,VEC_CLASSID,2);
+    if (ops[k].type != VEC_FUSED_NORM) PetscValidHeaderSpecific(ops[k].y,VEC_CLASSID,2);
+    if (ops[k].type == VEC_FUSED_WAXPY) PetscValidHeaderSpecific(ops[k].w,VEC_CLASSID,2);
+    if (VecFusedOpIsReduction(ops[k].type)) nred++;
+    for (j=0; j<3; j++) {
+      if (!vecs[j]) continue;
+      if (vecs[j]->ops->fused_local != fused_local) fused = PETSC_FALSE;
+#if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
+      if (vecs[j]->offloadmask == PETSC_OFFLOAD_GPU) fused = PETSC_FALSE;
+#endif
+    }
+  }
+  if (!fused_local) fused = PETSC_FALSE;
+
+  if (!fused) {
+    for (k=0; k<n; k++) {
+      switch (ops[k].type) {
+      case VEC_FUSED_AXPY:  ierr = VecAXPY(ops[k].y,ops[k].alpha,ops[k].x);CHKERRQ(ierr); break;
+      case VEC_FUSED_AYPX:  ierr = VecAYPX(ops[k].y,ops[k].alpha,ops[k].x);CHKERRQ(ierr); break;
+      case VEC_FUSED_WAXPY: ierr = VecWAXPY(ops[k].w,ops[k].alpha,ops[k].x,ops[k].y);CHKERRQ(ierr); break;
+      case VEC_FUSED_DOT:   ierr = VecDotBegin(ops[k].x,ops[k].y,NULL);CHKERRQ(ierr); break;
+      case VEC_FUSED_TDOT:  ierr = VecTDotBegin(ops[k].x,ops[k].y,NULL);CHKERRQ(ierr); break;
+      case VEC_FUSED_NORM:  ierr = VecNormBegin(ops[k].x,NORM_2,NULL);CHKERRQ(ierr); break;
+      default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Unknown fused operation %d",(int)ops[k].type);
+      }
+    }
+    PetscFunctionReturn(0);
+  }
+
+  ierr = PetscObjectGetComm((PetscObject)ops[0].x,&comm);CHKERRQ(ierr);
+  ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
+  while (sr->numopsbegin+nred > sr->maxops) {
+    ierr = PetscSplitReductionExtend(sr);CHKERRQ(ierr);
+  }
+  for (k=0,j=sr->numopsbegin; k<n; k++) {
+    if (!VecFusedOpIsReduction(ops[k].type)) continue;
+    sr->reducetype[j] = PETSC_SR_REDUCE_SUM;
+    sr->invecs[j++]   = (void*)ops[k].x;
+  }
+  ierr = PetscLogEventBegin(VEC_Fused,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*fused_local)(ops[0].x,n,ops,sr->lvalues+sr->numopsbegin);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_Fused,0,0,0,0);CHKERRQ(ierr);
+  sr->numopsbegin += nred;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecFusedEnd - Ends the reductions of a sequence of operations started with VecFusedBegin()
+
+   Collective on Vec
+
+   Input Parameters:
++  n - number of operations
+-  ops - the operations given to VecFusedBegin()
+
+   Output Parameter:
+.  result - one value for each VEC_FUSED_DOT, VEC_FUSED_TDOT and VEC_FUSED_NORM operation, in order; the
+            norms are 2-norms stored in the real part
+
+   Level: advanced
+
+   Notes:
+   Like the other split phase reductions, the calls to VecFusedEnd() and VecxxxEnd() must be in the same
+   order as the calls that began them.
+
+.seealso: VecFusedBegin(), VecFused(), VecFusedOp, VecDotEnd(), VecNormEnd()
+@*/
+PetscErrorCode VecFusedEnd(PetscInt n,const VecFusedOp ops[],PetscScalar result[])
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  MPI_Comm            comm;
+  PetscReal           norm;
+  PetscInt            k,l,j = 0,nred = 0;
+  PetscBool           cache;
+
+  PetscFunctionBegin;
+  if (n <= 0) PetscFunctionReturn(0);
+  PetscValidPointer(ops,2);
+  PetscValidHeaderSpecific(ops[0].x,VEC_CLASSID,2);
+  /* a sequence of updates only has nothing to communicate */
+  for (k=0; k<n; k++) if (VecFusedOpIsReduction(ops[k].type)) nred++;
+  if (!nred) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)ops[0].x,&comm);CHKERRQ(ierr);
+  ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  ierr = PetscSplitReductionEnd(sr);CHKERRQ(ierr);
+
+  for (k=0; k<n; k++) {
+    if (!VecFusedOpIsReduction(ops[k].type)) continue;
+    PetscValidPointer(result,3);
+    if (sr->numopsend >= sr->numopsbegin) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Called VecxxxEnd() more times then VecxxxBegin()");
+    if ((void*)ops[k].x != sr->invecs[sr->numopsend]) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Called VecxxxEnd() in a different order or with a different vector than VecxxxBegin()");
+    if (sr->reducetype[sr->numopsend] != PETSC_SR_REDUCE_SUM) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Called VecFusedEnd() on a reduction started with VecNormBegin(,NORM_MAX,)");
+    if (ops[k].type == VEC_FUSED_NORM) {
+      norm        = PetscSqrtReal(PetscRealPart(sr->gvalues[sr->numopsend++]));
+      result[j++] = norm;
+      /* the cached norm is only valid if no later operation changed the vector */
+      cache = PETSC_TRUE;
+      for (l=k+1; l<n; l++) {
+        if (ops[l].type == VEC_FUSED_WAXPY && ops[l].w == ops[k].x) cache = PETSC_FALSE;
+        if ((ops[l].type == VEC_FUSED_AXPY || ops[l].type == VEC_FUSED_AYPX) && ops[l].y == ops[k].x) cache = PETSC_FALSE;
+      }
+      if (cache) {
+        ierr = PetscObjectComposedDataSetReal((PetscObject)ops[k].x,NormIds[NORM_2],norm);CHKERRQ(ierr);
+      }
+    } else result[j++] = sr->gvalues[sr->numopsend++];
+  }
+
+  if (sr->numopsend == sr->numopsbegin) {
+    sr->state       = STATE_BEGIN;
+    sr->numopsend   = 0;
+    sr->numopsbegin = 0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecFused - Applies a sequence of vector updates and reductions in one pass over the entries, with one
+   global reduction for all the results
+
+   Collective on Vec
+
+   Input Parameters:
++  n - number of operations
+-  ops - the operations, built with VecFusedOpAXPY() and friends
+
+   Output Parameter:
+.  result - one value for each reduction, see VecFusedEnd()
+
+   Level: advanced
+
+   Notes:
+   While split phase reductions are pending on the communicator of the vectors, as when a Krylov method is the
+   preconditioner of a pipelined one, the operations are applied one by one with blocking reductions.
+
+.seealso: VecFusedBegin(), VecFusedEnd(), VecFusedOp
+@*/
+PetscErrorCode VecFused(PetscInt n,const VecFusedOp ops[],PetscScalar result[])
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  MPI_Comm            comm;
+  PetscReal           norm;
+  PetscInt            k,j = 0;
+
+  PetscFunctionBegin;
+  if (n <= 0) PetscFunctionReturn(0);
+  PetscValidPointer(ops,2);
+  PetscValidHeaderSpecific(ops[0].x,VEC_CLASSID,2);
+  ierr = PetscObjectGetComm((PetscObject)ops[0].x,&comm);CHKERRQ(ierr);
+  ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  /* a solver called between the VecxxxBegin() and VecxxxEnd() of another one, for instance as its
+     preconditioner, cannot add to the split reductions in flight on the communicator */
+  if (sr->state != STATE_BEGIN || sr->numopsbegin) {
+    for (k=0; k<n; k++) {
+      switch (ops[k].type) {
+      case VEC_FUSED_AXPY:  ierr = VecAXPY(ops[k].y,ops[k].alpha,ops[k].x);CHKERRQ(ierr); break;
+      case VEC_FUSED_AYPX:  ierr = VecAYPX(ops[k].y,ops[k].alpha,ops[k].x);CHKERRQ(ierr); break;
+      case VEC_FUSED_WAXPY: ierr = VecWAXPY(ops[k].w,ops[k].alpha,ops[k].x,ops[k].y);CHKERRQ(ierr); break;
+      case VEC_FUSED_DOT:   ierr = VecDot(ops[k].x,ops[k].y,&result[j++]);CHKERRQ(ierr); break;
+      case VEC_FUSED_TDOT:  ierr = VecTDot(ops[k].x,ops[k].y,&result[j++]);CHKERRQ(ierr); break;
+      case VEC_FUSED_NORM:  ierr = VecNorm(ops[k].x,NORM_2,&norm);CHKERRQ(ierr); result[j++] = norm; break;
+      default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Unknown fused operation %d",(int)ops[k].type);
+      }
+    }
+    PetscFunctionReturn(0);
+  }
+  ierr = VecFusedBegin(n,ops);CHKERRQ(ierr);
+  ierr = VecFusedEnd(n,ops,result);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -79,6 +79,7 @@ PetscErrorCode PETSCMAP1(VecScatterBeginMPI1)(VecScatter ctx,Vec xin,Vec yin,Ins
         PETSCMAP1(Pack_MPI1)(sstarts[i+1]-sstarts[i],indices + sstarts[i],xv,svalues + bs*sstarts[i],bs);
       }
       ierr = MPI_Start_isend((sstarts[i+1]-sstarts[i])*bs,MPIU_SCALAR,swaits+i);CHKERRQ(ierr);
+      ierr = PetscLogCommSend(PetscObjectComm((PetscObject)ctx),to->procs[i],(sstarts[i+1]-sstarts[i])*bs,MPIU_SCALAR);CHKERRQ(ierr);
     }
   }
 
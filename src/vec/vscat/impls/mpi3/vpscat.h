@@ -78,6 +78,7 @@ PetscErrorCode PETSCMAP1(VecScatterBegin)(VecScatter ctx,Vec xin,Vec yin,InsertM
     for (i=0; i<nsends; i++) {
       PETSCMAP1(Pack)(sstarts[i+1]-sstarts[i],indices + sstarts[i],xv,svalues + bs*sstarts[i],bs);
       ierr = MPI_Start_isend((sstarts[i+1]-sstarts[i])*bs,MPIU_SCALAR,swaits+i);CHKERRQ(ierr);
+      ierr = PetscLogCommSend(PetscObjectComm((PetscObject)ctx),to->procs[i],(sstarts[i+1]-sstarts[i])*bs,MPIU_SCALAR);CHKERRQ(ierr);
     }
   }
 
@@ -216,6 +217,7 @@ PetscErrorCode PETSCMAP1(VecScatterBeginMPI3Node)(VecScatter ctx,Vec xin,Vec yin
     for (i=0; i<nsends; i++) {
       PETSCMAP1(Pack)(sstarts[i+1]-sstarts[i],indices + sstarts[i],xv,svalues + bs*sstarts[i],bs);
       ierr = MPI_Start_isend((sstarts[i+1]-sstarts[i])*bs,MPIU_SCALAR,swaits+i);CHKERRQ(ierr);
+      ierr = PetscLogCommSend(PetscObjectComm((PetscObject)ctx),to->procs[i],(sstarts[i+1]-sstarts[i])*bs,MPIU_SCALAR);CHKERRQ(ierr);
     }
   }
 